@@ -23,10 +23,12 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/solvers1d/newtonsafe.hpp>
 #include <ql/patterns/visitor.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/yield/discountadjoints.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
 #include <utility>
@@ -518,6 +520,78 @@ namespace QuantLib {
         return { npv, bps };
     }
 
+    void CashFlows::npvbpsAdjoint(const Leg& leg,
+                                  const YieldTermStructure& discountCurve,
+                                  bool includeSettlementDateFlows,
+                                  Date settlementDate,
+                                  Date npvDate,
+                                  Real npvAdjoint,
+                                  Real bpsAdjoint,
+                                  DiscountAdjoints& adjoints) {
+        if (leg.empty())
+            return;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        Date today = Settings::instance().evaluationDate();
+        DiscountFactor d = discountCurve.discount(npvDate);
+        Real npv = 0.0, bps = 0.0;
+
+        for (const auto& i : leg) {
+            CashFlow& cf = *i;
+            if (!cf.hasOccurred(settlementDate,
+                                includeSettlementDateFlows) &&
+                !cf.tradingExCoupon(settlementDate)) {
+                std::shared_ptr<Coupon> cp = std::dynamic_pointer_cast<Coupon>(i);
+                Real df = discountCurve.discount(cf.date());
+                Real amount = cf.amount();
+                npv += amount * df;
+                Real dfAdjoint = amount * npvAdjoint / d;
+                if (cp != nullptr) {
+                    Real accrual = cp->nominal() * cp->accrualPeriod();
+                    bps += accrual * df;
+                    dfAdjoint += accrual * basisPoint_ * bpsAdjoint / d;
+                }
+                adjoints.add(discountCurve, cf.date(), dfAdjoint);
+
+                auto fc = std::dynamic_pointer_cast<FloatingRateCoupon>(i);
+                if (fc == nullptr)
+                    continue;
+                auto ibor = std::dynamic_pointer_cast<IborCoupon>(fc);
+                QL_REQUIRE(ibor != nullptr || fc->fixingDate() < today,
+                           "adjoint not available for "
+                           << fc->index()->name() << " coupons");
+                // known fixings, as in IborCoupon::indexFixing
+                if (ibor == nullptr || ibor->fixingDate() < today ||
+                    (ibor->fixingDate() == today &&
+                     (Settings::instance().enforcesTodaysHistoricFixings() ||
+                      ibor->index()->pastFixing(today) != Null<Real>())))
+                    continue;
+                QL_REQUIRE(!ibor->isInArrears(),
+                           "adjoint not available for in-arrears coupons");
+                const Handle<YieldTermStructure>& forwarding =
+                    ibor->iborIndex()->forwardingTermStructure();
+                QL_REQUIRE(!forwarding.empty(),
+                           "null term structure set to this instance of "
+                           << ibor->index()->name());
+                adjoints.addForward(**forwarding,
+                                    ibor->fixingValueDate(),
+                                    ibor->fixingEndDate(),
+                                    ibor->spanningTime(),
+                                    df * npvAdjoint / d * ibor->gearing() *
+                                        ibor->nominal() * ibor->accrualPeriod());
+            }
+        }
+
+        // d enters as npv/d and bps/d
+        adjoints.add(discountCurve, npvDate,
+                     -(npvAdjoint * npv + bpsAdjoint * basisPoint_ * bps) / (d * d));
+    }
+
     Rate CashFlows::atmRate(const Leg& leg,
                             const YieldTermStructure& discountCurve,
                             bool includeSettlementDateFlows,
@@ -35,6 +35,7 @@
 namespace QuantLib {
 
     class YieldTermStructure;
+    class DiscountAdjoints;
 
     //! %cashflow-analysis functions
     /*! \todo add tests */
@@ -206,6 +207,28 @@ namespace QuantLib {
                            Real& npv,
                            Real& bps);
 
+        //! Adjoint of the NPV and BPS of the cash flows.
+        /*! Adds to the given adjoints the derivatives of
+            npvAdjoint*NPV + bpsAdjoint*BPS, as returned by npvbps(),
+            with respect to the discount factors read from the
+            discount curve and, for Ibor coupons whose fixing is
+            still to be forecast, from the forwarding curve of their
+            index.
+
+            \warning Ibor coupons are assumed to pay
+                     gearing*fixing+spread, as with the default
+                     pricer; in-arrears coupons and other floating-rate
+                     coupons are not supported.
+        */
+        static void npvbpsAdjoint(const Leg& leg,
+                                  const YieldTermStructure& discountCurve,
+                                  bool includeSettlementDateFlows,
+                                  Date settlementDate,
+                                  Date npvDate,
+                                  Real npvAdjoint,
+                                  Real bpsAdjoint,
+                                  DiscountAdjoints& adjoints);
+
         //! At-the-money rate of the cash flows.
         /*! The result is the fixed rate for which a fixed rate cash flow
             vector, equivalent to the input vector, has the required NPV
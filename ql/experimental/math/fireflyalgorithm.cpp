@@ -30,11 +30,12 @@ namespace QuantLib {
                                        Size Mde,
                                        Real mutation,
                                        Real crossover,
-                                       unsigned long seed)
+                                       unsigned long seed,
+                                       Size threads)
     : mutation_(mutation), crossover_(crossover), M_(M), Mde_(Mde), Mfa_(M_ - Mde_),
       intensity_(std::move(intensity)), randomWalk_(std::move(randomWalk)),
       generator_(seed), distribution_(Mfa_, Mde > 0 ? M_ - 1 : M_),
-      rng_(seed) {
+      rng_(seed), threads_(threads) {
         QL_REQUIRE(M_ >= Mde_,
             "Differential Evolution subpopulation cannot be larger than total population");
     }
@@ -63,10 +64,13 @@ namespace QuantLib {
                 //Assign X=lb+(ub-lb)*random
                 x[j] = lX_[j] + bounds[j] * sample[j];
             }
-            //Evaluate point
-            values_.emplace_back(P.value(x), i);
         }
 
+        //Evaluate points
+        const Array f = P.batchValue(x_, threads_);
+        for (Size i = 0; i < M_; i++)
+            values_.emplace_back(f[i], i);
+
         //init intensity & randomWalk
         intensity_->init(this);
         randomWalk_->init(this);
@@ -173,29 +177,38 @@ namespace QuantLib {
                 randomWalk_->walk();
 
                 //Loop over particles
+                std::vector<Array> zFA(Mfa_, Array(N_));
                 for (Size i = 0; i < Mfa_; i++) {
                     Size index = values_[i].second;
-                    Array& x   = x_[index];
-                    Array& xI  = xI_[index];
-                    Array& xRW = xRW_[index];
+                    const Array& x   = x_[index];
+                    const Array& xI  = xI_[index];
+                    const Array& xRW = xRW_[index];
+                    Array& zi = zFA[i];
 
                     //Loop over dimensions
                     for (Size j = 0; j < N_; j++) {
                         //Update position
-                        z[j] = x[j] + xI[j] + xRW[j];
+                        zi[j] = x[j] + xI[j] + xRW[j];
                         //Enforce bounds on positions
-                        if (z[j] < lX_[j]) {
-                            z[j] = lX_[j];
+                        if (zi[j] < lX_[j]) {
+                            zi[j] = lX_[j];
                         }
-                        else if (z[j] > uX_[j]) {
-                            z[j] = uX_[j];
+                        else if (zi[j] > uX_[j]) {
+                            zi[j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
-                    if(!std::isnan(val))
+                }
+
+                //Evaluate particles
+                const Array f = P.batchValue(zFA, threads_);
+                for (Size i = 0; i < Mfa_; i++) {
+                    Size index = values_[i].second;
+                    Array& x = x_[index];
+                    Real val = f[i];
+                    if (val < QL_MAX_REAL)
 					{
 						//Accept new point
-                        x = z;
+                        x = zFA[i];
                         values_[index].first = val;
                         //mark best
                         if (val < bestValue) {
@@ -76,6 +76,12 @@ namespace QuantLib {
     \f]
     where C is the crossover constant, and R is a random uniformly distributed
     number.
+
+    The initial population and the firefly subpopulation of each iteration
+    are evaluated with a single call to Problem::batchValue(), in parallel if
+    more than one thread is given; the cost function must be thread safe in
+    this case. The DE operator updates the population in place and is applied
+    sequentially.
     */
     class FireflyAlgorithm : public OptimizationMethod {
       public:
@@ -87,7 +93,8 @@ namespace QuantLib {
                          Size Mde = 0,
                          Real mutationFactor = 1.0,
                          Real crossoverFactor = 0.5,
-                         unsigned long seed = SeedGenerator::instance().get());
+                         unsigned long seed = SeedGenerator::instance().get(),
+                         Size threads = 1);
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem& P, const EndCriteria& endCriteria) override;
 
@@ -102,6 +109,7 @@ namespace QuantLib {
         std::mt19937 generator_;
         std::uniform_int_distribution<QuantLib::Size> distribution_;
         MersenneTwisterUniformRng rng_;
+        Size threads_;
     };
 
     //! Base intensity class
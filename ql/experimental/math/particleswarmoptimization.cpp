@@ -30,8 +30,10 @@ namespace QuantLib {
                                                          std::shared_ptr<Inertia> inertia,
                                                          Real c1,
                                                          Real c2,
-                                                         unsigned long seed)
-    : M_(M), rng_(seed), topology_(std::move(topology)), inertia_(std::move(inertia)) {
+                                                         unsigned long seed,
+                                                         Size threads)
+    : M_(M), rng_(seed), threads_(threads), topology_(std::move(topology)),
+      inertia_(std::move(inertia)) {
         Real phi = c1 + c2;
         QL_ENSURE(phi*phi - 4 * phi != 0.0, "Invalid phi");
         c0_ = 2.0 / std::abs(2.0 - phi - sqrt(phi*phi - 4 * phi));
@@ -45,9 +47,10 @@ namespace QuantLib {
                                                          Real omega,
                                                          Real c1,
                                                          Real c2,
-                                                         unsigned long seed)
-    : M_(M), c0_(omega), c1_(c1), c2_(c2), rng_(seed), topology_(std::move(topology)),
-      inertia_(std::move(inertia)) {}
+                                                         unsigned long seed,
+                                                         Size threads)
+    : M_(M), c0_(omega), c1_(c1), c2_(c2), rng_(seed), threads_(threads),
+      topology_(std::move(topology)), inertia_(std::move(inertia)) {}
 
     void ParticleSwarmOptimization::startState(Problem &P, const EndCriteria &endCriteria) {
         QL_REQUIRE(topology_, "Invalid topology");
@@ -82,10 +85,11 @@ namespace QuantLib {
                 //Assign V=(ub-lb)*2*random-(ub-lb) -> between (lb-ub) and (ub-lb)
                 v[j] = bounds[j] * (2.0*sample[2 * j + 1] - 1.0);
             }
-            //Evaluate X and assign as personal best
+            //Assign X as personal best
             pBX_.push_back(X_.back());
-            pBF_[i] = P.value(X_.back());
         }
+        //Evaluate X
+        pBF_ = P.batchValue(X_, threads_);
 
         //init topology & inertia
         topology_->init(this);
@@ -130,7 +134,7 @@ namespace QuantLib {
             //Loop over particles
             for (Size i = 0; i < M_; i++) {
                 Array& x = X_[i];
-                Array& pB = pBX_[i];
+                const Array& pB = pBX_[i];
                 const Array& gB = gBX_[i];
                 Array& v = V_[i];
 
@@ -150,15 +154,18 @@ namespace QuantLib {
                         v[j] = 0.0;
                     }
                 }
-                //Evaluate x
-                Real f = P.value(x);
-                if (f < pBF_[i]) {
+            }
+
+            //Evaluate particles
+            const Array f = P.batchValue(X_, threads_);
+            for (Size i = 0; i < M_; i++) {
+                if (f[i] < pBF_[i]) {
                     //Update personal best
-                    pBF_[i] = f;
-                    pB = x;
+                    pBF_[i] = f[i];
+                    pBX_[i] = X_[i];
                     //Check stationary condition
-                    if (f < bestValue) {
-                        bestValue = f;
+                    if (f[i] < bestValue) {
+                        bestValue = f[i];
                         bestPosition = i;
                         iterationStat = 0;
                     }
@@ -88,6 +88,12 @@ namespace QuantLib {
 
     The optimization stops either because the number of iterations has been reached
     or because the stationary function value limit has been reached.
+
+    The particles of each iteration are evaluated with a single call to
+    Problem::batchValue(), in parallel if more than one thread is given;
+    the cost function must be thread safe in this case. All random numbers
+    are drawn before the evaluation, hence the results do not depend on the
+    number of threads.
     */
     class ParticleSwarmOptimization : public OptimizationMethod {
       public:
@@ -98,14 +104,16 @@ namespace QuantLib {
                                   std::shared_ptr<Inertia> inertia,
                                   Real c1 = 2.05,
                                   Real c2 = 2.05,
-                                  unsigned long seed = SeedGenerator::instance().get());
+                                  unsigned long seed = SeedGenerator::instance().get(),
+                                  Size threads = 1);
         explicit ParticleSwarmOptimization(Size M,
                                            std::shared_ptr<Topology> topology,
                                            std::shared_ptr<Inertia> inertia,
                                            Real omega,
                                            Real c1,
                                            Real c2,
-                                           unsigned long seed = SeedGenerator::instance().get());
+                                           unsigned long seed = SeedGenerator::instance().get(),
+                                           Size threads = 1);
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem& P, const EndCriteria& endCriteria) override;
 
@@ -116,6 +124,7 @@ namespace QuantLib {
         Size M_, N_;
         Real c0_, c1_, c2_;
         MersenneTwisterUniformRng rng_;
+        Size threads_;
         std::shared_ptr<Topology> topology_;
         std::shared_ptr<Inertia> inertia_;
     };
@@ -48,6 +48,10 @@ namespace QuantLib {
         Real drift(Time t, Real x) const override;
         Real diffusion(Time t, Real x) const override;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const override;
+        //! the evolution is overridden, no coefficients are available
+        bool stepCoefficients(const TimeGrid&, Array&, Array&) const override {
+            return false;
+        }
 
       private:
         const Discretization discretization_;
@@ -0,0 +1,128 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/experimental/risk/scenariorunner.hpp>
+#include <ql/patterns/dependencygraph.hpp>
+#include <algorithm>
+#include <map>
+
+namespace QuantLib {
+
+    ScenarioRunner::ScenarioRunner(
+                        std::vector<Handle<SimpleQuote> > quotes,
+                        std::vector<std::shared_ptr<Instrument> > instruments,
+                        std::vector<Real> quantities)
+    : quotes_(std::move(quotes)), instruments_(std::move(instruments)),
+      quantities_(std::move(quantities)), baseNpvs_(instruments_.size()),
+      baseNpv_(0.0), impact_(quotes_.size()),
+      impacted_(instruments_.size(), 0),
+      scenarios_(0), repriced_(0), skipped_(0) {
+
+        const Size n = instruments_.size();
+        if (quantities_.empty() ||
+            (quantities_.size()==1 && quantities_[0]==1.0)) {
+            quantities_ = std::vector<Real>(n, 1.0);
+        } else {
+            QL_REQUIRE(quantities_.size()==n,
+                       "dimension mismatch between instruments (" << n <<
+                       ") and quantities (" << quantities_.size() << ")");
+        }
+
+        // some objects register with their dependencies only when
+        // calculated; hence, the graph is queried afterwards
+        for (Size k=0; k<n; ++k) {
+            baseNpvs_[k] = instruments_[k]->NPV();
+            baseNpv_ += quantities_[k]*baseNpvs_[k];
+        }
+
+        std::map<const Instrument*, Size> index;
+        for (Size k=0; k<n; ++k)
+            index[instruments_[k].get()] = k;
+
+        for (Size i=0; i<quotes_.size(); ++i) {
+            QL_REQUIRE(!quotes_[i].empty(), "empty quote handle");
+            for (Instrument* instrument :
+                     reachableObservers<Instrument>(*quotes_[i].currentLink())) {
+                auto k = index.find(instrument);
+                if (k != index.end())
+                    impact_[i].push_back(k->second);
+            }
+            std::sort(impact_[i].begin(), impact_[i].end());
+        }
+    }
+
+    const std::vector<Size>& ScenarioRunner::impactedInstruments(Size i) const {
+        QL_REQUIRE(i < impact_.size(),
+                   "quote index (" << i << ") out of range");
+        return impact_[i];
+    }
+
+    Real ScenarioRunner::npv(const Scenario& scenario) {
+        std::vector<Size> instruments;
+        for (const auto& shift : scenario) {
+            QL_REQUIRE(shift.first < quotes_.size(),
+                       "quote index (" << shift.first << ") out of range");
+            for (Size k : impact_[shift.first]) {
+                if (impacted_[k] == 0) {
+                    impacted_[k] = 1;
+                    instruments.push_back(k);
+                }
+            }
+        }
+        for (Size k : instruments)
+            impacted_[k] = 0;
+
+        std::vector<Real> values(scenario.size());
+        Size applied = 0;
+        Real change = 0.0;
+        try {
+            for (; applied < scenario.size(); ++applied) {
+                const Handle<SimpleQuote>& quote =
+                    quotes_[scenario[applied].first];
+                values[applied] =
+                    quote->isValid() ? quote->value() : Null<Real>();
+                quote->setValue(scenario[applied].second);
+            }
+            for (Size k : instruments)
+                change += quantities_[k]*(instruments_[k]->NPV()-baseNpvs_[k]);
+        } catch (...) {
+            // restore in reverse order, in case a quote is set twice
+            while (applied-- > 0)
+                quotes_[scenario[applied].first]->setValue(values[applied]);
+            throw;
+        }
+        while (applied-- > 0)
+            quotes_[scenario[applied].first]->setValue(values[applied]);
+
+        ++scenarios_;
+        repriced_ += instruments.size();
+        skipped_ += instruments_.size() - instruments.size();
+
+        return baseNpv_ + change;
+    }
+
+    std::vector<Real>
+    ScenarioRunner::npv(const std::vector<Scenario>& scenarios) {
+        std::vector<Real> result;
+        result.reserve(scenarios.size());
+        for (const auto& scenario : scenarios)
+            result.push_back(npv(scenario));
+        return result;
+    }
+
+}
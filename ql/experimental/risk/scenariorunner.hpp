@@ -0,0 +1,86 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file scenariorunner.hpp
+    \brief portfolio valuation under market scenarios
+*/
+
+#ifndef quantlib_scenario_runner_hpp
+#define quantlib_scenario_runner_hpp
+
+#include <ql/handle.hpp>
+#include <ql/instrument.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! portfolio valuation under market scenarios
+    /*! A scenario assigns new values to some of the given quotes.
+        The instruments reachable from each quote through the graph
+        of observers are determined at construction, after
+        calculating the base NPVs of all instruments. For each
+        scenario, only the instruments reachable from the modified
+        quotes are repriced; the others contribute their base NPV.
+        The quotes are restored after each scenario.
+
+        The base NPVs and the impact map are not updated if the
+        market data or the instruments are modified outside the
+        runner; a new runner must be built in that case.
+
+        Empty quantities vector is considered as unit vector.
+    */
+    class ScenarioRunner {
+      public:
+        //! pairs of quote index and quote value
+        typedef std::vector<std::pair<Size, Real> > Scenario;
+
+        ScenarioRunner(std::vector<Handle<SimpleQuote> > quotes,
+                       std::vector<std::shared_ptr<Instrument> > instruments,
+                       std::vector<Real> quantities = std::vector<Real>());
+
+        //! base value of the portfolio
+        Real npv() const { return baseNpv_; }
+        //! value of the portfolio under the given scenario
+        Real npv(const Scenario& scenario);
+        //! values of the portfolio under the given scenarios
+        std::vector<Real> npv(const std::vector<Scenario>& scenarios);
+
+        //! indices of the instruments depending on the i-th quote
+        const std::vector<Size>& impactedInstruments(Size i) const;
+
+        //! \name Statistics
+        //@{
+        Size scenarios() const { return scenarios_; }
+        Size repricedInstruments() const { return repriced_; }
+        Size skippedInstruments() const { return skipped_; }
+        //@}
+      private:
+        std::vector<Handle<SimpleQuote> > quotes_;
+        std::vector<std::shared_ptr<Instrument> > instruments_;
+        std::vector<Real> quantities_, baseNpvs_;
+        Real baseNpv_;
+        std::vector<std::vector<Size> > impact_;
+        std::vector<char> impacted_;
+        Size scenarios_, repriced_, skipped_;
+    };
+
+}
+
+#endif
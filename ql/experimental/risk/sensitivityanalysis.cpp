@@ -20,12 +20,116 @@
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/instrument.hpp>
+#include <algorithm>
+#include <exception>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using std::vector;
 using std::pair;
 
 namespace QuantLib {
 
+    namespace {
+
+        // raises a flag when the observed instrument is notified
+        class NotificationFlag : public Observer {
+          public:
+            explicit NotificationFlag(char& flag) : flag_(flag) {}
+            void update() override { flag_ = 1; }
+          private:
+            char& flag_;
+        };
+
+        /* Tweaks quotes and reprices the instruments notified since
+           their last valuation; the others still have their reference
+           NPV. Instruments notified when a quote is restored are
+           repriced together with the next tweak, as it would happen
+           when calculating the aggregate NPV.
+        */
+        class BucketRepricer {
+          public:
+            BucketRepricer(const vector<std::shared_ptr<Instrument> >& instr,
+                           const vector<Real>& quant)
+            : instruments_(instr), quantities_(instr.size(), 1.0),
+              referenceNpvs_(instr.size()), notified_(instr.size(), 0) {
+                Size n = instruments_.size();
+                if (!quant.empty() && !(quant.size()==1 && quant[0]==1.0)) {
+                    QL_REQUIRE(quant.size()==n,
+                               "dimension mismatch between instruments (" << n <<
+                               ") and quantities (" << quant.size() << ")");
+                    quantities_ = quant;
+                }
+                flags_.reserve(n);
+                for (Size k=0; k<n; ++k) {
+                    referenceNpvs_[k] = instruments_[k]->NPV();
+                    flags_.push_back(
+                        std::make_shared<NotificationFlag>(notified_[k]));
+                    flags_.back()->registerWith(instruments_[k]);
+                }
+            }
+            BucketRepricer(const BucketRepricer&) = delete;
+            BucketRepricer& operator=(const BucketRepricer&) = delete;
+
+            pair<Real, Real> bucket(const Handle<SimpleQuote>& quote,
+                                    Real shift,
+                                    SensitivityAnalysis type) {
+                pair<Real, Real> result(0.0, 0.0);
+                if (!quote->isValid()) return result;
+                Real quoteValue = quote->value();
+
+                try {
+                    quote->setValue(quoteValue+shift);
+                    Real up = npvChange();
+                    switch (type) {
+                      case OneSide:
+                        result.first = up/shift;
+                        result.second = Null<Real>();
+                        break;
+                      case Centered:
+                        {
+                        quote->setValue(quoteValue-shift);
+                        Real down = npvChange();
+                        result.first = (up-down)/(2.0*shift);
+                        result.second = (up+down)/(shift*shift);
+                        }
+                        break;
+                      default:
+                          QL_FAIL("unknown SensitivityAnalysis (" <<
+                                  Integer(type) << ")");
+                    }
+                    quote->setValue(quoteValue);
+                } catch (...) {
+                    quote->setValue(quoteValue);
+                    throw;
+                }
+
+                return result;
+            }
+
+          private:
+            // change of the aggregate NPV with respect to the reference
+            Real npvChange() {
+                Real change = 0.0;
+                for (Size k=0; k<instruments_.size(); ++k) {
+                    if (notified_[k] != 0) {
+                        notified_[k] = 0;
+                        change += quantities_[k] *
+                            (instruments_[k]->NPV()-referenceNpvs_[k]);
+                    }
+                }
+                return change;
+            }
+
+            const vector<std::shared_ptr<Instrument> >& instruments_;
+            vector<Real> quantities_, referenceNpvs_;
+            vector<char> notified_;
+            vector<std::shared_ptr<NotificationFlag> > flags_;
+        };
+
+    }
+
     std::ostream& operator<<(std::ostream& out,
                              SensitivityAnalysis s) {
         switch (s) {
@@ -268,11 +372,12 @@ namespace QuantLib {
 
         if (instr.empty()) return result;
 
-        Real npv = aggregateNPV(instr, quant);
+        QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+        BucketRepricer repricer(instr, quant);
 
         pair<Real, Real> tmp;
         for (Size i=0; i<n; ++i) {
-            tmp = bucketAnalysis(quotes[i], instr, quant, shift, type, npv);
+            tmp = repricer.bucket(quotes[i], shift, type);
             result.first[i] = tmp.first;
             result.second[i] = tmp.second;
         }
@@ -280,6 +385,70 @@ namespace QuantLib {
         return result;
     }
 
+    pair<vector<Real>, vector<Real> >
+    parallelBucketAnalysis(
+                    const std::function<SensitivityAnalysisSetup()>& setup,
+                    const vector<Real>& quant,
+                    Real shift,
+                    SensitivityAnalysis type,
+                    Size workers)
+    {
+        QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+        QL_REQUIRE(workers!=0, "null number of workers");
+        // deferred notifications are collected in a global registry
+        QL_REQUIRE(ObservableSettings::instance().updatesEnabled(),
+                   "updates must be enabled for parallel sensitivity analysis");
+
+        // the copies are built here since their construction might
+        // register observers with global observables, e.g., the
+        // evaluation date
+        vector<SensitivityAnalysisSetup> setups(1, setup());
+        Size n = setups[0].first.size();
+        QL_REQUIRE(n>0, "empty SimpleQuote vector");
+        pair<vector<Real>, vector<Real> > result(vector<Real>(n, 0.0),
+                                                 vector<Real>(n, 0.0));
+
+        if (setups[0].second.empty()) return result;
+
+        Size nWorkers = workers;
+        if (nWorkers == Null<Size>()) {
+            nWorkers = 1;
+            #ifdef _OPENMP
+            nWorkers = omp_get_max_threads();
+            #endif
+        }
+        nWorkers = std::min(nWorkers, n);
+        for (Size w=1; w<nWorkers; ++w) {
+            setups.push_back(setup());
+            QL_REQUIRE(setups[w].first.size()==n &&
+                       setups[w].second.size()==setups[0].second.size(),
+                       "setup copies of different sizes");
+        }
+
+        // each worker tweaks a contiguous range of quotes
+        vector<std::exception_ptr> errors(nWorkers);
+        #pragma omp parallel for schedule(static, 1) num_threads(int(nWorkers))
+        for (long w=0; w<long(nWorkers); ++w) {
+            try {
+                BucketRepricer repricer(setups[w].second, quant);
+                Size begin = (w*n)/nWorkers, end = ((w+1)*n)/nWorkers;
+                for (Size i=begin; i<end; ++i) {
+                    pair<Real, Real> tmp =
+                        repricer.bucket(setups[w].first[i], shift, type);
+                    result.first[i] = tmp.first;
+                    result.second[i] = tmp.second;
+                }
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        }
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+
+        return result;
+    }
+
     void
     bucketAnalysis(std::vector<std::vector<Real> >& deltaMatrix, // result
                    std::vector<std::vector<Real> >& gammaMatrix, // result
@@ -330,12 +499,13 @@ namespace QuantLib {
 
         if (instr.empty()) return result;
 
-        Real npv = aggregateNPV(instr, quant);
+        QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+        BucketRepricer repricer(instr, quant);
 
         pair<Real, Real> tmp;
         for (Size i=0; i<n; ++i) {
           for (Size j=0; j<quotes[i].size(); ++j) {
-            tmp = bucketAnalysis(quotes[i][j], instr, quant, shift, type, npv);
+            tmp = repricer.bucket(quotes[i][j], shift, type);
             result.first[i][j] = tmp.first;
             result.second[i][j] = tmp.second;
           }
@@ -26,6 +26,7 @@
 
 #include <ql/types.hpp>
 #include <ql/utilities/null.hpp>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -127,7 +128,9 @@ namespace QuantLib {
         Empty quantities vector is considered as unit vector. The same if
         the vector is of size one.
 
-        The (bucket) SimpleQuotes are tweaked one by one separately.
+        The (bucket) SimpleQuotes are tweaked one by one separately;
+        after each tweak, only the instruments notified by the quote
+        are repriced.
     */
     std::pair<std::vector<Real>, std::vector<Real> >
     bucketAnalysis(const std::vector<Handle<SimpleQuote> >& quotes,
@@ -136,6 +139,45 @@ namespace QuantLib {
                    Real shift = 0.0001,
                    SensitivityAnalysis type = Centered);
 
+    //! quotes to be tweaked and instruments depending on them
+    typedef std::pair<std::vector<Handle<SimpleQuote> >,
+                      std::vector<std::shared_ptr<Instrument> > >
+        SensitivityAnalysisSetup;
+
+    //! parallel bucket PV01 sensitivity analysis for a SimpleQuote vector
+    /*! returns the same results as the bucket analysis above, but the
+        SimpleQuotes are distributed among the OpenMP threads.
+
+        The observer pattern is not thread-safe; therefore, each thread
+        works on its own copy of the quotes and instruments returned by
+        the given function. The copies are built sequentially before
+        the parallel computation. Every copy must be independent of
+        the others, i.e., no lazy object such as a bootstrapped curve
+        or a pricing engine can be shared between them, and the quotes
+        must be returned in the same order.
+
+        \warning the instruments are valued concurrently; therefore,
+                 their pricing engines and the term structures they
+                 use must not register with global observables, such
+                 as the evaluation date or the index fixings, during
+                 the calculation; registrations made when the copies
+                 are built are safe.
+
+        The number of workers, i.e., of copies, defaults to the
+        maximum number of OpenMP threads; it is limited by the number
+        of quotes. Without OpenMP the workers run one after the other.
+
+        Empty quantities vector is considered as unit vector. The same if
+        the vector is of size one.
+    */
+    std::pair<std::vector<Real>, std::vector<Real> >
+    parallelBucketAnalysis(
+                    const std::function<SensitivityAnalysisSetup()>& setup,
+                    const std::vector<Real>& quantities,
+                    Real shift = 0.0001,
+                    SensitivityAnalysis type = Centered,
+                    Size workers = Null<Size>());
+
     //! bucket parameters' sensitivity analysis for a SimpleQuote vector
     /*! returns a vector (one element for each paramet) of pair of first and
         second derivative vectors calculated as prescribed by
@@ -164,7 +206,9 @@ namespace QuantLib {
         Empty quantities vector is considered as unit vector. The same if
         the vector is of size one.
 
-        The (bucket) SimpleQuotes are tweaked one by one separately.
+        The (bucket) SimpleQuotes are tweaked one by one separately;
+        after each tweak, only the instruments notified by the quote
+        are repriced.
     */
     std::pair<std::vector<std::vector<Real> >, std::vector<std::vector<Real> > >
     bucketAnalysis(const std::vector<std::vector<Handle<SimpleQuote> > >&,
@@ -0,0 +1,41 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/variancegamma/variancegammacharacteristicfunction.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    VarianceGammaCharacteristicFunction::VarianceGammaCharacteristicFunction(
+        std::shared_ptr<VarianceGammaModel> model)
+    : model_(std::move(model)) {}
+
+    std::complex<Real> VarianceGammaCharacteristicFunction::operator()(
+        const std::complex<Real>& u, Time t) const {
+
+        const Real sigma = model_->sigma();
+        const Real nu    = model_->nu();
+        const Real theta = model_->theta();
+
+        const Real omega = std::log(1.0 - theta*nu - 0.5*sigma*sigma*nu)/nu;
+        const std::complex<Real> iu(-u.imag(), u.real());
+
+        return std::exp(iu*omega*t
+            - t/nu*std::log(1.0 - iu*theta*nu + 0.5*sigma*sigma*nu*u*u));
+    }
+
+}
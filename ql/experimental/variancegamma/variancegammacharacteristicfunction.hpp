@@ -0,0 +1,54 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file variancegammacharacteristicfunction.hpp
+    \brief characteristic function of the Variance Gamma model
+*/
+
+#ifndef quantlib_variance_gamma_characteristic_function_hpp
+#define quantlib_variance_gamma_characteristic_function_hpp
+
+#include <ql/experimental/variancegamma/variancegammamodel.hpp>
+#include <ql/pricingengines/vanilla/characteristicfunction.hpp>
+
+namespace QuantLib {
+
+    //! characteristic function of the Variance Gamma model
+    /*! \f[
+            \phi(u, t) = e^{iu\omega t}
+                \left(1 - iu\theta\nu + \tfrac{1}{2}\sigma^2\nu u^2
+                \right)^{-t/\nu}
+        \f]
+        with the martingale correction
+        \f$ \omega = \ln(1 - \theta\nu - \tfrac{1}{2}\sigma^2\nu)/\nu \f$.
+    */
+    class VarianceGammaCharacteristicFunction
+        : public CharacteristicFunction {
+      public:
+        explicit VarianceGammaCharacteristicFunction(
+            std::shared_ptr<VarianceGammaModel> model);
+
+        std::complex<Real> operator()(
+            const std::complex<Real>& u, Time t) const override;
+
+      private:
+        const std::shared_ptr<VarianceGammaModel> model_;
+    };
+
+}
+
+#endif
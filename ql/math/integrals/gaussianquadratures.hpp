@@ -69,8 +69,8 @@ namespace QuantLib {
 #endif
 
         Size order() const { return x_.size(); }
-        const Array& weights() { return w_; }
-        const Array& x()       { return x_; }
+        const Array& weights() const { return w_; }
+        const Array& x() const { return x_; }
         
       protected:
         Array x_, w_;
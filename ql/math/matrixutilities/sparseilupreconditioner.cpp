@@ -21,6 +21,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/math/matrix.hpp>
 
 #include <set>
+#include <vector>
 
 namespace QuantLib {
 
@@ -34,55 +35,59 @@ namespace QuantLib {
         QL_REQUIRE(A.size1() == A.size2(),
                    "sparse ILU preconditioner works only with square matrices");
 
-        for (SparseMatrix::size_type i=0; i < L_.size1(); ++i)
-            L_(i,i) = 1.0;
-
         const Integer n = A.size1();
-        std::set<Integer> lBandSet, uBandSet;
 
         compressed_matrix<Integer> levs(n,n);
         Integer lfilp = lfil + 1;
 
-        for (Integer ii=0; ii<n; ++ii) {
-            Array w(n);
-            for(Integer k=0; k<n; ++k) {
-                w[k] = A(ii,k);
-            }
+        // dense work space for the current row; only the entries
+        // touched by the row are reset, so that the cost of the
+        // factorization grows with the number of non-zeros only
+        Array w(n, 0.0);
+        std::vector<Integer> levii(n, 0);
+        // columns with non-zero level in the current row, in increasing order
+        std::set<Integer> active;
 
-            std::vector<Integer> levii(n, 0);
-            for (Integer i=0; i<n; ++i) {
-                if(   w[i] > QL_EPSILON
-                      || w[i] < -1.0*QL_EPSILON) levii[i] = 1;
+        for (Integer ii=0; ii<n; ++ii) {
+            Size rowBegin = 0, rowEnd = 0;
+            if (Size(ii+1) < A.filled1()) {
+                rowBegin = A.index1_data()[ii];
+                rowEnd = A.index1_data()[ii+1];
             }
-            Integer jj = -1;
-            while (jj < ii) {
-                for (Integer k=jj+1; k<n; ++k) {
-                    if (levii[k] != 0) {
-                        jj = k;
-                        break;
-                    }
-                }
-                if (jj >= ii) {
-                    break;
+            for (Size k=rowBegin; k < rowEnd; ++k) {
+                const Integer j = A.index2_data()[k];
+                const Real entry = A.value_data()[k];
+                w[j] = entry;
+                if (entry > QL_EPSILON || entry < -1.0*QL_EPSILON) {
+                    levii[j] = 1;
+                    active.insert(j);
                 }
+            }
+
+            // elements inserted into the set after the current one
+            // are visited by the loop as well
+            for (auto iter = active.begin();
+                 iter != active.end() && *iter < ii; ++iter) {
+                const Integer jj = *iter;
                 Integer jlev = levii[jj];
                 if (jlev <= lfilp) {
-                    std::vector<Integer> nonZeros;
+                    // row jj of U and of levs share the same sparsity
+                    // pattern; diagonal element comes first if present
+                    std::vector<Integer> nonZeros, nonZeroLevs;
                     std::vector<Real> nonZeroEntries;
-                    nonZeros.reserve(uBandSet.size()+1);
-                    nonZeroEntries.reserve(uBandSet.size()+1);
-                    const Real entry = U_(jj,jj);
-                    if(entry > QL_EPSILON || entry < -1.0*QL_EPSILON) {
-                        nonZeros.push_back(jj);
-                        nonZeroEntries.push_back(entry);
-                    }
-                    auto iter = uBandSet.begin();
-                    auto end = uBandSet.end();
-                    for (; iter != end; ++iter) {
-                        const Real entry = U_(jj,jj+*iter);
-                        if(entry > QL_EPSILON || entry < -1.0*QL_EPSILON) {
-                            nonZeros.push_back(jj+*iter);
-                            nonZeroEntries.push_back(entry);
+                    if (Size(jj+1) < U_.filled1()) {
+                        const Size begin = U_.index1_data()[jj];
+                        const Size end = U_.index1_data()[jj+1];
+                        nonZeros.reserve(end-begin);
+                        nonZeroLevs.reserve(end-begin);
+                        nonZeroEntries.reserve(end-begin);
+                        for (Size k=begin; k < end; ++k) {
+                            const Real entry = U_.value_data()[k];
+                            if(entry > QL_EPSILON || entry < -1.0*QL_EPSILON) {
+                                nonZeros.push_back(U_.index2_data()[k]);
+                                nonZeroLevs.push_back(levs.value_data()[k]);
+                                nonZeroEntries.push_back(entry);
+                            }
                         }
                     }
                     Real fact = w[jj];
@@ -91,11 +96,12 @@ namespace QuantLib {
                     }
                     for (Size k=0; k<nonZeros.size(); ++k) {
                         const Integer j = nonZeros[k] ;
-                        const Integer temp = levs(jj,j) + jlev ;
+                        const Integer temp = nonZeroLevs[k] + jlev ;
                         if (levii[j] == 0) {
                             if (temp <= lfilp) {
                                 w[j] =  - fact*nonZeroEntries[k];
                                 levii[j] = temp;
+                                active.insert(j);
                             }
                         }
                         else {
@@ -108,41 +114,39 @@ namespace QuantLib {
             }
             std::vector<Integer> wNonZeros;
             std::vector<Real> wNonZeroEntries;
-            wNonZeros.reserve(w.size());
-            wNonZeroEntries.reserve(w.size());
-            for (Size i=0; i<w.size(); ++i) {
+            std::vector<Integer> leviiNonZeroEntries;
+            wNonZeros.reserve(active.size());
+            wNonZeroEntries.reserve(active.size());
+            leviiNonZeroEntries.reserve(active.size());
+            for (Integer i : active) {
                 const Real entry = w[i];
                 if(entry > QL_EPSILON || entry < -1.0*QL_EPSILON) {
                     wNonZeros.push_back(i);
                     wNonZeroEntries.push_back(entry);
                 }
+                leviiNonZeroEntries.push_back(levii[i]);
             }
-            std::vector<Integer> leviiNonZeroEntries;
-            leviiNonZeroEntries.reserve(levii.size());
-            for (int entry : levii) {
-                if (entry > QL_EPSILON || entry < -1.0 * QL_EPSILON) {
-                    leviiNonZeroEntries.push_back(entry);
-                }
+            // the non-zero entries come in increasing column order,
+            // therefore the rows can be appended to the compressed storage
+            Size k=0;
+            for (; k<wNonZeros.size() && wNonZeros[k] < ii; ++k)
+                L_.push_back(ii, wNonZeros[k], wNonZeroEntries[k]);
+            L_.push_back(ii, ii, 1.0);
+
+            for (; k<wNonZeros.size(); ++k) {
+                const Integer j = wNonZeros[k];
+                U_.push_back(ii, j, wNonZeroEntries[k]);
+                levs.push_back(ii, j, leviiNonZeroEntries[k]);
             }
-            for (Size k=0; k<wNonZeros.size(); ++k) {
-                Integer j = wNonZeros[k];
-                if (j < ii) {
-                    L_(ii,j) = wNonZeroEntries[k];
-                    lBandSet.insert(ii-j);
-                }
-                else {
-                    U_(ii,j) = wNonZeroEntries[k];
-                    levs(ii,j) = leviiNonZeroEntries[k];
-                    if(j-ii > 0) {
-                        uBandSet.insert(j-ii);
-                    }
-                }
+
+            for (Size k=rowBegin; k < rowEnd; ++k)
+                w[A.index2_data()[k]] = 0.0;
+            for (Integer i : active) {
+                w[i] = 0.0;
+                levii[i] = 0;
             }
+            active.clear();
         }
-        lBands_.resize(lBandSet.size());
-        uBands_.resize(uBandSet.size());
-        std::copy(lBandSet.begin(), lBandSet.end(), lBands_.begin());
-        std::copy(uBandSet.begin(), uBandSet.end(), uBands_.begin());
     }
 
     const SparseMatrix& SparseILUPreconditioner::L() const {
@@ -158,30 +162,44 @@ namespace QuantLib {
     }
 
     Array SparseILUPreconditioner::forwardSolve(const Array& b) const {
-        Integer n = b.size();
+        const Size n = b.size();
         Array y(n, 0.0);
-        y[0]=b[0]/L_(0,0);
-        for (Integer i=1; i<=n-1; ++i) {
-            y[i] = b[i]/L_(i,i);
-            for (Integer j=lBands_.size()-1;
-                 j>=0 && i-Integer(lBands_[j]) <= i-1; --j) {
-                const Integer k = i-Integer(lBands_[j]);
-                if (k >= 0)
-                    y[i]-=L_(i,k)*y[k]/L_(i,i);
-            }
+
+        const auto& rowIdx = L_.index1_data();
+        const auto& colIdx = L_.index2_data();
+        const auto& values = L_.value_data();
+
+        for (Size i=0; i < n; ++i) {
+            // the diagonal element is the last one of each row
+            const Size diag = rowIdx[i+1]-1;
+            Real t = b[i];
+            for (Size k=rowIdx[i]; k < diag; ++k)
+                t -= values[k]*y[colIdx[k]];
+            y[i] = t/values[diag];
         }
         return y;
     }
 
     Array SparseILUPreconditioner::backwardSolve(const Array& y) const {
-        Size n = y.size();
+        const Size n = y.size();
         Array x(n, 0.0);
-        x[n-1] = y[n-1]/U_(n-1,n-1);
-        for (Integer i=n-2; i>=0; --i) {
-            x[i] = y[i]/U_(i,i);
-            for (Size j=0; j<uBands_.size() && i+uBands_[j] <= n-1; ++j) {
-                x[i] -= U_(i,i+uBands_[j])*x[i+uBands_[j]]/U_(i,i);
+
+        const auto& rowIdx = U_.index1_data();
+        const auto& colIdx = U_.index2_data();
+        const auto& values = U_.value_data();
+
+        for (Integer i=n-1; i>=0; --i) {
+            Real t = y[i], diag = 0.0;
+            if (Size(i+1) < U_.filled1()) {
+                for (Size k=rowIdx[i]; k < rowIdx[i+1]; ++k) {
+                    const Size j = colIdx[k];
+                    if (j > Size(i))
+                        t -= values[k]*x[j];
+                    else if (j == Size(i))
+                        diag = values[k];
+                }
             }
+            x[i] = t/diag;
         }
         return x;
     }
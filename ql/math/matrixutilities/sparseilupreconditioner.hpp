@@ -44,7 +44,6 @@ namespace QuantLib {
 
       private:
         SparseMatrix L_, U_;
-        std::vector<Size> lBands_, uBands_;
 
         Array forwardSolve(const Array& b) const;
         Array backwardSolve(const Array& y) const;
@@ -18,7 +18,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
 /*! \file sparsematrix.hpp
-    \brief typedef for boost sparse matrix class
+    \brief typedef for boost sparse matrix class and fast helpers
 */
 
 #ifndef quantlib_sparse_matrix_hpp
@@ -26,6 +26,8 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #include <ql/qldefines.hpp>
 #include <ql/math/array.hpp>
+#include <algorithm>
+#include <utility>
 
 #if defined(QL_PATCH_MSVC)
 #pragma warning(push)
@@ -48,26 +50,92 @@ namespace QuantLib {
     typedef boost::numeric::ublas::compressed_matrix<Real> SparseMatrix;
     typedef boost::numeric::ublas::matrix_reference<SparseMatrix> SparseMatrixReference;
 
+    //! sparse matrix-vector product \f$ b = A x \f$
+    /*! The product works directly on the compressed row storage.
+        Rows beyond the last filled one are zero.
+    */
     inline Array prod(const SparseMatrix& A, const Array& x) {
         QL_REQUIRE(x.size() == A.size2(),
                    "vectors and sparse matrices with different sizes ("
                    << x.size() << ", " << A.size1() << "x" << A.size2() <<
                    ") cannot be multiplied");
 
-        Array b(x.size(), 0.0);
+        Array b(A.size1(), 0.0);
+
+        const auto& rowIdx = A.index1_data();
+        const auto& colIdx = A.index2_data();
+        const auto& values = A.value_data();
 
         for (Size i=0; i < A.filled1()-1; ++i) {
-            const Size begin = A.index1_data()[i];
-            const Size end   = A.index1_data()[i+1];
+            const Size end = rowIdx[i+1];
             Real t=0;
-            for (Size j=begin; j < end; ++j) {
-                t += A.value_data()[j]*x[A.index2_data()[j]];
-            }
+            for (Size j=rowIdx[i]; j < end; ++j)
+                t += values[j]*x[colIdx[j]];
 
             b[i]=t;
         }
         return b;
     }
+
+    //! transposed sparse matrix-vector product \f$ b = A^T x \f$
+    inline Array prod(const Array& x, const SparseMatrix& A) {
+        QL_REQUIRE(x.size() == A.size1(),
+                   "vectors and sparse matrices with different sizes ("
+                   << x.size() << ", " << A.size1() << "x" << A.size2() <<
+                   ") cannot be multiplied");
+
+        Array b(A.size2(), 0.0);
+
+        const auto& rowIdx = A.index1_data();
+        const auto& colIdx = A.index2_data();
+        const auto& values = A.value_data();
+
+        for (Size i=0; i < A.filled1()-1; ++i) {
+            const Real xi = x[i];
+            const Size end = rowIdx[i+1];
+            for (Size j=rowIdx[i]; j < end; ++j)
+                b[colIdx[j]] += values[j]*xi;
+        }
+        return b;
+    }
+
+    //! appends a row to the compressed storage of a sparse matrix
+    /*! The range [begin, end) holds (column, value) pairs which can
+        be given in any order; entries with the same column are summed
+        up. The row must come after the last filled row of the matrix.
+
+        Filling a matrix row by row this way is much faster than the
+        element-wise insertion, which has to shift the compressed
+        storage on every new entry.
+
+        \warning the given range is sorted in place.
+    */
+    template <class Iterator>
+    void appendRow(SparseMatrix& A, Size row, Iterator begin, Iterator end) {
+        QL_REQUIRE(row < A.size1(),
+                   "row " << row << " out of range (" << A.size1() << ")");
+        QL_REQUIRE(row+2 > A.filled1(),
+                   "row " << row << " is already filled");
+
+        std::sort(begin, end,
+                  [](const std::pair<Size, Real>& a,
+                     const std::pair<Size, Real>& b) {
+                      return a.first < b.first;
+                  });
+
+        while (begin != end) {
+            const Size column = begin->first;
+            QL_REQUIRE(column < A.size2(),
+                       "column " << column << " out of range ("
+                       << A.size2() << ")");
+            Real value = 0.0;
+            for (; begin != end && begin->first == column; ++begin)
+                value += begin->second;
+
+            A.push_back(row, column, value);
+        }
+    }
+
 }
 
 #endif
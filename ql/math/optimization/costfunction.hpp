@@ -27,6 +27,7 @@
 
 #include <ql/math/array.hpp>
 #include <ql/math/matrix.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -44,6 +45,28 @@ namespace QuantLib {
         //! method to overload to compute the cost function values in x
         virtual Array values(const Array& x) const =0;
 
+        //! method to overload to compute the cost function value of several points
+        /*! Population-based optimizers evaluate all the candidates
+            of a generation with a single call, which allows the cost
+            function to vectorize the calculation. Points at which
+            the cost function can't be evaluated get a value of
+            QL_MAX_REAL. The default implementation calls value() for
+            each point.
+        */
+        virtual Array batchValue(const std::vector<Array>& x) const {
+            Array v(x.size());
+            for (Size i=0; i<x.size(); ++i) {
+                try {
+                    v[i] = value(x[i]);
+                } catch (Error&) {
+                    v[i] = QL_MAX_REAL;
+                }
+                if (!std::isfinite(v[i]))
+                    v[i] = QL_MAX_REAL;
+            }
+            return v;
+        }
+
         //! method to overload to compute grad_f, the first derivative of
         //  the cost function with respect to x
         virtual void gradient(Array& grad, const Array& x) const {
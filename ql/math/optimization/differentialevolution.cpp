@@ -74,8 +74,8 @@ namespace QuantLib {
                 population[i].values = configuration().initialPopulation[i];
                 QL_REQUIRE(population[i].values.size() == p.currentValue().size(),
                            "wrong values size in initial population");
-                population[i].cost = p.costFunction().value(population[i].values);
             }
+            evaluate(population, p);
         } else {
             population = std::vector<Candidate>(configuration().populationMembers,
                                                 Candidate(p.currentValue().size()));
@@ -293,16 +293,20 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
-            try {
-                population[popIter].cost = p.value(population[popIter].values);
-            } catch (Error&) {
-                population[popIter].cost = QL_MAX_REAL;
-            }
-            if (!std::isfinite(population[popIter].cost))
-                population[popIter].cost = QL_MAX_REAL;
-
         }
+
+        evaluate(population, p);
+    }
+
+    void DifferentialEvolution::evaluate(std::vector<Candidate>& candidates,
+                                         Problem& p) const {
+        std::vector<Array> x(candidates.size());
+        for (Size i = 0; i < candidates.size(); ++i)
+            x[i] = candidates[i].values;
+
+        const Array costs = p.batchValue(x, configuration().threads);
+        for (Size i = 0; i < candidates.size(); ++i)
+            candidates[i].cost = costs[i];
     }
 
     void DifferentialEvolution::getCrossoverMask(
@@ -377,21 +381,18 @@ namespace QuantLib {
 
     void DifferentialEvolution::fillInitialPopulation(
                                           std::vector<Candidate> & population,
-                                          const Problem& p) const {
+                                          Problem& p) const {
 
         // use initial values provided by the user
         population.front().values = p.currentValue();
-        population.front().cost = p.costFunction().value(population.front().values);
         // rest of the initial population is random
         for (Size j = 1; j < population.size(); ++j) {
             for (Size i = 0; i < p.currentValue().size(); ++i) {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
-            population[j].cost = p.costFunction().value(population[j].values);
-            if (!std::isfinite(population[j].cost))
-                population[j].cost = QL_MAX_REAL;
         }
+        evaluate(population, p);
     }
 
 }
@@ -50,6 +50,15 @@ namespace QuantLib {
         3) various weights distributions for the differences (dither etc.)
         4) printFullInfo parameter usage to track the algorithm
 
+        The candidates of each generation are evaluated with a single
+        call to Problem::batchValue(), in parallel if more than one
+        thread is configured. All random numbers are drawn before the
+        evaluation, hence the results do not depend on the number of
+        threads. The initial population is evaluated in the same way
+        and is included in Problem::functionEvaluation(); points of
+        the initial population that fail to evaluate get a cost of
+        QL_MAX_REAL instead of aborting the optimization.
+
         \warning This was reported to fail tests on Mac OS X 10.8.4.
     */
 
@@ -84,6 +93,7 @@ namespace QuantLib {
             Strategy strategy = BestMemberWithJitter;
             CrossoverType crossoverType = Normal;
             Size populationMembers = 100;
+            Size threads = 1;
             Real stepsizeWeight = 0.2, crossoverProbability = 0.9;
             unsigned long seed = 0;
             bool applyBounds = true, crossoverIsAdaptive = false;
@@ -130,6 +140,13 @@ namespace QuantLib {
                 return *this;
             }
 
+            //! the cost function must be thread safe if n > 1
+            Configuration& withThreads(Size n) {
+                QL_REQUIRE(n>0, "Positive number of threads required");
+                threads = n;
+                return *this;
+            }
+
             Configuration& withSeed(unsigned long s) {
                 seed = s;
                 return *this;
@@ -177,7 +194,9 @@ namespace QuantLib {
         MersenneTwisterUniformRng rng_;
 
         void fillInitialPopulation(std::vector<Candidate>& population,
-                                   const Problem& p) const;
+                                   Problem& p) const;
+
+        void evaluate(std::vector<Candidate>& candidates, Problem& p) const;
 
         void getCrossoverMask(std::vector<Array>& crossoverMask,
                               std::vector<Array>& invCrossoverMask,
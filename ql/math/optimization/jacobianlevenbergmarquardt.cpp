@@ -0,0 +1,275 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/optimization/constraint.hpp>
+#include <ql/math/optimization/jacobianlevenbergmarquardt.hpp>
+#include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <chrono>
+
+namespace QuantLib {
+
+    namespace {
+
+        // solves L L^T x = b
+        Array choleskySolve(const Matrix& L, const Array& b) {
+            const Size n = b.size();
+            Array y(n), x(n);
+            for (Size i=0; i<n; ++i) {
+                Real s = b[i];
+                for (Size k=0; k<i; ++k)
+                    s -= L[i][k]*y[k];
+                y[i] = s/L[i][i];
+            }
+            for (Size i=n; i-- > 0;) {
+                Real s = y[i];
+                for (Size k=i+1; k<n; ++k)
+                    s -= L[k][i]*x[k];
+                x[i] = s/L[i][i];
+            }
+            return x;
+        }
+
+        bool isFinite(const Array& a) {
+            return std::all_of(a.begin(), a.end(),
+                               [](Real x) { return std::isfinite(x); });
+        }
+
+        Real secondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<Real>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+
+    }
+
+    JacobianLevenbergMarquardt::JacobianLevenbergMarquardt(
+                                                Real epsfcn,
+                                                Real xtol,
+                                                Real gtol,
+                                                bool useCostFunctionsJacobian,
+                                                Size maxBroydenUpdates,
+                                                Real initialDamping)
+    : epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
+      useCostFunctionsJacobian_(useCostFunctionsJacobian),
+      maxBroydenUpdates_(maxBroydenUpdates),
+      initialDamping_(initialDamping) {
+        QL_REQUIRE(xtol >= 0.0, "negative x tolerance");
+        QL_REQUIRE(gtol >= 0.0, "negative g tolerance");
+        QL_REQUIRE(initialDamping > 0.0, "non-positive initial damping");
+    }
+
+    EndCriteria::Type JacobianLevenbergMarquardt::minimize(
+                                            Problem& P,
+                                            const EndCriteria& endCriteria) {
+        QL_REQUIRE(endCriteria.functionEpsilon() >= 0.0,
+                   "negative f tolerance");
+        QL_REQUIRE(endCriteria.maxIterations() > 0,
+                   "null number of evaluations");
+
+        diagnostics_ = Diagnostics();
+        P.reset();
+
+        Array x = P.currentValue();
+        const Size n = x.size();
+        QL_REQUIRE(n > 0, "no variables given");
+
+        Array f = values(P, x);
+        const Size m = f.size();
+        QL_REQUIRE(m >= n,
+                   "less functions (" << m <<
+                   ") than available variables (" << n << ")");
+        QL_REQUIRE(isFinite(f), "cost function values at the initial "
+                   "guess are not finite");
+
+        Matrix J(m, n);
+        jacobian(P, x, f, J);
+        // number of Broyden updates since the last Jacobian computation
+        Size broydenUpdates = 0;
+
+        // half the sum of squares
+        Real F = 0.5*DotProduct(f, f);
+        Real mu = initialDamping_, nu = 2.0;
+        Matrix A;
+        Array g, D(n, 0.0);
+        bool updateNormalEquations = true;
+
+        EndCriteria::Type ecType = EndCriteria::None;
+        Size iteration = 0;
+        for (;;) {
+            if (updateNormalEquations) {
+                const Matrix Jt = transpose(J);
+                A = Jt*J;
+                g = Jt*f;
+                for (Size j=0; j<n; ++j)
+                    D[j] = std::max(D[j], A[j][j]);
+
+                const Real fnorm = std::sqrt(2.0*F);
+                Real gnorm = 0.0;
+                for (Size j=0; j<n && fnorm > 0.0; ++j) {
+                    if (A[j][j] > 0.0)
+                        gnorm = std::max(gnorm, std::fabs(g[j])
+                                         /(std::sqrt(A[j][j])*fnorm));
+                }
+                if (gnorm <= gtol_) {
+                    ecType = EndCriteria::ZeroGradientNorm;
+                    break;
+                }
+                updateNormalEquations = false;
+            }
+
+            if (endCriteria.checkMaxIterations(iteration, ecType))
+                break;
+            if (!std::isfinite(mu)) {
+                ecType = EndCriteria::StationaryPoint;
+                break;
+            }
+            ++iteration;
+
+            // damped normal equations; zero columns are damped by mu
+            Matrix B = A;
+            for (Size j=0; j<n; ++j)
+                B[j][j] += mu*(D[j] > 0.0 ? D[j] : 1.0);
+            Array h;
+            try {
+                h = choleskySolve(CholeskyDecomposition(B), -g);
+            } catch (Error&) {
+                mu *= nu;
+                nu *= 2.0;
+                continue;
+            }
+
+            if (Norm2(h) <= xtol_*(Norm2(x) + xtol_)) {
+                ecType = EndCriteria::StationaryPoint;
+                break;
+            }
+
+            const Array xNew = x + h;
+            Array fNew;
+            bool valid = P.constraint().test(xNew);
+            if (valid) {
+                try {
+                    fNew = values(P, xNew);
+                    valid = isFinite(fNew);
+                } catch (Error&) {
+                    valid = false;
+                }
+            }
+
+            Real rho = -1.0, FNew = F;
+            if (valid) {
+                FNew = 0.5*DotProduct(fNew, fNew);
+                // predicted reduction: -h^T g - h^T A h / 2
+                Array Ah = A*h;
+                const Real predicted =
+                    -DotProduct(h, g) - 0.5*DotProduct(h, Ah);
+                if (predicted > 0.0)
+                    rho = (F - FNew)/predicted;
+            }
+
+            if (rho > 0.0) {
+                const bool stationary =
+                    F - FNew <= endCriteria.functionEpsilon()*F;
+                const bool broyden = !stationary
+                    && broydenUpdates < maxBroydenUpdates_;
+                if (broyden) {
+                    const Array r = fNew - f - J*h;
+                    const Real hh = DotProduct(h, h);
+                    for (Size i=0; i<m; ++i)
+                        for (Size j=0; j<n; ++j)
+                            J[i][j] += r[i]*h[j]/hh;
+                    ++broydenUpdates;
+                    ++diagnostics_.broydenUpdates;
+                }
+
+                x = xNew;
+                f = fNew;
+                F = FNew;
+                if (stationary) {
+                    ecType = EndCriteria::StationaryFunctionValue;
+                    break;
+                }
+                if (!broyden) {
+                    jacobian(P, x, f, J);
+                    broydenUpdates = 0;
+                }
+
+                const Real c = 2.0*rho - 1.0;
+                mu *= std::max(1.0/3.0, 1.0 - c*c*c);
+                nu = 2.0;
+                updateNormalEquations = true;
+            } else {
+                ++diagnostics_.rejectedSteps;
+                if (broydenUpdates > 0) {
+                    // the updated Jacobian might be too inaccurate
+                    jacobian(P, x, f, J);
+                    broydenUpdates = 0;
+                    updateNormalEquations = true;
+                } else {
+                    mu *= nu;
+                    nu *= 2.0;
+                }
+            }
+        }
+
+        diagnostics_.iterations = iteration;
+
+        P.setCurrentValue(x);
+        P.setFunctionValue(P.costFunction().value(x));
+
+        return ecType;
+    }
+
+    Array JacobianLevenbergMarquardt::values(Problem& P, const Array& x) {
+        const auto start = std::chrono::steady_clock::now();
+        Array f = P.values(x);
+        diagnostics_.functionTime += secondsSince(start);
+        ++diagnostics_.functionEvaluations;
+        return f;
+    }
+
+    void JacobianLevenbergMarquardt::jacobian(Problem& P,
+                                              const Array& x,
+                                              const Array& f,
+                                              Matrix& jac) {
+        const auto start = std::chrono::steady_clock::now();
+
+        if (useCostFunctionsJacobian_) {
+            P.costFunction().jacobian(jac, x);
+        } else {
+            const Real eps = std::sqrt(std::max(epsfcn_, QL_EPSILON));
+            Array xx(x);
+            for (Size j=0; j<x.size(); ++j) {
+                Real step = eps*std::fabs(x[j]);
+                if (step == 0.0)
+                    step = eps;
+                xx[j] = x[j] + step;
+                // step backwards if the forward point isn't admissible
+                if (!P.constraint().test(xx)) {
+                    step = -step;
+                    xx[j] = x[j] + step;
+                }
+                const Array fp = P.values(xx);
+                for (Size i=0; i<f.size(); ++i)
+                    jac[i][j] = (fp[i] - f[i])/step;
+                xx[j] = x[j];
+            }
+        }
+
+        diagnostics_.jacobianTime += secondsSince(start);
+        ++diagnostics_.jacobianEvaluations;
+    }
+
+}
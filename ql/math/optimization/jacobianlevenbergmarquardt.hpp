@@ -0,0 +1,119 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file jacobianlevenbergmarquardt.hpp
+    \brief Levenberg-Marquardt method with Jacobian reuse
+*/
+
+#ifndef quantlib_optimization_jacobian_levenberg_marquardt_hpp
+#define quantlib_optimization_jacobian_levenberg_marquardt_hpp
+
+#include <ql/math/optimization/problem.hpp>
+
+namespace QuantLib {
+
+    //! Levenberg-Marquardt method with Jacobian reuse
+    /*! Unlike LevenbergMarquardt, which wraps MINPACK's lmdif, this
+        is a native implementation working on the Jacobian matrix of
+        the cost function values. At each iteration the damped normal
+        equations
+        \f[
+            (J^T J + \mu D)\, h = -J^T f
+        \f]
+        are solved by Cholesky decomposition, where \f$ D \f$ holds
+        the largest diagonal of \f$ J^T J \f$ seen so far (Marquardt
+        scaling). The damping \f$ \mu \f$ is updated from the ratio of
+        the actual and the predicted reduction of the sum of squares
+        as suggested by Nielsen. Steps violating the constraint of
+        the problem are rejected.
+
+        If useCostFunctionsJacobian is true, the Jacobian is taken
+        from CostFunction::jacobian(), which allows analytic or
+        batch-evaluated Jacobians, e.g. the ones provided by the
+        calibration helpers in CalibratedModel::calibrate().
+        Otherwise it is computed by forward differences with a
+        relative step \f$ \sqrt{\epsilon_{fcn}} \f$.
+
+        If maxBroydenUpdates is positive, up to that number of
+        accepted steps update the Jacobian by the Broyden rank-one
+        formula
+        \f[
+            J \leftarrow J + \frac{(f(x+h) - f(x) - J h)\, h^T}{h^T h}
+        \f]
+        instead of recomputing it. When a step is rejected with an
+        updated Jacobian, the Jacobian is recomputed.
+
+        The iteration stops if
+        - the scaled gradient \f$ \max_j |(J^T f)_j| /
+          (\|J_j\| \|f\|) \f$ is below gtol (ZeroGradientNorm);
+        - the step is smaller than xtol relative to the parameters
+          (StationaryPoint);
+        - the relative reduction of the sum of squares of an
+          accepted step is below the function epsilon of the end
+          criteria (StationaryFunctionValue);
+        - the number of iterations reaches the maximum of the end
+          criteria (MaxIterations).
+
+        References:
+
+        K. Madsen, H.B. Nielsen and O. Tingleff, 2004, Methods for
+        Non-Linear Least Squares Problems, 2nd edition, IMM, DTU.
+
+        \ingroup optimizers
+    */
+    class JacobianLevenbergMarquardt : public OptimizationMethod {
+      public:
+        //! counters and wall-clock times (in seconds) of the last run
+        struct Diagnostics {
+            Size iterations = 0;
+            //! evaluations of the cost function values at trial points
+            Size functionEvaluations = 0;
+            //! Jacobian computations, analytic or by finite differences
+            Size jacobianEvaluations = 0;
+            Size broydenUpdates = 0;
+            Size rejectedSteps = 0;
+            Real functionTime = 0.0;
+            Real jacobianTime = 0.0;
+        };
+
+        JacobianLevenbergMarquardt(Real epsfcn = 1.0e-8,
+                                   Real xtol = 1.0e-8,
+                                   Real gtol = 1.0e-8,
+                                   bool useCostFunctionsJacobian = false,
+                                   Size maxBroydenUpdates = 0,
+                                   Real initialDamping = 1.0e-3);
+
+        EndCriteria::Type minimize(Problem& P,
+                                   const EndCriteria& endCriteria) override;
+
+        const Diagnostics& diagnostics() const { return diagnostics_; }
+
+      private:
+        Array values(Problem& P, const Array& x);
+        void jacobian(Problem& P, const Array& x, const Array& f,
+                      Matrix& jac);
+
+        const Real epsfcn_, xtol_, gtol_;
+        const bool useCostFunctionsJacobian_;
+        const Size maxBroydenUpdates_;
+        const Real initialDamping_;
+        Diagnostics diagnostics_;
+    };
+
+}
+
+#endif
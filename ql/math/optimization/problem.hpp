@@ -29,6 +29,8 @@
 #include <ql/math/optimization/constraint.hpp>
 #include <ql/math/optimization/costfunction.hpp>
 #include <ql/math/optimization/method.hpp>
+#include <algorithm>
+#include <exception>
 #include <utility>
 
 namespace QuantLib {
@@ -58,6 +60,18 @@ namespace QuantLib {
         //! call cost values computation and increment evaluation counter
         Array values(const Array& x);
 
+        /*! call cost function computation for several points and
+            increment evaluation counter.
+
+            The points are passed to CostFunction::batchValue(). If
+            more than one thread is given, they are split into one
+            contiguous chunk per thread, and the chunks are evaluated
+            in parallel if OpenMP is enabled; the cost function must
+            be thread safe in this case. Points at which the cost
+            function can't be evaluated get a value of QL_MAX_REAL.
+        */
+        Array batchValue(const std::vector<Array>& x, Size threads = 1);
+
         //! call cost function gradient computation and increment
         //  evaluation counter
         void gradient(Array& grad_f,
@@ -123,6 +137,37 @@ namespace QuantLib {
         return costFunction_.values(x);
     }
 
+    inline Array Problem::batchValue(const std::vector<Array>& x,
+                                     Size threads) {
+        functionEvaluation_ += static_cast<Integer>(x.size());
+        const Size chunks = std::min(threads, x.size());
+        if (chunks <= 1)
+            return costFunction_.batchValue(x);
+
+        Array v(x.size());
+        std::vector<std::exception_ptr> errors(chunks);
+
+        #pragma omp parallel for num_threads(int(chunks)) schedule(static)
+        for (long c=0; c < long(chunks); ++c) {
+            // chunk sizes differ by at most one
+            const Size begin = x.size()*Size(c)/chunks;
+            const Size end = x.size()*Size(c+1)/chunks;
+            try {
+                const Array vc = costFunction_.batchValue(
+                    std::vector<Array>(x.begin()+begin, x.begin()+end));
+                std::copy(vc.begin(), vc.end(), v.begin()+begin);
+            } catch (...) {
+                errors[c] = std::current_exception();
+            }
+        }
+
+        for (const auto& e : errors)
+            if (e)
+                std::rethrow_exception(e);
+
+        return v;
+    }
+
     inline void Problem::gradient(Array& grad_f,
                                   const Array& x) {
         ++gradientEvaluation_;
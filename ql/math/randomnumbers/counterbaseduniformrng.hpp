@@ -0,0 +1,238 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file counterbaseduniformrng.hpp
+    \brief Counter-based uniform random number generators
+*/
+
+#ifndef quantlib_counter_based_uniform_rng_hpp
+#define quantlib_counter_based_uniform_rng_hpp
+
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+#include <ql/methods/montecarlo/sample.hpp>
+#include <array>
+#include <cstdint>
+
+namespace QuantLib {
+
+    //! Philox-4x32-10 bijection
+    /*! Maps a 128-bit counter to a 128-bit random block using a
+        64-bit key.
+
+        \test the results are checked against the known-answer tests
+              of the reference implementation.
+    */
+    class Philox4x32 {
+      public:
+        typedef std::array<std::uint32_t, 4> counter_type;
+        typedef std::array<std::uint32_t, 2> key_type;
+        static counter_type apply(counter_type x, key_type key) {
+            for (Size r=0; r<10; ++r) {
+                if (r > 0) {
+                    key[0] += 0x9E3779B9U;
+                    key[1] += 0xBB67AE85U;
+                }
+                const std::uint64_t p0 = std::uint64_t(0xD2511F53U)*x[0];
+                const std::uint64_t p1 = std::uint64_t(0xCD9E8D57U)*x[2];
+                x = { std::uint32_t(p1 >> 32) ^ x[1] ^ key[0],
+                      std::uint32_t(p1),
+                      std::uint32_t(p0 >> 32) ^ x[3] ^ key[1],
+                      std::uint32_t(p0) };
+            }
+            return x;
+        }
+    };
+
+    //! Threefry-4x32-20 bijection
+    /*! Maps a 128-bit counter to a 128-bit random block using a
+        128-bit key.
+
+        \test the results are checked against the known-answer tests
+              of the reference implementation.
+    */
+    class Threefry4x32 {
+      public:
+        typedef std::array<std::uint32_t, 4> counter_type;
+        typedef std::array<std::uint32_t, 4> key_type;
+        static counter_type apply(counter_type x, const key_type& key) {
+            static const unsigned int rotations[8][2] = {
+                {10, 26}, {11, 21}, {13, 27}, {23, 5},
+                {6, 20}, {17, 11}, {25, 10}, {18, 20} };
+
+            std::uint32_t ks[5];
+            ks[4] = 0x1BD11BDAU;
+            for (Size i=0; i<4; ++i) {
+                ks[i] = key[i];
+                ks[4] ^= key[i];
+                x[i] += key[i];
+            }
+
+            for (Size r=0; r<20; ++r) {
+                const unsigned int* rot = rotations[r % 8];
+                if (r % 2 == 0) {
+                    x[0] += x[1]; x[1] = rotl(x[1], rot[0]); x[1] ^= x[0];
+                    x[2] += x[3]; x[3] = rotl(x[3], rot[1]); x[3] ^= x[2];
+                } else {
+                    x[0] += x[3]; x[3] = rotl(x[3], rot[0]); x[3] ^= x[0];
+                    x[2] += x[1]; x[1] = rotl(x[1], rot[1]); x[1] ^= x[2];
+                }
+                // key injection every four rounds
+                if (r % 4 == 3) {
+                    const std::uint32_t s = std::uint32_t(r/4 + 1);
+                    for (Size i=0; i<4; ++i)
+                        x[i] += ks[(s+i) % 5];
+                    x[3] += s;
+                }
+            }
+            return x;
+        }
+      private:
+        static std::uint32_t rotl(std::uint32_t x, unsigned int n) {
+            return (x << n) | (x >> (32 - n));
+        }
+    };
+
+
+    //! Counter-based uniform random number generator
+    /*! The \f$ i \f$-th block of four 32-bit random integers of a
+        stream is the image of the counter
+        \f$ (i_{lo}, i_{hi}, s_{lo}, s_{hi}) \f$, where \f$ s \f$ is
+        the stream id, under a bijection keyed by the seed.
+        Therefore, any position of any stream can be reached in
+        constant time, and streams with different ids, e.g., one per
+        thread or per worker, never overlap; a simulation split
+        across workers can reproduce the results of a sequential
+        run exactly.
+
+        Class Bijection must implement the following interface:
+        \code
+            static counter_type Bijection::apply(counter_type, key_type);
+        \endcode
+        with four-word counters.
+
+        For more details see J.K. Salmon, M.A. Moraes, R.O. Dror and
+        D.E. Shaw, Parallel random numbers: as easy as 1, 2, 3,
+        Proceedings of the International Conference for High
+        Performance Computing, Networking, Storage and Analysis, 2011.
+
+        \test the skip-ahead and the bulk generation are checked
+              against the sequential generation.
+    */
+    template <class Bijection>
+    class CounterBasedUniformRng {
+      public:
+        typedef Sample<Real> sample_type;
+        typedef typename Bijection::counter_type counter_type;
+        typedef typename Bijection::key_type key_type;
+
+        /*! if the given seed is 0, a random seed will be chosen
+            based on clock() */
+        explicit CounterBasedUniformRng(unsigned long seed = 0,
+                                        std::uint64_t stream = 0);
+
+        /*! returns a sample with weight 1.0 containing a random number
+            in the (0.0, 1.0) interval  */
+        sample_type next() const { return {nextReal(), 1.0}; }
+        //! return a random number in the (0.0, 1.0)-interval
+        Real nextReal() const {
+            return (Real(nextInt32()) + 0.5)/4294967296.0;
+        }
+        //! return a random integer in the [0,0xffffffff]-interval
+        unsigned long nextInt32() const {
+            const Size i = Size(position_ % 4);
+            if (i == 0)
+                block_ = generateBlock(position_ / 4);
+            ++position_;
+            return block_[i];
+        }
+
+        /*! fills the given range with random numbers in the
+            (0.0, 1.0) interval; the results are the same as the ones
+            of repeated calls to nextReal().
+        */
+        template <class Iterator>
+        void nextReals(Iterator begin, Iterator end) const;
+
+        //! \name stream positioning
+        //@{
+        //! moves to the n-th random number of the stream
+        void skipTo(std::uint64_t n) {
+            position_ = n;
+            if (n % 4 != 0)
+                block_ = generateBlock(n / 4);
+        }
+        //! skips the next n random numbers
+        void discard(std::uint64_t n) { skipTo(position_ + n); }
+        //! number of random numbers drawn so far from the stream
+        std::uint64_t position() const { return position_; }
+        std::uint64_t stream() const { return stream_; }
+        //@}
+      private:
+        counter_type generateBlock(std::uint64_t block) const {
+            const counter_type counter = {
+                std::uint32_t(block), std::uint32_t(block >> 32),
+                std::uint32_t(stream_), std::uint32_t(stream_ >> 32) };
+            return Bijection::apply(counter, key_);
+        }
+        key_type key_;
+        std::uint64_t stream_;
+        mutable std::uint64_t position_;
+        mutable counter_type block_;
+    };
+
+    //! Philox-4x32-10 uniform random number generator
+    typedef CounterBasedUniformRng<Philox4x32> Philox4x32UniformRng;
+    //! Threefry-4x32-20 uniform random number generator
+    typedef CounterBasedUniformRng<Threefry4x32> Threefry4x32UniformRng;
+
+
+    // template definitions
+
+    template <class Bijection>
+    inline CounterBasedUniformRng<Bijection>::CounterBasedUniformRng(
+                                    unsigned long seed, std::uint64_t stream)
+    : key_(), stream_(stream), position_(0), block_() {
+        const std::uint64_t s =
+            (seed != 0 ? seed : SeedGenerator::instance().get());
+        key_[0] = std::uint32_t(s);
+        key_[1] = std::uint32_t(s >> 32);
+    }
+
+    template <class Bijection>
+    template <class Iterator>
+    inline void CounterBasedUniformRng<Bijection>::nextReals(
+                                        Iterator begin, Iterator end) const {
+        // finish the current block
+        while (begin != end && position_ % 4 != 0)
+            *begin++ = nextReal();
+
+        // whole blocks
+        while (end - begin >= 4) {
+            const counter_type x = generateBlock(position_ / 4);
+            for (Size i=0; i<4; ++i)
+                *begin++ = (Real(x[i]) + 0.5)/4294967296.0;
+            position_ += 4;
+        }
+
+        while (begin != end)
+            *begin++ = nextReal();
+    }
+
+}
+
+
+#endif
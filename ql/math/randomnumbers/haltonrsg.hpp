@@ -48,6 +48,8 @@ namespace QuantLib {
                            bool randomStart = true,
                            bool randomShift = false);
         const sample_type& nextSequence() const;
+        //! skip to the n-th sample in the low-discrepancy sequence
+        void skipTo(Size n) { sequenceCounter_ = n; }
         const sample_type& lastSequence() const {
             return sequence_;
         }
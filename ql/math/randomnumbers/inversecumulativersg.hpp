@@ -26,6 +26,7 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -52,6 +53,16 @@ namespace QuantLib {
             IC::IC();
             Real IC::operator() const;
         \endcode
+
+        For partitioning the sequence, USG must also implement
+        \code
+            void USG::skipTo(Size n);
+        \endcode
+        which moves it to its n-th sequence. The sequence can then
+        be split in blocks of a fixed size to be drawn by different
+        workers; as long as the results of the blocks are combined in
+        block order, e.g., by summing the partial results, the
+        aggregate results don't depend on the number of workers.
     */
     template <class USG, class IC>
     class InverseCumulativeRsg {
@@ -61,8 +72,26 @@ namespace QuantLib {
         InverseCumulativeRsg(USG uniformSequenceGenerator, const IC& inverseCumulative);
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
+        /*! writes the next n samples, point after point, to the given
+            buffer of size n*dimension(); USG must implement
+            <tt>void USG::nextSequences(Size n, Real* output) const</tt>.
+            The sample weights are not returned.
+        */
+        void nextSequences(Size n, Real* output) const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
+        //! skips to the n-th sequence
+        void skipTo(Size n) { uniformSequenceGenerator_.skipTo(n); }
+        /*! returns a copy of the generator moved to the first
+            sequence of the i-th block of the given size.
+
+            \pre the generator must not have been used yet
+        */
+        InverseCumulativeRsg block(Size i, Size blockSize) const {
+            InverseCumulativeRsg rsg(*this);
+            rsg.skipTo(i*blockSize);
+            return rsg;
+        }
       private:
         USG uniformSequenceGenerator_;
         Size dimension_;
@@ -92,6 +121,20 @@ namespace QuantLib {
         return x_;
     }
 
+    template <class USG, class IC>
+    inline void InverseCumulativeRsg<USG, IC>::nextSequences(
+                                            Size n, Real* output) const {
+        if (n == 0)
+            return;
+        uniformSequenceGenerator_.nextSequences(n, output);
+        for (Size i = 0; i < n*dimension_; i++) {
+            output[i] = ICD_(output[i]);
+        }
+        std::copy(output + (n-1)*dimension_, output + n*dimension_,
+                  x_.value.begin());
+        x_.weight = 1.0;
+    }
+
 }
 
 
@@ -68,9 +68,197 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/errors.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        // polynomials over GF(2); bit i is the coefficient of x^i
+        typedef std::vector<std::uint64_t> Gf2Polynomial;
+
+        // degree of the characteristic polynomial, i.e., 32*N-31
+        const Size degree = 19937;
+        const Size polynomialWords = (degree + 63)/64;
+
+        bool coefficient(const Gf2Polynomial& p, Size i) {
+            return ((p[i/64] >> (i%64)) & 1U) != 0U;
+        }
+
+        void flip(Gf2Polynomial& p, Size i) {
+            p[i/64] ^= std::uint64_t(1) << (i%64);
+        }
+
+        bool parity(std::uint64_t x) {
+            x ^= x >> 32;
+            x ^= x >> 16;
+            x ^= x >> 8;
+            x ^= x >> 4;
+            x ^= x >> 2;
+            x ^= x >> 1;
+            return (x & 1U) != 0U;
+        }
+
+        // coefficients i, ..., i+63 of p
+        std::uint64_t coefficients(const Gf2Polynomial& p, Size i) {
+            const Size w = i/64, b = i%64;
+            std::uint64_t x = (w < p.size()) ? p[w] >> b : 0U;
+            if (b != 0 && w+1 < p.size())
+                x |= p[w+1] << (64-b);
+            return x;
+        }
+
+        // p += x^m q
+        void addShifted(Gf2Polynomial& p, const Gf2Polynomial& q, Size m) {
+            const Size ws = m/64, b = m%64;
+            for (Size w=0; w+ws < p.size(); ++w) {
+                p[w+ws] ^= q[w] << b;
+                if (b != 0 && w+ws+1 < p.size())
+                    p[w+ws+1] ^= q[w] >> (64-b);
+            }
+        }
+
+        /* Exponents of the non-null coefficients of the characteristic
+           polynomial of the generator, apart from the leading one.
+           The polynomial is irreducible; therefore, it is the minimal
+           polynomial of the bit sequence output by any non-null state
+           and it can be obtained by the Berlekamp-Massey algorithm.
+        */
+        std::vector<Size> characteristicPolynomial() {
+            const Size n = 2*degree;
+            const Size words = n/64 + 2;
+
+            // sequence in reversed order, r_k = s_{n-1-k}
+            MersenneTwisterUniformRng rng(5489UL);
+            Gf2Polynomial r(words, 0U);
+            for (Size i=0; i<n; ++i) {
+                if ((rng.nextInt32() & 1UL) != 0U)
+                    flip(r, n-1-i);
+            }
+
+            Gf2Polynomial c(words, 0U), b(words, 0U);
+            c[0] = b[0] = 1U;
+            Size L = 0, m = 1;
+            for (Size i=0; i<n; ++i) {
+                // discrepancy, sum_{j=0}^{L} c_j s_{i-j}
+                std::uint64_t d = 0U;
+                for (Size w=0; w <= L/64; ++w)
+                    d ^= c[w] & coefficients(r, n-1-i+64*w);
+                if (parity(d)) {
+                    if (2*L <= i) {
+                        Gf2Polynomial t = c;
+                        addShifted(c, b, m);
+                        L = i+1-L;
+                        b.swap(t);
+                        m = 1;
+                    } else {
+                        addShifted(c, b, m);
+                        ++m;
+                    }
+                } else {
+                    ++m;
+                }
+            }
+            QL_ENSURE(L == degree,
+                      "unexpected degree " << L
+                      << " of the characteristic polynomial");
+
+            // c is the reciprocal of the characteristic polynomial
+            std::vector<Size> exponents;
+            for (Size k=0; k<degree; ++k) {
+                if (coefficient(c, degree-k))
+                    exponents.push_back(k);
+            }
+            return exponents;
+        }
+
+        // p mod q, where q = x^degree + sum_e x^e
+        void reduce(Gf2Polynomial& p, Size top,
+                    const std::vector<Size>& exponents) {
+            for (Size d=top; d >= degree; --d) {
+                if (coefficient(p, d)) {
+                    flip(p, d);
+                    for (Size e : exponents)
+                        flip(p, d-degree+e);
+                }
+            }
+        }
+
+        std::uint64_t spread(std::uint64_t x) {
+            x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+            x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+            x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            x = (x | (x << 2)) & 0x3333333333333333ULL;
+            x = (x | (x << 1)) & 0x5555555555555555ULL;
+            return x;
+        }
+
+        // x^k modulo the characteristic polynomial
+        Gf2Polynomial jumpPolynomial(std::uint64_t k) {
+            static const std::vector<Size> exponents =
+                characteristicPolynomial();
+
+            Gf2Polynomial p(polynomialWords, 0U), square(2*polynomialWords);
+            p[0] = 1U;
+            for (Size bit=64; bit-- > 0;) {
+                // p = p^2, the square of a polynomial over GF(2)
+                // only has even powers
+                for (Size w=0; w<polynomialWords; ++w) {
+                    square[2*w] = spread(p[w] & 0xFFFFFFFFU);
+                    square[2*w+1] = spread(p[w] >> 32);
+                }
+                reduce(square, 2*degree-2, exponents);
+                std::copy(square.begin(), square.begin()+polynomialWords,
+                          p.begin());
+
+                // p = x p
+                if (((k >> bit) & 1U) != 0U) {
+                    for (Size w=polynomialWords; w-- > 1;)
+                        p[w] = (p[w] << 1) | (p[w-1] >> 63);
+                    p[0] <<= 1;
+                    if (coefficient(p, degree)) {
+                        flip(p, degree);
+                        for (Size e : exponents)
+                            flip(p, e);
+                    }
+                }
+            }
+            return p;
+        }
+
+        // window of consecutive untempered outputs, as a ring buffer
+        class Window {
+          public:
+            static const Size N = 624, M = 397;
+            Window() : x_(N, 0U) {}
+            std::uint32_t operator[](Size i) const {
+                return x_[index(i)];
+            }
+            // moves the window by one output
+            void next() {
+                const std::uint32_t y = (x_[first_] & 0x80000000U)
+                                      | (x_[index(1)] & 0x7fffffffU);
+                x_[first_] = x_[index(M)] ^ (y >> 1)
+                           ^ (((y & 1U) != 0U) ? 0x9908b0dfU : 0U);
+                first_ = index(1);
+            }
+            void set(Size i, std::uint32_t x) { x_[index(i)] = x; }
+            Window& operator^=(const Window& w) {
+                for (Size i=0; i<N; ++i)
+                    x_[index(i)] ^= w[i];
+                return *this;
+            }
+          private:
+            Size index(Size i) const {
+                const Size j = first_ + i;
+                return j < N ? j : j - N;
+            }
+            std::vector<std::uint32_t> x_;
+            Size first_ = 0;
+        };
+
+    }
+
     // constant vector a
     const unsigned long MersenneTwisterUniformRng::MATRIX_A = 0x9908b0dfUL;
     // most significant w-r bits
@@ -122,6 +310,45 @@ namespace QuantLib {
         mt[0] = UPPER_MASK; /*MSB is 1; assuring non-zero initial array*/
     }
 
+    void MersenneTwisterUniformRng::discard(std::uint64_t n) {
+        // short jumps are cheaper by stepping through the sequence
+        if (n < 1000000) {
+            for (; n > 0; --n) {
+                if (mti==N)
+                    twist();
+                ++mti;
+            }
+            return;
+        }
+
+        // mt contains the N outputs starting mti outputs before the
+        // next one. As the lower bits of the first of them don't
+        // affect the following outputs, the window moved by one
+        // output lies in the subspace where the characteristic
+        // polynomial p annihilates the transition matrix A; hence,
+        // A^k w = (x^k mod p)(A) w there.
+        const std::uint64_t s = mti + n;
+        const std::uint64_t k = s - s % N;
+
+        Window w;
+        for (Size i=0; i<N; ++i)
+            w.set(i, std::uint32_t(mt[i]));
+        w.next();
+
+        // Horner scheme
+        const Gf2Polynomial p = jumpPolynomial(k-1);
+        Window result;
+        for (Size i=degree; i-- > 0;) {
+            result.next();
+            if (coefficient(p, i))
+                result ^= w;
+        }
+
+        for (Size i=0; i<N; ++i)
+            mt[i] = result[i];
+        mti = Size(s % N);
+    }
+
     void MersenneTwisterUniformRng::twist() const {
         static const unsigned long mag01[2]={0x0UL, MATRIX_A};
         /* mag01[x] = x * MATRIX_A  for x=0,1 */
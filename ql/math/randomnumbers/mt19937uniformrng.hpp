@@ -26,6 +26,7 @@
 #define quantlib_mersennetwister_uniform_rng_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <cstdint>
 #include <vector>
 
 namespace QuantLib {
@@ -35,8 +36,16 @@ namespace QuantLib {
 
         For more details see http://www.math.keio.ac.jp/matumoto/emt.html
 
-        \test the correctness of the returned values is tested by
-              checking them against known good results.
+        Long jumps ahead are performed by means of the characteristic
+        polynomial of the generator, see H. Haramoto, M. Matsumoto,
+        T. Nishimura, F. Panneton and P. L'Ecuyer, Efficient jump
+        ahead for F2-linear random number generators, INFORMS Journal
+        on Computing 20(3), 2008.
+
+        \test
+        - the correctness of the returned values is tested by
+          checking them against known good results.
+        - the jump ahead is tested against the sequential generation.
     */
     class MersenneTwisterUniformRng {
       private:
@@ -70,6 +79,11 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        /*! advances the generator by n random numbers.  The cost of
+            long jumps does not depend on their length and is
+            comparable to the one of drawing a few million numbers.
+        */
+        void discard(std::uint64_t n);
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
@@ -27,6 +27,7 @@
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -131,6 +132,73 @@ namespace QuantLib {
     return x;
     }
 
+
+    //! Independent randomizations of a low-discrepancy sequence
+    /*! Cycles through \f$ K \f$ independently randomized copies of
+        a low-discrepancy sequence: the \f$ j \f$-th sample is the
+        \f$ \lfloor j/K \rfloor \f$-th point of the
+        \f$ (j \bmod K) \f$-th randomization.  Therefore, the
+        samples drawn so far are evenly spread over the
+        randomizations, and the dispersion of the averages over each
+        of them gives an error estimate for randomized quasi-Monte
+        Carlo which can be updated while the number of samples grows.
+
+        Class RSG must be constructible from its dimension and a seed,
+        the latter determining the randomization, e.g.,
+        ScrambledSobolRsg.
+
+        \test the samples are checked against the single
+              randomizations.
+    */
+    template <class RSG>
+    class MultiRandomizedLDS {
+      public:
+        typedef typename RSG::sample_type sample_type;
+        /*! the seeds of the randomizations are drawn from a Mersenne
+            Twister generator initialized with the given seed */
+        MultiRandomizedLDS(Size dimensionality,
+                           Size randomizations,
+                           BigNatural seed = 0);
+        const sample_type& nextSequence() const {
+            last_ = next_;
+            if (++next_ == generators_.size())
+                next_ = 0;
+            return generators_[last_].nextSequence();
+        }
+        const sample_type& lastSequence() const {
+            return generators_[last_].lastSequence();
+        }
+        //! skip to the n-th sample
+        void skipTo(Size n) {
+            const Size k = generators_.size();
+            for (Size i=0; i<k; ++i)
+                generators_[i].skipTo(n/k + (i < n%k ? 1 : 0));
+            next_ = n%k;
+        }
+        Size dimension() const { return generators_.front().dimension(); }
+        Size randomizations() const { return generators_.size(); }
+      private:
+        std::vector<RSG> generators_;
+        mutable Size next_ = 0, last_ = 0;
+    };
+
+    template <class RSG>
+    MultiRandomizedLDS<RSG>::MultiRandomizedLDS(Size dimensionality,
+                                                Size randomizations,
+                                                BigNatural seed) {
+        QL_REQUIRE(randomizations > 1,
+                   "at least two randomizations are required");
+        MersenneTwisterUniformRng rng(seed);
+        generators_.reserve(randomizations);
+        for (Size i=0; i<randomizations; ++i) {
+            unsigned long s;
+            do {
+                s = rng.nextInt32();
+            } while (s == 0);
+            generators_.push_back(RSG(dimensionality, s));
+        }
+    }
+
 }
 
 
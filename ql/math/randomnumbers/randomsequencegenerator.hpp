@@ -26,6 +26,7 @@
 
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
+#include <cstdint>
 #include <vector>
 
 namespace QuantLib {
@@ -43,6 +44,10 @@ namespace QuantLib {
         \code
             unsigned long RNG::nextInt32() const;
         \endcode
+        and if it wants to use the skipTo method, it must implement
+        \code
+            void RNG::discard(std::uint64_t);
+        \endcode
 
         \warning do not use with low-discrepancy sequence generator.
     */
@@ -66,6 +71,7 @@ namespace QuantLib {
           int32Sequence_(dimensionality) {}
 
         const sample_type& nextSequence() const {
+            ++sequenceCounter_;
             sequence_.weight = 1.0;
             for (Size i=0; i<dimensionality_; i++) {
                 typename RNG::sample_type x(rng_.next());
@@ -75,6 +81,7 @@ namespace QuantLib {
             return sequence_;
         }
         std::vector<BigNatural> nextInt32Sequence() const {
+            ++sequenceCounter_;
             for (Size i=0; i<dimensionality_; i++) {
                 int32Sequence_[i] = rng_.nextInt32();
             }
@@ -84,9 +91,18 @@ namespace QuantLib {
             return sequence_;
         }
         Size dimension() const {return dimensionality_;}
+        //! skip to the n-th sequence
+        void skipTo(Size n) {
+            QL_REQUIRE(n >= sequenceCounter_,
+                       "can't skip back to sequence " << n << ", "
+                       << sequenceCounter_ << " sequences already drawn");
+            rng_.discard(std::uint64_t(n - sequenceCounter_)*dimensionality_);
+            sequenceCounter_ = n;
+        }
       private:
         Size dimensionality_;
         RNG rng_;
+        mutable Size sequenceCounter_ = 0;
         mutable sample_type sequence_;
         mutable std::vector<BigNatural> int32Sequence_;
     };
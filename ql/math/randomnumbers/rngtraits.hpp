@@ -28,9 +28,12 @@
 
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/counterbaseduniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
+#include <ql/math/randomnumbers/randomizedlds.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
@@ -54,6 +57,17 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /*! for uniform generators with independent streams, e.g.,
+            Philox4x32UniformRng; the returned generator draws from
+            the given stream, so that workers using different streams
+            never share random numbers.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                std::uint64_t stream) {
+            ursg_type g(dimension, urng_type(seed, stream));
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
         // data
         static std::shared_ptr<IC> icInstance;
     };
@@ -77,6 +91,17 @@ namespace QuantLib {
     typedef GenericPseudoRandom<MersenneTwisterUniformRng,
                                 InverseCumulativePoisson> PoissonPseudoRandom;
 
+    //! traits for pseudo-random number generation with Philox-4x32-10
+    /*! \test a sequence generator is generated and tested by comparing
+              samples against the underlying uniform generator.
+    */
+    typedef GenericPseudoRandom<Philox4x32UniformRng,
+                                InverseCumulativeNormal> PhiloxPseudoRandom;
+
+    //! traits for pseudo-random number generation with Threefry-4x32-20
+    typedef GenericPseudoRandom<Threefry4x32UniformRng,
+                                InverseCumulativeNormal> ThreefryPseudoRandom;
+
 
     template <class URSG, class IC>
     struct GenericLowDiscrepancy {
@@ -104,6 +129,44 @@ namespace QuantLib {
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
+
+    /*! traits for randomized quasi-Monte Carlo; the sequence
+        generator cycles through K independent randomizations of the
+        URSG sequence. Monte Carlo models using these traits average
+        the results over each randomization and estimate the error
+        from the dispersion of the averages; see MonteCarloModel.
+    */
+    template <class URSG, class IC, Size K = 16>
+    struct GenericRandomizedLowDiscrepancy {
+        // typedefs
+        typedef MultiRandomizedLDS<URSG> ursg_type;
+        typedef InverseCumulativeRsg<ursg_type,IC> rsg_type;
+        // more traits
+        enum { allowsErrorEstimate = 1 };
+        static const Size randomizations = K;
+        // factory
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed) {
+            ursg_type g(dimension, K, seed);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
+        // data
+        static std::shared_ptr<IC> icInstance;
+    };
+
+    // static member initialization
+    template<class URSG, class IC, Size K>
+    std::shared_ptr<IC> GenericRandomizedLowDiscrepancy<URSG, IC, K>::icInstance;
+
+
+    //! default traits for randomized quasi-Monte Carlo
+    /*! \test the error estimate of a Monte Carlo engine using these
+              traits is checked against the actual error.
+    */
+    typedef GenericRandomizedLowDiscrepancy<ScrambledSobolRsg,
+                                            InverseCumulativeNormal>
+        RandomizedLowDiscrepancy;
+
 }
 
 
@@ -0,0 +1,68 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+
+namespace QuantLib {
+
+    ScrambledSobolRsg::ScrambledSobolRsg(
+                                Size dimensionality,
+                                unsigned long seed,
+                                SobolRsg::DirectionIntegers directionIntegers)
+    : dimensionality_(dimensionality),
+      sobol_(dimensionality, seed, directionIntegers),
+      columns_(dimensionality*bits_), shifts_(dimensionality),
+      integerSequence_(dimensionality),
+      sequence_(std::vector<Real>(dimensionality), 1.0) {
+
+        MersenneTwisterUniformRng rng(seed);
+        for (Size k=0; k<dimensionality_; ++k) {
+            // lower-triangular matrix with unit diagonal: the b-th
+            // column has a one at bit b and random less significant bits
+            for (Size b=0; b<bits_; ++b) {
+                const std::uint_least32_t unit = std::uint_least32_t(1) << b;
+                columns_[k*bits_+b] = unit
+                    | (std::uint_least32_t(rng.nextInt32()) & (unit-1));
+            }
+            shifts_[k] = std::uint_least32_t(rng.nextInt32());
+        }
+    }
+
+    const std::vector<std::uint_least32_t>&
+    ScrambledSobolRsg::nextInt32Sequence() const {
+        const std::vector<std::uint_least32_t>& x = sobol_.nextInt32Sequence();
+        for (Size k=0; k<dimensionality_; ++k) {
+            const std::uint_least32_t* c = &columns_[k*bits_];
+            std::uint_least32_t y = shifts_[k];
+            for (Size b=0; b<bits_; ++b)
+                y ^= c[b] & (std::uint_least32_t(0) - ((x[k] >> b) & 1U));
+            integerSequence_[k] = y;
+        }
+        return integerSequence_;
+    }
+
+    const ScrambledSobolRsg::sample_type&
+    ScrambledSobolRsg::nextSequence() const {
+        const std::vector<std::uint_least32_t>& v = nextInt32Sequence();
+        // scrambled points can be 0; shift to the cell center
+        for (Size k=0; k<dimensionality_; ++k)
+            sequence_.value[k] = (v[k] + 0.5)/4294967296.0;
+        return sequence_;
+    }
+
+}
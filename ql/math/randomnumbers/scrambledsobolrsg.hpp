@@ -0,0 +1,78 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scrambledsobolrsg.hpp
+    \brief Scrambled Sobol low-discrepancy sequence generator
+*/
+
+#ifndef quantlib_scrambled_sobol_ld_rsg_hpp
+#define quantlib_scrambled_sobol_ld_rsg_hpp
+
+#include <ql/math/randomnumbers/sobolrsg.hpp>
+
+namespace QuantLib {
+
+    //! Scrambled Sobol low-discrepancy sequence generator
+    /*! The points of the Sobol sequence are scrambled by a random
+        linear transformation of their binary digits, each digit
+        being replaced by its sum with a random combination of the
+        more significant ones, followed by a random digital shift.
+        This is Matoušek's affine matrix scrambling, which preserves
+        the net structure of the sequence; as for Owen's nested
+        scrambling, each point is uniformly distributed and
+        independent scramblings yield unbiased estimates whose
+        dispersion can be used to estimate the integration error.
+
+        For more details see J. Matoušek, On the L2-discrepancy for
+        anchored boxes, Journal of Complexity 14, 1998, and A.B. Owen,
+        Randomly permuted (t,m,s)-nets and (t,s)-sequences, Monte
+        Carlo and Quasi-Monte Carlo Methods in Scientific Computing,
+        1995.
+
+        \test
+        - the stratification of the scrambled points is tested.
+        - the generation is tested for reproducibility.
+    */
+    class ScrambledSobolRsg {
+      public:
+        typedef Sample<std::vector<Real> > sample_type;
+        /*! the seed is used for drawing the scrambling; if it is 0, a
+            random seed is used. */
+        explicit ScrambledSobolRsg(Size dimensionality,
+                                   unsigned long seed = 0,
+                                   SobolRsg::DirectionIntegers directionIntegers
+                                                        = SobolRsg::JoeKuoD7);
+        //! skip to the n-th sample in the low-discrepancy sequence
+        void skipTo(std::uint_least32_t n) { sobol_.skipTo(n); }
+        const std::vector<std::uint_least32_t>& nextInt32Sequence() const;
+        const sample_type& nextSequence() const;
+        const sample_type& lastSequence() const { return sequence_; }
+        Size dimension() const { return dimensionality_; }
+      private:
+        static const Size bits_ = 32;
+        Size dimensionality_;
+        SobolRsg sobol_;
+        // columns of the scrambling matrices, bits_ for each dimension
+        std::vector<std::uint_least32_t> columns_;
+        std::vector<std::uint_least32_t> shifts_;
+        mutable std::vector<std::uint_least32_t> integerSequence_;
+        mutable sample_type sequence_;
+    };
+
+}
+
+#endif
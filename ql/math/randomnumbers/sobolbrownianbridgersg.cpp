@@ -56,4 +56,8 @@ namespace QuantLib {
     Size SobolBrownianBridgeRsg::dimension() const {
         return dim_;
     }
+
+    void SobolBrownianBridgeRsg::skipTo(Size n) {
+        gen_.skipTo(n);
+    }
 }
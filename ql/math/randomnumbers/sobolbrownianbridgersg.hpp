@@ -43,6 +43,8 @@ namespace QuantLib {
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const;
         Size dimension() const;
+        //! skip to the n-th sample in the low-discrepancy sequence
+        void skipTo(Size n);
 
       private:
         const Size factors_, steps_, dim_;
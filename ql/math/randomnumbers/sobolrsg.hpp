@@ -27,6 +27,8 @@
 #define quantlib_sobol_ld_rsg_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -110,6 +112,7 @@ namespace QuantLib {
     class SobolRsg {
       public:
         typedef Sample<std::vector<Real> > sample_type;
+        enum Layout { PointMajor, DimensionMajor };
         enum DirectionIntegers {
             Unit, Jaeckel, SobolLevitan, SobolLevitanLemieux,
             JoeKuoD5, JoeKuoD6, JoeKuoD7,
@@ -129,6 +132,15 @@ namespace QuantLib {
                 sequence_.value[k] = v[k] * normalizationFactor_;
             return sequence_;
         }
+        /*! writes the next n points of the sequence to the given
+            buffer of size n*dimension(), point after point or
+            dimension after dimension; the results are the same as
+            the ones of n calls to nextSequence().  The direction
+            integers are stored by bit, so that the update of all the
+            dimensions is a contiguous XOR which can be vectorized.
+        */
+        void nextSequences(Size n, Real* output,
+                           Layout layout = PointMajor) const;
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
@@ -140,8 +152,70 @@ namespace QuantLib {
         mutable sample_type sequence_;
         mutable std::vector<std::uint_least32_t> integerSequence_;
         std::vector<std::vector<std::uint_least32_t>> directionIntegers_;
+        // direction integers stored by bit, used for bulk generation
+        mutable std::vector<std::uint_least32_t> directionsByBit_;
     };
 
+
+    inline void SobolRsg::nextSequences(Size n, Real* output,
+                                        Layout layout) const {
+        if (n == 0)
+            return;
+
+        const Size bits = directionIntegers_[0].size();
+        if (directionsByBit_.empty()) {
+            directionsByBit_.resize(bits*dimensionality_);
+            for (Size j=0; j<bits; ++j)
+                for (Size k=0; k<dimensionality_; ++k)
+                    directionsByBit_[j*dimensionality_+k] =
+                        directionIntegers_[k][j];
+        }
+
+        // points are generated in tiles and then copied to the output
+        const Size tileSize = 16;
+        std::vector<std::uint_least32_t> tile(tileSize*dimensionality_);
+        std::uint_least32_t* x = &integerSequence_[0];
+
+        for (Size first=0; first<n; first+=tileSize) {
+            const Size points = std::min(tileSize, n-first);
+            for (Size i=0; i<points; ++i) {
+                if (firstDraw_) {
+                    firstDraw_ = false;
+                } else {
+                    ++sequenceCounter_;
+                    QL_REQUIRE(sequenceCounter_ != 0, "period exceeded");
+                    // Gray code, see nextInt32Sequence()
+                    Size j = 0;
+                    for (std::uint_least32_t c=sequenceCounter_;
+                         (c & 1U) != 0U; c >>= 1)
+                        ++j;
+                    const std::uint_least32_t* v =
+                        &directionsByBit_[j*dimensionality_];
+                    for (Size k=0; k<dimensionality_; ++k)
+                        x[k] ^= v[k];
+                }
+                std::copy(x, x+dimensionality_,
+                          tile.begin() + i*dimensionality_);
+            }
+
+            if (layout == PointMajor) {
+                Real* y = output + first*dimensionality_;
+                for (Size l=0; l<points*dimensionality_; ++l)
+                    y[l] = tile[l] * normalizationFactor_;
+            } else {
+                for (Size k=0; k<dimensionality_; ++k) {
+                    Real* y = output + k*n + first;
+                    for (Size i=0; i<points; ++i)
+                        y[i] = tile[i*dimensionality_+k]
+                            * normalizationFactor_;
+                }
+            }
+        }
+
+        for (Size k=0; k<dimensionality_; ++k)
+            sequence_.value[k] = x[k] * normalizationFactor_;
+    }
+
 }
 
 #endif
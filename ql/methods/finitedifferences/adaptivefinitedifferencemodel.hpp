@@ -0,0 +1,228 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file adaptivefinitedifferencemodel.hpp
+    \brief finite difference model with adaptive time steps
+*/
+
+#ifndef quantlib_adaptive_finite_difference_model_hpp
+#define quantlib_adaptive_finite_difference_model_hpp
+
+#include <ql/methods/finitedifferences/operatortraits.hpp>
+#include <ql/methods/finitedifferences/stepcondition.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Finite difference model with adaptive time-step control
+    /*! The local error of each step is estimated by step doubling,
+        i.e., by comparing one step of size \f$ h \f$ with two steps
+        of size \f$ h/2 \f$. The step is accepted if the scaled error
+        \f[
+            \max_i \frac{|u^{h/2}_i - u^h_i|}{(2^p-1)\,\epsilon\,(1+|u^{h/2}_i|)}
+        \f]
+        is not greater than one, where \f$ p \f$ is the order of the
+        scheme and \f$ \epsilon \f$ the given tolerance; otherwise
+        it is repeated with a smaller step. The next step size is
+        chosen by the usual controller
+        \f$ h' = h \min(f_{max}, \max(f_{min}, 0.9\,err^{-1/(p+1)})) \f$.
+
+        The same difference is used for local Richardson
+        extrapolation: an accepted step continues from
+        \f[
+            u^{h/2} + \frac{u^{h/2} - u^h}{2^p-1},
+        \f]
+        which is of order \f$ p+1 \f$ for smooth solutions. The
+        extrapolation can be switched off in the constructor.
+
+        Stopping times are hit exactly. The condition is applied
+        after every accepted step as in FiniteDifferenceModel, i.e.,
+        to the extrapolated values, and between the two half steps.
+
+        \note step doubling triples the work per step; the
+              extrapolation makes up for it, so that for a given
+              number of evolver steps the adaptive grid is usually
+              more accurate than a uniform one.
+
+        \ingroup findiff
+    */
+    template<class Evolver>
+    class AdaptiveFiniteDifferenceModel {
+      public:
+        typedef typename Evolver::traits traits;
+        typedef typename traits::array_type array_type;
+        typedef typename traits::condition_type condition_type;
+
+        AdaptiveFiniteDifferenceModel(Evolver evolver,
+                                      Size order,
+                                      Real tolerance,
+                                      std::vector<Time> stoppingTimes
+                                                        = std::vector<Time>(),
+                                      Time initialStep = Null<Time>(),
+                                      Time minStep = Null<Time>(),
+                                      bool extrapolate = true)
+        : evolver_(std::move(evolver)), order_(order), tolerance_(tolerance),
+          initialStep_(initialStep), minStep_(minStep),
+          extrapolate_(extrapolate),
+          stoppingTimes_(std::move(stoppingTimes)),
+          acceptedSteps_(0), rejectedSteps_(0) {
+            QL_REQUIRE(order_ > 0, "order of the scheme must be positive");
+            QL_REQUIRE(tolerance_ > 0.0, "tolerance must be positive");
+            std::sort(stoppingTimes_.begin(), stoppingTimes_.end());
+            auto last = std::unique(stoppingTimes_.begin(), stoppingTimes_.end());
+            stoppingTimes_.erase(last, stoppingTimes_.end());
+        }
+
+        const Evolver& evolver() const { return evolver_; }
+
+        /*! solves the problem between the given times.
+            \warning being this a rollback, <tt>from</tt> must be a later
+                     time than <tt>to</tt>.
+        */
+        void rollback(array_type& a, Time from, Time to) {
+            rollbackImpl(a, from, to, (const condition_type*)nullptr);
+        }
+        /*! solves the problem between the given times,
+            applying a condition at every accepted step.
+            \warning being this a rollback, <tt>from</tt> must be a later
+                     time than <tt>to</tt>.
+        */
+        void rollback(array_type& a, Time from, Time to,
+                      const condition_type& condition) {
+            rollbackImpl(a, from, to, &condition);
+        }
+
+        //! number of accepted steps of the last rollback
+        Size acceptedSteps() const { return acceptedSteps_; }
+        //! number of rejected steps of the last rollback
+        Size rejectedSteps() const { return rejectedSteps_; }
+        /*! number of evolver steps of the last rollback; every
+            accepted or rejected step costs three evolver steps.
+        */
+        Size evolverSteps() const {
+            return 3*(acceptedSteps_ + rejectedSteps_);
+        }
+
+      private:
+        void doStep(array_type& a, Time now, Time dt) {
+            evolver_.setStep(dt);
+            evolver_.step(a, now);
+        }
+
+        Real error(const array_type& coarse, const array_type& fine) const {
+            const Real scale = (std::pow(2.0, Real(order_)) - 1.0)*tolerance_;
+            Real err = 0.0;
+            for (Size i=0; i < fine.size(); ++i)
+                err = std::max(err, std::fabs(fine[i] - coarse[i])
+                                    / (scale*(1.0 + std::fabs(fine[i]))));
+            return err;
+        }
+
+        void rollbackImpl(array_type& a, Time from, Time to,
+                          const condition_type* condition) {
+
+            QL_REQUIRE(from >= to,
+                       "trying to roll back from " << from << " to " << to);
+
+            acceptedSteps_ = rejectedSteps_ = 0;
+
+            const Time minStep = (minStep_ != Null<Time>())
+                ? minStep_ : 1e-8*(from-to);
+            Time h = (initialStep_ != Null<Time>())
+                ? initialStep_ : 0.01*(from-to);
+
+            if (!stoppingTimes_.empty() && stoppingTimes_.back() == from) {
+                if (condition)
+                    condition->applyTo(a, from);
+            }
+
+            const Real scale = std::pow(2.0, Real(order_)) - 1.0;
+            const Real exponent = -1.0/(order_ + 1.0);
+            const Real safety = 0.9, minFactor = 0.2, maxFactor = 2.0;
+
+            Time now = from;
+            while (now > to) {
+                // never step over "to" or over a stopping time
+                const Time target = now - h;
+                Time next = std::max(to, target);
+                for (auto iter = stoppingTimes_.rbegin();
+                     iter != stoppingTimes_.rend(); ++iter) {
+                    if (*iter < now && *iter > next) {
+                        next = *iter;
+                        break;
+                    }
+                }
+                if (next - to < std::sqrt(QL_EPSILON)*(from-to))
+                    next = to;
+
+                const Time dt = now - next;
+                const bool shortened = next > target;
+
+                array_type coarse(a), fine(a);
+                doStep(coarse, now, dt);
+                doStep(fine, now, 0.5*dt);
+                if (condition)
+                    condition->applyTo(fine, now - 0.5*dt);
+                doStep(fine, now - 0.5*dt, 0.5*dt);
+
+                const Real err = error(coarse, fine);
+                const Real factor = (err > 0.0)
+                    ? safety*std::pow(err, exponent) : maxFactor;
+
+                if (err <= 1.0 || dt <= minStep) {
+                    if (extrapolate_) {
+                        for (Size i=0; i < a.size(); ++i)
+                            a[i] = fine[i] + (fine[i] - coarse[i])/scale;
+                    } else {
+                        a.swap(fine);
+                    }
+                    now = next;
+                    if (condition)
+                        condition->applyTo(a, now);
+                    ++acceptedSteps_;
+                    const Real f =
+                        std::min(maxFactor, std::max(minFactor, factor));
+                    // a step shortened by a stopping time says little
+                    // about the step size, which is then only reduced
+                    // if the error requires it
+                    if (!shortened)
+                        h = dt*f;
+                    else if (f < 1.0)
+                        h = std::min(h, dt*f);
+                } else {
+                    ++rejectedSteps_;
+                    h = std::max(minStep,
+                                 dt*std::min(1.0, std::max(minFactor, factor)));
+                }
+            }
+        }
+
+        Evolver evolver_;
+        const Size order_;
+        const Real tolerance_;
+        const Time initialStep_, minStep_;
+        const bool extrapolate_;
+        std::vector<Time> stoppingTimes_;
+        Size acceptedSteps_, rejectedSteps_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file adaptive1dmesher.cpp
+    \brief One-dimensional mesher equidistributing a given mesh density
+*/
+
+#include <ql/errors.hpp>
+#include <ql/utilities/null.hpp>
+#include <ql/methods/finitedifferences/meshers/adaptive1dmesher.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    Adaptive1dMesher::Adaptive1dMesher(Size size,
+                                       const std::vector<Real>& x,
+                                       const std::vector<Real>& density)
+    : Fdm1dMesher(size) {
+
+        QL_REQUIRE(size > 1, "at least two nodes are needed");
+        QL_REQUIRE(x.size() > 1, "at least two reference points are needed");
+        QL_REQUIRE(x.size() == density.size(),
+                   "reference grid and density sizes differ ("
+                   << x.size() << ", " << density.size() << ")");
+
+        // cumulative integral of the density, which is taken to be
+        // linear between two reference points, i.e., the trapezoidal
+        // rule is exact
+        std::vector<Real> c(x.size(), 0.0);
+        for (Size i=1; i < x.size(); ++i) {
+            QL_REQUIRE(x[i] > x[i-1], "reference grid must be increasing");
+            QL_REQUIRE(density[i] >= 0.0 && density[i-1] >= 0.0,
+                       "density must be non-negative");
+            c[i] = c[i-1] + 0.5*(density[i]+density[i-1])*(x[i]-x[i-1]);
+        }
+        QL_REQUIRE(c.back() > 0.0, "density must not vanish");
+
+        locations_.front() = x.front();
+        locations_.back() = x.back();
+
+        Size j = 1;
+        for (Size i=1; i < size-1; ++i) {
+            const Real target = c.back()*Real(i)/(size-1);
+            while (c[j] < target)
+                ++j;
+            // solve d t + (d'/2) t^2 = target - c[j-1] for the offset t
+            // from x[j-1], d' being the slope of the density
+            const Real h = x[j] - x[j-1];
+            const Real a = 0.5*(density[j] - density[j-1])/h;
+            const Real b = density[j-1];
+            const Real r = target - c[j-1];
+            const Real t = 2.0*r/(b + std::sqrt(std::max(b*b + 4.0*a*r, 0.0)));
+            locations_[i] = x[j-1] + std::min(t, h);
+        }
+
+        dplus_.back() = dminus_.front() = Null<Real>();
+        for (Size i=0; i < size-1; ++i) {
+            dplus_[i] = dminus_[i+1] = locations_[i+1] - locations_[i];
+        }
+    }
+}
@@ -0,0 +1,49 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file adaptive1dmesher.hpp
+    \brief One-dimensional mesher equidistributing a given mesh density
+*/
+
+#ifndef quantlib_adaptive_1d_mesher_hpp
+#define quantlib_adaptive_1d_mesher_hpp
+
+#include <ql/methods/finitedifferences/meshers/fdm1dmesher.hpp>
+
+namespace QuantLib {
+
+    //! One-dimensional mesher equidistributing a given mesh density
+    /*! The nodes \f$ x_i \f$ are placed such that the integral of the
+        mesh density \f$ w \f$ is the same between all neighbouring
+        nodes, i.e., the mesh is fine where the density is large.
+        The density is given by its values on a reference grid,
+        which also defines the boundaries of the mesh, and is
+        interpolated linearly between the reference points.
+
+        Meshers of size \f$ n \f$ and \f$ 2n-1 \f$ built from the
+        same density are nested, which allows for Richardson
+        extrapolation in space.
+    */
+    class Adaptive1dMesher : public Fdm1dMesher {
+      public:
+        Adaptive1dMesher(Size size,
+                         const std::vector<Real>& x,
+                         const std::vector<Real>& density);
+    };
+}
+
+#endif
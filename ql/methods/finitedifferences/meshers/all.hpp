@@ -1,6 +1,7 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/methods/finitedifferences/meshers/adaptive1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/exponentialjump1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdm1dmesher.hpp>
@@ -145,16 +145,18 @@ namespace QuantLib {
         const Size n = index->size();
 
         SparseMatrix retVal(n, n, 9*n);
-        for (Size i=0; i < index->size(); ++i) {
-            retVal(i, i00_[i]) += a00_[i];
-            retVal(i, i01_[i]) += a01_[i];
-            retVal(i, i02_[i]) += a02_[i];
-            retVal(i, i10_[i]) += a10_[i];
-            retVal(i, i      ) += a11_[i];
-            retVal(i, i12_[i]) += a12_[i];
-            retVal(i, i20_[i]) += a20_[i];
-            retVal(i, i21_[i]) += a21_[i];
-            retVal(i, i22_[i]) += a22_[i];
+        std::pair<Size, Real> row[9];
+        for (Size i=0; i < n; ++i) {
+            row[0] = {i00_[i], a00_[i]};
+            row[1] = {i01_[i], a01_[i]};
+            row[2] = {i02_[i], a02_[i]};
+            row[3] = {i10_[i], a10_[i]};
+            row[4] = {i,       a11_[i]};
+            row[5] = {i12_[i], a12_[i]};
+            row[6] = {i20_[i], a20_[i]};
+            row[7] = {i21_[i], a21_[i]};
+            row[8] = {i22_[i], a22_[i]};
+            appendRow(retVal, i, row, row+9);
         }
 
         return retVal;
@@ -250,10 +250,12 @@ namespace QuantLib {
         const Size n = index->size();
 
         SparseMatrix retVal(n, n, 3*n);
+        std::pair<Size, Real> row[3];
         for (Size i=0; i < n; ++i) {
-            retVal(i, i0_[i]) += lower_[i];
-            retVal(i, i     ) += diag_[i];
-            retVal(i, i2_[i]) += upper_[i];
+            row[0] = {i0_[i], lower_[i]};
+            row[1] = {i,      diag_[i]};
+            row[2] = {i2_[i], upper_[i]};
+            appendRow(retVal, i, row, row+3);
         }
 
         return retVal;
@@ -99,4 +99,28 @@ namespace QuantLib {
         calculate();
         return interpolation_->secondDerivative(x);
     }
+
+    Array Fdm1DimSolver::interpolateAt(const Array& x) const {
+        calculate();
+        Array retVal(x.size());
+        for (Size i=0; i < x.size(); ++i)
+            retVal[i] = (*interpolation_)(x[i]);
+        return retVal;
+    }
+
+    Array Fdm1DimSolver::derivativeX(const Array& x) const {
+        calculate();
+        Array retVal(x.size());
+        for (Size i=0; i < x.size(); ++i)
+            retVal[i] = interpolation_->derivative(x[i]);
+        return retVal;
+    }
+
+    Array Fdm1DimSolver::derivativeXX(const Array& x) const {
+        calculate();
+        Array retVal(x.size());
+        for (Size i=0; i < x.size(); ++i)
+            retVal[i] = interpolation_->secondDerivative(x[i]);
+        return retVal;
+    }
 }
@@ -47,6 +47,13 @@ namespace QuantLib {
         Real derivativeX(Real x) const;
         Real derivativeXX(Real x) const;
 
+        //! \name Bulk evaluation
+        //@{
+        Array interpolateAt(const Array& x) const;
+        Array derivativeX(const Array& x) const;
+        Array derivativeXX(const Array& x) const;
+        //@}
+
       protected:
         void performCalculations() const override;
 
@@ -125,4 +125,74 @@ namespace QuantLib {
         return interpolation_->derivativeXY(x, y);
     }
 
+    Matrix Fdm2DimSolver::interpolateAt(const Array& x, const Array& y) const {
+        return valuesOnGrid(x, y, 0);
+    }
+
+    Matrix Fdm2DimSolver::derivativeX(const Array& x, const Array& y) const {
+        return valuesOnGrid(x, y, 1);
+    }
+
+    Matrix Fdm2DimSolver::derivativeXX(const Array& x, const Array& y) const {
+        return valuesOnGrid(x, y, 2);
+    }
+
+    Matrix Fdm2DimSolver::valuesOnGrid(const Array& x, const Array& y,
+                                       Size derivativeOrder) const {
+        calculate();
+
+        for (Real xi : x)
+            QL_REQUIRE(xi >= x_.front() && xi <= x_.back(),
+                       "x value " << xi << " is out of range ["
+                       << x_.front() << ", " << x_.back() << "]");
+        for (Real yj : y)
+            QL_REQUIRE(yj >= y_.front() && yj <= y_.back(),
+                       "y value " << yj << " is out of range ["
+                       << y_.front() << ", " << y_.back() << "]");
+
+        // natural cubic splines in y direction, one per x node. The
+        // tensor product spline is independent of the order of the
+        // directions, hence this gives the same values as BicubicSpline.
+        const Matrix columns = transpose(resultValues_);
+        std::vector<CubicInterpolation> ySplines;
+        ySplines.reserve(x_.size());
+        for (Size i=0; i < x_.size(); ++i)
+            ySplines.emplace_back(
+                y_.begin(), y_.end(), columns.row_begin(i),
+                CubicInterpolation::Spline, false,
+                CubicInterpolation::SecondDerivative, 0.0,
+                CubicInterpolation::SecondDerivative, 0.0);
+
+        Matrix retVal(x.size(), y.size());
+        std::vector<Real> section(x_.size());
+        for (Size j=0; j < y.size(); ++j) {
+            for (Size i=0; i < x_.size(); ++i)
+                section[i] = ySplines[i](y[j], true);
+
+            const CubicInterpolation xSpline(
+                x_.begin(), x_.end(), section.begin(),
+                CubicInterpolation::Spline, false,
+                CubicInterpolation::SecondDerivative, 0.0,
+                CubicInterpolation::SecondDerivative, 0.0);
+
+            for (Size i=0; i < x.size(); ++i) {
+                switch (derivativeOrder) {
+                  case 0:
+                    retVal[i][j] = xSpline(x[i], true);
+                    break;
+                  case 1:
+                    retVal[i][j] = xSpline.derivative(x[i], true);
+                    break;
+                  case 2:
+                    retVal[i][j] = xSpline.secondDerivative(x[i], true);
+                    break;
+                  default:
+                    QL_FAIL("unsupported derivative order " << derivativeOrder);
+                }
+            }
+        }
+
+        return retVal;
+    }
+
 }
@@ -50,10 +50,26 @@ namespace QuantLib {
         Real derivativeYY(Real x, Real y) const;
         Real derivativeXY(Real x, Real y) const;
 
+        //! \name Bulk evaluation
+        /*! The results are evaluated on the grid spanned by the given
+            points, i.e. the element \f$ (i,j) \f$ of the returned
+            matrix belongs to \f$ (x_i, y_j) \f$. The splines in y
+            direction are built only once for all points, which makes
+            the derivatives much cheaper than pointwise evaluation.
+        */
+        //@{
+        Matrix interpolateAt(const Array& x, const Array& y) const;
+        Matrix derivativeX(const Array& x, const Array& y) const;
+        Matrix derivativeXX(const Array& x, const Array& y) const;
+        //@}
+
       protected:
         void performCalculations() const override;
 
       private:
+        Matrix valuesOnGrid(const Array& x, const Array& y,
+                            Size derivativeOrder) const;
+
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const std::shared_ptr<FdmLinearOpComposite> op_;
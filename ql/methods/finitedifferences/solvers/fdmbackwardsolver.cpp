@@ -23,6 +23,7 @@
 */
 
 #include <ql/mathconstants.hpp>
+#include <ql/methods/finitedifferences/adaptivefinitedifferencemodel.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
@@ -39,6 +40,29 @@
 
 
 namespace QuantLib {
+
+    namespace {
+
+        template <class Scheme>
+        FdmAdaptiveRollbackStatistics adaptiveRollbackImpl(
+                                  Scheme scheme, Size order,
+                                  FdmBackwardSolver::array_type& rhs,
+                                  Time from, Time to, Real tolerance,
+                                  Time initialStep,
+                                  const FdmStepConditionComposite& condition) {
+            AdaptiveFiniteDifferenceModel<Scheme> model(
+                std::move(scheme), order, tolerance,
+                condition.stoppingTimes(), initialStep);
+            model.rollback(rhs, from, to, condition);
+
+            FdmAdaptiveRollbackStatistics statistics;
+            statistics.acceptedSteps = model.acceptedSteps();
+            statistics.rejectedSteps = model.rejectedSteps();
+            statistics.evolverSteps = model.evolverSteps();
+            return statistics;
+        }
+
+    }
     
     FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
     : type(aType), theta(aTheta), mu(aMu) { }
@@ -197,4 +221,91 @@ namespace QuantLib {
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    FdmAdaptiveRollbackStatistics FdmBackwardSolver::adaptiveRollback(
+        FdmBackwardSolver::array_type& rhs, Time from, Time to,
+        Real tolerance, Size dampingSteps, Time initialStep) {
+
+        if (initialStep == Null<Time>())
+            initialStep = std::min(tolerance, 0.01)*(from - to);
+
+        Time dampingTo = from;
+        Size appliedDampingSteps = 0;
+        if ((dampingSteps != 0U)
+            && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
+            dampingTo = std::max(to, from - dampingSteps*initialStep);
+
+            ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+            FiniteDifferenceModel<ImplicitEulerScheme>
+                    dampingModel(implicitEvolver, condition_->stoppingTimes());
+            dampingModel.rollback(rhs, from, dampingTo,
+                                  dampingSteps, *condition_);
+            appliedDampingSteps = dampingSteps;
+        }
+
+        FdmAdaptiveRollbackStatistics statistics;
+        switch (schemeDesc_.type) {
+          case FdmSchemeDesc::HundsdorferType:
+            statistics = adaptiveRollbackImpl(
+                HundsdorferScheme(schemeDesc_.theta, schemeDesc_.mu,
+                                  map_, bcSet_),
+                2, rhs, dampingTo, to, tolerance, initialStep, *condition_);
+            break;
+          case FdmSchemeDesc::DouglasType:
+            statistics = adaptiveRollbackImpl(
+                DouglasScheme(schemeDesc_.theta, map_, bcSet_),
+                (schemeDesc_.theta == 0.5) ? 2 : 1,
+                rhs, dampingTo, to, tolerance, initialStep, *condition_);
+            break;
+          case FdmSchemeDesc::CrankNicolsonType:
+            statistics = adaptiveRollbackImpl(
+                CrankNicolsonScheme(schemeDesc_.theta, map_, bcSet_),
+                (schemeDesc_.theta == 0.5) ? 2 : 1,
+                rhs, dampingTo, to, tolerance, initialStep, *condition_);
+            break;
+          case FdmSchemeDesc::CraigSneydType:
+            statistics = adaptiveRollbackImpl(
+                CraigSneydScheme(schemeDesc_.theta, schemeDesc_.mu,
+                                 map_, bcSet_),
+                2, rhs, dampingTo, to, tolerance, initialStep, *condition_);
+            break;
+          case FdmSchemeDesc::ModifiedCraigSneydType:
+            statistics = adaptiveRollbackImpl(
+                ModifiedCraigSneydScheme(schemeDesc_.theta, schemeDesc_.mu,
+                                         map_, bcSet_),
+                2, rhs, dampingTo, to, tolerance, initialStep, *condition_);
+            break;
+          case FdmSchemeDesc::ImplicitEulerType:
+            statistics = adaptiveRollbackImpl(
+                ImplicitEulerScheme(map_, bcSet_),
+                1, rhs, from, to, tolerance, initialStep, *condition_);
+            break;
+          case FdmSchemeDesc::TrBDF2Type:
+            {
+                const FdmSchemeDesc trDesc
+                    = FdmSchemeDesc::CraigSneyd();
+
+                const std::shared_ptr<CraigSneydScheme> hsEvolver(
+                    std::make_shared<CraigSneydScheme>(
+                        trDesc.theta, trDesc.mu, map_, bcSet_));
+
+                statistics = adaptiveRollbackImpl(
+                    TrBDF2Scheme<CraigSneydScheme>(
+                        schemeDesc_.theta, map_, hsEvolver,
+                        bcSet_, schemeDesc_.mu),
+                    2, rhs, dampingTo, to, tolerance, initialStep,
+                    *condition_);
+            }
+            break;
+          case FdmSchemeDesc::ExplicitEulerType:
+          case FdmSchemeDesc::MethodOfLinesType:
+            QL_FAIL("adaptive time steps are not supported "
+                    "by this scheme type");
+          default:
+            QL_FAIL("Unknown scheme type");
+        }
+
+        statistics.evolverSteps += appliedDampingSteps;
+        return statistics;
+    }
 }
@@ -26,6 +26,7 @@
 #define quantlib_fdm_backward_solver_hpp
 
 #include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
+#include <ql/utilities/null.hpp>
 
 namespace QuantLib {
 
@@ -58,6 +59,14 @@ namespace QuantLib {
         static FdmSchemeDesc TrBDF2();
     };
         
+    //! step statistics of FdmBackwardSolver::adaptiveRollback()
+    struct FdmAdaptiveRollbackStatistics {
+        Size acceptedSteps = 0;
+        Size rejectedSteps = 0;
+        //! steps of the evolver, including rejected and damping steps
+        Size evolverSteps = 0;
+    };
+
     class FdmBackwardSolver {
       public:
         typedef FdmLinearOp::array_type array_type;
@@ -71,6 +80,28 @@ namespace QuantLib {
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        /*! rolls back using adaptive time steps, see
+            AdaptiveFiniteDifferenceModel. The initial step size
+            defaults to \f$ \min(\epsilon, 0.01) \f$ times the time
+            span, \f$ \epsilon \f$ being the tolerance. The damping
+            steps are implicit Euler steps which keep this fixed size;
+            they are neither controlled nor extrapolated, and since
+            they are of first order only, longer damping steps would
+            dominate the error of the rollback. As every
+            adaptive step costs three evolver steps by step doubling,
+            the returned statistics contain the total number of
+            evolver steps, which is the measure of the work to be
+            compared to rollback().
+
+            \note the method of lines and the explicit Euler scheme
+                  are not supported.
+        */
+        FdmAdaptiveRollbackStatistics adaptiveRollback(array_type& a,
+                                                       Time from, Time to,
+                                                       Real tolerance,
+                                                       Size dampingSteps = 0,
+                                                       Time initialStep = Null<Time>());
+
       protected:
         const std::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
@@ -73,4 +73,20 @@ namespace QuantLib {
     Real FdmBlackScholesSolver::thetaAt(Real s) const {
         return solver_->thetaAt(std::log(s));
     }
+
+    Array FdmBlackScholesSolver::valueAt(const Array& s) const {
+        calculate();
+        return solver_->interpolateAt(Log(s));
+    }
+
+    Array FdmBlackScholesSolver::deltaAt(const Array& s) const {
+        calculate();
+        return solver_->derivativeX(Log(s))/s;
+    }
+
+    Array FdmBlackScholesSolver::gammaAt(const Array& s) const {
+        calculate();
+        const Array x = Log(s);
+        return (solver_->derivativeXX(x) - solver_->derivativeX(x))/(s*s);
+    }
 }
@@ -52,6 +52,13 @@ namespace QuantLib {
         Real gammaAt(Real s) const;
         Real thetaAt(Real s) const;
 
+        //! \name Bulk evaluation, e.g. for spot ladders
+        //@{
+        Array valueAt(const Array& s) const;
+        Array deltaAt(const Array& s) const;
+        Array gammaAt(const Array& s) const;
+        //@}
+
       protected:
         void performCalculations() const override;
 
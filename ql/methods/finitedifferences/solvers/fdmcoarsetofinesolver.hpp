@@ -0,0 +1,320 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmcoarsetofinesolver.hpp
+    \brief coarse-to-fine solver with curvature adapted meshes
+*/
+
+#ifndef quantlib_fdm_coarse_to_fine_solver_hpp
+#define quantlib_fdm_coarse_to_fine_solver_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/interpolations/multicubicspline.hpp>
+#include <ql/methods/finitedifferences/meshers/adaptive1dmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
+#include <functional>
+
+namespace QuantLib {
+
+    //! coarse-to-fine solver with curvature adapted meshes
+    /*! The problem is solved first on the given coarse mesh. For
+        each refinement step the second derivatives of the solution
+        along every direction are used to build a mesh density
+        \f[
+            w_d(x_d) = \left( \alpha + \max |\partial^2_{x_d} u| \right)^{1/3},
+        \f]
+        where the maximum is taken over all the other directions, and
+        a mesh equidistributing this density is built, see
+        Adaptive1dMesher. This concentrates the nodes where the
+        curvature is large, e.g. around strikes, barriers or the
+        exercise boundary, while keeping the number of nodes of the
+        coarse mesh.
+
+        The coarse solution is not computed again on the
+        intermediate meshes: it is interpolated by cubic splines
+        onto each adapted mesh, which is the start for the next
+        refinement step. The problem is only solved again on the
+        last adapted mesh.
+
+        If requested, the last mesh is refined to \f$ 2n-1 \f$ nodes
+        per direction with the same density; the two nested solutions
+        are then combined by Richardson extrapolation assuming second
+        order convergence in space.
+
+        The PDE solver is passed as a function returning the
+        solution in layout order for a given mesher.
+
+        \ingroup findiff
+    */
+    template <Size N>
+    class FdmCoarseToFineSolver : public LazyObject {
+      public:
+        typedef std::function<Array(const std::shared_ptr<FdmMesherComposite>&)>
+            PdeSolver;
+
+        FdmCoarseToFineSolver(PdeSolver pdeSolver,
+                              std::shared_ptr<FdmMesherComposite> coarseMesher,
+                              Size refinements = 1,
+                              bool richardsonExtrapolation = true,
+                              Real densityFloor = 0.1);
+
+        Real interpolateAt(const std::vector<Real>& x) const;
+
+        //! final adapted mesher
+        const std::shared_ptr<FdmMesherComposite>& mesher() const;
+        //! values on the final adapted mesher, in layout order
+        const Array& values() const;
+        //! total number of nodes of all the PDE solves
+        Size totalNodes() const;
+        //! number of PDE solves
+        Size solves() const;
+
+      protected:
+        void performCalculations() const override;
+
+      private:
+        std::vector<std::vector<Real> > density(
+            const std::shared_ptr<FdmMesherComposite>& mesher,
+            const Array& u) const;
+        std::shared_ptr<FdmMesherComposite> adaptedMesher(
+            const std::shared_ptr<FdmMesherComposite>& mesher,
+            const std::vector<std::vector<Real> >& density,
+            bool doubleSize) const;
+        Array interpolate(const std::shared_ptr<FdmMesherComposite>& mesher,
+                          const Array& u,
+                          const std::shared_ptr<FdmMesherComposite>& target) const;
+
+        const PdeSolver pdeSolver_;
+        const std::shared_ptr<FdmMesherComposite> coarseMesher_;
+        const Size refinements_;
+        const bool richardsonExtrapolation_;
+        const Real densityFloor_;
+
+        mutable std::shared_ptr<FdmMesherComposite> mesher_;
+        mutable Array values_;
+        mutable Size totalNodes_, solves_;
+
+        typedef typename MultiCubicSpline<N>::data_table data_table;
+        const std::vector<bool> extrapolation_;
+        mutable std::vector<std::vector<Real> > x_;
+        mutable std::shared_ptr<data_table> f_;
+        mutable std::shared_ptr<MultiCubicSpline<N> > interp_;
+    };
+
+
+    template <Size N>
+    inline FdmCoarseToFineSolver<N>::FdmCoarseToFineSolver(
+        PdeSolver pdeSolver,
+        std::shared_ptr<FdmMesherComposite> coarseMesher,
+        Size refinements,
+        bool richardsonExtrapolation,
+        Real densityFloor)
+    : pdeSolver_(std::move(pdeSolver)), coarseMesher_(std::move(coarseMesher)),
+      refinements_(refinements),
+      richardsonExtrapolation_(richardsonExtrapolation),
+      densityFloor_(densityFloor), totalNodes_(0), solves_(0),
+      extrapolation_(N, false), x_(N) {
+        QL_REQUIRE(coarseMesher_->layout()->dim().size() == N,
+                   "solver dim " << N << " does not fit to layout dim "
+                   << coarseMesher_->layout()->dim().size());
+        QL_REQUIRE(refinements_ > 0 || !richardsonExtrapolation_,
+                   "Richardson extrapolation needs at least one refinement");
+        QL_REQUIRE(densityFloor_ > 0.0, "density floor must be positive");
+    }
+
+    template <Size N>
+    inline std::vector<std::vector<Real> > FdmCoarseToFineSolver<N>::density(
+        const std::shared_ptr<FdmMesherComposite>& mesher,
+        const Array& u) const {
+
+        const std::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        std::vector<std::vector<Real> > w(N);
+
+        for (Size d=0; d < N; ++d) {
+            const Array uxx = SecondDerivativeOp(d, mesher).apply(u);
+
+            std::vector<Real> curvature(layout->dim()[d], 0.0);
+            for (const auto& iter : *layout) {
+                Real& c = curvature[iter.coordinates()[d]];
+                c = std::max(c, std::fabs(uxx[iter.index()]));
+            }
+
+            // the second derivative is not defined on the boundaries
+            const Size n = curvature.size();
+            curvature.front() = curvature[1];
+            curvature.back() = curvature[n-2];
+
+            const Real maxCurvature =
+                *std::max_element(curvature.begin(), curvature.end());
+            const Real floor = densityFloor_*std::max(maxCurvature, QL_EPSILON);
+
+            w[d].resize(n);
+            for (Size i=0; i < n; ++i)
+                w[d][i] = std::cbrt(floor + curvature[i]);
+
+            // smooth the density to avoid abrupt changes of the spacing
+            for (Size k=0; k < 2; ++k) {
+                const std::vector<Real> tmp(w[d]);
+                for (Size i=1; i < n-1; ++i)
+                    w[d][i] = 0.25*(tmp[i-1] + 2*tmp[i] + tmp[i+1]);
+            }
+        }
+
+        return w;
+    }
+
+    template <Size N>
+    inline std::shared_ptr<FdmMesherComposite>
+    FdmCoarseToFineSolver<N>::adaptedMesher(
+        const std::shared_ptr<FdmMesherComposite>& mesher,
+        const std::vector<std::vector<Real> >& density,
+        bool doubleSize) const {
+
+        std::vector<std::shared_ptr<Fdm1dMesher> > meshers(N);
+        for (Size d=0; d < N; ++d) {
+            const Size n = coarseMesher_->getFdm1dMeshers()[d]->size();
+            meshers[d] = std::make_shared<Adaptive1dMesher>(
+                doubleSize ? 2*n-1 : n,
+                mesher->getFdm1dMeshers()[d]->locations(), density[d]);
+        }
+        return std::make_shared<FdmMesherComposite>(meshers);
+    }
+
+    template <Size N>
+    inline Array FdmCoarseToFineSolver<N>::interpolate(
+        const std::shared_ptr<FdmMesherComposite>& mesher,
+        const Array& u,
+        const std::shared_ptr<FdmMesherComposite>& target) const {
+
+        std::vector<std::vector<Real> > x(N);
+        for (Size d=0; d < N; ++d)
+            x[d] = mesher->getFdm1dMeshers()[d]->locations();
+
+        data_table f(x);
+        for (const auto& iter : *mesher->layout())
+            FdmNdimSolver<N>::setValue(f, iter.coordinates(), u[iter.index()]);
+
+        // both meshes span the same domain; extrapolation is only
+        // needed for the nodes on its boundary
+        const std::vector<bool> boundary(N, true);
+        const MultiCubicSpline<N> spline(x, f, boundary);
+
+        const std::shared_ptr<FdmLinearOpLayout> layout = target->layout();
+        Array v(layout->size());
+        std::vector<Real> point(N);
+        for (const auto& iter : *layout) {
+            for (Size d=0; d < N; ++d)
+                point[d] = target->location(iter, d);
+            v[iter.index()] = spline(point);
+        }
+        return v;
+    }
+
+    template <Size N>
+    inline void FdmCoarseToFineSolver<N>::performCalculations() const {
+        mesher_ = coarseMesher_;
+        values_ = pdeSolver_(mesher_);
+        totalNodes_ = mesher_->layout()->size();
+        solves_ = 1;
+
+        std::shared_ptr<FdmMesherComposite> fineMesher;
+        for (Size r=0; r < refinements_; ++r) {
+            const std::vector<std::vector<Real> > w = density(mesher_, values_);
+            const std::shared_ptr<FdmMesherComposite> adapted =
+                adaptedMesher(mesher_, w, false);
+
+            if (r < refinements_-1) {
+                values_ = interpolate(mesher_, values_, adapted);
+            } else {
+                if (richardsonExtrapolation_)
+                    fineMesher = adaptedMesher(mesher_, w, true);
+                values_ = pdeSolver_(adapted);
+                totalNodes_ += adapted->layout()->size();
+                ++solves_;
+            }
+            mesher_ = adapted;
+        }
+
+        const std::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+
+        if (fineMesher != nullptr) {
+            const Array fine = pdeSolver_(fineMesher);
+            totalNodes_ += fineMesher->layout()->size();
+            ++solves_;
+
+            // every other node of the fine mesh is a node of the coarse one
+            const std::shared_ptr<FdmLinearOpLayout> fineLayout =
+                fineMesher->layout();
+            std::vector<Size> fineCoordinates(N);
+            for (const auto& iter : *layout) {
+                for (Size d=0; d < N; ++d)
+                    fineCoordinates[d] = 2*iter.coordinates()[d];
+                const Real f = fine[fineLayout->index(fineCoordinates)];
+                values_[iter.index()] = (4.0*f - values_[iter.index()])/3.0;
+            }
+        }
+
+        for (Size d=0; d < N; ++d)
+            x_[d] = mesher_->getFdm1dMeshers()[d]->locations();
+
+        f_ = std::make_shared<data_table>(x_);
+        for (const auto& iter : *layout)
+            FdmNdimSolver<N>::setValue(*f_, iter.coordinates(),
+                                       values_[iter.index()]);
+
+        // the spline keeps references to the grid and the data
+        interp_ = std::make_shared<MultiCubicSpline<N> >(
+            x_, *f_, extrapolation_);
+    }
+
+    template <Size N>
+    inline Real FdmCoarseToFineSolver<N>::interpolateAt(
+        const std::vector<Real>& x) const {
+        calculate();
+        return (*interp_)(x);
+    }
+
+    template <Size N>
+    inline const std::shared_ptr<FdmMesherComposite>&
+    FdmCoarseToFineSolver<N>::mesher() const {
+        calculate();
+        return mesher_;
+    }
+
+    template <Size N>
+    inline const Array& FdmCoarseToFineSolver<N>::values() const {
+        calculate();
+        return values_;
+    }
+
+    template <Size N>
+    inline Size FdmCoarseToFineSolver<N>::totalNodes() const {
+        calculate();
+        return totalNodes_;
+    }
+
+    template <Size N>
+    inline Size FdmCoarseToFineSolver<N>::solves() const {
+        calculate();
+        return solves_;
+    }
+}
+
+#endif
@@ -24,6 +24,7 @@
 #include <ql/methods/finitedifferences/solvers/fdm2dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 #include <ql/processes/hestonprocess.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -90,4 +91,30 @@ namespace QuantLib {
         calculate();
         return solver_->thetaAt(std::log(s), v);
     }
+
+    Matrix FdmHestonSolver::valueAt(const Array& s, const Array& v) const {
+        calculate();
+        return solver_->interpolateAt(Log(s), v);
+    }
+
+    Matrix FdmHestonSolver::deltaAt(const Array& s, const Array& v) const {
+        calculate();
+        Matrix retVal = solver_->derivativeX(Log(s), v);
+        for (Size i=0; i < s.size(); ++i)
+            std::transform(retVal.row_begin(i), retVal.row_end(i),
+                           retVal.row_begin(i),
+                           [&](Real d) { return d/s[i]; });
+        return retVal;
+    }
+
+    Matrix FdmHestonSolver::gammaAt(const Array& s, const Array& v) const {
+        calculate();
+        const Array x = Log(s);
+        Matrix retVal = solver_->derivativeXX(x, v) - solver_->derivativeX(x, v);
+        for (Size i=0; i < s.size(); ++i)
+            std::transform(retVal.row_begin(i), retVal.row_end(i),
+                           retVal.row_begin(i),
+                           [&](Real g) { return g/(s[i]*s[i]); });
+        return retVal;
+    }
 }
@@ -27,6 +27,7 @@
 #define quantlib_fdm_heston_solver_hpp
 
 #include <ql/handle.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
@@ -63,6 +64,16 @@ namespace QuantLib {
         Real meanVarianceDeltaAt(Real s, Real v) const;
         Real meanVarianceGammaAt(Real s, Real v) const;
 
+        /*! \name Bulk evaluation
+            The element \f$ (i,j) \f$ of the returned matrix belongs
+            to the spot \f$ s_i \f$ and the variance \f$ v_j \f$.
+        */
+        //@{
+        Matrix valueAt(const Array& s, const Array& v) const;
+        Matrix deltaAt(const Array& s, const Array& v) const;
+        Matrix gammaAt(const Array& s, const Array& v) const;
+        //@}
+
       protected:
         void performCalculations() const override;
 
@@ -50,6 +50,9 @@ namespace QuantLib {
         Real interpolateAt(const std::vector<Real>& x) const;
         Real thetaAt(const std::vector<Real>& x) const;
 
+        //! bulk evaluation, one value per point
+        Array interpolateAt(const std::vector<std::vector<Real> >& x) const;
+
         // template meta programming
         typedef typename MultiCubicSpline<N>::data_table data_table;
         void static setValue(data_table& f,
@@ -168,6 +171,17 @@ namespace QuantLib {
         return (*interp_)(x);
     }
 
+    template <Size N> inline
+    Array FdmNdimSolver<N>::interpolateAt(
+        const std::vector<std::vector<Real> >& x) const {
+        calculate();
+
+        Array retVal(x.size());
+        for (Size i=0; i < x.size(); ++i)
+            retVal[i] = (*interp_)(x[i]);
+        return retVal;
+    }
+
     template <Size N> inline
     void FdmNdimSolver<N>::setValue(data_table& f,
                                     const std::vector<Size>& x, Real value) {
@@ -0,0 +1,108 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmsolutioncache.hpp
+    \brief cache of finite-difference solutions
+*/
+
+#ifndef quantlib_fdm_solution_cache_hpp
+#define quantlib_fdm_solution_cache_hpp
+
+#include <ql/errors.hpp>
+#include <ql/patterns/observable.hpp>
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! cache of finite-difference solutions
+    /*! Solutions are stored under a key describing the contract and
+        the numerical setup, e.g., payoff, exercise dates and grid
+        sizes. The market data the solutions depend on must not be
+        part of the key; instead, the cache is registered with it and
+        is cleared whenever it changes.
+
+        When the cache is full, the oldest entry is removed.
+    */
+    template <class T>
+    class FdmSolutionCache : public Observer {
+      public:
+        typedef std::vector<Real> key_type;
+        typedef T value_type;
+
+        explicit FdmSolutionCache(Size maxSize = 100)
+        : maxSize_(maxSize), hits_(0), misses_(0) {
+            QL_REQUIRE(maxSize_ > 0, "cache size must be positive");
+        }
+
+        //! returns the cached solution or null if the key is not found
+        const T* find(const key_type& key) const {
+            return find(key, [](const T&) { return true; });
+        }
+        /*! returns the cached solution or null if the key is not found
+            or the solution can't be used for the current calculation,
+            e.g., because the spot is too close to the boundaries.
+        */
+        template <class Predicate>
+        const T* find(const key_type& key, const Predicate& isUsable) const {
+            auto iter = entries_.find(key);
+            if (iter == entries_.end() || !isUsable(iter->second)) {
+                ++misses_;
+                return nullptr;
+            }
+            ++hits_;
+            return &iter->second;
+        }
+
+        void insert(const key_type& key, T value) {
+            auto iter = entries_.find(key);
+            if (iter != entries_.end()) {
+                iter->second = std::move(value);
+                return;
+            }
+            if (entries_.size() == maxSize_) {
+                entries_.erase(keys_.front());
+                keys_.pop_front();
+            }
+            entries_.emplace(key, std::move(value));
+            keys_.push_back(key);
+        }
+
+        void clear() {
+            entries_.clear();
+            keys_.clear();
+        }
+
+        Size size() const { return entries_.size(); }
+        Size hits() const { return hits_; }
+        Size misses() const { return misses_; }
+
+        //! the market data changed, cached solutions are invalid
+        void update() override { clear(); }
+
+      private:
+        const Size maxSize_;
+        std::map<key_type, T> entries_;
+        std::deque<key_type> keys_;
+        mutable Size hits_, misses_;
+    };
+
+}
+
+#endif
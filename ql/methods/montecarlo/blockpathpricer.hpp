@@ -0,0 +1,47 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blockpathpricer.hpp
+    \brief base class for path pricers working on blocks of paths
+*/
+
+#ifndef quantlib_montecarlo_block_path_pricer_hpp
+#define quantlib_montecarlo_block_path_pricer_hpp
+
+#include <ql/math/array.hpp>
+
+namespace QuantLib {
+
+    //! base class for path pricers working on blocks of paths
+    /*! Returns the values of an option on all the paths of a given
+        block, e.g., a PathBlock or a MultiPathBlock. Implementations
+        should loop over the paths in their inner loops, which then
+        run over contiguous memory and can be vectorized.
+
+        \ingroup mcarlo
+    */
+    template<class BlockType>
+    class BlockPathPricer {
+      public:
+        virtual ~BlockPathPricer() = default;
+        virtual Array operator()(const BlockType& paths) const = 0;
+    };
+
+}
+
+
+#endif
@@ -109,5 +109,51 @@ namespace QuantLib {
         }
     }
 
-}
+    void BrownianBridge::transform(const Matrix& input,
+                                   Matrix& output) const {
+        QL_REQUIRE(input.rows() == size_, "incompatible sequence size");
+        const Size n = input.columns();
+        if (output.rows() != size_ || output.columns() != n)
+            output = Matrix(size_, n);
+
+        // We use output to store the paths...
+        Real* last = output.row_begin(size_-1);
+        const Real* in = input.row_begin(0);
+        for (Size p=0; p<n; ++p)
+            last[p] = stdDev_[0] * in[p];
+
+        for (Size i=1; i<size_; ++i) {
+            const Size j = leftIndex_[i];
+            const Size k = rightIndex_[i];
+            const Size l = bridgeIndex_[i];
+            const Real wl = leftWeight_[i], wr = rightWeight_[i];
+            const Real sd = stdDev_[i];
+            const Real* right = output.row_begin(k);
+            Real* out = output.row_begin(l);
+            in = input.row_begin(i);
+            if (j != 0) {
+                const Real* left = output.row_begin(j-1);
+                for (Size p=0; p<n; ++p)
+                    out[p] = wl * left[p] + wr * right[p] + sd * in[p];
+            } else {
+                for (Size p=0; p<n; ++p)
+                    out[p] = wr * right[p] + sd * in[p];
+            }
+        }
 
+        // ...after which, we calculate the variations and
+        // normalize to unit times
+        for (Size i=size_-1; i>=1; --i) {
+            Real* out = output.row_begin(i);
+            const Real* previous = output.row_begin(i-1);
+            for (Size p=0; p<n; ++p) {
+                out[p] -= previous[p];
+                out[p] /= sqrtdt_[i];
+            }
+        }
+        Real* first = output.row_begin(0);
+        for (Size p=0; p<n; ++p)
+            first[p] /= sqrtdt_[0];
+    }
+
+}
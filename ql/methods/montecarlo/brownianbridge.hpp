@@ -36,6 +36,7 @@
 #ifndef quantlib_brownian_bridge_hpp
 #define quantlib_brownian_bridge_hpp
 
+#include <ql/math/matrix.hpp>
 #include <ql/methods/montecarlo/path.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 
@@ -135,6 +136,15 @@ namespace QuantLib {
             }
             output[0] /= sqrtdt_[0];
         }
+
+        //! Brownian-bridge generator function for a block of paths
+        /*! Transforms the input sequences of a block of paths, stored
+            by step with one column per path as in PathBlock, into the
+            variations of the corresponding bridge paths. The results
+            are the same as the ones of the transform above applied to
+            every column, but the inner loops run over the paths.
+        */
+        void transform(const Matrix& input, Matrix& output) const;
       private:
         void initialize();
         Size size_;
@@ -24,9 +24,10 @@
 #ifndef quantlib_early_exercise_path_pricer_hpp
 #define quantlib_early_exercise_path_pricer_hpp
 
-#include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/methods/montecarlo/path.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <functional>
 
 
 namespace QuantLib {
@@ -43,6 +44,16 @@ namespace QuantLib {
         static Size pathLength(const Path& path) {
             return path.length();
         }
+        static Size stateSize(StateType) {
+            return 1;
+        }
+        static Real stateComponent(StateType state, Size) {
+            return state;
+        }
+        static StateType state(const std::vector<Real>* components,
+                               Size, Size i) {
+            return components[0][i];
+        }
     };
 
     template <>
@@ -52,6 +63,19 @@ namespace QuantLib {
         static Size pathLength(const MultiPath& path) {
             return path.pathSize();
         }
+        static Size stateSize(const StateType& state) {
+            return state.size();
+        }
+        static Real stateComponent(const StateType& state, Size k) {
+            return state[k];
+        }
+        static StateType state(const std::vector<Real>* components,
+                               Size size, Size i) {
+            StateType state(size);
+            for (Size k=0; k<size; ++k)
+                state[k] = components[k][i];
+            return state;
+        }
     };
 
     //! base class for early exercise path pricers
@@ -73,6 +97,26 @@ namespace QuantLib {
             state(const PathType& path, TimeType t) const = 0;
         virtual std::vector<std::function<ValueType(StateType)> >
             basisSystem() const = 0;
+
+        /*! returns the values of the basis functions at the given
+            states, one row per state. The default implementation
+            calls the functions returned by basisSystem(); derived
+            classes can override it with a batch evaluation.
+        */
+        virtual Matrix
+            basisSystemValues(const std::vector<StateType>& states) const {
+            const std::vector<std::function<ValueType(StateType)> > v =
+                basisSystem();
+            Matrix A(states.size(), v.size());
+
+            #pragma omp parallel for
+            for (long k=0; k < long(states.size()); ++k) {
+                for (Size l=0; l<v.size(); ++l)
+                    A[k][l] = v[l](states[k]);
+            }
+
+            return A;
+        }
     };
 }
 
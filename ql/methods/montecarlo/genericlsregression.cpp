@@ -18,8 +18,11 @@
 */
 
 #include <ql/methods/montecarlo/genericlsregression.hpp>
-#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/methods/montecarlo/lsmregression.hpp>
+#include <ql/math/statistics/statistics.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
+#include <algorithm>
+#include <functional>
 
 namespace QuantLib {
 
@@ -34,34 +37,50 @@ namespace QuantLib {
 
             std::vector<NodeData>& exerciseData = simulationData[i];
 
-            // 1) find the covariance matrix of basis function values and
-            //    deflated cash-flows
+            // 1) accumulate the normal equations of basis function
+            //    values and deflated cash-flows
             Size N = exerciseData.front().values.size();
-            std::vector<Real> temp(N+1);
-            SequenceStatistics stats(N+1);
-
-            Size j;
-            for (j=0; j<exerciseData.size(); ++j) {
-                if (exerciseData[j].isValid) {
-                    std::copy(exerciseData[j].values.begin(),
-                              exerciseData[j].values.end(),
-                              temp.begin());
-                    temp.back() = exerciseData[j].cumulatedCashFlows
-                                - exerciseData[j].controlValue;
-
-                    stats.add(temp);
+            const LsmNormalEquations normalEquations =
+                LsmNormalEquations::accumulate(
+                    N, exerciseData.size(),
+                    [&](Size j, LsmNormalEquations& equations) {
+                        const NodeData& data = exerciseData[j];
+                        if (data.isValid)
+                            equations.add(data.values.begin(),
+                                          data.cumulatedCashFlows
+                                          - data.controlValue);
+                    });
+
+            const Size n = normalEquations.samples();
+            QL_REQUIRE(n > 1, "insufficient number of valid paths ("
+                       << n << ") at exercise " << i);
+
+            // means of basis function values and deflated cash-flows
+            Array means(N, 0.0);
+            Real meanTarget = 0.0;
+            for (const auto& data : exerciseData) {
+                if (data.isValid) {
+                    std::transform(means.begin(), means.end(),
+                                   data.values.begin(), means.begin(),
+                                   std::plus<Real>());
+                    meanTarget += data.cumulatedCashFlows
+                                - data.controlValue;
                 }
             }
+            means /= Real(n);
+            meanTarget /= n;
 
-            std::vector<Real> means = stats.mean();
-            Matrix covariance = stats.covariance();
-
+            // covariance plus product of means as before, i.e., the
+            // second moments with the unbiased normalization
             Matrix C(N,N);
             Array target(N);
             for (Size k=0; k<N; ++k) {
-                target[k] = covariance[k][N] + means[k]*means[N];
+                target[k] = (normalEquations.rhs()[k]
+                             - means[k]*meanTarget)/(n-1.0);
                 for (Size l=0; l<=k; ++l)
-                    C[k][l] = C[l][k] = covariance[k][l] + means[k]*means[l];
+                    C[k][l] = C[l][k] =
+                        (normalEquations.normalMatrix()[k][l]
+                         - means[k]*means[l])/(n-1.0);
             }
 
             // 2) solve for least squares regression
@@ -72,7 +91,7 @@ namespace QuantLib {
 
             // 3) use exercise strategy to divide paths into exercise and
             //    non-exercise domains
-            for (j=0; j<exerciseData.size(); ++j) {
+            for (Size j=0; j<exerciseData.size(); ++j) {
                 if (exerciseData[j].isValid) {
                     Real exerciseValue = exerciseData[j].exerciseValue;
                     Real continuationValue =
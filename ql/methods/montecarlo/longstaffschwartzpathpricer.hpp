@@ -30,6 +30,7 @@
 #include <ql/math/generallinearleastsquares.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
+#include <ql/methods/montecarlo/lsmregression.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <utility>
@@ -38,7 +39,16 @@
 namespace QuantLib {
 
     //! Longstaff-Schwarz path pricer for early exercise options
-    /*! References:
+    /*! During the calibration phase the paths are not stored. Only
+        the exercise values and the states needed by the basis
+        functions are kept, in one contiguous buffer per exercise date
+        and state component.
+
+        The basis functions are evaluated into a design matrix per
+        exercise date by EarlyExercisePathPricer::basisSystemValues;
+        the regression is solved by the given LsmRegression method.
+
+        References:
 
         Francis Longstaff, Eduardo Schwartz, 2001. Valuing American Options
         by Simulation: A Simple Least-Squares Approach, The Review of
@@ -56,7 +66,9 @@ namespace QuantLib {
 
         LongstaffSchwartzPathPricer(const TimeGrid& times,
                                     std::shared_ptr<EarlyExercisePathPricer<PathType> >,
-                                    const std::shared_ptr<YieldTermStructure>& termStructure);
+                                    const std::shared_ptr<YieldTermStructure>& termStructure,
+                                    LsmRegression::Method regressionMethod = LsmRegression::SVD);
+        ~LongstaffSchwartzPathPricer() override;
 
         Real operator()(const PathType& path) const override;
         virtual void calibrate();
@@ -77,20 +89,41 @@ namespace QuantLib {
         std::unique_ptr<Array[]> coeff_;
         std::unique_ptr<DiscountFactor[]> dF_;
 
-        mutable std::vector<PathType> paths_;
         const   std::vector<std::function<Real(StateType)> > v_;
 
         const Size len_;
+        const LsmRegression::Method regressionMethod_;
+
+        /*! \deprecated The calibration paths are no longer stored and
+                        this member stays empty. The states, prices and
+                        exercise values of the calibration paths are
+                        passed to post_processing instead.
+                        Deprecated in version 1.30.
+        */
+        QL_DEPRECATED
+        mutable std::vector<PathType> paths_;
+
+      private:
+        typedef EarlyExerciseTraits<PathType> traits;
+        StateType calibrationState(Size i, Size j) const;
+
+        // calibration data, indexed by time and by time/state component
+        mutable std::vector<std::vector<Real> > exerciseValues_;
+        mutable std::vector<std::vector<Real> > stateValues_;
+        mutable Size stateSize_ = 0;
     };
 
+    QL_DEPRECATED_DISABLE_WARNING
+
     template <class PathType>
     inline LongstaffSchwartzPathPricer<PathType>::LongstaffSchwartzPathPricer(
         const TimeGrid& times,
         std::shared_ptr<EarlyExercisePathPricer<PathType> > pathPricer,
-        const std::shared_ptr<YieldTermStructure>& termStructure)
+        const std::shared_ptr<YieldTermStructure>& termStructure,
+        LsmRegression::Method regressionMethod)
     : pathPricer_(std::move(pathPricer)), coeff_(new Array[times.size() - 2]),
       dF_(new DiscountFactor[times.size() - 1]), v_(pathPricer_->basisSystem()),
-      len_(times.size()) {
+      len_(times.size()), regressionMethod_(regressionMethod) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -98,12 +131,31 @@ namespace QuantLib {
         }
     }
 
+    template <class PathType>
+    inline LongstaffSchwartzPathPricer<PathType>::~LongstaffSchwartzPathPricer() = default;
+
+    QL_DEPRECATED_ENABLE_WARNING
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::operator()
         (const PathType& path) const {
         if (calibrationPhase_) {
-            // store paths for the calibration
-            paths_.push_back(path);
+            // store exercise values and states for the calibration
+            if (exerciseValues_.empty()) {
+                stateSize_ = traits::stateSize(pathPricer_->state(path, 0));
+                exerciseValues_.resize(len_);
+                stateValues_.resize(len_*stateSize_);
+            }
+            for (Size i=1; i<len_; ++i) {
+                exerciseValues_[i].push_back((*pathPricer_)(path, i));
+
+                const StateType state = pathPricer_->state(path, i);
+                QL_REQUIRE(traits::stateSize(state) == stateSize_,
+                           "inconsistent state size");
+                for (Size k=0; k<stateSize_; ++k)
+                    stateValues_[i*stateSize_+k].push_back(
+                        traits::stateComponent(state, k));
+            }
             // result doesn't matter
             return 0.0;
         }
@@ -139,16 +191,24 @@ namespace QuantLib {
         return price*dF_[0];
     }
 
+    template <class PathType> inline
+    typename LongstaffSchwartzPathPricer<PathType>::StateType
+    LongstaffSchwartzPathPricer<PathType>::calibrationState(
+        Size i, Size j) const {
+        return traits::state(&stateValues_[i*stateSize_], stateSize_, j);
+    }
+
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
-        const Size n = paths_.size();
+        const Size n =
+            exerciseValues_.empty() ? 0 : exerciseValues_.back().size();
         Array prices(n), exercise(n);
         std::vector<StateType> p_state(n);
         std::vector<Real> p_price(n), p_exercise(n);
 
         for (Size i=0; i<n; ++i) {
-            p_state[i] = pathPricer_->state(paths_[i],len_-1);
-            prices[i] = p_price[i] = (*pathPricer_)(paths_[i], len_-1);
+            p_state[i] = calibrationState(len_-1, i);
+            prices[i] = p_price[i] = exerciseValues_[len_-1][i];
             p_exercise[i] = prices[i];
         }
 
@@ -162,35 +222,40 @@ namespace QuantLib {
 
             //roll back step
             for (Size j=0; j<n; ++j) {
-                exercise[j]=(*pathPricer_)(paths_[j], i);
+                exercise[j]=exerciseValues_[i][j];
                 if (exercise[j]>0.0) {
-                    x.push_back(pathPricer_->state(paths_[j], i));
+                    x.push_back(calibrationState(i, j));
                     y.push_back(dF_[i]*prices[j]);
                 }
             }
 
-            if (v_.size() <=  x.size()) {
-                coeff_[i-1] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+            // design matrix of the basis functions at the itm states
+            const Size m = v_.size(), nItm = x.size();
+            const Matrix A = pathPricer_->basisSystemValues(x);
+            QL_REQUIRE(A.rows() == nItm && A.columns() == m,
+                       "inconsistent basis system values");
+
+            if (m <= nItm) {
+                coeff_[i-1] = LsmRegression::coefficients(
+                    A, Array(y.begin(), y.end()), regressionMethod_);
             }
             else {
             // if number of itm paths is smaller then the number of
             // calibration functions then early exercise if exerciseValue > 0
-                coeff_[i-1] = Array(v_.size(), 0.0);
+                coeff_[i-1] = Array(m, 0.0);
             }
 
+            const Array continuationValues = A*coeff_[i-1];
+
             for (Size j=0, k=0; j<n; ++j) {
                 prices[j]*=dF_[i];
                 if (exercise[j]>0.0) {
-                    Real continuationValue = 0.0;
-                    for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i-1][l] * v_[l](x[k]);
-                    }
-                    if (continuationValue < exercise[j]) {
+                    if (continuationValues[k] < exercise[j]) {
                         prices[j] = exercise[j];
                     }
                     ++k;
                 }
-                p_state[j] = pathPricer_->state(paths_[j],i);
+                p_state[j] = calibrationState(i, j);
                 p_price[j] = prices[j];
                 p_exercise[j] = exercise[j];
             }
@@ -198,9 +263,9 @@ namespace QuantLib {
             post_processing(i, p_state, p_price, p_exercise);
         }
 
-        // remove calibration paths and release memory
-        std::vector<PathType> empty;
-        paths_.swap(empty);
+        // remove calibration data and release memory
+        std::vector<std::vector<Real> >().swap(exerciseValues_);
+        std::vector<std::vector<Real> >().swap(stateValues_);
         // entering the calculation phase
         calibrationPhase_ = false;
     }
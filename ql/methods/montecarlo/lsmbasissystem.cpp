@@ -37,40 +37,6 @@ namespace QuantLib {
         typedef std::vector<std::function<Real(Array)> > VF_A;
         typedef std::vector<std::vector<Size> > VV;
 
-        // pow(x, order)
-        class MonomialFct {
-          public:
-            explicit MonomialFct(Size order): order_(order) {}
-            inline Real operator()(const Real x) const {
-                Real ret = 1.0;
-                for(Size i=0; i<order_; ++i)
-                    ret *= x;
-                return ret;
-            }
-          private:
-            const Size order_;
-        };
-
-        /* multiplies [Real -> Real] functors
-           to create [Array -> Real] functor */
-        class MultiDimFct {
-          public:
-            explicit MultiDimFct(VF_R b) : b_(std::move(b)) {
-                QL_REQUIRE(!b_.empty(), "zero size basis");
-            }
-            inline Real operator()(const Array& a) const {
-                #if defined(QL_EXTRA_SAFETY_CHECKS)
-                QL_REQUIRE(b_.size()==a.size(), "wrong argument size");
-                #endif
-                Real ret = b_[0](a[0]);
-                for(Size i=1; i<b_.size(); ++i)
-                    ret *= b_[i](a[i]);
-                return ret;
-            }
-          private:
-            const VF_R b_;
-        };
-
         // check size and order of tuples
         void check_tuples(const VV& v, Size dim, Size order) {
             for (const auto& i : v) {
@@ -107,78 +73,146 @@ namespace QuantLib {
     // LsmBasisSystem static methods
 
     VF_R LsmBasisSystem::pathBasisSystem(Size order, PolynomialType type) {
+        const auto basis = std::make_shared<LsmPolynomialBasis>(1, order, type);
         VF_R ret(order+1);
-        for (Size i=0; i<=order; ++i) {
-            switch (type) {
-              case Monomial:
-                ret[i] = MonomialFct(i);
-                break;
-              case Laguerre:
-                {
-                  GaussLaguerrePolynomial p;
-                  ret[i] = [=](Real x){ return p.weightedValue(i, x); };
-                }
-                break;
-              case Hermite:
-                {
-                  GaussHermitePolynomial p;
-                  ret[i] = [=](Real x){ return p.weightedValue(i, x); };
-                }
-                break;
-              case Hyperbolic:
-                {
-                  GaussHyperbolicPolynomial p;
-                  ret[i] = [=](Real x){ return p.weightedValue(i, x); };
-                }
-                break;
-              case Legendre:
-                {
-                  GaussLegendrePolynomial p;
-                  ret[i] = [=](Real x){ return p.weightedValue(i, x); };
-                }
-                break;
-              case Chebyshev:
-                {
-                  GaussChebyshevPolynomial p;
-                  ret[i] = [=](Real x){ return p.weightedValue(i, x); };
-                }
-                break;
-              case Chebyshev2nd:
-                {
-                  GaussChebyshev2ndPolynomial p;
-                  ret[i] = [=](Real x){ return p.weightedValue(i, x); };
-                }
-                break;
-              default:
-                QL_FAIL("unknown regression type");
-            }
-        }
+        for (Size i=0; i<=order; ++i)
+            ret[i] = [basis, i](Real x){ return basis->polynomialValue(i, x); };
         return ret;
     }
 
     VF_A LsmBasisSystem::multiPathBasisSystem(Size dim, Size order,
                                               PolynomialType type) {
-        QL_REQUIRE(dim>0, "zero dimension");
-        // get single factor basis
-        VF_R pathBasis = pathBasisSystem(order, type);
-        VF_A ret;
-        // 0-th order term
-        VF_R term(dim, pathBasis[0]);
-        ret.push_back(MultiDimFct(term));
-        // start with all 0 tuple
-        VV tuples(1, std::vector<Size>(dim));
-        // add multi-factor terms
-        for(Size i=1; i<=order; ++i) {
-            tuples = next_order_tuples(tuples);
-            // now we have all tuples of order i
-            // for each tuple add the corresponding term
-            for (auto& tuple : tuples) {
-                for(Size k=0; k<dim; ++k)
-                    term[k] = pathBasis[tuple[k]];
-                ret.push_back(MultiDimFct(term));
+        const auto basis =
+            std::make_shared<LsmPolynomialBasis>(dim, order, type);
+        VF_A ret(basis->size());
+        for (Size k=0; k<ret.size(); ++k)
+            ret[k] = [basis, k](const Array& a) {
+                #if defined(QL_EXTRA_SAFETY_CHECKS)
+                QL_REQUIRE(basis->dim()==a.size(), "wrong argument size");
+                #endif
+                return basis->value(k, a.begin());
+            };
+        return ret;
+    }
+
+
+    LsmPolynomialBasis::LsmPolynomialBasis(
+        Size dim, Size order, LsmBasisSystem::PolynomialType type)
+    : dim_(dim), order_(order), type_(type) {
+        QL_REQUIRE(dim_ > 0, "zero dimension");
+
+        switch (type_) {
+          case LsmBasisSystem::Monomial:
+            break;
+          case LsmBasisSystem::Laguerre:
+            polynomial_ = std::make_shared<GaussLaguerrePolynomial>();
+            break;
+          case LsmBasisSystem::Hermite:
+            polynomial_ = std::make_shared<GaussHermitePolynomial>();
+            break;
+          case LsmBasisSystem::Hyperbolic:
+            polynomial_ = std::make_shared<GaussHyperbolicPolynomial>();
+            break;
+          case LsmBasisSystem::Legendre:
+            polynomial_ = std::make_shared<GaussLegendrePolynomial>();
+            break;
+          case LsmBasisSystem::Chebyshev:
+            polynomial_ = std::make_shared<GaussChebyshevPolynomial>();
+            break;
+          case LsmBasisSystem::Chebyshev2nd:
+            polynomial_ = std::make_shared<GaussChebyshev2ndPolynomial>();
+            break;
+          default:
+            QL_FAIL("unknown regression type");
+        }
+
+        // recurrence coefficients; beta(0) is not used by the
+        // recurrence and can't be computed for Jacobi polynomials
+        if (polynomial_ != nullptr) {
+            for (Size i=0; i<order_; ++i) {
+                alpha_.push_back(polynomial_->alpha(i));
+                beta_.push_back(i > 0 ? polynomial_->beta(i) : 0.0);
             }
         }
-        return ret;
+
+        // orders of the one-dimensional polynomials: the constant
+        // term first, followed by the terms of increasing total order
+        VV tuples(1, std::vector<Size>(dim_));
+        tuples_ = tuples;
+        for (Size i=1; i<=order_; ++i) {
+            tuples = next_order_tuples(tuples);
+            tuples_.insert(tuples_.end(), tuples.begin(), tuples.end());
+        }
+    }
+
+    void LsmPolynomialBasis::polynomialValues(Real x, Real* values) const {
+        values[0] = 1.0;
+        if (polynomial_ == nullptr) {
+            for (Size k=1; k<=order_; ++k)
+                values[k] = values[k-1]*x;
+            return;
+        }
+
+        if (order_ > 0)
+            values[1] = x - alpha_[0];
+        for (Size k=2; k<=order_; ++k)
+            values[k] = (x-alpha_[k-1])*values[k-1] - beta_[k-1]*values[k-2];
+
+        const Real sqrtW = std::sqrt(polynomial_->w(x));
+        for (Size k=0; k<=order_; ++k)
+            values[k] *= sqrtW;
+    }
+
+    Real LsmPolynomialBasis::polynomialValue(Size n, Real x) const {
+        QL_REQUIRE(n <= order_,
+                   "order " << n << " exceeds maximum order " << order_);
+
+        if (polynomial_ == nullptr) {
+            Real ret = 1.0;
+            for (Size k=0; k<n; ++k)
+                ret *= x;
+            return ret;
+        }
+
+        Real p0 = 1.0, p1 = (n > 0) ? x - alpha_[0] : 1.0;
+        for (Size k=2; k<=n; ++k) {
+            const Real p2 = (x-alpha_[k-1])*p1 - beta_[k-1]*p0;
+            p0 = p1;
+            p1 = p2;
+        }
+        return std::sqrt(polynomial_->w(x))*p1;
+    }
+
+    Matrix LsmPolynomialBasis::designMatrix(
+        const std::vector<Real>& states) const {
+        QL_REQUIRE(dim_ == 1, "one-dimensional basis system required");
+
+        Matrix A(states.size(), size());
+
+        #pragma omp parallel for
+        for (long i=0; i < long(states.size()); ++i)
+            polynomialValues(states[i], A.row_begin(i));
+
+        return A;
+    }
+
+    Matrix LsmPolynomialBasis::designMatrix(
+        const std::vector<Array>& states) const {
+        for (const auto& state : states)
+            QL_REQUIRE(state.size() == dim_, "wrong state size");
+
+        Matrix A(states.size(), size());
+
+        #pragma omp parallel
+        {
+            std::vector<Real> workspace(workspaceSize());
+
+            #pragma omp for
+            for (long i=0; i < long(states.size()); ++i)
+                values(states[i].begin(), A.row_begin(i), &workspace[0]);
+        }
+
+        return A;
     }
 
 }
@@ -29,11 +29,14 @@
 
 #include <ql/qldefines.hpp>
 #include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
 
 #include <vector>
 
 namespace QuantLib {
 
+    class GaussianOrthogonalPolynomial;
+
     class LsmBasisSystem {
       public:
         enum PolynomialType {
@@ -54,6 +57,94 @@ namespace QuantLib {
         multiPathBasisSystem(Size dim, Size order, PolynomialType type);
     };
 
+    //! polynomial basis system evaluating all basis functions at once
+    /*! The basis functions are the same as the ones returned by
+        LsmBasisSystem::pathBasisSystem for dim = 1 and by
+        LsmBasisSystem::multiPathBasisSystem otherwise, in the same
+        order. The one-dimensional polynomials are evaluated by their
+        three-term recurrences with precomputed coefficients, and the
+        multi-dimensional basis functions as tensor products of them,
+        so that all basis functions at a state are calculated from
+        dim*(order+1) polynomial values.
+    */
+    class LsmPolynomialBasis {
+      public:
+        LsmPolynomialBasis(Size dim,
+                           Size order,
+                           LsmBasisSystem::PolynomialType type);
+
+        Size dim() const { return dim_; }
+        Size order() const { return order_; }
+        //! number of basis functions
+        Size size() const { return tuples_.size(); }
+
+        //! weighted values of the polynomials of order 0 to order() at x
+        void polynomialValues(Real x, Real* values) const;
+        //! weighted value of the polynomial of order n at x
+        Real polynomialValue(Size n, Real x) const;
+
+        //! value of the k-th basis function at the given state
+        template <class Iterator>
+        Real value(Size k, Iterator state) const;
+        //! values of all basis functions at the given state
+        template <class Iterator>
+        void values(Iterator state, Real* values) const;
+        /*! values of all basis functions at the given state using
+            the given workspace of workspaceSize() elements, e.g.,
+            one per thread.
+        */
+        template <class Iterator>
+        void values(Iterator state, Real* values, Real* workspace) const;
+        Size workspaceSize() const { return dim_*(order_+1); }
+
+        //! design matrix of one-dimensional states, one row per state
+        Matrix designMatrix(const std::vector<Real>& states) const;
+        //! design matrix of multi-dimensional states, one row per state
+        Matrix designMatrix(const std::vector<Array>& states) const;
+
+      private:
+        const Size dim_, order_;
+        const LsmBasisSystem::PolynomialType type_;
+        std::shared_ptr<GaussianOrthogonalPolynomial> polynomial_;
+        std::vector<Real> alpha_, beta_;
+        // orders of the one-dimensional polynomials per basis function
+        std::vector<std::vector<Size> > tuples_;
+    };
+
+
+    template <class Iterator>
+    inline Real LsmPolynomialBasis::value(Size k, Iterator state) const {
+        const std::vector<Size>& tuple = tuples_[k];
+        Real ret = polynomialValue(tuple[0], *state);
+        for (Size d=1; d < dim_; ++d)
+            ret *= polynomialValue(tuple[d], *(++state));
+        return ret;
+    }
+
+    template <class Iterator>
+    inline void LsmPolynomialBasis::values(Iterator state, Real* values) const {
+        std::vector<Real> workspace(workspaceSize());
+        this->values(state, values, &workspace[0]);
+    }
+
+    template <class Iterator>
+    inline void LsmPolynomialBasis::values(
+        Iterator state, Real* values, Real* workspace) const {
+
+        // polynomial values, one row per dimension
+        const Size n = order_ + 1;
+        for (Size d=0; d < dim_; ++d, ++state)
+            polynomialValues(*state, workspace + d*n);
+
+        for (Size k=0; k < tuples_.size(); ++k) {
+            const std::vector<Size>& tuple = tuples_[k];
+            Real ret = workspace[tuple[0]];
+            for (Size d=1; d < dim_; ++d)
+                ret *= workspace[d*n + tuple[d]];
+            values[k] = ret;
+        }
+    }
+
 
 }
 
@@ -0,0 +1,143 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
+#include <ql/methods/montecarlo/lsmregression.hpp>
+#include <numeric>
+
+namespace QuantLib {
+
+    LsmNormalEquations::LsmNormalEquations(Size dim)
+    : normalMatrix_(dim, dim, 0.0), rhs_(dim, 0.0), samples_(0) {}
+
+    void LsmNormalEquations::merge(const LsmNormalEquations& other) {
+        QL_REQUIRE(other.dim() == dim(),
+                   "dimension mismatch: " << other.dim() << " vs " << dim());
+        normalMatrix_ += other.normalMatrix_;
+        rhs_ += other.rhs_;
+        samples_ += other.samples_;
+    }
+
+    Array LsmNormalEquations::solve() const {
+        const Size m = rhs_.size();
+
+        // Cholesky decomposition of the lower triangle
+        Matrix L(m, m, 0.0);
+        for (Size i=0; i < m; ++i) {
+            for (Size j=0; j <= i; ++j) {
+                Real sum = normalMatrix_[i][j];
+                for (Size k=0; k < j; ++k)
+                    sum -= L[i][k]*L[j][k];
+
+                if (i == j) {
+                    if (sum <= 1e-10*normalMatrix_[i][i])
+                        return Array();
+                    L[i][i] = std::sqrt(sum);
+                } else {
+                    L[i][j] = sum/L[j][j];
+                }
+            }
+        }
+
+        // forward and backward substitution
+        Array a(m);
+        for (Size i=0; i < m; ++i) {
+            Real sum = rhs_[i];
+            for (Size k=0; k < i; ++k)
+                sum -= L[i][k]*a[k];
+            a[i] = sum/L[i][i];
+        }
+        for (Size i=m; i-- > 0;) {
+            Real sum = a[i];
+            for (Size k=i+1; k < m; ++k)
+                sum -= L[k][i]*a[k];
+            a[i] = sum/L[i][i];
+        }
+
+        return a;
+    }
+
+
+    Array LsmRegression::coefficients(const Matrix& A,
+                                      const Array& y,
+                                      Method method) {
+        const Size n = A.rows(), m = A.columns();
+
+        QL_REQUIRE(y.size() == n, "sample set need to be of the same size");
+        QL_REQUIRE(n >= m, "sample set is too small");
+
+        switch (method) {
+          case SVD: {
+            const QuantLib::SVD svd(A);
+            const Matrix& V = svd.V();
+            const Matrix& U = svd.U();
+            const Array& w = svd.singularValues();
+            const Real threshold = n*QL_EPSILON*w[0];
+
+            Array a(m, 0.0);
+            for (Size i=0; i < m; ++i) {
+                if (w[i] > threshold) {
+                    const Real u = std::inner_product(
+                        U.column_begin(i), U.column_end(i),
+                        y.begin(), Real(0.0))/w[i];
+
+                    for (Size j=0; j < m; ++j)
+                        a[j] += u*V[j][i];
+                }
+            }
+            return a;
+          }
+          case QR: {
+            Matrix Q, R;
+            const std::vector<Size> ipvt = qrDecomposition(A, Q, R, true);
+
+            // the diagonal of R is decreasing in magnitude; columns
+            // beyond the numerical rank are dropped
+            const Real threshold = n*QL_EPSILON*std::fabs(R[0][0]);
+            Size rank = 0;
+            while (rank < m && std::fabs(R[rank][rank]) > threshold)
+                ++rank;
+
+            Array c(rank);
+            for (Size i=rank; i-- > 0;) {
+                Real sum = std::inner_product(
+                    Q.column_begin(i), Q.column_end(i),
+                    y.begin(), Real(0.0));
+                for (Size k=i+1; k < rank; ++k)
+                    sum -= R[i][k]*c[k];
+                c[i] = sum/R[i][i];
+            }
+
+            Array a(m, 0.0);
+            for (Size i=0; i < rank; ++i)
+                a[ipvt[i]] = c[i];
+            return a;
+          }
+          case Cholesky: {
+            const Array a = LsmNormalEquations::accumulate(
+                m, n, [&](Size j, LsmNormalEquations& equations) {
+                    equations.add(A.row_begin(j), y[j]);
+                }).solve();
+            return a.empty() ? coefficients(A, y, SVD) : a;
+          }
+          default:
+            QL_FAIL("unknown regression method");
+        }
+    }
+
+}
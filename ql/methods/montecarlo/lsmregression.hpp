@@ -0,0 +1,146 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lsmregression.hpp
+    \brief least-squares regression for Longstaff-Schwartz calibrations
+*/
+
+#ifndef quantlib_lsm_regression_hpp
+#define quantlib_lsm_regression_hpp
+
+#include <ql/math/matrix.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace QuantLib {
+
+    //! least-squares regression for Longstaff-Schwartz calibrations
+    /*! The regression problem is given by the design matrix
+        \f$ A_{jl} = v_l(x_j) \f$ of the basis functions evaluated at
+        the sample states and the vector of the sample values.
+
+        - SVD solves the problem via singular value decomposition of
+          the design matrix. This is the most robust but also the
+          slowest method.
+        - QR uses a pivoted QR decomposition of the design matrix.
+          Columns beyond the numerical rank are dropped, e.g. if the
+          payoff is part of a polynomial basis system.
+        - Cholesky solves the normal equations
+          \f$ A^T A\, \alpha = A^T y \f$. The normal equations are
+          accumulated over chunks of samples in parallel if OpenMP is
+          enabled; the chunks are merged in a fixed order, hence the
+          results do not depend on the number of threads. If the
+          normal matrix is numerically singular the method falls back
+          to SVD.
+
+        \ingroup mcarlo
+    */
+    class LsmRegression {
+      public:
+        enum Method { SVD, QR, Cholesky };
+
+        static Array coefficients(const Matrix& designMatrix,
+                                  const Array& y,
+                                  Method method = SVD);
+    };
+
+    //! normal equations of a linear least-squares problem
+    /*! Partial normal equations of disjoint sample sets can be
+        accumulated independently, e.g. in different threads, and
+        merged afterwards.
+    */
+    class LsmNormalEquations {
+      public:
+        explicit LsmNormalEquations(Size dim);
+
+        /*! accumulates the samples \f$ 0, \dots, n-1 \f$ in chunks,
+            in parallel if OpenMP is enabled. The chunks are merged in
+            a fixed order, hence the result does not depend on the
+            number of threads. <tt>addSample(j, equations)</tt> must
+            add the j-th sample, if any, to the given equations.
+        */
+        template <class F>
+        static LsmNormalEquations accumulate(Size dim, Size n,
+                                             const F& addSample);
+
+        //! adds a sample given by the basis function values and the value
+        template <class Iterator>
+        void add(Iterator basisBegin, Real y);
+        void merge(const LsmNormalEquations& other);
+
+        Size dim() const { return rhs_.size(); }
+        Size samples() const { return samples_; }
+        //! lower triangle of \f$ A^T A \f$
+        const Matrix& normalMatrix() const { return normalMatrix_; }
+        //! \f$ A^T y \f$
+        const Array& rhs() const { return rhs_; }
+
+        /*! solves the normal equations via Cholesky decomposition;
+            returns an empty array if the normal matrix is
+            numerically singular.
+        */
+        Array solve() const;
+
+      private:
+        static const Size chunkSize_ = 4096;
+
+        Matrix normalMatrix_;
+        Array rhs_;
+        Size samples_;
+    };
+
+
+    template <class Iterator>
+    inline void LsmNormalEquations::add(Iterator basisBegin, Real y) {
+        const Size m = rhs_.size();
+        Iterator vk = basisBegin;
+        for (Size k=0; k < m; ++k, ++vk) {
+            const Real v = *vk;
+            rhs_[k] += v*y;
+            Iterator vl = basisBegin;
+            for (Size l=0; l <= k; ++l, ++vl)
+                normalMatrix_[k][l] += v*(*vl);
+        }
+        ++samples_;
+    }
+
+    template <class F>
+    inline LsmNormalEquations LsmNormalEquations::accumulate(
+        Size dim, Size n, const F& addSample) {
+
+        const Size nChunks = (n + chunkSize_ - 1)/chunkSize_;
+        std::vector<LsmNormalEquations> partial(
+            nChunks, LsmNormalEquations(dim));
+
+        #pragma omp parallel for
+        for (long c=0; c < long(nChunks); ++c) {
+            const Size begin = Size(c)*chunkSize_;
+            const Size end = std::min(n, begin + chunkSize_);
+            for (Size j=begin; j < end; ++j)
+                addSample(j, partial[c]);
+        }
+
+        LsmNormalEquations normalEquations(dim);
+        for (const auto& p : partial)
+            normalEquations.merge(p);
+
+        return normalEquations;
+    }
+
+}
+
+#endif
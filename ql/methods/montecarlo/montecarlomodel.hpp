@@ -28,10 +28,26 @@
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <memory>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // number of randomizations of randomized quasi-Monte Carlo
+        // traits; zero for other traits
+        template <class RNG, class = void>
+        struct randomizations : std::integral_constant<Size, 0> {};
+
+        template <class RNG>
+        struct randomizations<RNG,
+                              std::void_t<decltype(RNG::randomizations)> >
+        : std::integral_constant<Size, RNG::randomizations> {};
+
+    }
+
     //! General-purpose Monte Carlo model for path samples
     /*! The template arguments of this class correspond to available
         policies for the particular model to be instantiated---i.e.,
@@ -46,6 +62,14 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        If the RNG traits use \f$ K \f$ independent randomizations of
+        a low-discrepancy sequence, e.g., RandomizedLowDiscrepancy,
+        the samples are added in whole rounds over the randomizations
+        and the sample accumulator contains the averages over each of
+        them; its mean is the randomized quasi-Monte Carlo estimate
+        and its error estimate is given by the dispersion of the
+        averages.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -76,7 +100,20 @@ namespace QuantLib {
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator() const;
+        //! number of samples simulated so far
+        Size samples() const { return samples_; }
       private:
+        static const Size randomizations_ =
+            detail::randomizations<RNG>::value;
+        typedef std::integral_constant<bool, (randomizations_ > 0)>
+            randomized;
+        void addSample(const result_type& sample, Real weight,
+                       std::false_type);
+        void addSample(const result_type& sample, Real weight,
+                       std::true_type);
+        void updateAccumulator(std::false_type) {}
+        void updateAccumulator(std::true_type);
+
         std::shared_ptr<path_generator_type> pathGenerator_;
         std::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -85,11 +122,19 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         std::shared_ptr<path_generator_type> cvPathGenerator_;
+        Size samples_ = 0;
+        // sums and weights of the samples of each randomization
+        std::vector<result_type> sums_;
+        std::vector<Real> weights_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        if (randomizations_ > 0)
+            samples = ((samples + randomizations_ - 1)/randomizations_)
+                    * randomizations_;
+
         for(Size j = 1; j <= samples; j++) {
 
             const sample_type& path = pathGenerator_->next();
@@ -117,10 +162,43 @@ namespace QuantLib {
                     }
                 }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
+                addSample((price+price2)/2.0, path.weight, randomized());
             } else {
-                sampleAccumulator_.add(price, path.weight);
+                addSample(price, path.weight, randomized());
             }
+            ++samples_;
+        }
+
+        updateAccumulator(randomized());
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSample(
+                       const result_type& sample, Real weight, std::false_type) {
+        sampleAccumulator_.add(sample, weight);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSample(
+                       const result_type& sample, Real weight, std::true_type) {
+        // the j-th sample belongs to the (j mod K)-th randomization
+        const Size k = samples_ % randomizations_;
+        if (samples_ < randomizations_) {
+            sums_.resize(randomizations_);
+            weights_.resize(randomizations_, 0.0);
+            sums_[k] = weight*sample;
+        } else {
+            sums_[k] += weight*sample;
+        }
+        weights_[k] += weight;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::updateAccumulator(std::true_type) {
+        sampleAccumulator_.reset();
+        for (Size k = 0; k < sums_.size(); k++) {
+            if (weights_[k] > 0.0)
+                sampleAccumulator_.add(sums_[k]/weights_[k], 1.0);
         }
     }
 
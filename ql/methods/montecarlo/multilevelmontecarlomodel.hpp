@@ -0,0 +1,326 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelmontecarlomodel.hpp
+    \brief Multilevel Monte Carlo model
+*/
+
+#ifndef quantlib_multilevel_montecarlo_model_hpp
+#define quantlib_multilevel_montecarlo_model_hpp
+
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/statistics/statistics.hpp>
+#include <ql/methods/montecarlo/multilevelpathgenerator.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo model
+    /*! The expectation \f$ E[P_L] \f$ of the discounted payoff
+        simulated on the finest time grid is written as the
+        telescopic sum
+        \f[
+            E[P_L] = E[P_0] + \sum_{l=1}^L E[P_l - P_{l-1}]
+        \f]
+        whose terms are estimated independently; the fine and
+        coarse paths of each level are coupled as described in
+        MultilevelPathGenerator, so that the variance of the
+        differences decreases on finer levels and most of the
+        samples are taken on the cheap coarse ones.
+
+        The algorithm follows M.B. Giles, "Multilevel Monte Carlo
+        path simulation", Operations Research 56(3), 2008: starting
+        with three levels, the number of samples of each level is set
+        to the optimal
+        \f[
+            N_l = \left\lceil \frac{2}{\epsilon^2}
+                  \sqrt{\frac{V_l}{C_l}}
+                  \sum_k \sqrt{V_k C_k} \right\rceil
+        \f]
+        from the current variance estimates \f$ V_l \f$ and the
+        costs \f$ C_l \f$ per sample, so that the statistical error
+        is \f$ \epsilon/\sqrt{2} \f$; levels are then added until the
+        bias, estimated from the last two levels assuming weak order
+        \f$ \alpha \f$ of the discretization, is below
+        \f$ \epsilon/\sqrt{2} \f$ as well.
+
+        If a single level is allowed, the samples of the coarsest
+        grid are set in the same way, i.e., plain Monte Carlo is run
+        with statistical error \f$ \epsilon/\sqrt{2} \f$ and the
+        bias is not estimated; this gives the single-level cost for
+        the same root mean square error when the coarsest grid is
+        the finest one of a multilevel run.
+
+        The path pricers for the time grids of the different levels
+        are created by the given function.
+
+        \ingroup mcarlo
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MultilevelMonteCarloModel {
+      public:
+        typedef typename RNG::rsg_type rsg_type;
+        typedef MultilevelPathGenerator<rsg_type> path_generator_type;
+        typedef PathPricer<MultiPath> path_pricer_type;
+        typedef std::function<std::shared_ptr<path_pricer_type>(
+            const TimeGrid&)> path_pricer_factory;
+        typedef S stats_type;
+
+        MultilevelMonteCarloModel(std::shared_ptr<StochasticProcess> process,
+                                  TimeGrid coarsestGrid,
+                                  path_pricer_factory pathPricers,
+                                  Real weakOrder = 1.0,
+                                  bool antitheticVariate = false,
+                                  BigNatural seed = 0);
+
+        /*! adds levels and samples until the root mean square error
+            is estimated to be below the given tolerance
+        */
+        void calculate(Real tolerance,
+                       Size maxLevels = 10,
+                       Size initialSamples = 1000);
+        //! adds a level with the given number of samples
+        void addLevel(Size samples);
+        //! adds samples to the given level
+        void addSamples(Size level, Size samples);
+
+        //! multilevel estimate of the expected value
+        Real value() const;
+        //! statistical error of the estimate
+        Real errorEstimate() const;
+        //! bias of the finest level, estimated from the last two
+        Real biasEstimate() const;
+
+        Size levels() const { return levels_.size(); }
+        //! samples of \f$ P_l - P_{l-1} \f$, or of \f$ P_0 \f$ for l = 0
+        const stats_type& levelAccumulator(Size level) const;
+        //! time steps simulated per sample of the given level
+        Size costPerSample(Size level) const;
+        //! total number of time steps simulated so far
+        Real cost() const;
+
+      private:
+        struct Level {
+            std::shared_ptr<path_generator_type> generator;
+            stats_type accumulator;
+            Size costPerSample;
+        };
+
+        Real levelSample(Size level, bool antithetic, Real& weight) const;
+
+        std::shared_ptr<StochasticProcess> process_;
+        TimeGrid coarsestGrid_;
+        path_pricer_factory pathPricerFactory_;
+        Real weakOrder_;
+        bool isAntitheticVariate_;
+        BigNatural seed_;
+        MersenneTwisterUniformRng seeds_;
+        std::vector<Level> levels_;
+        // path pricers for the grids of the levels
+        std::vector<std::shared_ptr<path_pricer_type> > pathPricers_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S>
+    inline MultilevelMonteCarloModel<RNG,S>::MultilevelMonteCarloModel(
+                                  std::shared_ptr<StochasticProcess> process,
+                                  TimeGrid coarsestGrid,
+                                  path_pricer_factory pathPricers,
+                                  Real weakOrder,
+                                  bool antitheticVariate,
+                                  BigNatural seed)
+    : process_(std::move(process)), coarsestGrid_(std::move(coarsestGrid)),
+      pathPricerFactory_(std::move(pathPricers)), weakOrder_(weakOrder),
+      isAntitheticVariate_(antitheticVariate), seed_(seed), seeds_(seed) {
+        QL_REQUIRE(coarsestGrid_.size() > 1, "no times given");
+        QL_REQUIRE(weakOrder_ > 0.0, "weak order must be positive");
+    }
+
+    template <class RNG, class S>
+    inline void MultilevelMonteCarloModel<RNG,S>::addLevel(Size samples) {
+        const Size level = levels_.size();
+
+        // independent sequences for the different levels
+        const BigNatural seed = (seed_ != 0) ? seeds_.nextInt32() : 0;
+        const TimeGrid grid =
+            path_generator_type::refinedGrid(coarsestGrid_, level);
+        rsg_type rsg = RNG::make_sequence_generator(
+            process_->factors()*(grid.size()-1), seed);
+
+        Level l;
+        l.generator = std::make_shared<path_generator_type>(
+            process_, coarsestGrid_, level, rsg);
+        l.costPerSample = (grid.size()-1)
+            + (level > 0 ? (grid.size()-1)/2 : 0);
+        if (isAntitheticVariate_)
+            l.costPerSample *= 2;
+
+        pathPricers_.push_back(pathPricerFactory_(grid));
+        levels_.push_back(l);
+
+        addSamples(level, samples);
+    }
+
+    template <class RNG, class S>
+    inline Real MultilevelMonteCarloModel<RNG,S>::levelSample(
+                           Size level, bool antithetic, Real& weight) const {
+        const typename path_generator_type::sample_type& path =
+            antithetic ? levels_[level].generator->antithetic()
+                       : levels_[level].generator->next();
+        weight = path.weight;
+        Real sample = (*pathPricers_[level])(path.value.first);
+        if (level > 0)
+            sample -= (*pathPricers_[level-1])(path.value.second);
+        return sample;
+    }
+
+    template <class RNG, class S>
+    inline void MultilevelMonteCarloModel<RNG,S>::addSamples(Size level,
+                                                             Size samples) {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available");
+
+        Level& l = levels_[level];
+        Real weight, antitheticWeight;
+        for (Size j=0; j<samples; ++j) {
+            Real sample = levelSample(level, false, weight);
+            if (isAntitheticVariate_)
+                sample = 0.5*(sample
+                              + levelSample(level, true, antitheticWeight));
+            l.accumulator.add(sample, weight);
+        }
+    }
+
+    template <class RNG, class S>
+    inline void MultilevelMonteCarloModel<RNG,S>::calculate(
+                                                  Real tolerance,
+                                                  Size maxLevels,
+                                                  Size initialSamples) {
+        QL_REQUIRE(tolerance > 0.0, "tolerance must be positive");
+        QL_REQUIRE(maxLevels > 0, "at least one level required");
+        QL_REQUIRE(initialSamples > 1,
+                   "at least two initial samples required");
+
+        while (levels_.size() < std::min<Size>(3, maxLevels))
+            addLevel(initialSamples);
+
+        const Real factor = 2.0/(tolerance*tolerance);
+        for (;;) {
+            // optimal number of samples per level; the variance
+            // estimates are updated until no level needs more than
+            // one percent of additional samples
+            bool done;
+            do {
+                Real sum = 0.0;
+                for (const auto& l : levels_)
+                    sum += std::sqrt(l.accumulator.variance()*l.costPerSample);
+
+                done = true;
+                for (Size level=0; level<levels_.size(); ++level) {
+                    const Level& l = levels_[level];
+                    const Real optimal = std::ceil(
+                        factor*sum*std::sqrt(l.accumulator.variance()
+                                             / l.costPerSample));
+                    const Real current = l.accumulator.samples();
+                    if (optimal > 1.01*current) {
+                        addSamples(level, Size(optimal - current));
+                        done = false;
+                    }
+                }
+            } while (!done);
+
+            if (maxLevels == 1)
+                break;
+
+            const Real bias = biasEstimate();
+            if (bias <= tolerance*M_SQRT1_2)
+                break;
+
+            QL_REQUIRE(levels_.size() < maxLevels,
+                       "max number of levels (" << maxLevels
+                       << ") reached, while the estimated bias ("
+                       << bias << ") is still above the required "
+                       "tolerance (" << tolerance*M_SQRT1_2 << ")");
+            addLevel(initialSamples);
+        }
+    }
+
+    template <class RNG, class S>
+    inline Real MultilevelMonteCarloModel<RNG,S>::value() const {
+        Real sum = 0.0;
+        for (const auto& l : levels_)
+            sum += l.accumulator.mean();
+        return sum;
+    }
+
+    template <class RNG, class S>
+    inline Real MultilevelMonteCarloModel<RNG,S>::errorEstimate() const {
+        Real sum = 0.0;
+        for (const auto& l : levels_)
+            sum += l.accumulator.variance()/l.accumulator.samples();
+        return std::sqrt(sum);
+    }
+
+    template <class RNG, class S>
+    inline Real MultilevelMonteCarloModel<RNG,S>::biasEstimate() const {
+        QL_REQUIRE(levels_.size() > 1, "at least two levels required");
+
+        const Size L = levels_.size()-1;
+        const Real factor = std::pow(2.0, weakOrder_);
+
+        Real bias = std::fabs(levels_[L].accumulator.mean());
+        if (L > 1)
+            bias = std::max(bias,
+                            std::fabs(levels_[L-1].accumulator.mean())/factor);
+        return bias/(factor-1.0);
+    }
+
+    template <class RNG, class S>
+    inline const typename MultilevelMonteCarloModel<RNG,S>::stats_type&
+    MultilevelMonteCarloModel<RNG,S>::levelAccumulator(Size level) const {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available");
+        return levels_[level].accumulator;
+    }
+
+    template <class RNG, class S>
+    inline Size
+    MultilevelMonteCarloModel<RNG,S>::costPerSample(Size level) const {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available");
+        return levels_[level].costPerSample;
+    }
+
+    template <class RNG, class S>
+    inline Real MultilevelMonteCarloModel<RNG,S>::cost() const {
+        Real sum = 0.0;
+        for (const auto& l : levels_)
+            sum += Real(l.costPerSample)*l.accumulator.samples();
+        return sum;
+    }
+
+}
+
+#endif
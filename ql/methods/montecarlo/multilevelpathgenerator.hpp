@@ -0,0 +1,206 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelpathgenerator.hpp
+    \brief Generates coupled fine and coarse paths for multilevel Monte Carlo
+*/
+
+#ifndef quantlib_multilevel_path_generator_hpp
+#define quantlib_multilevel_path_generator_hpp
+
+#include <ql/mathconstants.hpp>
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/stochasticprocess.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Generates coupled fine and coarse paths for multilevel Monte Carlo
+    /*! The time grid of level \f$ l \f$ is obtained by bisecting
+        \f$ l \f$ times all the steps of the given coarsest grid.
+        The fine path is simulated on the grid of the level, the
+        coarse one on the grid of the previous level; the Gaussian
+        increment of each coarse step is the normalized sum
+        \f$ (\Delta w_{2i} + \Delta w_{2i+1})/\sqrt{2} \f$ of those
+        of the two fine steps it contains, so that both paths are
+        driven by the same Brownian motion. On level 0 only the fine
+        path is simulated.
+
+        GSG must generate \f$ n_f \times n_s \f$ Gaussian variates,
+        where \f$ n_f \f$ is the number of factors of the process and
+        \f$ n_s \f$ the number of steps of the fine grid.
+
+        \warning the generator must be rebuilt when the process
+                 changes.
+
+        \ingroup mcarlo
+    */
+    template <class GSG>
+    class MultilevelPathGenerator {
+      public:
+        //! fine and coarse path
+        typedef Sample<std::pair<MultiPath, MultiPath> > sample_type;
+        MultilevelPathGenerator(
+                          const std::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& coarsestGrid,
+                          Size level,
+                          GSG generator);
+        const sample_type& next() const;
+        const sample_type& antithetic() const;
+        Size level() const { return level_; }
+        //! time grid of the fine paths
+        const TimeGrid& timeGrid() const { return fineGrid_; }
+        //! grid obtained by bisecting the steps of the given one
+        static TimeGrid refinedGrid(const TimeGrid& grid, Size level);
+      private:
+        const sample_type& next(bool antithetic) const;
+        std::shared_ptr<StochasticProcess> process_;
+        Size level_;
+        TimeGrid fineGrid_, coarseGrid_;
+        GSG generator_;
+        mutable sample_type next_;
+        std::shared_ptr<StochasticProcess::StepEvolver> fineEvolver_,
+                                                        coarseEvolver_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    MultilevelPathGenerator<GSG>::MultilevelPathGenerator(
+                          const std::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& coarsestGrid,
+                          Size level,
+                          GSG generator)
+    : process_(process), level_(level),
+      fineGrid_(refinedGrid(coarsestGrid, level)),
+      coarseGrid_(level > 0 ? refinedGrid(coarsestGrid, level-1)
+                            : TimeGrid()),
+      generator_(std::move(generator)),
+      next_(std::make_pair(MultiPath(process->size(), fineGrid_),
+                           level > 0
+                               ? MultiPath(process->size(), coarseGrid_)
+                               : MultiPath()), 1.0),
+      fineEvolver_(process->stepEvolver(fineGrid_)),
+      coarseEvolver_(level > 0 ? process->stepEvolver(coarseGrid_)
+                               : std::shared_ptr<StochasticProcess::StepEvolver>()) {
+
+        QL_REQUIRE(generator_.dimension() ==
+                   process->factors()*(fineGrid_.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << process->factors() << " * " << fineGrid_.size()-1
+                   << ") the number of factors "
+                   << "times the number of time steps");
+    }
+
+    template <class GSG>
+    TimeGrid MultilevelPathGenerator<GSG>::refinedGrid(const TimeGrid& grid,
+                                                       Size level) {
+        QL_REQUIRE(grid.size() > 1, "no times given");
+
+        std::vector<Time> times(grid.begin(), grid.end());
+        for (Size l=0; l<level; ++l) {
+            std::vector<Time> refined;
+            refined.reserve(2*times.size()-1);
+            refined.push_back(times.front());
+            for (Size i=1; i<times.size(); ++i) {
+                refined.push_back(0.5*(times[i-1]+times[i]));
+                refined.push_back(times[i]);
+            }
+            times.swap(refined);
+        }
+        return TimeGrid(times.begin(), times.end());
+    }
+
+    template <class GSG>
+    inline const typename MultilevelPathGenerator<GSG>::sample_type&
+    MultilevelPathGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const typename MultilevelPathGenerator<GSG>::sample_type&
+    MultilevelPathGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const typename MultilevelPathGenerator<GSG>::sample_type&
+    MultilevelPathGenerator<GSG>::next(bool antithetic) const {
+
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence_ =
+            antithetic ? generator_.lastSequence()
+                       : generator_.nextSequence();
+        const Real sign = antithetic ? -1.0 : 1.0;
+
+        const Size m = process_->size();
+        const Size n = process_->factors();
+        const Array x0 = process_->initialValues();
+        Array temp(n);
+
+        next_.weight = sequence_.weight;
+
+        MultiPath& fine = next_.value.first;
+        Array asset = x0;
+        for (Size j=0; j<m; j++)
+            fine[j].front() = asset[j];
+
+        for (Size i=1; i<fine.pathSize(); i++) {
+            const Size offset = (i-1)*n;
+            for (Size k=0; k<n; k++)
+                temp[k] = sign*sequence_.value[offset+k];
+
+            asset = fineEvolver_
+                ? fineEvolver_->evolve(i-1, asset, temp)
+                : process_->evolve(fineGrid_[i-1], asset,
+                                   fineGrid_.dt(i-1), temp);
+            for (Size j=0; j<m; j++)
+                fine[j][i] = asset[j];
+        }
+
+        if (level_ > 0) {
+            MultiPath& coarse = next_.value.second;
+            asset = x0;
+            for (Size j=0; j<m; j++)
+                coarse[j].front() = asset[j];
+
+            for (Size i=1; i<coarse.pathSize(); i++) {
+                // each coarse step contains two fine steps
+                const Size offset = 2*(i-1)*n;
+                for (Size k=0; k<n; k++)
+                    temp[k] = sign*M_SQRT1_2
+                        * (sequence_.value[offset+k]
+                           + sequence_.value[offset+n+k]);
+
+                asset = coarseEvolver_
+                    ? coarseEvolver_->evolve(i-1, asset, temp)
+                    : process_->evolve(coarseGrid_[i-1], asset,
+                                       coarseGrid_.dt(i-1), temp);
+                for (Size j=0; j<m; j++)
+                    coarse[j][i] = asset[j];
+            }
+        }
+
+        return next_;
+    }
+
+}
+
+#endif
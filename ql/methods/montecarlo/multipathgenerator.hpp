@@ -43,6 +43,13 @@ namespace QuantLib {
         };
         \endcode
 
+        If the process provides a step evolver for the time grid, see
+        StochasticProcess::stepEvolver, it is built together with the
+        generator and used instead of evolving the process directly.
+
+        \warning the generator must be rebuilt when the process
+                 changes.
+
         \ingroup mcarlo
 
         \test the generated paths are checked against cached results
@@ -63,6 +70,7 @@ namespace QuantLib {
         std::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        std::shared_ptr<StochasticProcess::StepEvolver> evolver_;
     };
 
 
@@ -74,7 +82,8 @@ namespace QuantLib {
                                                 GSG generator,
                                                 bool brownianBridge)
     : brownianBridge_(brownianBridge), process_(process), generator_(std::move(generator)),
-      next_(MultiPath(process->size(), times), 1.0) {
+      next_(MultiPath(process->size(), times), 1.0),
+      evolver_(process->stepEvolver(times)) {
 
         QL_REQUIRE(generator_.dimension() ==
                    process->factors()*(times.size()-1),
@@ -142,7 +151,8 @@ namespace QuantLib {
                               sequence_.value.begin()+offset+n,
                               temp.begin());
 
-                asset = process_->evolve(t, asset, dt, temp);
+                asset = evolver_ ? evolver_->evolve(i-1, asset, temp)
+                                 : process_->evolve(t, asset, dt, temp);
                 for (Size j=0; j<m; j++)
                     path[j][i] = asset[j];
             }
@@ -0,0 +1,128 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathblock.hpp
+    \brief blocks of single- and multi-factor random walks
+*/
+
+#ifndef quantlib_montecarlo_path_block_hpp
+#define quantlib_montecarlo_path_block_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! block of single-factor random walks
+    /*! The values are stored by time point, i.e., block[i] points to
+        the values of all the paths at the \f$ i \f$-th time point
+        and block[i][j] is the value of the \f$ j \f$-th path. Loops
+        over the paths of the block thus run over contiguous memory.
+
+        \ingroup mcarlo
+
+        \note the paths include the initial asset value as their
+              first point.
+    */
+    class PathBlock {
+      public:
+        PathBlock(TimeGrid timeGrid, Size paths);
+        //! \name inspectors
+        //@{
+        Size length() const { return timeGrid_.size(); }
+        //! number of paths
+        Size size() const { return values_.columns(); }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //! values of all the paths at the \f$ i \f$-th point
+        Matrix::const_row_iterator operator[](Size i) const {
+            return values_.row_begin(i);
+        }
+        Matrix::row_iterator operator[](Size i) { return values_.row_begin(i); }
+        //! values of all the paths, one row per time point
+        const Matrix& values() const { return values_; }
+        //! copy of the \f$ j \f$-th path
+        Path path(Size j) const;
+        //@}
+      private:
+        TimeGrid timeGrid_;
+        Matrix values_;
+    };
+
+
+    //! block of correlated multiple asset paths
+    /*! block[k] is the block of the paths followed by the
+        \f$ k \f$-th asset.
+
+        \ingroup mcarlo
+    */
+    class MultiPathBlock {
+      public:
+        MultiPathBlock(Size nAsset, const TimeGrid& timeGrid, Size paths);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return blocks_.size(); }
+        Size pathSize() const { return blocks_[0].length(); }
+        //! number of paths
+        Size size() const { return blocks_[0].size(); }
+        //@}
+        //! \name read/write access to components
+        //@{
+        const PathBlock& operator[](Size k) const { return blocks_[k]; }
+        PathBlock& operator[](Size k) { return blocks_[k]; }
+        //@}
+        //! copy of the \f$ j \f$-th multi-path
+        MultiPath multiPath(Size j) const;
+      private:
+        std::vector<PathBlock> blocks_;
+    };
+
+
+    // inline definitions
+
+    inline PathBlock::PathBlock(TimeGrid timeGrid, Size paths)
+    : timeGrid_(std::move(timeGrid)), values_(timeGrid_.size(), paths) {
+        QL_REQUIRE(paths > 0, "number of paths must be positive");
+    }
+
+    inline Path PathBlock::path(Size j) const {
+        QL_REQUIRE(j < size(), "path index out of range");
+        Path path(timeGrid_);
+        for (Size i=0; i<length(); ++i)
+            path[i] = values_[i][j];
+        return path;
+    }
+
+    inline MultiPathBlock::MultiPathBlock(Size nAsset,
+                                          const TimeGrid& timeGrid,
+                                          Size paths)
+    : blocks_(nAsset, PathBlock(timeGrid, paths)) {
+        QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+    }
+
+    inline MultiPath MultiPathBlock::multiPath(Size j) const {
+        std::vector<Path> paths;
+        paths.reserve(blocks_.size());
+        for (const auto& block : blocks_)
+            paths.push_back(block.path(j));
+        return MultiPath(std::move(paths));
+    }
+
+}
+
+
+#endif
@@ -0,0 +1,328 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathblockgenerator.hpp
+    \brief Generates blocks of random paths using a sequence generator
+*/
+
+#ifndef quantlib_montecarlo_path_block_generator_hpp
+#define quantlib_montecarlo_path_block_generator_hpp
+
+#include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
+#include <ql/stochasticprocess.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Generates blocks of random paths using a sequence generator
+    /*! The paths of a block are generated from consecutive sequences
+        of the generator, so that the \f$ j \f$-th path of a block is
+        the one that PathGenerator would return for the \f$ j \f$-th
+        sequence. The Brownian bridge and the evolution of the
+        process are then carried out for all the paths of the block
+        one time step at a time. As in PathGenerator, the step
+        coefficients of the process are used if available, reducing
+        the evolution to a multiply-add and a call to apply() per
+        path and step.
+
+        \warning the weights of the sequences are not stored; the
+                 generator is meant to be used with sequence generators
+                 returning samples of unit weight.
+
+        \ingroup mcarlo
+
+        \test the generated paths are checked against PathGenerator
+    */
+    template <class GSG>
+    class PathBlockGenerator {
+      public:
+        typedef PathBlock sample_type;
+        PathBlockGenerator(const std::shared_ptr<StochasticProcess>&,
+                           TimeGrid timeGrid,
+                           GSG generator,
+                           bool brownianBridge,
+                           Size blockSize);
+        //! \name inspectors
+        //@{
+        const PathBlock& next() const;
+        //! antithetic paths of the last block
+        const PathBlock& antithetic() const;
+        Size size() const { return dimension_; }
+        Size blockSize() const { return blockSize_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+      private:
+        const PathBlock& next(bool antithetic) const;
+        bool brownianBridge_;
+        GSG generator_;
+        Size dimension_, blockSize_;
+        TimeGrid timeGrid_;
+        std::shared_ptr<StochasticProcess1D> process_;
+        mutable PathBlock next_;
+        mutable Matrix sequences_, variates_;
+        BrownianBridge bb_;
+        Array drift_, diffusion_;
+        bool hasCoefficients_;
+    };
+
+
+    //! Generates blocks of multi-asset paths using a sequence generator
+    /*! The paths of a block are generated from consecutive sequences
+        of the generator, so that the \f$ j \f$-th multi-path of a
+        block is the one that MultiPathGenerator would return for the
+        \f$ j \f$-th sequence. The paths are evolved one time step at
+        a time across the whole block, in preallocated buffers, by
+        StochasticProcess::StepEvolver::evolveBlock() if the process
+        provides a step evolver and path by path otherwise.
+
+        If the Brownian bridge is used, the sequence elements
+        \f$ i n + l \f$ for the \f$ n \f$ factors \f$ l \f$ are taken as
+        the \f$ i \f$-th bridge variates of the \f$ l \f$-th factor, so
+        that the first dimensions of a low-discrepancy sequence
+        determine the terminal values of all factors. Without the
+        bridge, they are the variates of the \f$ i \f$-th step, as in
+        MultiPathGenerator, which doesn't support the bridge.
+
+        \warning the weights of the sequences are not stored; the
+                 generator is meant to be used with sequence generators
+                 returning samples of unit weight.
+
+        \ingroup mcarlo
+
+        \test the generated paths are checked against MultiPathGenerator
+    */
+    template <class GSG>
+    class MultiPathBlockGenerator {
+      public:
+        typedef MultiPathBlock sample_type;
+        MultiPathBlockGenerator(const std::shared_ptr<StochasticProcess>&,
+                                const TimeGrid&,
+                                GSG generator,
+                                Size blockSize,
+                                bool brownianBridge = false);
+        const MultiPathBlock& next() const;
+        //! antithetic paths of the last block
+        const MultiPathBlock& antithetic() const;
+        Size blockSize() const { return blockSize_; }
+      private:
+        const MultiPathBlock& next(bool antithetic) const;
+        std::shared_ptr<StochasticProcess> process_;
+        GSG generator_;
+        Size blockSize_;
+        TimeGrid timeGrid_;
+        mutable MultiPathBlock next_;
+        mutable Matrix sequences_, state_, variates_;
+        std::shared_ptr<StochasticProcess::StepEvolver> evolver_;
+        bool brownianBridge_;
+        BrownianBridge bb_;
+        mutable Matrix bridgeInput_, bridgeOutput_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    PathBlockGenerator<GSG>::PathBlockGenerator(
+                            const std::shared_ptr<StochasticProcess>& process,
+                            TimeGrid timeGrid,
+                            GSG generator,
+                            bool brownianBridge,
+                            Size blockSize)
+    : brownianBridge_(brownianBridge), generator_(std::move(generator)),
+      dimension_(generator_.dimension()), blockSize_(blockSize),
+      timeGrid_(std::move(timeGrid)),
+      process_(std::dynamic_pointer_cast<StochasticProcess1D>(process)),
+      next_(timeGrid_, blockSize_), sequences_(dimension_, blockSize_),
+      bb_(timeGrid_), hasCoefficients_(false) {
+        QL_REQUIRE(process_, "1-D stochastic process required");
+        hasCoefficients_ =
+            process_->stepCoefficients(timeGrid_, drift_, diffusion_);
+        QL_REQUIRE(dimension_==timeGrid_.size()-1,
+                   "sequence generator dimensionality (" << dimension_
+                   << ") != timeSteps (" << timeGrid_.size()-1 << ")");
+    }
+
+    template <class GSG>
+    const PathBlock& PathBlockGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    const PathBlock& PathBlockGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const PathBlock& PathBlockGenerator<GSG>::next(bool antithetic) const {
+
+        if (!antithetic) {
+            // draw the sequences path by path, store them step by step
+            for (Size j=0; j<blockSize_; ++j) {
+                const auto& sequence = generator_.nextSequence().value;
+                for (Size i=0; i<dimension_; ++i)
+                    sequences_[i][j] = sequence[i];
+            }
+
+            if (brownianBridge_)
+                bb_.transform(sequences_, variates_);
+            else
+                variates_ = sequences_;
+        }
+
+        const Real sign = antithetic ? -1.0 : 1.0;
+
+        std::fill(next_[0], next_[0] + blockSize_, process_->x0());
+        for (Size i=1; i<timeGrid_.size(); ++i) {
+            const Time t = timeGrid_[i-1];
+            const Time dt = timeGrid_.dt(i-1);
+            const Real* dw = variates_.row_begin(i-1);
+            const Real* x = next_[i-1];
+            Real* y = next_[i];
+            if (hasCoefficients_) {
+                const Real a = drift_[i-1], b = sign*diffusion_[i-1];
+                for (Size j=0; j<blockSize_; ++j)
+                    y[j] = process_->apply(x[j], b*dw[j] + a);
+            } else {
+                for (Size j=0; j<blockSize_; ++j)
+                    y[j] = process_->evolve(t, x[j], dt, sign*dw[j]);
+            }
+        }
+
+        return next_;
+    }
+
+
+    template <class GSG>
+    MultiPathBlockGenerator<GSG>::MultiPathBlockGenerator(
+                            const std::shared_ptr<StochasticProcess>& process,
+                            const TimeGrid& times,
+                            GSG generator,
+                            Size blockSize,
+                            bool brownianBridge)
+    : process_(process), generator_(std::move(generator)),
+      blockSize_(blockSize), timeGrid_(times),
+      next_(process->size(), times, blockSize),
+      sequences_(generator_.dimension(), blockSize),
+      state_(process->size(), blockSize),
+      variates_(process->factors(), blockSize),
+      evolver_(process->stepEvolver(times)),
+      brownianBridge_(brownianBridge), bb_(times),
+      bridgeInput_(times.size()-1, blockSize),
+      bridgeOutput_(times.size()-1, blockSize) {
+
+        QL_REQUIRE(generator_.dimension() ==
+                   process->factors()*(times.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << process->factors() << " * " << times.size()-1
+                   << ") the number of factors "
+                   << "times the number of time steps");
+        QL_REQUIRE(times.size() > 1,
+                   "no times given");
+    }
+
+    template <class GSG>
+    inline const MultiPathBlock& MultiPathBlockGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const MultiPathBlock&
+    MultiPathBlockGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const MultiPathBlock&
+    MultiPathBlockGenerator<GSG>::next(bool antithetic) const {
+
+        const Size dimension = sequences_.rows();
+        if (!antithetic) {
+            for (Size j=0; j<blockSize_; ++j) {
+                const auto& sequence = generator_.nextSequence().value;
+                for (Size i=0; i<dimension; ++i)
+                    sequences_[i][j] = sequence[i];
+            }
+
+            if (brownianBridge_) {
+                // the bridge is linear, the antithetic paths can
+                // reuse the transformed sequences
+                const Size n = process_->factors();
+                const Size steps = timeGrid_.size()-1;
+                for (Size l=0; l<n; ++l) {
+                    for (Size i=0; i<steps; ++i)
+                        std::copy(sequences_.row_begin(i*n+l),
+                                  sequences_.row_end(i*n+l),
+                                  bridgeInput_.row_begin(i));
+                    bb_.transform(bridgeInput_, bridgeOutput_);
+                    for (Size i=0; i<steps; ++i)
+                        std::copy(bridgeOutput_.row_begin(i),
+                                  bridgeOutput_.row_end(i),
+                                  sequences_.row_begin(i*n+l));
+                }
+            }
+        }
+
+        const Size m = process_->size();
+        const Size n = process_->factors();
+        const Real sign = antithetic ? -1.0 : 1.0;
+
+        const Array x0 = process_->initialValues();
+        for (Size k=0; k<m; ++k) {
+            std::fill(state_.row_begin(k), state_.row_end(k), x0[k]);
+            std::copy(state_.row_begin(k), state_.row_end(k), next_[k][0]);
+        }
+
+        Array asset(m), temp(n);
+        for (Size i=1; i<timeGrid_.size(); ++i) {
+            const Size offset = (i-1)*n;
+            for (Size l=0; l<n; ++l)
+                std::transform(sequences_.row_begin(offset+l),
+                               sequences_.row_end(offset+l),
+                               variates_.row_begin(l),
+                               [sign](Real w) { return sign*w; });
+
+            if (evolver_ != nullptr) {
+                evolver_->evolveBlock(i-1, state_, variates_);
+            } else {
+                const Time t = timeGrid_[i-1];
+                const Time dt = timeGrid_.dt(i-1);
+                for (Size j=0; j<blockSize_; ++j) {
+                    for (Size k=0; k<m; ++k)
+                        asset[k] = state_[k][j];
+                    for (Size l=0; l<n; ++l)
+                        temp[l] = variates_[l][j];
+                    asset = process_->evolve(t, asset, dt, temp);
+                    for (Size k=0; k<m; ++k)
+                        state_[k][j] = asset[k];
+                }
+            }
+
+            for (Size k=0; k<m; ++k)
+                std::copy(state_.row_begin(k), state_.row_end(k),
+                          next_[k][i]);
+        }
+
+        return next_;
+    }
+
+}
+
+
+#endif
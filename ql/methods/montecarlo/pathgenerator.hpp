@@ -37,6 +37,14 @@ namespace QuantLib {
     /*! Generates random paths with drift(S,t) and variance(S,t)
         using a gaussian sequence generator
 
+        If the process provides step coefficients for the time grid,
+        see StochasticProcess1D::stepCoefficients, they are computed
+        when the generator is built and used instead of evolving the
+        process at each step.
+
+        \warning the generator must be rebuilt when the process
+                 changes.
+
         \ingroup mcarlo
 
         \test the generated paths are checked against cached results
@@ -72,6 +80,8 @@ namespace QuantLib {
         mutable sample_type next_;
         mutable std::vector<Real> temp_;
         BrownianBridge bb_;
+        Array drift_, diffusion_;
+        bool hasCoefficients_;
     };
 
 
@@ -86,7 +96,10 @@ namespace QuantLib {
     : brownianBridge_(brownianBridge), generator_(std::move(generator)),
       dimension_(generator_.dimension()), timeGrid_(length, timeSteps),
       process_(std::dynamic_pointer_cast<StochasticProcess1D>(process)),
-      next_(Path(timeGrid_), 1.0), temp_(dimension_), bb_(timeGrid_) {
+      next_(Path(timeGrid_), 1.0), temp_(dimension_), bb_(timeGrid_),
+      hasCoefficients_(process_ != nullptr &&
+                       process_->stepCoefficients(timeGrid_, drift_,
+                                                  diffusion_)) {
         QL_REQUIRE(dimension_==timeSteps,
                    "sequence generator dimensionality (" << dimension_
                    << ") != timeSteps (" << timeSteps << ")");
@@ -100,7 +113,10 @@ namespace QuantLib {
     : brownianBridge_(brownianBridge), generator_(std::move(generator)),
       dimension_(generator_.dimension()), timeGrid_(std::move(timeGrid)),
       process_(std::dynamic_pointer_cast<StochasticProcess1D>(process)),
-      next_(Path(timeGrid_), 1.0), temp_(dimension_), bb_(timeGrid_) {
+      next_(Path(timeGrid_), 1.0), temp_(dimension_), bb_(timeGrid_),
+      hasCoefficients_(process_ != nullptr &&
+                       process_->stepCoefficients(timeGrid_, drift_,
+                                                  diffusion_)) {
         QL_REQUIRE(dimension_==timeGrid_.size()-1,
                    "sequence generator dimensionality (" << dimension_
                    << ") != timeSteps (" << timeGrid_.size()-1 << ")");
@@ -143,11 +159,15 @@ namespace QuantLib {
         path.front() = process_->x0();
 
         for (Size i=1; i<path.length(); i++) {
-            Time t = timeGrid_[i-1];
-            Time dt = timeGrid_.dt(i-1);
-            path[i] = process_->evolve(t, path[i-1], dt,
-                                       antithetic ? -temp_[i-1] :
-                                                     temp_[i-1]);
+            const Real dw = antithetic ? -temp_[i-1] : temp_[i-1];
+            if (hasCoefficients_) {
+                path[i] = process_->apply(path[i-1],
+                                          diffusion_[i-1]*dw + drift_[i-1]);
+            } else {
+                Time t = timeGrid_[i-1];
+                Time dt = timeGrid_.dt(i-1);
+                path[i] = process_->evolve(t, path[i-1], dt, dw);
+            }
         }
 
         return next_;
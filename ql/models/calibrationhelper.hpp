@@ -25,6 +25,7 @@
 #ifndef quantlib_interest_rate_modelling_calibration_helper_h
 #define quantlib_interest_rate_modelling_calibration_helper_h
 
+#include <ql/math/array.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
@@ -42,6 +43,11 @@ namespace QuantLib {
         virtual ~CalibrationHelper() = default;
         //! returns the error resulting from the model valuation
         virtual Real calibrationError() = 0;
+        /*! returns the derivatives of the calibration error with
+            respect to the model parameters, or an empty array if
+            they are not available analytically.
+        */
+        virtual Array calibrationErrorGradient() { return Array(); }
     };
 
     //! liquid Black76 market instrument used during calibration
@@ -75,8 +81,15 @@ namespace QuantLib {
         //! returns the price of the instrument according to the model
         virtual Real modelValue() const = 0;
 
+        /*! returns the derivatives of the model price with respect to
+            the model parameters, or an empty array if the pricing
+            engine doesn't provide them.
+        */
+        virtual Array modelValueGradient() const { return Array(); }
+
         //! returns the error resulting from the model valuation
         Real calibrationError() override;
+        Array calibrationErrorGradient() override;
 
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
@@ -93,6 +106,9 @@ namespace QuantLib {
         void setPricingEngine(const std::shared_ptr<PricingEngine>& engine) {
             engine_ = engine;
         }
+        const std::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
 
       protected:
         mutable Real marketValue_;
@@ -103,6 +119,12 @@ namespace QuantLib {
 
       private:
         class ImpliedVolatilityHelper;
+        /*! Black volatility implied by the given model price; it is
+            floored and capped if the price is outside the range of
+            Black prices.
+        */
+        Volatility modelImpliedVolatility(Real modelPrice,
+                                          bool& bounded) const;
         const CalibrationErrorType calibrationErrorType_;
     };
 
@@ -23,8 +23,10 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <typeinfo>
 #include <utility>
 
 
@@ -83,6 +85,26 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    Array HestonModelHelper::modelValueGradient() const {
+        calculate();
+        Array gradient;
+        // derived engines add terms to the characteristic function
+        // which are not part of the analytic gradient
+        if (engine_ != nullptr
+            && typeid(*engine_) == typeid(AnalyticHestonEngine)) {
+            const auto engine =
+                std::static_pointer_cast<AnalyticHestonEngine>(engine_);
+            if (engine->integration().isGaussianQuadrature()) {
+                const auto payoff =
+                    std::dynamic_pointer_cast<PlainVanillaPayoff>(
+                        option_->payoff());
+                QL_REQUIRE(payoff, "plain-vanilla payoff required");
+                engine->priceAndGradient(*payoff, exerciseDate_, gradient);
+            }
+        }
+        return gradient;
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
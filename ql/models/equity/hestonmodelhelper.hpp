@@ -56,6 +56,11 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const override {}
         void performCalculations() const override;
         Real modelValue() const override;
+        /*! available if the pricing engine is an
+            AnalyticHestonEngine using a Gaussian quadrature; derived
+            engines, e.g. for the Bates model, are not supported.
+        */
+        Array modelValueGradient() const override;
         Real blackPrice(Real volatility) const override;
         Time maturity() const  { calculate(); return tau_; }
       private:
@@ -205,6 +205,10 @@ namespace QuantLib {
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    void SobolBrownianGenerator::skipTo(Size n) {
+        generator_.skipTo(n);
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
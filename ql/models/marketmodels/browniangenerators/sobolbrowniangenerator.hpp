@@ -60,6 +60,9 @@ namespace QuantLib {
         Size numberOfFactors() const override;
         Size numberOfSteps() const override;
 
+        //! skip to the n-th path
+        void skipTo(Size n);
+
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
         std::vector<std::vector<Real> > transform(
@@ -23,7 +23,14 @@
 #include <ql/math/optimization/projection.hpp>
 #include <ql/models/model.hpp>
 #include <ql/utilities/null_deleter.hpp>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <set>
 #include <utility>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using std::vector;
 
@@ -37,28 +44,55 @@ namespace QuantLib {
         CalibrationFunction(CalibratedModel* model,
                             const vector<std::shared_ptr<CalibrationHelper> >& h,
                             vector<Real> weights,
-                            const Projection& projection)
+                            const Projection& projection,
+                            Size threads = 1,
+                            CalibrationDiagnostics* diagnostics = nullptr)
         : model_(model, null_deleter()), instruments_(h), weights_(std::move(weights)),
-          projection_(projection) {}
+          projection_(projection), threads_(threads), diagnostics_(diagnostics) {}
 
         ~CalibrationFunction() override = default;
 
         Real value(const Array& params) const override {
-            model_->setParams(projection_.include(params));
+            Array errors = calibrationErrors(params);
             Real value = 0.0;
-            for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
-            }
+            for (Size i=0; i<instruments_.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
             return std::sqrt(value);
         }
 
         Array values(const Array& params) const override {
-            model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
-            for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+            Array values = calibrationErrors(params);
+            for (Size i=0; i<instruments_.size(); i++)
+                values[i] *= std::sqrt(weights_[i]);
+            return values;
+        }
+
+        void gradient(Array& grad, const Array& params) const override {
+            Matrix jac(instruments_.size(), params.size());
+            Array values;
+            if (!analyticJacobian(jac, values, params)) {
+                CostFunction::gradient(grad, params);
+                return;
+            }
+            // value = sqrt(sum_i values_i^2)
+            const Real value = std::sqrt(DotProduct(values, values));
+            grad = (value > 0.0)
+                ? Array(transpose(jac)*values/value)
+                : Array(params.size(), 0.0);
+        }
+
+        void jacobian(Matrix& jac, const Array& params) const override {
+            Array values;
+            if (!analyticJacobian(jac, values, params))
+                CostFunction::jacobian(jac, params);
+        }
+
+        Array valuesAndJacobian(Matrix& jac,
+                                const Array& params) const override {
+            Array values;
+            if (!analyticJacobian(jac, values, params)) {
+                CostFunction::jacobian(jac, params);
+                values = this->values(params);
             }
             return values;
         }
@@ -66,10 +100,87 @@ namespace QuantLib {
         Real finiteDifferenceEpsilon() const override { return 1e-6; }
 
       private:
+        // calls f(i) for every helper, in parallel if requested
+        template <class F>
+        void forEachHelper(const F& f) const {
+            const Size n = instruments_.size();
+
+            // the first helper is priced alone so that lazy objects
+            // shared by all of them, e.g. term structures, are
+            // calculated before the parallel loop
+            f(0);
+
+            vector<std::exception_ptr> failures(n);
+            #pragma omp parallel for schedule(dynamic) num_threads(int(threads_)) if(threads_ > 1)
+            for (long i=1; i<long(n); ++i) {
+                try {
+                    f(Size(i));
+                } catch (...) {
+                    failures[i] = std::current_exception();
+                }
+            }
+            for (const auto& failure : failures)
+                if (failure)
+                    std::rethrow_exception(failure);
+        }
+
+        /* returns false if any of the helpers doesn't provide the
+           derivatives of its calibration error; in this case, the
+           helpers are not asked again. */
+        bool analyticJacobian(Matrix& jac, Array& values,
+                              const Array& params) const {
+            if (!analyticJacobianAvailable_)
+                return false;
+
+            values = calibrationErrors(params);
+
+            const Size nParams = model_->params().size();
+            vector<Array> gradients(instruments_.size());
+            forEachHelper([&](Size i) {
+                gradients[i] = instruments_[i]->calibrationErrorGradient();
+            });
+
+            for (Size i=0; i<instruments_.size(); ++i) {
+                if (gradients[i].size() != nParams) {
+                    analyticJacobianAvailable_ = false;
+                    return false;
+                }
+                const Array row = projection_.project(gradients[i]);
+                const Real w = std::sqrt(weights_[i]);
+                std::transform(row.begin(), row.end(), jac.row_begin(i),
+                               [=](Real x) -> Real { return w*x; });
+                values[i] *= w;
+            }
+            return true;
+        }
+
+        Array calibrationErrors(const Array& params) const {
+            const auto start = std::chrono::steady_clock::now();
+
+            model_->setParams(projection_.include(params));
+            Array errors(instruments_.size());
+            forEachHelper([&](Size i) {
+                errors[i] = instruments_[i]->calibrationError();
+            });
+
+            if (diagnostics_ != nullptr) {
+                const Real elapsed = std::chrono::duration<Real>(
+                    std::chrono::steady_clock::now() - start).count();
+                ++diagnostics_->evaluations;
+                diagnostics_->totalTime += elapsed;
+                diagnostics_->evaluationTimes.push_back(elapsed);
+            }
+
+            return errors;
+        }
+
         std::shared_ptr<CalibratedModel> model_;
         const vector<std::shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        Size threads_;
+        CalibrationDiagnostics* diagnostics_;
+        mutable bool analyticJacobianAvailable_ = true;
     };
 
     void CalibratedModel::calibrate(
@@ -102,7 +213,29 @@ namespace QuantLib {
                    fixParameters.size() << ")");
         vector<bool> all(prms.size(), false);
         Projection proj(prms, !fixParameters.empty() ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+
+        Size threads = 1;
+        #ifdef _OPENMP
+        threads = std::min<Size>(calibrationThreads_, instruments.size());
+        #endif
+        if (threads > 1) {
+            std::set<const PricingEngine*> engines;
+            for (const auto& instrument : instruments) {
+                auto helper =
+                    std::dynamic_pointer_cast<BlackCalibrationHelper>(instrument);
+                if (helper != nullptr && helper->pricingEngine() != nullptr) {
+                    QL_REQUIRE(engines.insert(helper->pricingEngine().get()).second,
+                               "calibration helpers share a pricing engine; "
+                               "each helper needs its own engine for "
+                               "parallel calibration");
+                }
+            }
+        }
+
+        calibrationDiagnostics_ = CalibrationDiagnostics();
+        calibrationDiagnostics_.threads = threads;
+        CalibrationFunction f(this, instruments, w, proj, threads,
+                              &calibrationDiagnostics_);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
@@ -114,6 +247,11 @@ namespace QuantLib {
         notifyObservers();
     }
 
+    void CalibratedModel::setCalibrationThreads(Size threads) {
+        QL_REQUIRE(threads > 0, "at least one thread is needed");
+        calibrationThreads_ = threads;
+    }
+
     Real CalibratedModel::value(
                 const Array& params,
                 const vector<std::shared_ptr<CalibrationHelper> >& instruments) {
@@ -85,6 +85,16 @@ namespace QuantLib {
     //! Calibrated model class
     class CalibratedModel : public virtual Observer, public virtual Observable {
       public:
+        //! timing of the cost-function evaluations of the last calibration
+        struct CalibrationDiagnostics {
+            Size evaluations = 0;
+            //! number of threads used for repricing the helpers
+            Size threads = 1;
+            //! wall-clock times in seconds
+            Real totalTime = 0.0;
+            std::vector<Real> evaluationTimes;
+        };
+
         CalibratedModel(Size nArguments);
 
         void update() override {
@@ -95,6 +105,12 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (usually caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If all helpers provide the derivatives of their
+            calibration errors, the gradient and the Jacobian of the
+            cost function are calculated from them instead of by
+            finite differences; e.g., LevenbergMarquardt uses them if
+            constructed with useCostFunctionsJacobian = true.
         */
         virtual void calibrate(
                 const std::vector<std::shared_ptr<CalibrationHelper> >&,
@@ -121,6 +137,24 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        /*! Sets the number of threads used to reprice the calibration
+            helpers at each evaluation of the cost function. It is
+            ignored if OpenMP is not enabled.
+
+            \warning the helpers are priced concurrently, hence each
+                     of them must have its own pricing engine and the
+                     engines must not modify shared state apart from
+                     the lazy objects calculated by the first helper,
+                     which is priced before the others.
+        */
+        void setCalibrationThreads(Size threads);
+        Size calibrationThreads() const { return calibrationThreads_; }
+
+        //! Returns timing diagnostics of the last calibration
+        const CalibrationDiagnostics& calibrationDiagnostics() const {
+            return calibrationDiagnostics_;
+        }
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -128,6 +162,8 @@ namespace QuantLib {
         EndCriteria::Type shortRateEndCriteria_ = EndCriteria::None;
         Array problemValues_;
         Integer functionEvaluation_;
+        Size calibrationThreads_ = 1;
+        CalibrationDiagnostics calibrationDiagnostics_;
 
       private:
         //! Constraint imposed on arguments
@@ -3,6 +3,7 @@
 
 #include <ql/patterns/composite.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <ql/patterns/dependencygraph.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/patterns/observable.hpp>
 #include <ql/patterns/singleton.hpp>
@@ -0,0 +1,56 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/patterns/dependencygraph.hpp>
+#include <deque>
+#include <set>
+#include <typeinfo>
+
+namespace QuantLib {
+
+    std::vector<Observer*> reachableObservers(const Observable& observable) {
+        std::vector<Observer*> result;
+        std::set<const Observable*> visited;
+        std::set<Observer*> found;
+        std::deque<const Observable*> queue(1, &observable);
+        visited.insert(&observable);
+
+        while (!queue.empty()) {
+            const Observable* current = queue.front();
+            queue.pop_front();
+            for (Observer* observer : current->observers()) {
+                if (!found.insert(observer).second)
+                    continue;
+                result.push_back(observer);
+                auto* next = dynamic_cast<const Observable*>(observer);
+                if (next != nullptr && visited.insert(next).second)
+                    queue.push_back(next);
+            }
+        }
+        return result;
+    }
+
+    std::map<std::type_index, std::vector<Observer*> >
+    reachableObserversByType(const Observable& observable) {
+        std::map<std::type_index, std::vector<Observer*> > result;
+        for (Observer* observer : reachableObservers(observable))
+            result[std::type_index(typeid(*observer))].push_back(observer);
+        return result;
+    }
+
+}
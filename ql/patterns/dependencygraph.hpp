@@ -0,0 +1,64 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file dependencygraph.hpp
+    \brief queries on the graph of observers and observables
+*/
+
+#ifndef quantlib_dependency_graph_hpp
+#define quantlib_dependency_graph_hpp
+
+#include <ql/patterns/observable.hpp>
+#include <map>
+#include <typeindex>
+#include <vector>
+
+namespace QuantLib {
+
+    //! observers notified, directly or indirectly, by an observable
+    /*! The graph of observers is traversed breadth-first; observers
+        which are observables themselves, e.g., lazy objects or the
+        links of handles, are traversed in turn. Each observer is
+        returned once, even if it is reachable along several paths.
+
+        The graph is the one existing at the time of the call; objects
+        registering with their dependencies only when calculated, or
+        depending on data without observing them, are not found.
+
+        \ingroup patterns
+    */
+    std::vector<Observer*> reachableObservers(const Observable& observable);
+
+    //! reachable observers of the given type, e.g., instruments
+    template <class T>
+    std::vector<T*> reachableObservers(const Observable& observable) {
+        std::vector<T*> result;
+        for (Observer* observer : reachableObservers(observable)) {
+            if (auto* t = dynamic_cast<T*>(observer))
+                result.push_back(t);
+        }
+        return result;
+    }
+
+    //! reachable observers grouped by their dynamic type
+    std::map<std::type_index, std::vector<Observer*> >
+    reachableObserversByType(const Observable& observable);
+
+}
+
+#endif
@@ -171,6 +171,18 @@ namespace QuantLib {
         }
     }
 
+    std::vector<Observer*> Observable::observers() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        std::vector<Observer*> result;
+        result.reserve(observers_.size());
+        for (const auto& proxy : observers_) {
+            Observer* observer = proxy->observer();
+            if (observer != nullptr)
+                result.push_back(observer);
+        }
+        return result;
+    }
+
     void Observable::notifyObservers() {
         if (settings_.updatesEnabled()) {
             return (*sig_)();
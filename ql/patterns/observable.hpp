@@ -36,6 +36,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <boost/unordered_set.hpp>
 #include <unordered_set>
 #include <set>
+#include <vector>
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
@@ -59,6 +60,8 @@ namespace QuantLib {
             or when the programmer desires to notify any changes.
         */
         void notifyObservers();
+        //! observers currently registered with this object
+        std::vector<Observer*> observers() const;
       private:
         typedef std::set<Observer*> set_type;
         typedef set_type::iterator iterator;
@@ -190,6 +193,10 @@ namespace QuantLib {
         return observers_.insert(o);
     }
 
+    inline std::vector<Observer*> Observable::observers() const {
+        return std::vector<Observer*>(observers_.begin(), observers_.end());
+    }
+
     inline Size Observable::unregisterObserver(Observer* o) {
         if (settings_.updatesDeferred())
             settings_.unregisterDeferredObserver(o);
@@ -347,6 +354,11 @@ namespace QuantLib {
                 active_ = false;
             }
 
+            Observer* observer() const {
+                std::lock_guard<std::recursive_mutex> lock(mutex_);
+                return active_ ? observer_ : nullptr;
+            }
+
         private:
             bool active_;
             mutable std::recursive_mutex mutex_;
@@ -388,6 +400,8 @@ namespace QuantLib {
             or when the programmer desires to notify any changes.
         */
         void notifyObservers();
+        //! observers currently registered with this object
+        std::vector<Observer*> observers() const;
       private:
         void registerObserver(const std::shared_ptr<Observer::Proxy>&);
         void unregisterObserver(
@@ -51,4 +51,37 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+    ArithmeticAPOBlockPathPricer::ArithmeticAPOBlockPathPricer(
+                                         Option::Type type,
+                                         Real strike, DiscountFactor discount,
+                                         Real runningSum, Size pastFixings)
+    : payoff_(type, strike), discount_(discount),
+      runningSum_(runningSum), pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0,
+            "strike less than zero not allowed");
+    }
+
+    Array ArithmeticAPOBlockPathPricer::operator()(
+                                           const PathBlock& paths) const {
+        Size n = paths.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        // include initial fixing if needed
+        const Size first =
+            (paths.timeGrid().mandatoryTimes()[0]==0.0) ? 0 : 1;
+        const Size fixings = pastFixings_ + n - first;
+
+        Array sum(paths.size(), runningSum_);
+        for (Size i=first; i<n; ++i) {
+            const Real* s = paths[i];
+            for (Size j=0; j<sum.size(); ++j)
+                sum[j] += s[j];
+        }
+
+        Array values(paths.size());
+        for (Size j=0; j<values.size(); ++j)
+            values[j] = discount_ * payoff_(sum[j]/fixings);
+        return values;
+    }
+
 }
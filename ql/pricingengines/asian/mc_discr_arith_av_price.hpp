@@ -26,8 +26,11 @@
 #define quantlib_mc_discrete_arithmetic_average_price_asian_engine_hpp
 
 #include <ql/exercise.hpp>
+#include <ql/methods/montecarlo/blockpathpricer.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/pricingengines/asian/analytic_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <utility>
 
@@ -40,6 +43,13 @@ namespace QuantLib {
          AnalyticDiscreteGeometricAveragePriceAsianEngine (analytic discrete
          arithmetic average price engine) for control variation.
 
+         If requested, delta, vega and rho are estimated in the same
+         simulation by pathwise derivatives or likelihood-ratio
+         weights of the paths, see BlackScholesPathDerivatives. The
+         control variate, if any, is not applied to the greeks. Their
+         standard errors are returned as additional results, see
+         MonteCarloGreeksResults.
+
          \ingroup asianengines
 
          \test the correctness of the returned value is tested by
@@ -66,7 +76,9 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             MonteCarloGreeks::Estimator greeks = MonteCarloGreeks::None);
+        void calculate() const override;
       protected:
         std::shared_ptr<path_pricer_type> pathPricer() const override;
         std::shared_ptr<path_pricer_type> controlPathPricer() const override;
@@ -78,6 +90,7 @@ namespace QuantLib {
             return std::shared_ptr<PricingEngine>(new
                 AnalyticDiscreteGeometricAveragePriceAsianEngine(process));
         }
+        MonteCarloGreeksResults greeks_;
     };
 
 
@@ -97,6 +110,23 @@ namespace QuantLib {
         Size pastFixings_;
     };
 
+    //! arithmetic average-price path pricer for blocks of paths
+    class ArithmeticAPOBlockPathPricer : public BlockPathPricer<PathBlock> {
+      public:
+        ArithmeticAPOBlockPathPricer(Option::Type type,
+                                     Real strike,
+                                     DiscountFactor discount,
+                                     Real runningSum = 0.0,
+                                     Size pastFixings = 0);
+        Array operator()(const PathBlock& paths) const override;
+
+      private:
+        PlainVanillaPayoff payoff_;
+        DiscountFactor discount_;
+        Real runningSum_;
+        Size pastFixings_;
+    };
+
 
     // inline definitions
 
@@ -110,7 +140,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             MonteCarloGreeks::Estimator greeks)
     : MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>(process,
                                                               brownianBridge,
                                                               antitheticVariate,
@@ -118,7 +149,15 @@ namespace QuantLib {
                                                               requiredSamples,
                                                               requiredTolerance,
                                                               maxSamples,
-                                                              seed) {}
+                                                              seed),
+      greeks_(greeks) {}
+
+    template <class RNG, class S>
+    inline void MCDiscreteArithmeticAPEngine<RNG,S>::calculate() const {
+        greeks_.reset();
+        MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>::calculate();
+        greeks_.fillResults(this->results_);
+    }
 
     template <class RNG, class S>
     inline
@@ -141,14 +180,50 @@ namespace QuantLib {
                 this->process_);
         QL_REQUIRE(process, "Black-Scholes process required");
 
-        return std::shared_ptr<typename
-            MCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>(
-                new ArithmeticAPOPathPricer(
-                    payoff->optionType(),
-                    payoff->strike(),
-                    process->riskFreeRate()->discount(exercise->lastDate()),
+        const DiscountFactor discount =
+            process->riskFreeRate()->discount(exercise->lastDate());
+
+        if (greeks_.estimator() == MonteCarloGreeks::None) {
+            return std::shared_ptr<typename
+                MCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>(
+                    new ArithmeticAPOPathPricer(
+                        payoff->optionType(),
+                        payoff->strike(),
+                        discount,
+                        this->arguments_.runningAccumulator,
+                        this->arguments_.pastFixings));
+        }
+
+        const TimeGrid grid = this->timeGrid();
+        const Time paymentTime = process->time(exercise->lastDate());
+        BlackScholesPathDerivatives derivatives(process, grid);
+
+        switch (greeks_.estimator()) {
+          case MonteCarloGreeks::Pathwise: {
+            // same fixings as in ArithmeticAPOPathPricer
+            const Size firstFixing =
+                (grid.mandatoryTimes()[0] == 0.0) ? 0 : 1;
+            return greeks_.setPricer(std::make_shared<PathwiseAveragePathPricer>(
+                payoff->optionType(), payoff->strike(), discount, paymentTime,
+                derivatives, firstFixing, this->antitheticVariate_,
+                this->arguments_.runningAccumulator,
+                this->arguments_.pastFixings));
+          }
+          case MonteCarloGreeks::LikelihoodRatio:
+            return greeks_.setPricer(std::make_shared<LikelihoodRatioPathPricer>(
+                std::make_shared<ArithmeticAPOPathPricer>(
+                    payoff->optionType(), payoff->strike(), discount,
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings),
+                std::make_shared<ArithmeticAPOPathPricer>(
+                    payoff->optionType(), payoff->strike(),
+                    paymentTime*discount,
                     this->arguments_.runningAccumulator,
-                    this->arguments_.pastFixings));
+                    this->arguments_.pastFixings),
+                derivatives, this->antitheticVariate_));
+          default:
+            QL_FAIL("unknown greeks estimator");
+        }
     }
 
     template <class RNG, class S>
@@ -196,6 +271,8 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withGreeks(
+            MonteCarloGreeks::Estimator estimator = MonteCarloGreeks::Pathwise);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
       private:
@@ -205,6 +282,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_ = true;
         BigNatural seed_ = 0;
+        MonteCarloGreeks::Estimator greeks_ = MonteCarloGreeks::None;
     };
 
     template <class RNG, class S>
@@ -270,6 +348,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withGreeks(
+                                    MonteCarloGreeks::Estimator estimator) {
+        greeks_ = estimator;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator std::shared_ptr<PricingEngine>()
@@ -280,7 +366,8 @@ namespace QuantLib {
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
-                                                seed_));
+                                                seed_,
+                                                greeks_));
     }
 
 
@@ -0,0 +1,285 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmc_discr_arith_av_price.hpp
+    \brief Multilevel Monte Carlo engine for discrete arithmetic average price Asian
+*/
+
+#ifndef quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+#define quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+
+#include <ql/exercise.hpp>
+#include <ql/instruments/asianoption.hpp>
+#include <ql/pricingengines/asian/mc_discr_arith_av_price_heston.hpp>
+#include <ql/pricingengines/asian/mcdiscreteasianenginebase.hpp>
+#include <ql/pricingengines/multilevelmcsimulation.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo engine for discrete arithmetic average price Asian
+    /*! The coarsest time grid contains the fixing times and the
+        given number of additional steps; finer levels bisect its
+        steps, so that the fixing times belong to all the levels.
+        The first asset of the process is averaged, hence P can be
+        either a Black-Scholes or a Heston process; in the former
+        case the discretization is exact and the finer levels only
+        add a negligible correction.
+
+        \ingroup asianengines
+
+        \test the correctness of the returned value is tested by
+              reproducing results available in literature.
+    */
+    template <class RNG = PseudoRandom,
+              class S = Statistics, class P = GeneralizedBlackScholesProcess>
+    class MLMCDiscreteArithmeticAPEngine
+        : public DiscreteAveragingAsianOption::engine,
+          public MultilevelMcSimulation<RNG,S> {
+      public:
+        typedef typename MultilevelMcSimulation<RNG,S>::path_pricer_type
+            path_pricer_type;
+        MLMCDiscreteArithmeticAPEngine(std::shared_ptr<P> process,
+                                       Size timeSteps,
+                                       Size timeStepsPerYear,
+                                       bool antitheticVariate,
+                                       Real requiredTolerance,
+                                       Size maxLevels,
+                                       Size initialSamples,
+                                       BigNatural seed,
+                                       Real weakOrder = 1.0);
+        void calculate() const override;
+      protected:
+        std::shared_ptr<StochasticProcess> process() const override {
+            return process_;
+        }
+        TimeGrid coarsestTimeGrid() const override;
+        std::shared_ptr<path_pricer_type> pathPricer(
+                                       const TimeGrid& grid) const override;
+        std::vector<Time> fixingTimes() const;
+        std::shared_ptr<P> process_;
+        Size timeSteps_, timeStepsPerYear_;
+        Real requiredTolerance_;
+        Size maxLevels_, initialSamples_;
+        BigNatural seed_;
+    };
+
+    //! Multilevel Monte Carlo discrete arithmetic average-price Asian engine factory
+    template <class RNG = PseudoRandom,
+              class S = Statistics, class P = GeneralizedBlackScholesProcess>
+    class MakeMLMCDiscreteArithmeticAPEngine {
+      public:
+        explicit MakeMLMCDiscreteArithmeticAPEngine(std::shared_ptr<P>);
+        // named parameters
+        MakeMLMCDiscreteArithmeticAPEngine& withSteps(Size steps);
+        MakeMLMCDiscreteArithmeticAPEngine& withStepsPerYear(Size steps);
+        MakeMLMCDiscreteArithmeticAPEngine& withAbsoluteTolerance(
+                                                            Real tolerance);
+        MakeMLMCDiscreteArithmeticAPEngine& withMaxLevels(Size levels);
+        MakeMLMCDiscreteArithmeticAPEngine& withInitialSamples(Size samples);
+        MakeMLMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
+        MakeMLMCDiscreteArithmeticAPEngine& withAntitheticVariate(
+                                                            bool b = true);
+        MakeMLMCDiscreteArithmeticAPEngine& withWeakOrder(Real order);
+        // conversion to pricing engine
+        operator std::shared_ptr<PricingEngine>() const;
+      private:
+        std::shared_ptr<P> process_;
+        bool antithetic_ = false;
+        Size steps_, stepsPerYear_;
+        Real tolerance_;
+        Size maxLevels_ = 10, initialSamples_ = 1000;
+        BigNatural seed_ = 0;
+        Real weakOrder_ = 1.0;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S, class P>
+    inline
+    MLMCDiscreteArithmeticAPEngine<RNG,S,P>::MLMCDiscreteArithmeticAPEngine(
+                std::shared_ptr<P> process,
+                Size timeSteps, Size timeStepsPerYear, bool antitheticVariate,
+                Real requiredTolerance, Size maxLevels, Size initialSamples,
+                BigNatural seed, Real weakOrder)
+    : MultilevelMcSimulation<RNG,S>(antitheticVariate, weakOrder),
+      process_(std::move(process)), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear),
+      requiredTolerance_(requiredTolerance), maxLevels_(maxLevels),
+      initialSamples_(initialSamples), seed_(seed) {
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S, class P>
+    inline std::vector<Time>
+    MLMCDiscreteArithmeticAPEngine<RNG,S,P>::fixingTimes() const {
+        std::vector<Time> fixingTimes;
+        for (const auto& fixingDate : arguments_.fixingDates) {
+            const Time t = process_->time(fixingDate);
+            if (t >= 0)
+                fixingTimes.push_back(t);
+        }
+        return fixingTimes;
+    }
+
+    template <class RNG, class S, class P>
+    inline TimeGrid
+    MLMCDiscreteArithmeticAPEngine<RNG,S,P>::coarsestTimeGrid() const {
+        const std::vector<Time> times = fixingTimes();
+        if (times.empty() || (times.size() == 1 && times.front() == 0.0))
+            throw detail::PastFixingsOnly();
+
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(times.begin(), times.end(), timeSteps_);
+        } else if (timeStepsPerYear_ != Null<Size>()) {
+            return TimeGrid(times.begin(), times.end(),
+                            static_cast<Size>(timeStepsPerYear_*times.back()));
+        }
+        return TimeGrid(times.begin(), times.end());
+    }
+
+    template <class RNG, class S, class P>
+    inline
+    std::shared_ptr<
+        typename MLMCDiscreteArithmeticAPEngine<RNG,S,P>::path_pricer_type>
+    MLMCDiscreteArithmeticAPEngine<RNG,S,P>::pathPricer(
+                                                 const TimeGrid& grid) const {
+        std::shared_ptr<PlainVanillaPayoff> payoff =
+            std::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        std::shared_ptr<EuropeanExercise> exercise =
+            std::dynamic_pointer_cast<EuropeanExercise>(arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        // the fixing times belong to the grids of all the levels
+        std::vector<Size> fixingIndices;
+        for (Time t : fixingTimes())
+            fixingIndices.push_back(grid.index(t));
+
+        return std::make_shared<ArithmeticAPOHestonPathPricer>(
+            payoff->optionType(), payoff->strike(),
+            process_->riskFreeRate()->discount(exercise->lastDate()),
+            fixingIndices, arguments_.runningAccumulator,
+            arguments_.pastFixings);
+    }
+
+    template <class RNG, class S, class P>
+    inline void MLMCDiscreteArithmeticAPEngine<RNG,S,P>::calculate() const {
+        QL_REQUIRE(arguments_.averageType == Average::Arithmetic,
+                   "not an arithmetic average option");
+
+        MultilevelMcSimulation<RNG,S>::calculate(requiredTolerance_,
+                                                 maxLevels_,
+                                                 initialSamples_,
+                                                 seed_);
+        results_.value = this->model_->value();
+        results_.errorEstimate = this->model_->errorEstimate();
+        results_.additionalResults["Levels"] = this->model_->levels();
+        results_.additionalResults["Cost"] = this->model_->cost();
+    }
+
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::
+    MakeMLMCDiscreteArithmeticAPEngine(std::shared_ptr<P> process)
+    : process_(std::move(process)), steps_(Null<Size>()),
+      stepsPerYear_(Null<Size>()), tolerance_(Null<Real>()) {}
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::withSteps(Size steps) {
+        QL_REQUIRE(stepsPerYear_ == Null<Size>(),
+                   "number of steps per year already set");
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::withStepsPerYear(Size steps) {
+        QL_REQUIRE(steps_ == Null<Size>(),
+                   "number of steps already set");
+        stepsPerYear_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::withAbsoluteTolerance(
+                                                            Real tolerance) {
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::withMaxLevels(Size levels) {
+        maxLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::withInitialSamples(
+                                                              Size samples) {
+        initialSamples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::withAntitheticVariate(
+                                                                    bool b) {
+        antithetic_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::withWeakOrder(Real order) {
+        weakOrder_ = order;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S,P>::
+    operator std::shared_ptr<PricingEngine>() const {
+        return std::make_shared<MLMCDiscreteArithmeticAPEngine<RNG,S,P> >(
+            process_, steps_, stepsPerYear_, antithetic_, tolerance_,
+            maxLevels_, initialSamples_, seed_, weakOrder_);
+    }
+
+}
+
+
+#endif
@@ -246,4 +246,76 @@ namespace QuantLib {
         }
     }
 
+
+    BiasedBarrierBlockPathPricer::BiasedBarrierBlockPathPricer(
+                                        Barrier::Type barrierType,
+                                        Real barrier,
+                                        Real rebate,
+                                        Option::Type type,
+                                        Real strike,
+                                        std::vector<DiscountFactor> discounts)
+    : barrierType_(barrierType), barrier_(barrier), rebate_(rebate), payoff_(type, strike),
+      discounts_(std::move(discounts)) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(barrier>0.0,
+                   "barrier less/equal zero not allowed");
+    }
+
+
+    Array BiasedBarrierBlockPathPricer::operator()(
+                                           const PathBlock& paths) const {
+        static Size null = Null<Size>();
+        Size n = paths.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        bool isDown, isKnockIn;
+        switch (barrierType_) {
+          case Barrier::DownIn:
+            isDown = true;
+            isKnockIn = true;
+            break;
+          case Barrier::UpIn:
+            isDown = false;
+            isKnockIn = true;
+            break;
+          case Barrier::DownOut:
+            isDown = true;
+            isKnockIn = false;
+            break;
+          case Barrier::UpOut:
+            isDown = false;
+            isKnockIn = false;
+            break;
+          default:
+            QL_FAIL("unknown barrier type");
+        }
+
+        // first node at which each path crosses the barrier
+        const Size m = paths.size();
+        std::vector<Size> knockNode(m, null);
+        for (Size i=1; i<n; ++i) {
+            const Real* s = paths[i];
+            for (Size j=0; j<m; ++j) {
+                const bool hit = isDown ? s[j] <= barrier_
+                                        : s[j] >= barrier_;
+                if (hit && knockNode[j] == null)
+                    knockNode[j] = i;
+            }
+        }
+
+        const Real* s = paths[n-1];
+        Array values(m);
+        for (Size j=0; j<m; ++j) {
+            const bool knocked = (knockNode[j] != null);
+            if (knocked == isKnockIn)
+                values[j] = payoff_(s[j]) * discounts_.back();
+            else if (isKnockIn)
+                values[j] = rebate_*discounts_.back();
+            else
+                values[j] = rebate_*discounts_[knockNode[j]];
+        }
+        return values;
+    }
+
 }
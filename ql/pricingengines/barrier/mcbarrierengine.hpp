@@ -28,6 +28,9 @@
 
 #include <ql/exercise.hpp>
 #include <ql/instruments/barrieroption.hpp>
+#include <ql/methods/montecarlo/blockpathpricer.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <utility>
@@ -48,6 +51,15 @@ namespace QuantLib {
         Journal of Derivatives; Winter 1998; 6, 2; pg. 65-83
         </i>
 
+        If requested, delta, vega and rho are estimated in the same
+        simulation by likelihood-ratio weights of the paths, see
+        BlackScholesPathDerivatives; pathwise derivatives are not
+        available because of the discontinuity of the payoff at the
+        barrier. Since the Brownian-bridge correction depends on the
+        volatility, vega is only returned by the biased engine. The
+        standard errors of the greeks are returned as additional
+        results, see MonteCarloGreeksResults.
+
         \ingroup barrierengines
 
         \test the correctness of the returned value is tested by
@@ -74,11 +86,14 @@ namespace QuantLib {
                         Real requiredTolerance,
                         Size maxSamples,
                         bool isBiased,
-                        BigNatural seed);
+                        BigNatural seed,
+                        MonteCarloGreeks::Estimator greeks
+                                                  = MonteCarloGreeks::None);
         void calculate() const override {
             Real spot = process_->x0();
             QL_REQUIRE(spot > 0.0, "negative or null underlying given");
             QL_REQUIRE(!triggered(spot), "barrier touched");
+            greeks_.reset();
             McSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
                                                          requiredSamples_,
                                                          maxSamples_);
@@ -86,6 +101,7 @@ namespace QuantLib {
             if (RNG::allowsErrorEstimate)
             results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
+            greeks_.fillResults(results_, isBiased_);
         }
 
       protected:
@@ -108,6 +124,7 @@ namespace QuantLib {
         bool isBiased_;
         bool brownianBridge_;
         BigNatural seed_;
+        MonteCarloGreeksResults greeks_;
     };
 
 
@@ -126,6 +143,9 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withGreeks(
+            MonteCarloGreeks::Estimator estimator
+                                      = MonteCarloGreeks::LikelihoodRatio);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +154,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_ = 0;
+        MonteCarloGreeks::Estimator greeks_ = MonteCarloGreeks::None;
     };
 
 
@@ -179,6 +200,29 @@ namespace QuantLib {
     };
 
 
+    //! discretely-monitored barrier path pricer for blocks of paths
+    /*! The barrier is checked at the points of the paths only, as in
+        BiasedBarrierPathPricer.
+    */
+    class BiasedBarrierBlockPathPricer : public BlockPathPricer<PathBlock> {
+      public:
+        BiasedBarrierBlockPathPricer(Barrier::Type barrierType,
+                                     Real barrier,
+                                     Real rebate,
+                                     Option::Type type,
+                                     Real strike,
+                                     std::vector<DiscountFactor> discounts);
+        Array operator()(const PathBlock& paths) const override;
+
+      private:
+        Barrier::Type barrierType_;
+        Real barrier_;
+        Real rebate_;
+        PlainVanillaPayoff payoff_;
+        std::vector<DiscountFactor> discounts_;
+    };
+
+
 
     // template definitions
 
@@ -193,11 +237,12 @@ namespace QuantLib {
         Real requiredTolerance,
         Size maxSamples,
         bool isBiased,
-        BigNatural seed)
+        BigNatural seed,
+        MonteCarloGreeks::Estimator greeks)
     : McSimulation<SingleVariate, RNG, S>(antitheticVariate, false), process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance), isBiased_(isBiased),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed), greeks_(greeks) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -210,6 +255,8 @@ namespace QuantLib {
         QL_REQUIRE(timeStepsPerYear != 0,
                    "timeStepsPerYear must be positive, " << timeStepsPerYear <<
                    " not allowed");
+        QL_REQUIRE(greeks != MonteCarloGreeks::Pathwise,
+                   "pathwise greeks not available for barrier options");
         registerWith(process_);
     }
 
@@ -241,32 +288,49 @@ namespace QuantLib {
         for (Size i=0; i<grid.size(); i++)
             discounts[i] = process_->riskFreeRate()->discount(grid[i]);
 
-        // do this with template parameters?
-        if (isBiased_) {
-            return std::shared_ptr<
-                        typename MCBarrierEngine<RNG,S>::path_pricer_type>(
-                new BiasedBarrierPathPricer(
-                       arguments_.barrierType,
-                       arguments_.barrier,
-                       arguments_.rebate,
-                       payoff->optionType(),
-                       payoff->strike(),
-                       discounts));
-        } else {
-            PseudoRandom::ursg_type sequenceGen(grid.size()-1,
-                                                PseudoRandom::urng_type(5));
-            return std::shared_ptr<
-                        typename MCBarrierEngine<RNG,S>::path_pricer_type>(
-                new BarrierPathPricer(
-                    arguments_.barrierType,
-                    arguments_.barrier,
-                    arguments_.rebate,
-                    payoff->optionType(),
-                    payoff->strike(),
-                    discounts,
-                    process_,
-                    sequenceGen));
+        auto pricer = [&](const std::vector<DiscountFactor>& discounts)
+                                     -> std::shared_ptr<path_pricer_type> {
+            // do this with template parameters?
+            if (isBiased_) {
+                return std::shared_ptr<path_pricer_type>(
+                    new BiasedBarrierPathPricer(
+                           arguments_.barrierType,
+                           arguments_.barrier,
+                           arguments_.rebate,
+                           payoff->optionType(),
+                           payoff->strike(),
+                           discounts));
+            } else {
+                PseudoRandom::ursg_type sequenceGen(grid.size()-1,
+                                                    PseudoRandom::urng_type(5));
+                return std::shared_ptr<path_pricer_type>(
+                    new BarrierPathPricer(
+                        arguments_.barrierType,
+                        arguments_.barrier,
+                        arguments_.rebate,
+                        payoff->optionType(),
+                        payoff->strike(),
+                        discounts,
+                        process_,
+                        sequenceGen));
+            }
+        };
+
+        if (greeks_.estimator() == MonteCarloGreeks::None) {
+            return pricer(discounts);
         }
+
+        // the rate sensitivity of the discounting is the value of the
+        // payoff with discount factors multiplied by their times; the
+        // two pricers draw the same random numbers for the bridge.
+        std::vector<DiscountFactor> timeWeightedDiscounts(grid.size());
+        for (Size i=0; i<grid.size(); i++)
+            timeWeightedDiscounts[i] = grid[i]*discounts[i];
+
+        return greeks_.setPricer(std::make_shared<LikelihoodRatioPathPricer>(
+            pricer(discounts), pricer(timeWeightedDiscounts),
+            BlackScholesPathDerivatives(process_, grid),
+            this->antitheticVariate_));
     }
 
 
@@ -304,6 +368,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withGreeks(
+                                    MonteCarloGreeks::Estimator estimator) {
+        greeks_ = estimator;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
     MakeMCBarrierEngine<RNG,S>::withSamples(Size samples) {
@@ -363,7 +435,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   greeks_));
     }
 
 }
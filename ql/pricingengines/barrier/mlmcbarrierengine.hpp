@@ -0,0 +1,285 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmcbarrierengine.hpp
+    \brief Multilevel Monte Carlo barrier option engine
+*/
+
+#ifndef quantlib_mlmc_barrier_engine_hpp
+#define quantlib_mlmc_barrier_engine_hpp
+
+#include <ql/exercise.hpp>
+#include <ql/instruments/barrieroption.hpp>
+#include <ql/instruments/payoffs.hpp>
+#include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/multilevelmcsimulation.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <cmath>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo engine for barrier options
+    /*! The barrier is monitored at the points of the time grid of
+        each level, with the continuity correction of Broadie,
+        Glasserman and Kou (1997): the barrier is moved towards the
+        spot by a factor \f$ \exp(0.5826\,\sigma\sqrt{\Delta t}) \f$,
+        which leaves a discretization bias of order
+        \f$ \Delta t \f$ with respect to the continuously-monitored
+        option. Fine and coarse paths of a level are monitored on
+        their own grids with their own corrections and are driven by
+        the same Brownian increments, so that the levels are coupled.
+
+        \warning for a Black-Scholes process with deterministic
+                 volatility, MCBarrierEngine with the Brownian-bridge
+                 crossing probabilities is unbiased on any grid and
+                 is faster; this engine is meant for the cases in
+                 which no such correction is available, and as a
+                 reference for the multilevel framework.
+
+        \ingroup barrierengines
+
+        \test the correctness of the returned value is tested by
+              checking it against analytic results.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCBarrierEngine : public BarrierOption::engine,
+                              public MultilevelMcSimulation<RNG,S> {
+      public:
+        typedef typename MultilevelMcSimulation<RNG,S>::path_pricer_type
+            path_pricer_type;
+        MLMCBarrierEngine(std::shared_ptr<GeneralizedBlackScholesProcess> process,
+                          Size timeSteps,
+                          Size timeStepsPerYear,
+                          bool antitheticVariate,
+                          Real requiredTolerance,
+                          Size maxLevels,
+                          Size initialSamples,
+                          BigNatural seed,
+                          Real weakOrder = 1.0);
+        void calculate() const override;
+      protected:
+        std::shared_ptr<StochasticProcess> process() const override {
+            return process_;
+        }
+        TimeGrid coarsestTimeGrid() const override;
+        std::shared_ptr<path_pricer_type> pathPricer(
+                                       const TimeGrid& grid) const override;
+        std::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size timeSteps_, timeStepsPerYear_;
+        Real requiredTolerance_;
+        Size maxLevels_, initialSamples_;
+        BigNatural seed_;
+    };
+
+    //! Multilevel Monte Carlo barrier-option engine factory
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MakeMLMCBarrierEngine {
+      public:
+        explicit MakeMLMCBarrierEngine(
+                          std::shared_ptr<GeneralizedBlackScholesProcess>);
+        // named parameters
+        MakeMLMCBarrierEngine& withSteps(Size steps);
+        MakeMLMCBarrierEngine& withStepsPerYear(Size steps);
+        MakeMLMCBarrierEngine& withAbsoluteTolerance(Real tolerance);
+        MakeMLMCBarrierEngine& withMaxLevels(Size levels);
+        MakeMLMCBarrierEngine& withInitialSamples(Size samples);
+        MakeMLMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMLMCBarrierEngine& withAntitheticVariate(bool b = true);
+        MakeMLMCBarrierEngine& withWeakOrder(Real order);
+        // conversion to pricing engine
+        operator std::shared_ptr<PricingEngine>() const;
+      private:
+        std::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        bool antithetic_ = false;
+        Size steps_, stepsPerYear_;
+        Real tolerance_;
+        Size maxLevels_ = 10, initialSamples_ = 1000;
+        BigNatural seed_ = 0;
+        Real weakOrder_ = 1.0;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S>
+    inline MLMCBarrierEngine<RNG,S>::MLMCBarrierEngine(
+                    std::shared_ptr<GeneralizedBlackScholesProcess> process,
+                    Size timeSteps, Size timeStepsPerYear,
+                    bool antitheticVariate, Real requiredTolerance,
+                    Size maxLevels, Size initialSamples,
+                    BigNatural seed, Real weakOrder)
+    : MultilevelMcSimulation<RNG,S>(antitheticVariate, weakOrder),
+      process_(std::move(process)), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear),
+      requiredTolerance_(requiredTolerance), maxLevels_(maxLevels),
+      initialSamples_(initialSamples), seed_(seed) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCBarrierEngine<RNG,S>::coarsestTimeGrid() const {
+        const Time t = process_->time(arguments_.exercise->lastDate());
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(t, timeSteps_);
+        } else {
+            const Size steps = static_cast<Size>(timeStepsPerYear_*t);
+            return TimeGrid(t, std::max<Size>(steps, 1));
+        }
+    }
+
+    template <class RNG, class S>
+    inline
+    std::shared_ptr<typename MLMCBarrierEngine<RNG,S>::path_pricer_type>
+    MLMCBarrierEngine<RNG,S>::pathPricer(const TimeGrid& grid) const {
+        std::shared_ptr<PlainVanillaPayoff> payoff =
+            std::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        std::vector<DiscountFactor> discounts(grid.size());
+        for (Size i=0; i<grid.size(); i++)
+            discounts[i] = process_->riskFreeRate()->discount(grid[i]);
+
+        // continuity correction of Broadie, Glasserman and Kou: the
+        // barrier is moved towards the spot by 0.5826 sigma sqrt(dt)
+        const Time dt = grid.back()/(grid.size()-1);
+        const Volatility vol = process_->blackVolatility()->blackVol(
+            grid.back(), arguments_.barrier, true);
+        const Real shift = std::exp(0.5826*vol*std::sqrt(dt));
+        const Real barrier =
+            (arguments_.barrierType == Barrier::DownIn ||
+             arguments_.barrierType == Barrier::DownOut)
+            ? arguments_.barrier*shift
+            : arguments_.barrier/shift;
+
+        return std::make_shared<SingleAssetPathPricer>(
+            std::make_shared<BiasedBarrierPathPricer>(
+                arguments_.barrierType, barrier,
+                arguments_.rebate, payoff->optionType(),
+                payoff->strike(), discounts));
+    }
+
+    template <class RNG, class S>
+    inline void MLMCBarrierEngine<RNG,S>::calculate() const {
+        const Real spot = process_->x0();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+        QL_REQUIRE(!triggered(spot), "barrier touched");
+
+        MultilevelMcSimulation<RNG,S>::calculate(requiredTolerance_,
+                                                 maxLevels_,
+                                                 initialSamples_,
+                                                 seed_);
+        results_.value = this->model_->value();
+        results_.errorEstimate = this->model_->errorEstimate();
+        results_.additionalResults["Levels"] = this->model_->levels();
+        results_.additionalResults["Cost"] = this->model_->cost();
+    }
+
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>::MakeMLMCBarrierEngine(
+                    std::shared_ptr<GeneralizedBlackScholesProcess> process)
+    : process_(std::move(process)), steps_(Null<Size>()),
+      stepsPerYear_(Null<Size>()), tolerance_(Null<Real>()) {}
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withSteps(Size steps) {
+        QL_REQUIRE(stepsPerYear_ == Null<Size>(),
+                   "number of steps per year already set");
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withStepsPerYear(Size steps) {
+        QL_REQUIRE(steps_ == Null<Size>(),
+                   "number of steps already set");
+        stepsPerYear_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withAbsoluteTolerance(Real tolerance) {
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withMaxLevels(Size levels) {
+        maxLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withInitialSamples(Size samples) {
+        initialSamples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withAntitheticVariate(bool b) {
+        antithetic_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withWeakOrder(Real order) {
+        weakOrder_ = order;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline
+    MakeMLMCBarrierEngine<RNG,S>::operator std::shared_ptr<PricingEngine>()
+                                                                      const {
+        QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
+                   "number of steps not given");
+        return std::make_shared<MLMCBarrierEngine<RNG,S> >(
+            process_, steps_, stepsPerYear_, antithetic_, tolerance_,
+            maxLevels_, initialSamples_, seed_, weakOrder_);
+    }
+
+}
+
+
+#endif
@@ -30,6 +30,7 @@ namespace QuantLib {
         Size polynomialOrder,
         LsmBasisSystem::PolynomialType polynomialType)
     : assetNumber_(assetNumber), payoff_(std::move(payoff)),
+      basis_(assetNumber_, polynomialOrder, polynomialType),
       v_(LsmBasisSystem::multiPathBasisSystem(assetNumber_, polynomialOrder, polynomialType)) {
         QL_REQUIRE(   polynomialType == LsmBasisSystem::Monomial
                    || polynomialType == LsmBasisSystem::Laguerre
@@ -83,4 +84,26 @@ namespace QuantLib {
         return v_;
     }
 
+    Matrix AmericanBasketPathPricer::basisSystemValues(
+                                    const std::vector<Array>& states) const {
+        for (const auto& state : states)
+            QL_REQUIRE(state.size() == assetNumber_, "invalid state size");
+
+        const Size m = basis_.size();
+        Matrix A(states.size(), m+1);
+
+        #pragma omp parallel
+        {
+            std::vector<Real> workspace(basis_.workspaceSize());
+
+            #pragma omp for
+            for (long k=0; k < long(states.size()); ++k) {
+                basis_.values(states[k].begin(), A.row_begin(k), &workspace[0]);
+                A[k][m] = payoff(states[k]);
+            }
+        }
+
+        return A;
+    }
+
 }
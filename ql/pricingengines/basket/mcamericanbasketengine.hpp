@@ -114,6 +114,7 @@ namespace QuantLib {
         Real operator()(const MultiPath& path, Size t) const override;
 
         std::vector<std::function<Real(Array)> > basisSystem() const override;
+        Matrix basisSystemValues(const std::vector<Array>& states) const override;
 
       protected:
         Real payoff(const Array& state) const;
@@ -122,6 +123,7 @@ namespace QuantLib {
         const std::shared_ptr<Payoff> payoff_;
 
         Real scalingValue_ = 1.0;
+        const LsmPolynomialBasis basis_;
         std::vector<std::function<Real(Array)> > v_;
     };
 
@@ -44,5 +44,26 @@ namespace QuantLib {
         return (*payoff_)(finalPrice) * discount_;
     }
 
-}
+    EuropeanMultiPathBlockPricer::EuropeanMultiPathBlockPricer(
+                                        std::shared_ptr<BasketPayoff> payoff,
+                                        DiscountFactor discount)
+    : payoff_(std::move(payoff)), discount_(discount) {}
 
+    Array EuropeanMultiPathBlockPricer::operator()(
+                                      const MultiPathBlock& paths) const {
+        Size n = paths.pathSize();
+        QL_REQUIRE(n>0, "the path cannot be empty");
+
+        Size numAssets = paths.assetNumber();
+        QL_REQUIRE(numAssets>0, "there must be some paths");
+
+        Array finalPrice(numAssets), values(paths.size());
+        for (Size j=0; j<values.size(); ++j) {
+            for (Size k=0; k<numAssets; ++k)
+                finalPrice[k] = paths[k][n-1][j];
+            values[j] = (*payoff_)(finalPrice) * discount_;
+        }
+        return values;
+    }
+
+}
@@ -27,6 +27,8 @@
 
 #include <ql/exercise.hpp>
 #include <ql/instruments/basketoption.hpp>
+#include <ql/methods/montecarlo/blockpathpricer.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
@@ -137,6 +139,19 @@ namespace QuantLib {
         DiscountFactor discount_;
     };
 
+    //! European basket path pricer for blocks of paths
+    class EuropeanMultiPathBlockPricer
+        : public BlockPathPricer<MultiPathBlock> {
+      public:
+        EuropeanMultiPathBlockPricer(std::shared_ptr<BasketPayoff> payoff,
+                                     DiscountFactor discount);
+        Array operator()(const MultiPathBlock& paths) const override;
+
+      private:
+        std::shared_ptr<BasketPayoff> payoff_;
+        DiscountFactor discount_;
+    };
+
 
     // template definitions
 
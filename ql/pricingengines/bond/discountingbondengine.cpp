@@ -66,4 +66,40 @@ namespace QuantLib {
         }
     }
 
+    void DiscountingBondEngine::npvAdjoint(const Bond& bond,
+                                           Real npvAdjoint,
+                                           DiscountAdjoints& adjoints) const {
+        QL_REQUIRE(!discountCurve_.empty(),
+                   "discounting term structure handle is empty");
+
+        Date valuationDate = (*discountCurve_)->referenceDate();
+
+        bool includeRefDateFlows = includeSettlementDateFlows_ ? // NOLINT(readability-implicit-bool-conversion)
+                                       *includeSettlementDateFlows_ :
+                                       Settings::instance().includeReferenceDateEvents();
+
+        CashFlows::npvbpsAdjoint(bond.cashflows(),
+                                 **discountCurve_,
+                                 includeRefDateFlows,
+                                 valuationDate,
+                                 valuationDate,
+                                 npvAdjoint, 0.0,
+                                 adjoints);
+    }
+
+    void DiscountingBondEngine::settlementValueAdjoint(const Bond& bond,
+                                                       Real settlementValueAdjoint,
+                                                       DiscountAdjoints& adjoints) const {
+        QL_REQUIRE(!discountCurve_.empty(),
+                   "discounting term structure handle is empty");
+
+        CashFlows::npvbpsAdjoint(bond.cashflows(),
+                                 **discountCurve_,
+                                 false,
+                                 bond.settlementDate(),
+                                 bond.settlementDate(),
+                                 settlementValueAdjoint, 0.0,
+                                 adjoints);
+    }
+
 }
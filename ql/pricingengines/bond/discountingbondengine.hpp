@@ -32,6 +32,8 @@
 
 namespace QuantLib {
 
+    class DiscountAdjoints;
+
     class DiscountingBondEngine : public Bond::engine {
       public:
         DiscountingBondEngine(
@@ -41,6 +43,20 @@ namespace QuantLib {
         Handle<YieldTermStructure> discountCurve() const {
             return discountCurve_;
         }
+        //! \name Adjoints
+        //@{
+        /*! adds to the given adjoints the derivatives of
+            npvAdjoint times the NPV of the bond, as calculated by
+            this engine, with respect to the discount factors it reads.
+        */
+        void npvAdjoint(const Bond& bond,
+                        Real npvAdjoint,
+                        DiscountAdjoints& adjoints) const;
+        //! same as above for the settlement value
+        void settlementValueAdjoint(const Bond& bond,
+                                    Real settlementValueAdjoint,
+                                    DiscountAdjoints& adjoints) const;
+        //@}
       private:
         Handle<YieldTermStructure> discountCurve_;
         std::optional<bool> includeSettlementDateFlows_;
@@ -0,0 +1,203 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/mcgreeks.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    BlackScholesPathDerivatives::BlackScholesPathDerivatives(
+        const std::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        const TimeGrid& grid) {
+        QL_REQUIRE(process, "null process given");
+        QL_REQUIRE(process->stepCoefficients(grid, drift_, diffusion_),
+                   "exact lognormal evolution of the process required");
+        sqrtDt_ = Array(grid.size()-1);
+        for (Size k=0; k<sqrtDt_.size(); ++k) {
+            QL_REQUIRE(diffusion_[k] > 0.0,
+                       "positive volatility required");
+            sqrtDt_[k] = std::sqrt(grid.dt(k));
+        }
+    }
+
+    Real BlackScholesPathDerivatives::normal(const Path& path,
+                                             Size k) const {
+        return (std::log(path[k+1]/path[k]) - drift_[k])/diffusion_[k];
+    }
+
+    void BlackScholesPathDerivatives::spotDerivatives(const Path& path,
+                                                      Array& result) const {
+        const Size n = path.length();
+        QL_REQUIRE(n == drift_.size()+1, "path doesn't fit the time grid");
+        result.resize(n);
+        for (Size i=0; i<n; ++i)
+            result[i] = path[i]/path.front();
+    }
+
+    void BlackScholesPathDerivatives::volatilityDerivatives(
+                                    const Path& path, Array& result) const {
+        const Size n = path.length();
+        QL_REQUIRE(n == drift_.size()+1, "path doesn't fit the time grid");
+        result.resize(n);
+        // d ln S_{k+1} / d sigma = d ln S_k / d sigma
+        //                          + sqrt(dt_k) (Z_k - sigma_k sqrt(dt_k))
+        Real dLogS = 0.0;
+        result[0] = 0.0;
+        for (Size k=0; k<n-1; ++k) {
+            dLogS += sqrtDt_[k]*(normal(path, k) - diffusion_[k]);
+            result[k+1] = path[k+1]*dLogS;
+        }
+    }
+
+    void BlackScholesPathDerivatives::rateDerivatives(const Path& path,
+                                                      Array& result) const {
+        const Size n = path.length();
+        QL_REQUIRE(n == drift_.size()+1, "path doesn't fit the time grid");
+        result.resize(n);
+        const TimeGrid& grid = path.timeGrid();
+        for (Size i=0; i<n; ++i)
+            result[i] = path[i]*(grid[i] - grid.front());
+    }
+
+    Real BlackScholesPathDerivatives::spotWeight(const Path& path) const {
+        QL_REQUIRE(path.length() == drift_.size()+1,
+                   "path doesn't fit the time grid");
+        // only the density of the first step depends on the spot
+        return normal(path, 0)/(path.front()*diffusion_[0]);
+    }
+
+    Real BlackScholesPathDerivatives::volatilityWeight(
+                                                 const Path& path) const {
+        QL_REQUIRE(path.length() == drift_.size()+1,
+                   "path doesn't fit the time grid");
+        Real weight = 0.0;
+        for (Size k=0; k<drift_.size(); ++k) {
+            const Real z = normal(path, k);
+            weight += sqrtDt_[k]*((z*z - 1.0)/diffusion_[k] - z);
+        }
+        return weight;
+    }
+
+    Real BlackScholesPathDerivatives::rateWeight(const Path& path) const {
+        QL_REQUIRE(path.length() == drift_.size()+1,
+                   "path doesn't fit the time grid");
+        Real weight = 0.0;
+        for (Size k=0; k<drift_.size(); ++k)
+            weight += normal(path, k)*sqrtDt_[k]*sqrtDt_[k]/diffusion_[k];
+        return weight;
+    }
+
+
+    void GreeksAccumulator::addGreeks(Real delta, Real vega, Real rho) const {
+        if (!antitheticVariate_) {
+            delta_.add(delta);
+            vega_.add(vega);
+            rho_.add(rho);
+        } else if (!pending_) {
+            pendingDelta_ = delta;
+            pendingVega_ = vega;
+            pendingRho_ = rho;
+            pending_ = true;
+        } else {
+            delta_.add(0.5*(pendingDelta_ + delta));
+            vega_.add(0.5*(pendingVega_ + vega));
+            rho_.add(0.5*(pendingRho_ + rho));
+            pending_ = false;
+        }
+    }
+
+
+    PathwiseAveragePathPricer::PathwiseAveragePathPricer(
+                                    Option::Type type,
+                                    Real strike,
+                                    DiscountFactor discount,
+                                    Time paymentTime,
+                                    BlackScholesPathDerivatives derivatives,
+                                    Size firstFixing,
+                                    bool antitheticVariate,
+                                    Real runningSum,
+                                    Size pastFixings)
+    : GreeksPathPricer(antitheticVariate),
+      phi_(type == Option::Call ? 1.0 : -1.0), strike_(strike),
+      discount_(discount), paymentTime_(paymentTime),
+      derivatives_(std::move(derivatives)), firstFixing_(firstFixing),
+      runningSum_(runningSum), pastFixings_(pastFixings) {
+        QL_REQUIRE(type == Option::Call || type == Option::Put,
+                   "unknown option type");
+        QL_REQUIRE(strike >= 0.0, "strike less than zero not allowed");
+    }
+
+    Real PathwiseAveragePathPricer::operator()(const Path& path) const {
+        const Size n = path.length();
+        QL_REQUIRE(n > firstFixing_, "not enough points in the path");
+
+        const Size fixings = pastFixings_ + n - firstFixing_;
+        Real sum = runningSum_;
+        for (Size i=firstFixing_; i<n; ++i)
+            sum += path[i];
+        const Real payoff = std::max(phi_*(sum/fixings - strike_), 0.0);
+        const Real value = discount_*payoff;
+
+        if (payoff == 0.0) {
+            // the discounting gives no contribution either
+            addGreeks(0.0, 0.0, 0.0);
+        } else {
+            derivatives_.spotDerivatives(path, dSpot_);
+            derivatives_.volatilityDerivatives(path, dVol_);
+            derivatives_.rateDerivatives(path, dRate_);
+            Real delta = 0.0, vega = 0.0, rho = 0.0;
+            for (Size i=firstFixing_; i<n; ++i) {
+                delta += dSpot_[i];
+                vega += dVol_[i];
+                rho += dRate_[i];
+            }
+            const Real factor = phi_*discount_/fixings;
+            addGreeks(factor*delta, factor*vega,
+                      factor*rho - paymentTime_*value);
+        }
+
+        return value;
+    }
+
+
+    LikelihoodRatioPathPricer::LikelihoodRatioPathPricer(
+                        std::shared_ptr<PathPricer<Path> > pricer,
+                        std::shared_ptr<PathPricer<Path> > timeWeightedPricer,
+                        BlackScholesPathDerivatives derivatives,
+                        bool antitheticVariate)
+    : GreeksPathPricer(antitheticVariate), pricer_(std::move(pricer)),
+      timeWeightedPricer_(std::move(timeWeightedPricer)),
+      derivatives_(std::move(derivatives)) {
+        QL_REQUIRE(pricer_, "null path pricer given");
+        QL_REQUIRE(timeWeightedPricer_, "null time-weighted path pricer given");
+    }
+
+    Real LikelihoodRatioPathPricer::operator()(const Path& path) const {
+        const Real value = (*pricer_)(path);
+        const Real timeWeightedValue = (*timeWeightedPricer_)(path);
+        if (value == 0.0 && timeWeightedValue == 0.0) {
+            addGreeks(0.0, 0.0, 0.0);
+        } else {
+            addGreeks(value*derivatives_.spotWeight(path),
+                      value*derivatives_.volatilityWeight(path),
+                      value*derivatives_.rateWeight(path)
+                      - timeWeightedValue);
+        }
+        return value;
+    }
+
+}
@@ -0,0 +1,264 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcgreeks.hpp
+    \brief first-order greeks of single-asset Monte Carlo engines
+*/
+
+#ifndef quantlib_mc_greeks_hpp
+#define quantlib_mc_greeks_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/option.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! estimators of first-order greeks in Monte Carlo engines
+    /*! Pathwise estimators are not smoothed; engines pricing
+        discontinuous payoffs, such as barrier options, only provide
+        likelihood-ratio estimators.
+    */
+    struct MonteCarloGreeks {
+        enum Estimator {
+            None,            /*!< greeks are not calculated */
+            Pathwise,        /*!< derivatives of the path payoff;
+                                  requires a continuous payoff */
+            LikelihoodRatio  /*!< payoff times the derivatives of the
+                                  log-density of the path */
+        };
+    };
+
+    //! derivatives of Black-Scholes paths
+    /*! The paths are assumed to be generated by the exact lognormal
+        evolution of the process, i.e., the log-increment over the
+        k-th step is
+        \f[
+            \ln \frac{S_{k+1}}{S_k} = \mu_k + \sigma_k \sqrt{\Delta t_k}\, Z_k
+        \f]
+        with deterministic coefficients; the normal variates
+        \f$ Z_k \f$ are recovered from the path values.
+
+        Volatility derivatives refer to a parallel shift of the
+        instantaneous volatilities \f$ \sigma_k \f$, which is a
+        parallel shift of a flat Black volatility; rate derivatives
+        refer to a parallel shift of the continuously-compounded
+        risk-free rate in the drift. The effect of the rate on the
+        discount factors must be added by the path pricer.
+
+        \ingroup mcarlo
+    */
+    class BlackScholesPathDerivatives {
+      public:
+        BlackScholesPathDerivatives(
+            const std::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const TimeGrid& grid);
+
+        //! \name Pathwise derivatives
+        //@{
+        //! derivatives of the path values with respect to the spot
+        void spotDerivatives(const Path& path, Array& result) const;
+        //! derivatives of the path values with respect to the volatility
+        void volatilityDerivatives(const Path& path, Array& result) const;
+        //! derivatives of the path values with respect to the rate
+        void rateDerivatives(const Path& path, Array& result) const;
+        //@}
+
+        //! \name Likelihood-ratio weights
+        //@{
+        Real spotWeight(const Path& path) const;
+        Real volatilityWeight(const Path& path) const;
+        Real rateWeight(const Path& path) const;
+        //@}
+      private:
+        Real normal(const Path& path, Size k) const;
+        Array drift_, diffusion_, sqrtDt_;
+    };
+
+
+    //! accumulator of first-order greeks
+    /*! Path pricers inheriting from this class add the estimates of
+        delta, vega and rho of each path. If antithetic paths are
+        used, the estimates of each pair of paths are averaged before
+        being accumulated, as the prices are in MonteCarloModel.
+
+        \ingroup mcarlo
+    */
+    class GreeksAccumulator {
+      public:
+        explicit GreeksAccumulator(bool antitheticVariate)
+        : antitheticVariate_(antitheticVariate) {}
+        virtual ~GreeksAccumulator() = default;
+
+        const IncrementalStatistics& delta() const { return delta_; }
+        const IncrementalStatistics& vega() const { return vega_; }
+        const IncrementalStatistics& rho() const { return rho_; }
+
+      protected:
+        void addGreeks(Real delta, Real vega, Real rho) const;
+
+      private:
+        bool antitheticVariate_;
+        mutable bool pending_ = false;
+        mutable Real pendingDelta_ = 0.0, pendingVega_ = 0.0,
+                     pendingRho_ = 0.0;
+        mutable IncrementalStatistics delta_, vega_, rho_;
+    };
+
+
+    //! single-path pricer accumulating first-order greeks
+    /*! Derived classes return the discounted payoff of each path and
+        add the corresponding estimates of delta, vega and rho.
+
+        \ingroup mcarlo
+    */
+    class GreeksPathPricer : public PathPricer<Path>,
+                             public GreeksAccumulator {
+      public:
+        explicit GreeksPathPricer(bool antitheticVariate)
+        : GreeksAccumulator(antitheticVariate) {}
+    };
+
+
+    //! greeks of the last calculation of a Monte Carlo engine
+    /*! Engines hold an instance, pass the greeks pricer they build
+        in their pathPricer() method to setPricer() and call
+        fillResults() after the simulation. Besides delta, vega and
+        rho, the standard errors of the estimates are stored in the
+        additional results as "deltaError", "vegaError" and
+        "rhoError".
+
+        \ingroup mcarlo
+    */
+    class MonteCarloGreeksResults {
+      public:
+        explicit MonteCarloGreeksResults(
+            MonteCarloGreeks::Estimator estimator = MonteCarloGreeks::None)
+        : estimator_(estimator) {}
+
+        MonteCarloGreeks::Estimator estimator() const { return estimator_; }
+        //! forgets the pricer of the previous calculation
+        void reset() const { pricer_.reset(); }
+        //! stores the pricer accumulating the greeks and returns it
+        template <class Pricer>
+        std::shared_ptr<Pricer> setPricer(std::shared_ptr<Pricer> pricer) const {
+            pricer_ = pricer;
+            return pricer;
+        }
+        /*! copies the estimates to the given results, if a pricer
+            was set since the last reset; the vega is skipped if
+            withVega is false.
+        */
+        template <class Results>
+        void fillResults(Results& results, bool withVega = true) const;
+
+      private:
+        MonteCarloGreeks::Estimator estimator_;
+        mutable std::shared_ptr<const GreeksAccumulator> pricer_;
+    };
+
+
+    //! pathwise greeks of an option on the average of path values
+    /*! The payoff is \f$ \max(\phi(A-K), 0) \f$, paid at a fixed time,
+        where \f$ A \f$ is the arithmetic average of the path values
+        from the given node to the end of the path and of the past
+        fixings, if any. A European option is the special case of
+        a single fixing at the last node.
+
+        \ingroup mcarlo
+    */
+    class PathwiseAveragePathPricer : public GreeksPathPricer {
+      public:
+        PathwiseAveragePathPricer(Option::Type type,
+                                  Real strike,
+                                  DiscountFactor discount,
+                                  Time paymentTime,
+                                  BlackScholesPathDerivatives derivatives,
+                                  Size firstFixing,
+                                  bool antitheticVariate,
+                                  Real runningSum = 0.0,
+                                  Size pastFixings = 0);
+        Real operator()(const Path& path) const override;
+
+      private:
+        Real phi_, strike_;
+        DiscountFactor discount_;
+        Time paymentTime_;
+        BlackScholesPathDerivatives derivatives_;
+        Size firstFixing_;
+        Real runningSum_;
+        Size pastFixings_;
+        mutable Array dSpot_, dVol_, dRate_;
+    };
+
+
+    //! likelihood-ratio greeks of an arbitrary path pricer
+    /*! The estimators are the discounted payoff times the likelihood
+        ratio weights of the path; they don't require a continuous
+        payoff.
+
+        The effect of the rate on the discounting is given by a
+        second pricer of the same payoff whose discount factors are
+        multiplied by their times; it must return its value for the
+        same path, e.g., it must draw the same random numbers if any.
+
+        \ingroup mcarlo
+    */
+    class LikelihoodRatioPathPricer : public GreeksPathPricer {
+      public:
+        LikelihoodRatioPathPricer(
+            std::shared_ptr<PathPricer<Path> > pricer,
+            std::shared_ptr<PathPricer<Path> > timeWeightedPricer,
+            BlackScholesPathDerivatives derivatives,
+            bool antitheticVariate);
+        Real operator()(const Path& path) const override;
+
+      private:
+        std::shared_ptr<PathPricer<Path> > pricer_, timeWeightedPricer_;
+        BlackScholesPathDerivatives derivatives_;
+    };
+
+
+    // inline definitions
+
+    template <class Results>
+    inline void MonteCarloGreeksResults::fillResults(Results& results,
+                                                     bool withVega) const {
+        if (pricer_ == nullptr)
+            return;
+
+        results.delta = pricer_->delta().mean();
+        results.additionalResults["deltaError"] =
+            pricer_->delta().errorEstimate();
+        if (withVega) {
+            results.vega = pricer_->vega().mean();
+            results.additionalResults["vegaError"] =
+                pricer_->vega().errorEstimate();
+        }
+        results.rho = pricer_->rho().mean();
+        results.additionalResults["rhoError"] =
+            pricer_->rho().errorEstimate();
+    }
+
+}
+
+
+#endif
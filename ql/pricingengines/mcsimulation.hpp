@@ -106,11 +106,10 @@ namespace QuantLib {
         McSimulation<MC,RNG,S>::value(Real tolerance,
                                               Size maxSamples,
                                               Size minSamples) const {
-        Size sampleNumber =
-            mcModel_->sampleAccumulator().samples();
+        Size sampleNumber = mcModel_->samples();
         if (sampleNumber<minSamples) {
             mcModel_->addSamples(minSamples-sampleNumber);
-            sampleNumber = mcModel_->sampleAccumulator().samples();
+            sampleNumber = mcModel_->samples();
         }
 
         Size nextBatch;
@@ -130,8 +129,8 @@ namespace QuantLib {
 
             // do not exceed maxSamples
             nextBatch = std::min(nextBatch, maxSamples-sampleNumber);
-            sampleNumber += nextBatch;
             mcModel_->addSamples(nextBatch);
+            sampleNumber = mcModel_->samples();
             error = result_type(mcModel_->sampleAccumulator().errorEstimate());
         }
 
@@ -143,7 +142,7 @@ namespace QuantLib {
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::valueWithSamples(Size samples) const {
 
-        Size sampleNumber = mcModel_->sampleAccumulator().samples();
+        Size sampleNumber = mcModel_->samples();
 
         QL_REQUIRE(samples>=sampleNumber,
                    "number of already simulated samples (" << sampleNumber
@@ -0,0 +1,107 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelmcsimulation.hpp
+    \brief framework for multilevel Monte Carlo engines
+*/
+
+#ifndef quantlib_multilevel_montecarlo_engine_hpp
+#define quantlib_multilevel_montecarlo_engine_hpp
+
+#include <ql/methods/montecarlo/multilevelmontecarlomodel.hpp>
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/utilities/null.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! base class for multilevel Monte Carlo engines
+    /*! Deriving a class from MultilevelMcSimulation gives an easy way
+        to write a multilevel Monte Carlo engine; derived classes
+        provide the process, the coarsest time grid and the path
+        pricer for the time grid of any level, see
+        MultilevelMonteCarloModel.
+
+        See MLMCEuropeanHestonEngine as an example.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MultilevelMcSimulation {
+      public:
+        typedef MultilevelMonteCarloModel<RNG,S> model_type;
+        typedef typename model_type::path_pricer_type path_pricer_type;
+        typedef typename model_type::stats_type stats_type;
+
+        virtual ~MultilevelMcSimulation() = default;
+        //! model used by the last calculation
+        const std::shared_ptr<model_type>& model() const { return model_; }
+      protected:
+        MultilevelMcSimulation(bool antitheticVariate, Real weakOrder)
+        : antitheticVariate_(antitheticVariate), weakOrder_(weakOrder) {}
+        virtual std::shared_ptr<StochasticProcess> process() const = 0;
+        virtual TimeGrid coarsestTimeGrid() const = 0;
+        virtual std::shared_ptr<path_pricer_type> pathPricer(
+                                               const TimeGrid& grid) const = 0;
+        //! basic calculate method provided to inherited pricing engines
+        void calculate(Real requiredTolerance,
+                       Size maxLevels,
+                       Size initialSamples,
+                       BigNatural seed) const;
+
+        mutable std::shared_ptr<model_type> model_;
+        bool antitheticVariate_;
+        Real weakOrder_;
+    };
+
+
+    //! path pricer for the first asset of multi-asset paths
+    /*! It allows to use single-asset path pricers with
+        MultilevelMcSimulation.
+    */
+    class SingleAssetPathPricer : public PathPricer<MultiPath> {
+      public:
+        explicit SingleAssetPathPricer(std::shared_ptr<PathPricer<Path> > pricer)
+        : pricer_(std::move(pricer)) {}
+        Real operator()(const MultiPath& path) const override {
+            return (*pricer_)(path[0]);
+        }
+      private:
+        std::shared_ptr<PathPricer<Path> > pricer_;
+    };
+
+
+    // inline definitions
+
+    template <class RNG, class S>
+    inline void MultilevelMcSimulation<RNG,S>::calculate(
+                                                   Real requiredTolerance,
+                                                   Size maxLevels,
+                                                   Size initialSamples,
+                                                   BigNatural seed) const {
+        QL_REQUIRE(requiredTolerance != Null<Real>(),
+                   "required tolerance not given");
+
+        model_ = std::make_shared<model_type>(
+            process(), coarsestTimeGrid(),
+            [this](const TimeGrid& grid) { return this->pathPricer(grid); },
+            weakOrder_, antitheticVariate_, seed);
+        model_->calculate(requiredTolerance, maxLevels, initialSamples);
+    }
+
+}
+
+
+#endif
@@ -111,4 +111,45 @@ namespace QuantLib {
         }
     }
 
+    void DiscountingSwapEngine::npvAdjoint(const Swap& swap,
+                                           Real npvAdjoint,
+                                           DiscountAdjoints& adjoints) const {
+        Size n = swap.numberOfLegs();
+        legAdjoints(swap, std::vector<Real>(n, npvAdjoint),
+                    std::vector<Real>(n, 0.0), adjoints);
+    }
+
+    void DiscountingSwapEngine::legAdjoints(const Swap& swap,
+                                            const std::vector<Real>& legNPVAdjoints,
+                                            const std::vector<Real>& legBPSAdjoints,
+                                            DiscountAdjoints& adjoints) const {
+        QL_REQUIRE(!discountCurve_.empty(),
+                   "discounting term structure handle is empty");
+
+        Size n = swap.numberOfLegs();
+        QL_REQUIRE(legNPVAdjoints.size() == n && legBPSAdjoints.size() == n,
+                   "wrong number of leg adjoints");
+
+        Date refDate = discountCurve_->referenceDate();
+        Date settlementDate =
+            settlementDate_ == Date() ? refDate : settlementDate_;
+        Date valuationDate = npvDate_ == Date() ? refDate : npvDate_;
+
+        bool includeRefDateFlows = includeSettlementDateFlows_ ? // NOLINT(readability-implicit-bool-conversion)
+                                       *includeSettlementDateFlows_ :
+                                       Settings::instance().includeReferenceDateEvents();
+
+        for (Size i=0; i<n; ++i) {
+            Real sign = swap.payer(i) ? -1.0 : 1.0;
+            CashFlows::npvbpsAdjoint(swap.leg(i),
+                                     **discountCurve_,
+                                     includeRefDateFlows,
+                                     settlementDate,
+                                     valuationDate,
+                                     sign * legNPVAdjoints[i],
+                                     sign * legBPSAdjoints[i],
+                                     adjoints);
+        }
+    }
+
 }
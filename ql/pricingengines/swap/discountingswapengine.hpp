@@ -32,6 +32,8 @@
 
 namespace QuantLib {
 
+    class DiscountAdjoints;
+
     class DiscountingSwapEngine : public Swap::engine {
       public:
         DiscountingSwapEngine(
@@ -43,6 +45,23 @@ namespace QuantLib {
         Handle<YieldTermStructure> discountCurve() const {
             return discountCurve_;
         }
+        //! \name Adjoints
+        //@{
+        /*! adds to the given adjoints the derivatives of
+            npvAdjoint times the NPV of the swap, as calculated by
+            this engine, with respect to the discount factors it reads.
+        */
+        void npvAdjoint(const Swap& swap,
+                        Real npvAdjoint,
+                        DiscountAdjoints& adjoints) const;
+        /*! same as above for a combination of the leg NPVs and BPSs
+            weighted by the given adjoints.
+        */
+        void legAdjoints(const Swap& swap,
+                         const std::vector<Real>& legNPVAdjoints,
+                         const std::vector<Real>& legBPSAdjoints,
+                         DiscountAdjoints& adjoints) const;
+        //@}
       private:
         Handle<YieldTermStructure> discountCurve_;
         std::optional<bool> includeSettlementDateFlows_;
@@ -45,6 +45,7 @@
 namespace QuantLib {
 
     class Quote;
+    class DiscountAdjoints;
 
     namespace detail {
 
@@ -70,6 +71,20 @@ namespace QuantLib {
         void calculate() const override;
         Handle<YieldTermStructure> termStructure() { return discountCurve_; }
         Handle<SwaptionVolatilityStructure> volatility() { return vol_; }
+        /*! adds to the given adjoints the derivatives of npvAdjoint
+            times the NPV of the swaption, as calculated by this
+            engine, with respect to the discount factors read through
+            the underlying swap.
+
+            \warning only available for annuities given by the fixed
+                     leg BPS (physical settlement or collateralized
+                     cash price) and for swaps without floating spread;
+                     the smile dependence of the volatility on the
+                     forward is not taken into account.
+        */
+        void npvAdjoint(const Swaption& swaption,
+                        Real npvAdjoint,
+                        DiscountAdjoints& adjoints) const;
 
       private:
         Handle<YieldTermStructure> discountCurve_;
@@ -313,6 +328,55 @@ namespace QuantLib {
         results_.additionalResults["impliedVolatility"] = Real(stdDev / std::sqrt(exerciseTime));
     }
 
+    template<class Spec>
+    void BlackStyleSwaptionEngine<Spec>::npvAdjoint(const Swaption& swaption,
+                                                    Real npvAdjoint,
+                                                    DiscountAdjoints& adjoints) const {
+        static const Spread basisPoint = 1.0e-4;
+
+        QL_REQUIRE(swaption.settlementType() == Settlement::Physical ||
+                   swaption.settlementMethod() == Settlement::CollateralizedCashPrice,
+                   "adjoint not available for par-yield cash settlement");
+
+        Date exerciseDate = swaption.exercise()->date(0);
+        VanillaSwap swap = *swaption.underlyingSwap();
+        QL_REQUIRE(swap.spread() == 0.0,
+                   "adjoint not available for swaps with floating spread");
+
+        auto swapEngine = std::make_shared<DiscountingSwapEngine>(discountCurve_, false);
+        swap.setPricingEngine(swapEngine);
+        Rate strike = swap.fixedRate();
+        Rate atmForward = swap.fairRate();
+        Real fixedLegBPS = swap.fixedLegBPS();
+        Real annuity = std::fabs(fixedLegBPS) / basisPoint;
+
+        Time swapLength = vol_->swapLength(swap.floatingSchedule().dates().front(),
+                                           swap.floatingSchedule().dates().back());
+        swapLength = std::max(swapLength, 1.0 / 12.0);
+        Real variance = vol_->blackVariance(exerciseDate, swapLength, strike);
+        Real displacement =
+            vol_->volatilityType() == ShiftedLognormal ?
+            vol_->shift(exerciseDate, swapLength) : 0.0;
+        Real stdDev = std::sqrt(variance);
+        Option::Type w = (swaption.type()==Swap::Payer) ? Option::Call : Option::Put;
+
+        // value = annuity * black(atmForward), with
+        // atmForward = strike - NPV/(fixedLegBPS/bp) and
+        // annuity = |fixedLegBPS|/bp
+        Real value = Spec().value(w, strike, atmForward, stdDev, annuity, displacement);
+        Real forwardAdjoint =
+            npvAdjoint * Spec().delta(w, strike, atmForward, stdDev, annuity, displacement);
+        Real annuityAdjoint = annuity != 0.0 ? Real(npvAdjoint * value / annuity) : 0.0;
+
+        Real npvAdjointOfSwap = - forwardAdjoint * basisPoint / fixedLegBPS;
+        Real bpsAdjoint = forwardAdjoint * (strike - atmForward) / fixedLegBPS
+            + annuityAdjoint * (fixedLegBPS < 0.0 ? -1.0 : 1.0) / basisPoint;
+        swapEngine->legAdjoints(swap,
+                                {npvAdjointOfSwap, npvAdjointOfSwap},
+                                {bpsAdjoint, 0.0},
+                                adjoints);
+    }
+
     }  // namespace detail
 
 }
@@ -21,6 +21,7 @@
 #include <ql/exercise.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/termstructures/yield/discountadjoints.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -114,5 +115,42 @@ namespace QuantLib {
         results_.additionalResults["timeToExpiry"] = tte;
     }
 
+    void AnalyticEuropeanEngine::npvAdjoint(const VanillaOption& option,
+                                            Real npvAdjoint,
+                                            DiscountAdjoints& adjoints) const {
+
+        const YieldTermStructure& discountCurve =
+            discountCurve_.empty() ? **process_->riskFreeRate() : **discountCurve_;
+
+        QL_REQUIRE(option.exercise()->type() == Exercise::European,
+                   "not an European option");
+
+        std::shared_ptr<StrikedTypePayoff> payoff =
+            std::dynamic_pointer_cast<StrikedTypePayoff>(option.payoff());
+        QL_REQUIRE(payoff, "non-striked payoff given");
+
+        Date lastDate = option.exercise()->lastDate();
+        Real variance =
+            process_->blackVolatility()->blackVariance(lastDate, payoff->strike());
+        DiscountFactor dividendDiscount =
+            process_->dividendYield()->discount(lastDate);
+        DiscountFactor df = discountCurve.discount(lastDate);
+        DiscountFactor riskFreeDiscountForFwdEstimation =
+            process_->riskFreeRate()->discount(lastDate);
+        Real spot = process_->stateVariable()->value();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+        Real forwardPrice = spot * dividendDiscount / riskFreeDiscountForFwdEstimation;
+
+        BlackCalculator black(payoff, forwardPrice, std::sqrt(variance), df);
+
+        // value = df * black(forward)
+        Real forwardAdjoint = npvAdjoint * black.deltaForward();
+        adjoints.add(discountCurve, lastDate, npvAdjoint * black.value() / df);
+        adjoints.add(**process_->dividendYield(), lastDate,
+                     forwardAdjoint * forwardPrice / dividendDiscount);
+        adjoints.add(**process_->riskFreeRate(), lastDate,
+                     -forwardAdjoint * forwardPrice / riskFreeDiscountForFwdEstimation);
+    }
+
 }
 
@@ -31,6 +31,8 @@
 
 namespace QuantLib {
 
+    class DiscountAdjoints;
+
     //! Pricing engine for European vanilla options using analytical formulae
     /*! \ingroup vanillaengines
 
@@ -75,6 +77,15 @@ namespace QuantLib {
                                Handle<YieldTermStructure> discountCurve);
         void calculate() const override;
 
+        /*! adds to the given adjoints the derivatives of npvAdjoint
+            times the NPV of the option, as calculated by this
+            engine, with respect to the discount factors it reads
+            from the risk-free, dividend and discount curves.
+        */
+        void npvAdjoint(const VanillaOption& option,
+                        Real npvAdjoint,
+                        DiscountAdjoints& adjoints) const;
+
       private:
         std::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Handle<YieldTermStructure> discountCurve_;
@@ -27,6 +27,7 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/math/integrals/discreteintegrals.hpp>
 #include <ql/math/integrals/exponentialintegrals.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
 #include <ql/math/integrals/kronrodintegral.hpp>
 #include <ql/math/integrals/simpsonintegral.hpp>
@@ -156,6 +157,10 @@ namespace QuantLib {
 
       Real operator()(Real phi) const;
 
+      /* exponent of the integrand without the strike-dependent term
+         -i phi ln(K); it is not defined for phi = 0. */
+      std::complex<Real> exponent(Real phi) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -244,6 +249,36 @@ namespace QuantLib {
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
+        if (cpxLog_ == Gatheral && phi == 0.0) {
+            // use l'Hospital's rule to get lim_{phi->0}
+            if (j_ == 1) {
+                const Real kmr = rsigma_-kappa_;
+                if (std::fabs(kmr) > 1e-7) {
+                    return dd_-sx_
+                        + (std::exp(kmr*term_)*kappa_*theta_
+                           -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
+                        - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
+                }
+                else
+                    // \kappa = \rho * \sigma
+                    return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                                   + 0.5*v0_*term_;
+            }
+            else {
+                return dd_-sx_
+                    - (std::exp(-kappa_*term_)*kappa_*theta_
+                       +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
+                    - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
+            }
+        }
+
+        return std::exp(exponent(phi) + std::complex<Real>(0.0, -phi*sx_)
+                        ).imag()/phi;
+    }
+
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::exponent(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -256,54 +291,26 @@ namespace QuantLib {
             engine_ != nullptr ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
         if (cpxLog_ == Gatheral) {
-            if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+            if (sigma_ > 1e-5) {
+                const std::complex<Real> p = (t1-d)/(t1+d);
+                const std::complex<Real> g
+                                        = std::log((1.0 - p*ex)/(1.0 - p));
+
+                return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                       + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                       + std::complex<Real>(0.0, phi*dd_)
+                       + addOnTerm;
             }
             else {
-                // use l'Hospital's rule to get lim_{phi->0}
-                if (j_ == 1) {
-                    const Real kmr = rsigma_-kappa_;
-                    if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
-                               -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
-                            - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
-                    }
-                    else
-                        // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
-                }
-                else {
-                    return dd_-sx_
-                        - (std::exp(-kappa_*term_)*kappa_*theta_
-                           +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
-                        - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
-                }
+                const std::complex<Real> td = phi/(2.0*t1)
+                               *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                const std::complex<Real> p = td*sigma2_/(t1+d);
+                const std::complex<Real> g = p*(1.0-ex);
+
+                return v0_*td*(1.0-ex)/(1.0-p*ex)
+                       + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                       + std::complex<Real>(0.0, phi*dd_)
+                       + addOnTerm;
             }
         }
         else if (cpxLog_ == BranchCorrection) {
@@ -349,11 +356,10 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2*b_*M_PI);
 
-            return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
-                            + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+            return v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
+                   + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
+                   + std::complex<Real>(0,phi*dd_)
+                   + addOnTerm;
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
@@ -405,6 +411,12 @@ namespace QuantLib {
     }
 
     Real AnalyticHestonEngine::AP_Helper::operator()(Real u) const {
+        return (std::exp(std::complex<Real>(0.0, u*freq_))
+                * integrandKernel(u)).real();
+    }
+
+    std::complex<Real>
+    AnalyticHestonEngine::AP_Helper::integrandKernel(Real u) const {
         QL_REQUIRE(   enginePtr_->addOnTerm(u, term_, 1)
                         == std::complex<Real>(0.0)
                    && enginePtr_->addOnTerm(u, term_, 2)
@@ -428,8 +440,7 @@ namespace QuantLib {
             QL_FAIL("unknown control variate");
         }
 
-        return (std::exp(std::complex<Real>(0.0, u*freq_))
-            * (phiBS - enginePtr_->chF(z, term_)) / (u*u + 0.25)).real();
+        return (phiBS - enginePtr_->chF(z, term_)) / (u*u + 0.25);
     }
 
     Real AnalyticHestonEngine::AP_Helper::controlVariateValue() const {
@@ -708,6 +719,470 @@ namespace QuantLib {
     }
 
 
+    Real AnalyticHestonEngine::priceAndGradient(
+        const PlainVanillaPayoff& payoff,
+        const Date& maturity,
+        Array& gradient) const {
+
+        QL_REQUIRE(integration_->isGaussianQuadrature(),
+                   "analytic gradient requires a Gaussian quadrature");
+
+        const std::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real forward = spotPrice*dividendDiscount/riskFreeDiscount;
+        const Real strike = payoff.strike();
+        const Time t = process->time(maturity);
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real rho = model_->rho();
+        const Real v0 = model_->v0();
+        const Real sigma2 = sigma*sigma;
+
+        typedef std::complex<Real> Complex;
+        const Complex i(0.0, 1.0);
+
+        // normalized characteristic function psi = exp(A + v0 B) of
+        // the log-forward in the "little trap" form, together with its
+        // derivatives with respect to theta, kappa, sigma, rho, v0
+        // and, last, z
+        const auto chFAndGradient = [&](const Complex& z,
+                                        Complex* dPsi) -> Complex {
+            const Complex xi = kappa - sigma*rho*i*z;
+            const Complex zz = z*z + i*z;
+            const Complex d = std::sqrt(xi*xi + sigma2*zz);
+            const Complex g = (xi - d)/(xi + d);
+            const Complex e = std::exp(-d*t);
+            const Complex q = (1.0 - e)/(1.0 - g*e);
+            const Complex h = (xi - d)/sigma2;
+            const Complex L = (xi - d)*t
+                - 2.0*std::log((1.0 - g*e)/(1.0 - g));
+            const Real c = kappa*theta/sigma2;
+
+            const Complex B = h*q;
+            const Complex psi = std::exp(c*L + v0*B);
+
+            // d xi/dp, d sigma/dp, d zz/dp and d c/dp for
+            // p = theta, kappa, sigma, rho, z
+            const Complex dXi[5] = { 0.0, 1.0, -rho*i*z, -sigma*i*z,
+                                     -sigma*rho*i };
+            const Real dSigma[5] = { 0.0, 0.0, 1.0, 0.0, 0.0 };
+            const Complex dZz[5] = { 0.0, 0.0, 0.0, 0.0, 2.0*z + i };
+            const Real dC[5] = { kappa/sigma2, theta/sigma2,
+                                 -2.0*c/sigma, 0.0, 0.0 };
+
+            for (Size j=0; j < 5; ++j) {
+                const Complex dD = (xi*dXi[j] + sigma*dSigma[j]*zz
+                                    + 0.5*sigma2*dZz[j])/d;
+                const Complex dE = -t*e*dD;
+                const Complex dG =
+                    2.0*(d*dXi[j] - xi*dD)/((xi + d)*(xi + d));
+                const Complex dH = (dXi[j] - dD)/sigma2
+                    - 2.0*(xi - d)*dSigma[j]/(sigma2*sigma);
+                const Complex dQ = (-dE*(1.0 - g*e)
+                                    + (1.0 - e)*(dG*e + g*dE))
+                    / ((1.0 - g*e)*(1.0 - g*e));
+                const Complex dL = (dXi[j] - dD)*t
+                    + 2.0*(dG*e + g*dE)/(1.0 - g*e) - 2.0*dG/(1.0 - g);
+
+                dPsi[j < 4 ? j : 5] =
+                    psi*(dC[j]*L + c*dL + v0*(dH*q + h*dQ));
+            }
+            dPsi[4] = psi*B;
+
+            return psi;
+        };
+
+        const Real freq = std::log(forward/strike);
+        std::vector<Real> nodes, weights;
+        Complex dPsi1[6], dPsi2[6];
+        Real callValue;
+        gradient = Array(5, 0.0);
+
+        switch (cpxLog_) {
+          case Gatheral:
+          case BranchCorrection: {
+            // P_j = 1/2 + 1/pi int Im(e^{iu ln(F/K)} f_j(u))/u du
+            // with f_1(u) = psi(u-i) and f_2(u) = psi(u), as in
+            // doCalculation; the little-trap form of psi needs no
+            // branch correction.
+            const Real s = std::sqrt(1.0-rho*rho);
+            const Real m = std::min(0.2, std::max(0.0001, s/sigma));
+            const Real c_inf = m*(v0 + kappa*theta*t);
+            integration_->quadratureNodes(c_inf, nodes, weights);
+
+            // derivatives of c_inf, which scales the nodes of some
+            // quadratures
+            Array dCInf(5, 0.0);
+            if (integration_->isScaledQuadrature()) {
+                if (m == s/sigma) {
+                    dCInf[2] = -s/sigma2*(v0 + kappa*theta*t);
+                    dCInf[3] = -rho/(s*sigma)*(v0 + kappa*theta*t);
+                }
+                dCInf[0] = m*kappa*t;
+                dCInf[1] = m*theta*t;
+                dCInf[4] = m;
+            }
+
+            Real p1 = 0.0, p2 = 0.0;
+            Array dP1(5, 0.0), dP2(5, 0.0);
+            // u f'(u) + f(u) for the integrands f; the derivative of
+            // the integrals with respect to c_inf is -1/c_inf times
+            // their integrals
+            Real nodeTerm1 = 0.0, nodeTerm2 = 0.0;
+            for (Size n=0; n < nodes.size(); ++n) {
+                const Real u = nodes[n];
+                const Complex psi1 = chFAndGradient(Complex(u, -1.0), dPsi1);
+                const Complex psi2 = chFAndGradient(Complex(u, 0.0), dPsi2);
+                const Complex phase = std::exp(i*(u*freq));
+                const Real w = weights[n]/u;
+                p1 += w*(phase*psi1).imag();
+                p2 += w*(phase*psi2).imag();
+                for (Size j=0; j < 5; ++j) {
+                    dP1[j] += w*(phase*dPsi1[j]).imag();
+                    dP2[j] += w*(phase*dPsi2[j]).imag();
+                }
+                nodeTerm1 += weights[n]
+                    *(phase*(i*freq*psi1 + dPsi1[5])).imag();
+                nodeTerm2 += weights[n]
+                    *(phase*(i*freq*psi2 + dPsi2[5])).imag();
+            }
+            evaluations_ = 2*nodes.size();
+
+            callValue = spotPrice*dividendDiscount*(p1/M_PI + 0.5)
+                - strike*riskFreeDiscount*(p2/M_PI + 0.5);
+            const Real dCallValue = -(spotPrice*dividendDiscount*nodeTerm1
+                - strike*riskFreeDiscount*nodeTerm2)/(M_PI*c_inf);
+            for (Size j=0; j < 5; ++j)
+                gradient[j] = (spotPrice*dividendDiscount*dP1[j]
+                               - strike*riskFreeDiscount*dP2[j])/M_PI
+                    + dCInf[j]*dCallValue;
+          }
+          break;
+          case AndersenPiterbarg:
+          case AndersenPiterbargOptCV:
+          case AsymptoticChF:
+          case OptimalCV: {
+            // C = D (C_cv + sqrt(KF)/pi int Re(e^{iu ln(F/K)}
+            //     (phi_cv(u) - psi(u-i/2)))/(u^2+1/4) du)
+            // as in doCalculation, differentiating the control
+            // variate as well
+            const Real s = std::sqrt(1.0-rho*rho);
+            const Real c_inf = s*(v0 + kappa*theta*t)/sigma;
+            integration_->quadratureNodes(c_inf, nodes, weights);
+
+            Array dCInf(5, 0.0);
+            if (integration_->isScaledQuadrature()) {
+                dCInf[0] = s*kappa*t/sigma;
+                dCInf[1] = s*theta*t/sigma;
+                dCInf[2] = -c_inf/sigma;
+                dCInf[3] = -rho/s*(v0 + kappa*theta*t)/sigma;
+                dCInf[4] = s/sigma;
+            }
+
+            const ComplexLogFormula cv = (cpxLog_ == OptimalCV)
+                ? optimalControlVariate(t, v0, kappa, theta, sigma, rho)
+                : cpxLog_;
+            const AP_Helper cvHelper(t, forward, strike, cv, this);
+            const Real cvValue = cvHelper.controlVariateValue();
+            Array dCvValue(5);
+
+            // phi_cv(u) = exp(a u^2 + b u + c), with the derivatives
+            // of the coefficients
+            Complex a, b, c;
+            Complex dA[5], dB[5], dC[5];
+
+            if (cv == AndersenPiterbarg || cv == AndersenPiterbargOptCV) {
+                Real vAvg;
+                Real dVAvg[5];
+                if (cv == AndersenPiterbarg) {
+                    const Real x = kappa*t;
+                    const Real f = (1.0 - std::exp(-x))/x;
+                    const Real dF = (x*std::exp(-x) - (1.0 - std::exp(-x)))
+                        /(kappa*kappa*t);
+                    vAvg = f*(v0 - theta) + theta;
+                    dVAvg[0] = 1.0 - f;
+                    dVAvg[1] = (v0 - theta)*dF;
+                    dVAvg[2] = dVAvg[3] = 0.0;
+                    dVAvg[4] = f;
+                } else {
+                    const Real psi = chFAndGradient(Complex(0.0, -0.5), dPsi1).real();
+                    vAvg = -8.0*std::log(psi)/t;
+                    for (Size j=0; j < 5; ++j)
+                        dVAvg[j] = -8.0*dPsi1[j].real()/(psi*t);
+                }
+                // Black-Scholes characteristic function at u-i/2
+                a = -0.5*vAvg*t;
+                b = 0.0;
+                c = -0.125*vAvg*t;
+                const Real dValue = BlackCalculator(
+                    Option::Call, strike, forward, std::sqrt(vAvg*t))
+                    .vega(t)/(2.0*std::sqrt(vAvg));
+                for (Size j=0; j < 5; ++j) {
+                    dA[j] = -0.5*t*dVAvg[j];
+                    dB[j] = 0.0;
+                    dC[j] = -0.125*t*dVAvg[j];
+                    dCvValue[j] = dValue*dVAvg[j];
+                }
+            } else {
+                // asymptotic characteristic function exp(u phi + psi),
+                // see AP_Helper
+                const Real s = std::sqrt(1.0 - rho*rho);
+                const Real V = v0 + t*kappa*theta;
+                const Real dV[5] = { t*kappa, t*theta, 0.0, 0.0, 1.0 };
+                const Real asinRho = std::atan(rho/s);
+                const Real logS = std::log(4*(1.0 - rho*rho));
+                const Real g = (0.5*rho*rho*sigma - kappa*rho)/s;
+                const Real dG[5] = {
+                    0.0, -rho/s, 0.5*rho*rho/s,
+                    (rho*sigma - kappa)/s + g*rho/(s*s), 0.0 };
+                const Real R = (kappa - 0.5*rho*sigma)*V + kappa*theta*logS;
+                const Real I = -g*V + 2*kappa*theta*asinRho;
+                const Real dR[5] = {
+                    (kappa - 0.5*rho*sigma)*dV[0] + kappa*logS,
+                    V + (kappa - 0.5*rho*sigma)*dV[1] + theta*logS,
+                    -0.5*rho*V,
+                    -0.5*sigma*V - 2.0*kappa*theta*rho/(1.0 - rho*rho),
+                    kappa - 0.5*rho*sigma };
+                const Real dI[5] = {
+                    -g*dV[0] + 2*kappa*asinRho,
+                    -dG[1]*V - g*dV[1] + 2*theta*asinRho,
+                    -dG[2]*V,
+                    -dG[3]*V + 2*kappa*theta/s,
+                    -g };
+                const Real dSigma[5] = { 0.0, 0.0, 1.0, 0.0, 0.0 };
+                const Real dRho[5] = { 0.0, 0.0, 0.0, 1.0, 0.0 };
+                const Real dS[5] = { 0.0, 0.0, 0.0, -rho/s, 0.0 };
+
+                const Complex phi = -V/sigma*Complex(s, rho);
+                const Complex psi = Complex(R, I)/sigma2;
+                a = 0.0;
+                b = phi;
+                c = psi;
+
+                // C_cv = F - sqrt(KF)/pi Re(e^psi G(phi + i ln(F/K)))
+                using namespace ExponentialIntegral;
+                const Complex x = 0.5*Complex(phi.real(), phi.imag() + freq);
+                const Complex G = -2.0*Ci(-x)*std::sin(x)
+                    + std::cos(x)*(M_PI + 2.0*Si(x));
+                const Complex dGdPhi = -Ci(-x)*std::cos(x)
+                    - 0.5*std::sin(x)*(M_PI + 2.0*Si(x));
+
+                for (Size j=0; j < 5; ++j) {
+                    dA[j] = 0.0;
+                    dB[j] = -dV[j]/sigma*Complex(s, rho)
+                        + V/sigma2*dSigma[j]*Complex(s, rho)
+                        - V/sigma*Complex(dS[j], dRho[j]);
+                    dC[j] = Complex(dR[j], dI[j])/sigma2
+                        - 2.0*psi/sigma*dSigma[j];
+                    dCvValue[j] = -std::sqrt(strike*forward)/M_PI
+                        *(std::exp(psi)*(dC[j]*G + dGdPhi*dB[j])).real();
+                }
+            }
+
+            Real h = 0.0, nodeTerm = 0.0;
+            Array dH(5, 0.0);
+            for (Size n=0; n < nodes.size(); ++n) {
+                const Real u = nodes[n];
+                const Complex phiCv = std::exp(a*u*u + b*u + c);
+                const Complex psi = chFAndGradient(Complex(u, -0.5), dPsi1);
+                const Complex phase = std::exp(i*(u*freq));
+                const Real u2 = u*u + 0.25;
+                const Real w = weights[n]/u2;
+                const Complex delta = phiCv - psi;
+                h += w*(phase*delta).real();
+                for (Size j=0; j < 5; ++j) {
+                    const Complex dPhiCv = phiCv*(dA[j]*u*u + dB[j]*u + dC[j]);
+                    dH[j] += w*(phase*(dPhiCv - dPsi1[j])).real();
+                }
+                const Complex dDelta = phiCv*(2.0*a*u + b) - dPsi1[5];
+                nodeTerm += w*((phase*((1.0 + i*(freq*u))*delta
+                                       + u*dDelta)).real()
+                               - 2.0*u*u*(phase*delta).real()/u2);
+            }
+            evaluations_ = nodes.size();
+
+            const Real factor = std::sqrt(strike*forward)/M_PI;
+            callValue = riskFreeDiscount*(cvValue + factor*h);
+            for (Size j=0; j < 5; ++j)
+                gradient[j] = riskFreeDiscount*(dCvValue[j] + factor*dH[j]
+                                    - dCInf[j]*factor*nodeTerm/c_inf);
+          }
+          break;
+          default:
+            QL_FAIL("unknown complex log formula");
+        }
+
+        switch (payoff.optionType()) {
+          case Option::Call:
+            return callValue;
+          case Option::Put:
+            return callValue - riskFreeDiscount*(forward - strike);
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+
+    std::vector<Real> AnalyticHestonEngine::prices(
+        const std::vector<std::shared_ptr<PlainVanillaPayoff> >& payoffs,
+        const Date& maturity) const {
+
+        const std::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(maturity);
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0 = model_->v0();
+        const Real rho = model_->rho();
+
+        std::vector<Real> values(payoffs.size());
+        if (payoffs.empty())
+            return values;
+
+        if (!integration_->isGaussianQuadrature()) {
+            evaluations_ = 0;
+            for (Size i=0; i < payoffs.size(); ++i) {
+                Size evaluations;
+                doCalculation(riskFreeDiscount, dividendDiscount, spotPrice,
+                              payoffs[i]->strike(), term,
+                              kappa, theta, sigma, v0, rho,
+                              *payoffs[i], *integration_, cpxLog_, this,
+                              values[i], evaluations);
+                evaluations_ += evaluations;
+            }
+            return values;
+        }
+
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+        const Real fwdPrice = spotPrice/ratio;
+        const std::complex<Real> i(0.0, 1.0);
+
+        std::vector<Real> nodes, weights;
+
+        switch (cpxLog_) {
+          case Gatheral:
+          case BranchCorrection: {
+            const Real c_inf = std::min(0.2, std::max(0.0001,
+                std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+            integration_->quadratureNodes(c_inf, nodes, weights);
+
+            // the strike only enters the phase of the integrands
+            const Real anyStrike = payoffs.front()->strike();
+            const Fj_Helper f1(kappa, theta, sigma, v0, spotPrice, rho, this,
+                               cpxLog_, term, anyStrike, ratio, 1);
+            const Fj_Helper f2(kappa, theta, sigma, v0, spotPrice, rho, this,
+                               cpxLog_, term, anyStrike, ratio, 2);
+
+            std::vector<std::complex<Real> > e1(nodes.size()), e2(nodes.size());
+            for (Size n=0; n < nodes.size(); ++n) {
+                e1[n] = std::exp(f1.exponent(nodes[n]));
+                e2[n] = std::exp(f2.exponent(nodes[n]));
+            }
+            evaluations_ = 2*nodes.size();
+
+            for (Size k=0; k < payoffs.size(); ++k) {
+                const Real strike = payoffs[k]->strike();
+                const Real sx = std::log(strike);
+
+                Real p1 = 0.0, p2 = 0.0;
+                for (Size n=0; n < nodes.size(); ++n) {
+                    const Real phi = nodes[n];
+                    const std::complex<Real> phase = std::exp(-i*(phi*sx));
+                    p1 += weights[n]*(e1[n]*phase).imag()/phi;
+                    p2 += weights[n]*(e2[n]*phase).imag()/phi;
+                }
+                p1 /= M_PI;
+                p2 /= M_PI;
+
+                switch (payoffs[k]->optionType()) {
+                  case Option::Call:
+                    values[k] = spotPrice*dividendDiscount*(p1+0.5)
+                        - strike*riskFreeDiscount*(p2+0.5);
+                    break;
+                  case Option::Put:
+                    values[k] = spotPrice*dividendDiscount*(p1-0.5)
+                        - strike*riskFreeDiscount*(p2-0.5);
+                    break;
+                  default:
+                    QL_FAIL("unknown option type");
+                }
+            }
+          }
+          break;
+          case AndersenPiterbarg:
+          case AndersenPiterbargOptCV:
+          case AsymptoticChF:
+          case OptimalCV: {
+            const Real c_inf =
+                std::sqrt(1.0-rho*rho)*(v0 + kappa*theta*term)/sigma;
+            integration_->quadratureNodes(c_inf, nodes, weights);
+
+            const ComplexLogFormula cv = (cpxLog_ == OptimalCV)
+                ? optimalControlVariate(term, v0, kappa, theta, sigma, rho)
+                : cpxLog_;
+
+            std::vector<std::complex<Real> > kernel(nodes.size());
+            {
+                const AP_Helper helper(term, fwdPrice,
+                                       payoffs.front()->strike(), cv, this);
+                for (Size n=0; n < nodes.size(); ++n)
+                    kernel[n] = helper.integrandKernel(nodes[n]);
+            }
+            evaluations_ = nodes.size();
+
+            for (Size k=0; k < payoffs.size(); ++k) {
+                const Real strike = payoffs[k]->strike();
+                const AP_Helper cvHelper(term, fwdPrice, strike, cv, this);
+                const Real freq = std::log(fwdPrice/strike);
+
+                Real h = 0.0;
+                for (Size n=0; n < nodes.size(); ++n)
+                    h += weights[n]
+                        *(std::exp(i*(nodes[n]*freq))*kernel[n]).real();
+                const Real h_cv = h*std::sqrt(strike*fwdPrice)/M_PI;
+                const Real cvValue = cvHelper.controlVariateValue();
+
+                switch (payoffs[k]->optionType()) {
+                  case Option::Call:
+                    values[k] = (cvValue + h_cv)*riskFreeDiscount;
+                    break;
+                  case Option::Put:
+                    values[k] = (cvValue + h_cv - (fwdPrice - strike))
+                        *riskFreeDiscount;
+                    break;
+                  default:
+                    QL_FAIL("unknown option type");
+                }
+            }
+          }
+          break;
+          default:
+            QL_FAIL("unknown complex log formula");
+        }
+
+        return values;
+    }
+
+
     AnalyticHestonEngine::Integration::Integration(Algorithm intAlgo,
                                                    std::shared_ptr<Integrator> integrator)
     : intAlgo_(intAlgo), integrator_(std::move(integrator)) {}
@@ -808,6 +1283,44 @@ namespace QuantLib {
         }
     }
 
+    bool AnalyticHestonEngine::Integration::isGaussianQuadrature() const {
+        return intAlgo_ == GaussLaguerre
+            || intAlgo_ == GaussLegendre
+            || intAlgo_ == GaussChebyshev
+            || intAlgo_ == GaussChebyshev2nd;
+    }
+
+    void AnalyticHestonEngine::Integration::quadratureNodes(
+        Real c_inf,
+        std::vector<Real>& nodes,
+        std::vector<Real>& weights) const {
+
+        QL_REQUIRE(isGaussianQuadrature(),
+                   "nodes are only available for Gaussian quadratures");
+
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+
+        nodes.clear();
+        weights.clear();
+        // same order as GaussianQuadrature::operator()
+        for (Size i=x.size(); i-- > 0;) {
+            if (intAlgo_ == GaussLaguerre) {
+                nodes.push_back(x[i]);
+                weights.push_back(w[i]);
+            }
+            // same variable transformation as integrand1
+            else if ((1.0-x[i])*c_inf > QL_EPSILON) {
+                nodes.push_back(-std::log(0.5-0.5*x[i])/c_inf);
+                weights.push_back(w[i]/((1.0-x[i])*c_inf));
+            }
+        }
+    }
+
+    bool AnalyticHestonEngine::Integration::isScaledQuadrature() const {
+        return isGaussianQuadrature() && intAlgo_ != GaussLaguerre;
+    }
+
     bool AnalyticHestonEngine::Integration::isAdaptiveIntegration() const {
         return intAlgo_ == GaussLobatto
             || intAlgo_ == GaussKronrod
@@ -77,6 +77,11 @@ namespace QuantLib {
         Interest Rate Modeling, Volume I: Foundations and Vanilla Models,
         Atlantic Financial Press London.
 
+        Y. Cui, S. del Baño Rollin and G. Germano, 2017,
+        Full and fast calibration of the Heston stochastic volatility
+        model, European Journal of Operational Research 263(2),
+        pp. 625-638.
+
 
         \ingroup vanillaengines
 
@@ -132,6 +137,36 @@ namespace QuantLib {
         void calculate() const override;
         Size numberOfEvaluations() const;
 
+        const Integration& integration() const;
+
+        /*! returns the price of a European plain-vanilla option and
+            its derivatives with respect to the model parameters
+            theta, kappa, sigma, rho and v0, i.e., in the order of
+            HestonModel::params(). The derivatives of the
+            characteristic function are calculated analytically
+            following Cui et al. and integrated together with the
+            price, using the quadrature nodes and the complex-log
+            formula or control variate of the engine; the price
+            equals the one returned by calculate() and the gradient
+            is its exact derivative, up to rounding errors.
+
+            \pre the integration of the engine must be a Gaussian
+                 quadrature.
+        */
+        Real priceAndGradient(const PlainVanillaPayoff& payoff,
+                              const Date& maturity,
+                              Array& gradient) const;
+
+        /*! returns the prices of European plain-vanilla options with
+            a common maturity. If the integration is a Gaussian
+            quadrature, the characteristic function is evaluated only
+            once per quadrature node and shared by all strikes;
+            otherwise, the options are priced one by one.
+        */
+        std::vector<Real> prices(
+            const std::vector<std::shared_ptr<PlainVanillaPayoff> >& payoffs,
+            const Date& maturity) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -163,6 +198,11 @@ namespace QuantLib {
             Real operator()(Real u) const;
             Real controlVariateValue() const;
 
+            /*! strike-independent part of the integrand, i.e.
+                operator()(u) = Re(exp(iu ln(F/K)) integrandKernel(u))
+            */
+            std::complex<Real> integrandKernel(Real u) const;
+
           private:
             const Time term_;
             const Real fwd_, strike_, freq_;
@@ -227,6 +267,20 @@ namespace QuantLib {
 
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
+        bool isGaussianQuadrature() const;
+
+        /*! nodes and weights of the Gaussian quadratures, such that
+            calculate(c_inf, f) is the weighted sum of f at the nodes.
+            The nodes are returned in the order in which calculate()
+            evaluates f, as needed by the branch correction.
+        */
+        void quadratureNodes(Real c_inf,
+                             std::vector<Real>& nodes,
+                             std::vector<Real>& weights) const;
+        /*! whether the nodes and weights returned by
+            quadratureNodes() are inversely proportional to c_inf
+        */
+        bool isScaledQuadrature() const;
 
       private:
         enum Algorithm
@@ -246,6 +300,11 @@ namespace QuantLib {
 
     // inline
 
+    inline const AnalyticHestonEngine::Integration&
+    AnalyticHestonEngine::integration() const {
+        return *integration_;
+    }
+
     inline 
     std::complex<Real> AnalyticHestonEngine::addOnTerm(Real,
                                                        Time,
@@ -0,0 +1,62 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/vanilla/characteristicfunction.hpp>
+
+namespace QuantLib {
+
+    HestonCharacteristicFunction::HestonCharacteristicFunction(
+        const std::shared_ptr<HestonModel>& model)
+    : engine_(std::make_shared<AnalyticHestonEngine>(model)) {}
+
+    std::complex<Real> HestonCharacteristicFunction::operator()(
+        const std::complex<Real>& u, Time t) const {
+        return engine_->chF(u, t);
+    }
+
+
+    BatesCharacteristicFunction::BatesCharacteristicFunction(
+        const std::shared_ptr<BatesModel>& model)
+    : HestonCharacteristicFunction(model), model_(model) {}
+
+    std::complex<Real> BatesCharacteristicFunction::operator()(
+        const std::complex<Real>& u, Time t) const {
+
+        const Real nu     = model_->nu();
+        const Real delta2 = 0.5*model_->delta()*model_->delta();
+        const Real lambda = model_->lambda();
+        const std::complex<Real> g(-u.imag(), u.real());
+
+        // compensated log-normal jumps, see BatesEngine::addOnTerm
+        return HestonCharacteristicFunction::operator()(u, t)
+            * std::exp(t*lambda*(std::exp(nu*g + delta2*g*g) - 1.0
+                                 - g*(std::exp(nu+delta2) - 1.0)));
+    }
+
+
+    PiecewiseTimeDependentHestonCharacteristicFunction::
+    PiecewiseTimeDependentHestonCharacteristicFunction(
+        const std::shared_ptr<PiecewiseTimeDependentHestonModel>& model)
+    : engine_(std::make_shared<AnalyticPTDHestonEngine>(model)) {}
+
+    std::complex<Real>
+    PiecewiseTimeDependentHestonCharacteristicFunction::operator()(
+        const std::complex<Real>& u, Time t) const {
+        return engine_->chF(u, t);
+    }
+
+}
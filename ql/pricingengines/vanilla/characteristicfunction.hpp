@@ -0,0 +1,92 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file characteristicfunction.hpp
+    \brief characteristic functions of the log spot of affine models
+*/
+
+#ifndef quantlib_characteristic_function_hpp
+#define quantlib_characteristic_function_hpp
+
+#include <ql/models/equity/batesmodel.hpp>
+#include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <complex>
+
+namespace QuantLib {
+
+    //! characteristic function of the normalized log spot
+    /*! The characteristic function
+        \f[
+            \phi(u, t) = E\left[ e^{iu \ln(S_t/F_t)} \right]
+        \f]
+        of the log spot normalized by its forward \f$ F_t \f$.
+        Fourier pricers evaluate it for complex arguments within the
+        strip of finite exponential moments, e.g.
+        \f$ \phi(-i, t) = 1 \f$.
+    */
+    class CharacteristicFunction {
+      public:
+        virtual ~CharacteristicFunction() = default;
+        virtual std::complex<Real> operator()(
+            const std::complex<Real>& u, Time t) const = 0;
+    };
+
+    //! characteristic function of the Heston model
+    class HestonCharacteristicFunction : public CharacteristicFunction {
+      public:
+        explicit HestonCharacteristicFunction(
+            const std::shared_ptr<HestonModel>& model);
+
+        std::complex<Real> operator()(
+            const std::complex<Real>& u, Time t) const override;
+
+      private:
+        const std::shared_ptr<AnalyticHestonEngine> engine_;
+    };
+
+    //! characteristic function of the Bates model
+    class BatesCharacteristicFunction : public HestonCharacteristicFunction {
+      public:
+        explicit BatesCharacteristicFunction(
+            const std::shared_ptr<BatesModel>& model);
+
+        std::complex<Real> operator()(
+            const std::complex<Real>& u, Time t) const override;
+
+      private:
+        const std::shared_ptr<BatesModel> model_;
+    };
+
+    //! characteristic function of the piecewise time dependent Heston model
+    class PiecewiseTimeDependentHestonCharacteristicFunction
+        : public CharacteristicFunction {
+      public:
+        explicit PiecewiseTimeDependentHestonCharacteristicFunction(
+            const std::shared_ptr<PiecewiseTimeDependentHestonModel>& model);
+
+        std::complex<Real> operator()(
+            const std::complex<Real>& u, Time t) const override;
+
+      private:
+        const std::shared_ptr<AnalyticPTDHestonEngine> engine_;
+    };
+
+}
+
+#endif
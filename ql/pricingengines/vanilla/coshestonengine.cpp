@@ -60,9 +60,16 @@ namespace QuantLib {
             std::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non plain vanilla payoff given");
 
+        results_.value =
+            prices({ payoff }, arguments_.exercise->lastDate()).front();
+    }
+
+    std::vector<Real> COSHestonEngine::prices(
+        const std::vector<std::shared_ptr<PlainVanillaPayoff> >& payoffs,
+        const Date& maturityDate) const {
+
         const std::shared_ptr<HestonProcess> process = model_->process();
 
-        const Date maturityDate = arguments_.exercise->lastDate();
         const Time maturity = process->time(maturityDate);
 
         const Real cum1 = c1(maturity);
@@ -71,7 +78,6 @@ namespace QuantLib {
             // + std::sqrt(std::fabs(c4(maturity)))
         );
 
-        const Real k = payoff->strike();
         const Real spot = process->s0()->value();
         QL_REQUIRE(spot > 0.0, "negative or null underlying given");
 
@@ -80,48 +86,61 @@ namespace QuantLib {
         const DiscountFactor qf
             = process->dividendYield()->discount(maturityDate);
         const Real fwd = spot*qf/df;
-        const Real x = std::log(fwd/k);
-
-        const Real a = x + cum1 - L_*w;
-        const Real b = x + cum1 + L_*w;
-        
-        // Check if it exceeds the truncation bound
-        
-        if (x >= b/2 || x <= a/2) {
-            //returns lower/upper bounds
-            if (payoff->optionType() == Option::Put)
-                results_.value = std::max(-spot*qf+k*df,0.0);
-            else if (payoff->optionType() == Option::Call)
-           	    results_.value = std::max(spot*qf-k*df,0.0);
-       	    else
-                QL_FAIL("unknown payoff type");
-            return;
-        }
-		
-
-        const Real d = 1.0/(b-a);
 
-        const Real expA = std::exp(a);
-        Real s = chF(0, maturity).real()*(expA-1-a)*d;
+        // with a = x + cum1 - L*w, both 1/(b-a) and x-a are
+        // independent of the strike
+        const Real d = 1.0/(2.0*L_*w);
+        const Real xma = L_*w - cum1;
 
+        std::vector<std::complex<Real> > phi(N_);
         for (Size n=1; n < N_; ++n) {
             const Real r = n*M_PI*d;
-            const Real U_n = 2.0*d*( 1.0/(1.0 + r*r)
-                *(expA + r*std::sin(r*a) - std::cos(r*a)) - 1.0/r*std::sin(r*a));
-
-            s += U_n*(chF(r, maturity)
-                     *std::exp(std::complex<Real>(0, r*(x-a)))).real();
+            phi[n] = chF(r, maturity)*std::exp(std::complex<Real>(0, r*xma));
         }
+        const Real phi0 = chF(0, maturity).real();
+
+        std::vector<Real> values(payoffs.size());
+        for (Size i=0; i < payoffs.size(); ++i) {
+            const std::shared_ptr<PlainVanillaPayoff>& payoff = payoffs[i];
+            const Real k = payoff->strike();
+            const Real x = std::log(fwd/k);
 
-        if (payoff->optionType() == Option::Put)
-            results_.value = k*df*s;
-        else if (payoff->optionType() == Option::Call) {
-            const DiscountFactor qf
-                = process->dividendYield()->discount(maturityDate);
-            results_.value = spot*qf - k*df*(1-s);
+            const Real a = x + cum1 - L_*w;
+            const Real b = x + cum1 + L_*w;
+
+            // Check if it exceeds the truncation bound
+
+            if (x >= b/2 || x <= a/2) {
+                //returns lower/upper bounds
+                if (payoff->optionType() == Option::Put)
+                    values[i] = std::max(-spot*qf+k*df,0.0);
+                else if (payoff->optionType() == Option::Call)
+                    values[i] = std::max(spot*qf-k*df,0.0);
+                else
+                    QL_FAIL("unknown payoff type");
+                continue;
+            }
+
+            const Real expA = std::exp(a);
+            Real s = phi0*(expA-1-a)*d;
+
+            for (Size n=1; n < N_; ++n) {
+                const Real r = n*M_PI*d;
+                const Real U_n = 2.0*d*( 1.0/(1.0 + r*r)
+                    *(expA + r*std::sin(r*a) - std::cos(r*a)) - 1.0/r*std::sin(r*a));
+
+                s += U_n*phi[n].real();
+            }
+
+            if (payoff->optionType() == Option::Put)
+                values[i] = k*df*s;
+            else if (payoff->optionType() == Option::Call)
+                values[i] = spot*qf - k*df*(1-s);
+            else
+                QL_FAIL("unknown payoff type");
         }
-        else
-            QL_FAIL("unknown payoff type");
+
+        return values;
     }
 
     Real COSHestonEngine::muT(Time t) const {
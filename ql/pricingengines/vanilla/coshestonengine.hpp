@@ -29,6 +29,7 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 
 #include <complex>
+#include <vector>
 
 namespace QuantLib {
 
@@ -61,6 +62,16 @@ namespace QuantLib {
         void update() override;
         void calculate() const override;
 
+        /*! returns the prices of European plain-vanilla options with
+            a common maturity. The truncation range is centered on
+            the log-moneyness and its width doesn't depend on the
+            strike, hence the characteristic function is evaluated
+            only once per expansion term and shared by all strikes.
+        */
+        std::vector<Real> prices(
+            const std::vector<std::shared_ptr<PlainVanillaPayoff> >& payoffs,
+            const Date& maturity) const;
+
         // normalized characteristic function
         std::complex<Real> chF(Real u, Real t) const;
 
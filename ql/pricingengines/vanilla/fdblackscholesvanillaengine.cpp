@@ -31,9 +31,47 @@
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/settings.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        bool solutionCacheKey(
+            const std::shared_ptr<Payoff>& payoff,
+            const std::shared_ptr<Exercise>& exercise,
+            const DividendSchedule& dividends,
+            std::vector<Real>& key) {
+
+            const std::shared_ptr<PlainVanillaPayoff> plainPayoff =
+                std::dynamic_pointer_cast<PlainVanillaPayoff>(payoff);
+            if (plainPayoff == nullptr)
+                return false;
+
+            key.clear();
+            key.push_back(Real(plainPayoff->optionType()));
+            key.push_back(plainPayoff->strike());
+
+            key.push_back(Real(exercise->type()));
+            const std::shared_ptr<EarlyExercise> earlyExercise =
+                std::dynamic_pointer_cast<EarlyExercise>(exercise);
+            key.push_back(Real(earlyExercise != nullptr
+                               && earlyExercise->payoffAtExpiry()));
+            for (const auto& d: exercise->dates())
+                key.push_back(Real(d.serialNumber()));
+
+            for (const auto& cf: dividends) {
+                if (std::dynamic_pointer_cast<FixedDividend>(cf) == nullptr)
+                    return false;
+                key.push_back(Real(cf->date().serialNumber()));
+                key.push_back(cf->amount());
+            }
+
+            return true;
+        }
+
+    }
+
     FdBlackScholesVanillaEngine::FdBlackScholesVanillaEngine(
         std::shared_ptr<GeneralizedBlackScholesProcess> process,
         Size tGrid,
@@ -156,6 +194,52 @@ namespace QuantLib {
               QL_FAIL("unknwon cash dividend model");
         }
 
+        const Real spot = process_->x0() + spotAdjustment;
+
+        const auto setResults = [&](const FdmBlackScholesSolver& solver) {
+            results_.value = solver.valueAt(spot);
+            results_.delta = solver.deltaAt(spot);
+            results_.gamma = solver.gammaAt(spot);
+            results_.theta = solver.thetaAt(spot);
+
+            if (!spotLadder_.empty()) {
+                Array spots(spotLadder_.begin(), spotLadder_.end());
+                spots += spotAdjustment;
+
+                const Array values = solver.valueAt(spots);
+                const Array deltas = solver.deltaAt(spots);
+                const Array gammas = solver.gammaAt(spots);
+
+                results_.additionalResults["spotLadder"] = spotLadder_;
+                results_.additionalResults["valueLadder"] =
+                    std::vector<Real>(values.begin(), values.end());
+                results_.additionalResults["deltaLadder"] =
+                    std::vector<Real>(deltas.begin(), deltas.end());
+                results_.additionalResults["gammaLadder"] =
+                    std::vector<Real>(gammas.begin(), gammas.end());
+            }
+        };
+
+        std::vector<Real> cacheKey;
+        const bool useCache = solutionCache_ != nullptr
+            && solutionCacheKey(arguments_.payoff, arguments_.exercise,
+                                passedDividends, cacheKey);
+
+        if (useCache) {
+            // the spot must stay well inside of the cached grid
+            const Real x = std::log(spot);
+            const CachedSolution* cached = solutionCache_->find(
+                cacheKey, [x](const CachedSolution& s) {
+                    const Real margin = 0.25*(s.xMax - s.xMin);
+                    return x > s.xMin + margin && x < s.xMax - margin;
+                });
+
+            if (cached != nullptr) {
+                setResults(*cached->solver);
+                return;
+            }
+        }
+
         // 1. Mesher
         const std::shared_ptr<StrikedTypePayoff> payoff =
             std::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
@@ -207,12 +291,42 @@ namespace QuantLib {
                 localVol_, illegalLocalVolOverwrite_,
                 Handle<FdmQuantoHelper>(quantoHelper_)));
 
-        const Real spot = process_->x0() + spotAdjustment;
+        setResults(*solver);
+
+        if (useCache) {
+            // the solver would otherwise recalculate on spot changes
+            solver->freeze();
+            solutionCache_->insert(
+                cacheKey, { solver, equityMesher->locations().front(),
+                            equityMesher->locations().back() });
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::enableSolutionCaching(Size maxSize) {
+        solutionCache_ =
+            std::make_shared<FdmSolutionCache<CachedSolution> >(maxSize);
+
+        solutionCache_->registerWith(process_->riskFreeRate());
+        solutionCache_->registerWith(process_->dividendYield());
+        solutionCache_->registerWith(process_->blackVolatility());
+        solutionCache_->registerWith(Settings::instance().evaluationDate());
+        if (localVol_)
+            solutionCache_->registerWith(process_->stateVariable());
+        if (quantoHelper_ != nullptr)
+            solutionCache_->registerWith(quantoHelper_);
+    }
+
+    Size FdBlackScholesVanillaEngine::solutionCacheHits() const {
+        return (solutionCache_ != nullptr) ? solutionCache_->hits() : 0;
+    }
 
-        results_.value = solver->valueAt(spot);
-        results_.delta = solver->deltaAt(spot);
-        results_.gamma = solver->gammaAt(spot);
-        results_.theta = solver->thetaAt(spot);
+    Size FdBlackScholesVanillaEngine::solutionCacheMisses() const {
+        return (solutionCache_ != nullptr) ? solutionCache_->misses() : 0;
+    }
+
+    void FdBlackScholesVanillaEngine::enableSpotLadder(
+                                        const std::vector<Real>& spots) {
+        spotLadder_ = spots;
     }
 
     MakeFdBlackScholesVanillaEngine::MakeFdBlackScholesVanillaEngine(
@@ -282,10 +396,24 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeFdBlackScholesVanillaEngine&
+    MakeFdBlackScholesVanillaEngine::withSolutionCaching(Size maxSize) {
+        solutionCacheSize_ = maxSize;
+        return *this;
+    }
+
+    MakeFdBlackScholesVanillaEngine&
+    MakeFdBlackScholesVanillaEngine::withSpotLadder(
+        const std::vector<Real>& spots) {
+        spotLadder_ = spots;
+        return *this;
+    }
+
     MakeFdBlackScholesVanillaEngine::operator
     std::shared_ptr<PricingEngine>() const {
+        std::shared_ptr<FdBlackScholesVanillaEngine> engine;
         if (explicitDividends_) {
-            return std::make_shared<FdBlackScholesVanillaEngine>(
+            engine = std::make_shared<FdBlackScholesVanillaEngine>(
                 process_,
                 dividends_,
                 quantoHelper_,
@@ -295,7 +423,7 @@ namespace QuantLib {
                 illegalLocalVolOverwrite_,
                 cashDividendModel_);
         } else {
-            return std::make_shared<FdBlackScholesVanillaEngine>(
+            engine = std::make_shared<FdBlackScholesVanillaEngine>(
                 process_,
                 quantoHelper_,
                 tGrid_, xGrid_, dampingSteps_,
@@ -304,6 +432,11 @@ namespace QuantLib {
                 illegalLocalVolOverwrite_,
                 cashDividendModel_);
         }
+        if (solutionCacheSize_ > 0)
+            engine->enableSolutionCaching(solutionCacheSize_);
+        if (!spotLadder_.empty())
+            engine->enableSpotLadder(spotLadder_);
+        return engine;
     }
 
 }
@@ -29,10 +29,12 @@
 #include <ql/pricingengine.hpp>
 #include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmsolutioncache.hpp>
 
 namespace QuantLib {
 
     class FdmQuantoHelper;
+    class FdmBlackScholesSolver;
     class GeneralizedBlackScholesProcess;
 
     QL_DEPRECATED_DISABLE_WARNING
@@ -95,7 +97,34 @@ namespace QuantLib {
 
         void calculate() const override;
 
+        //! caches the PDE solutions for repricing at different spots
+        /*! Solutions are cached by payoff, exercise and dividends, so
+            that a change of the spot, e.g. for a spot ladder or a
+            bump-and-reprice delta, does not trigger a new rollback as
+            long as the spot stays well inside the grid. Any change of
+            the term structures, the volatility or the evaluation date
+            clears the cache.
+
+            Only plain-vanilla payoffs with fixed cash dividends are
+            cached; other options are priced as usual.
+        */
+        void enableSolutionCaching(Size maxSize = 100);
+        Size solutionCacheHits() const;
+        Size solutionCacheMisses() const;
+
+        //! values and greeks for a ladder of spots from the same solve
+        /*! The results are returned as the additional results
+            "spotLadder", "valueLadder", "deltaLadder" and
+            "gammaLadder". All spots must lie within the grid.
+        */
+        void enableSpotLadder(const std::vector<Real>& spots);
+
       private:
+        struct CachedSolution {
+            std::shared_ptr<FdmBlackScholesSolver> solver;
+            Real xMin, xMax;
+        };
+
         std::shared_ptr<GeneralizedBlackScholesProcess> process_;
         DividendSchedule dividends_;
         bool explicitDividends_;
@@ -105,6 +134,8 @@ namespace QuantLib {
         Real illegalLocalVolOverwrite_;
         std::shared_ptr<FdmQuantoHelper> quantoHelper_;
         CashDividendModel cashDividendModel_;
+        std::shared_ptr<FdmSolutionCache<CachedSolution> > solutionCache_;
+        std::vector<Real> spotLadder_;
     };
 
 
@@ -135,6 +166,12 @@ namespace QuantLib {
         MakeFdBlackScholesVanillaEngine& withCashDividendModel(
             FdBlackScholesVanillaEngine::CashDividendModel cashDividendModel);
 
+        MakeFdBlackScholesVanillaEngine& withSolutionCaching(
+            Size maxSize = 100);
+
+        MakeFdBlackScholesVanillaEngine& withSpotLadder(
+            const std::vector<Real>& spots);
+
         operator std::shared_ptr<PricingEngine>() const;
       private:
         std::shared_ptr<GeneralizedBlackScholesProcess> process_;
@@ -146,6 +183,8 @@ namespace QuantLib {
         Real illegalLocalVolOverwrite_;
         std::shared_ptr<FdmQuantoHelper> quantoHelper_;
         FdBlackScholesVanillaEngine::CashDividendModel cashDividendModel_ = FdBlackScholesVanillaEngine::Spot;
+        Size solutionCacheSize_ = 0;
+        std::vector<Real> spotLadder_;
     };
 
 }
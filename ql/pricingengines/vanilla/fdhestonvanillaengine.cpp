@@ -20,6 +20,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/exercise.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
@@ -30,6 +31,8 @@
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/processes/batesprocess.hpp>
+#include <ql/settings.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -190,6 +193,32 @@ namespace QuantLib {
         const DividendSchedule& passedDividends = explicitDividends_ ? dividends_ : arguments_.cashFlow;
         QL_DEPRECATED_ENABLE_WARNING
 
+        const std::shared_ptr<HestonProcess> process = model_->process();
+        const Real v0   = process->v0();
+        const Real spot = process->s0()->value();
+
+        // a solution for the strike K prices the strike K/d at the
+        // spot S as V(S*d)/d, which is used by the multiple strikes cache
+        const auto setLadder = [&](const FdmHestonSolver& solver, Real d) {
+            if (spotLadder_.empty())
+                return;
+
+            const Array spots(spotLadder_.begin(), spotLadder_.end());
+            const Array variances = varianceLadder_.empty()
+                ? Array(1, v0)
+                : Array(varianceLadder_.begin(), varianceLadder_.end());
+
+            results_.additionalResults["spotLadder"] = spotLadder_;
+            results_.additionalResults["varianceLadder"] =
+                std::vector<Real>(variances.begin(), variances.end());
+            results_.additionalResults["valueGrid"] =
+                solver.valueAt(spots*d, variances)/d;
+            results_.additionalResults["deltaGrid"] =
+                solver.deltaAt(spots*d, variances);
+            results_.additionalResults["gammaGrid"] =
+                solver.gammaAt(spots*d, variances)*d;
+        };
+
         // cache lookup for precalculated results
         for (auto& cachedArgs2result : cachedArgs2results_) {
             if (cachedArgs2result.first.exercise->type() == arguments_.exercise->type() &&
@@ -205,26 +234,57 @@ namespace QuantLib {
                     QL_REQUIRE(passedDividends.empty(),
                                "multiple strikes engine does not work with discrete dividends");
                     results_ = cachedArgs2result.second;
+                    setLadder(*strikesSolver_,
+                              strikesSolverStrike_/p1->strike());
                     return;
                 }
             }
         }
 
-        const std::shared_ptr<HestonProcess> process = model_->process();
+        const auto setResults = [&](const FdmHestonSolver& solver) {
+            results_.value = solver.valueAt(spot, v0);
+            results_.delta = solver.deltaAt(spot, v0);
+            results_.gamma = solver.gammaAt(spot, v0);
+            results_.theta = solver.thetaAt(spot, v0);
+            setLadder(solver, 1.0);
+        };
+
+        std::vector<Real> cacheKey;
+        const bool useCache = solutionCache_ != nullptr && strikes_.empty()
+            && solutionCacheKey(cacheKey);
+
+        if (useCache) {
+            // the spot must stay well inside of the cached grid
+            const Real x = std::log(spot);
+            const CachedSolution* cached = solutionCache_->find(
+                cacheKey, [x](const CachedSolution& s) {
+                    const Real margin = 0.25*(s.xMax - s.xMin);
+                    return x > s.xMin + margin && x < s.xMax - margin;
+                });
+
+            if (cached != nullptr) {
+                setResults(*cached->solver);
+                return;
+            }
+        }
 
+        const FdmSolverDesc solverDesc = getSolverDesc(1.5);
         std::shared_ptr<FdmHestonSolver> solver(new FdmHestonSolver(
                     Handle<HestonProcess>(process),
-                    getSolverDesc(1.5), schemeDesc_,
+                    solverDesc, schemeDesc_,
                     Handle<FdmQuantoHelper>(quantoHelper_), leverageFct_,
                     mixingFactor_));
 
-        const Real v0   = process->v0();
-        const Real spot = process->s0()->value();
+        setResults(*solver);
 
-        results_.value = solver->valueAt(spot, v0);
-        results_.delta = solver->deltaAt(spot, v0);
-        results_.gamma = solver->gammaAt(spot, v0);
-        results_.theta = solver->thetaAt(spot, v0);
+        if (useCache) {
+            // the solver would otherwise recalculate on spot changes
+            solver->freeze();
+            const Array x = solverDesc.mesher->locations(0);
+            solutionCache_->insert(
+                cacheKey, { solver, *std::min_element(x.begin(), x.end()),
+                            *std::max_element(x.begin(), x.end()) });
+        }
 
         cachedArgs2results_.resize(strikes_.size());
         const std::shared_ptr<StrikedTypePayoff> payoff =
@@ -244,10 +304,51 @@ namespace QuantLib {
             results.gamma = solver->gammaAt(spot*d, v0)*d;
             results.theta = solver->thetaAt(spot*d, v0)/d;
         }
+        if (!strikes_.empty()) {
+            strikesSolver_ = solver;
+            strikesSolverStrike_ = payoff->strike();
+        }
+    }
+
+    bool FdHestonVanillaEngine::solutionCacheKey(
+                                        std::vector<Real>& key) const {
+        QL_DEPRECATED_DISABLE_WARNING
+        const DividendSchedule& passedDividends = explicitDividends_ ? dividends_ : arguments_.cashFlow;
+        QL_DEPRECATED_ENABLE_WARNING
+
+        const std::shared_ptr<PlainVanillaPayoff> payoff =
+            std::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        if (payoff == nullptr)
+            return false;
+
+        // the model observes the spot, hence the cache can't observe
+        // the model; its parameters are part of the key instead
+        const std::shared_ptr<HestonProcess> process = model_->process();
+        key = { process->theta(), process->kappa(), process->sigma(),
+                process->rho(), process->v0(),
+                Real(payoff->optionType()), payoff->strike(),
+                Real(arguments_.exercise->type()) };
+
+        const std::shared_ptr<EarlyExercise> earlyExercise =
+            std::dynamic_pointer_cast<EarlyExercise>(arguments_.exercise);
+        key.push_back(Real(earlyExercise != nullptr
+                           && earlyExercise->payoffAtExpiry()));
+        for (const auto& d: arguments_.exercise->dates())
+            key.push_back(Real(d.serialNumber()));
+
+        for (const auto& cf: passedDividends) {
+            if (std::dynamic_pointer_cast<FixedDividend>(cf) == nullptr)
+                return false;
+            key.push_back(Real(cf->date().serialNumber()));
+            key.push_back(cf->amount());
+        }
+
+        return true;
     }
 
     void FdHestonVanillaEngine::update() {
         cachedArgs2results_.clear();
+        strikesSolver_.reset();
         QL_DEPRECATED_DISABLE_WARNING
         GenericModelEngine<HestonModel,
                            DividendVanillaOption::arguments,
@@ -259,6 +360,36 @@ namespace QuantLib {
                                         const std::vector<Real>& strikes) {
         strikes_ = strikes;
         cachedArgs2results_.clear();
+        strikesSolver_.reset();
+    }
+
+    void FdHestonVanillaEngine::enableSolutionCaching(Size maxSize) {
+        const std::shared_ptr<HestonProcess> process = model_->process();
+
+        solutionCache_ =
+            std::make_shared<FdmSolutionCache<CachedSolution> >(maxSize);
+        solutionCache_->registerWith(process->riskFreeRate());
+        solutionCache_->registerWith(process->dividendYield());
+        solutionCache_->registerWith(Settings::instance().evaluationDate());
+        if (leverageFct_ != nullptr)
+            solutionCache_->registerWith(leverageFct_);
+        if (quantoHelper_ != nullptr)
+            solutionCache_->registerWith(quantoHelper_);
+    }
+
+    Size FdHestonVanillaEngine::solutionCacheHits() const {
+        return (solutionCache_ != nullptr) ? solutionCache_->hits() : 0;
+    }
+
+    Size FdHestonVanillaEngine::solutionCacheMisses() const {
+        return (solutionCache_ != nullptr) ? solutionCache_->misses() : 0;
+    }
+
+    void FdHestonVanillaEngine::enableSpotLadder(
+                                        const std::vector<Real>& spots,
+                                        const std::vector<Real>& variances) {
+        spotLadder_ = spots;
+        varianceLadder_ = variances;
     }
 
 
@@ -319,10 +450,17 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeFdHestonVanillaEngine&
+    MakeFdHestonVanillaEngine::withSolutionCaching(Size maxSize) {
+        solutionCacheSize_ = maxSize;
+        return *this;
+    }
+
     MakeFdHestonVanillaEngine::operator
     std::shared_ptr<PricingEngine>() const {
+        std::shared_ptr<FdHestonVanillaEngine> engine;
         if (explicitDividends_) {
-            return std::make_shared<FdHestonVanillaEngine>(
+            engine = std::make_shared<FdHestonVanillaEngine>(
                 hestonModel_,
                 dividends_,
                 quantoHelper_,
@@ -330,13 +468,16 @@ namespace QuantLib {
                 *schemeDesc_,
                 leverageFct_);
         } else {
-            return std::make_shared<FdHestonVanillaEngine>(
+            engine = std::make_shared<FdHestonVanillaEngine>(
                 hestonModel_,
                 quantoHelper_,
                 tGrid_, xGrid_, vGrid_, dampingSteps_,
                 *schemeDesc_,
                 leverageFct_);
         }
+        if (solutionCacheSize_ > 0)
+            engine->enableSolutionCaching(solutionCacheSize_);
+        return engine;
     }
 
 }
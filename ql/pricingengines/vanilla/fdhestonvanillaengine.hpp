@@ -31,11 +31,13 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmsolutioncache.hpp>
 #include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
 
 namespace QuantLib {
 
     class FdmQuantoHelper;
+    class FdmHestonSolver;
 
     QL_DEPRECATED_DISABLE_WARNING
 
@@ -99,10 +101,43 @@ namespace QuantLib {
         void update() override;
         void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
 
+        //! caches the PDE solutions for repricing at different spots
+        /*! Solutions are cached by payoff, exercise, dividends and the
+            Heston parameters, so that a change of the spot does not
+            trigger a new rollback as long as the spot stays well
+            inside the grid. The model observes the spot, hence the
+            parameters are part of the key instead of being observed;
+            any change of the term structures, the leverage function
+            or the evaluation date clears the cache.
+
+            Only plain-vanilla payoffs with fixed cash dividends are
+            cached, and only if multiple strikes caching is disabled.
+        */
+        void enableSolutionCaching(Size maxSize = 100);
+        Size solutionCacheHits() const;
+        Size solutionCacheMisses() const;
+
+        /*! values and greeks on a grid of spots and variances from the
+            same solve, returned as the additional results "spotLadder",
+            "varianceLadder", "valueGrid", "deltaGrid" and "gammaGrid".
+            The element (i,j) of the matrices belongs to the i-th spot
+            and the j-th variance; if no variances are given, the
+            current variance of the model is used. The grids are
+            also returned for results taken from either cache.
+        */
+        void enableSpotLadder(const std::vector<Real>& spots,
+                              const std::vector<Real>& variances = {});
+
         // helper method for Heston like engines
         FdmSolverDesc getSolverDesc(Real equityScaleFactor) const;
 
       private:
+        struct CachedSolution {
+            std::shared_ptr<FdmHestonSolver> solver;
+            Real xMin, xMax;
+        };
+        bool solutionCacheKey(std::vector<Real>& key) const;
+
         DividendSchedule dividends_;
         bool explicitDividends_;
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
@@ -112,11 +147,15 @@ namespace QuantLib {
         const Real mixingFactor_;
 
         std::vector<Real> strikes_;
+        std::vector<Real> spotLadder_, varianceLadder_;
         QL_DEPRECATED_DISABLE_WARNING
         mutable std::vector<std::pair<DividendVanillaOption::arguments,
                                       DividendVanillaOption::results> >
                                                             cachedArgs2results_;
         QL_DEPRECATED_ENABLE_WARNING
+        mutable std::shared_ptr<FdmHestonSolver> strikesSolver_;
+        mutable Real strikesSolverStrike_ = Null<Real>();
+        std::shared_ptr<FdmSolutionCache<CachedSolution> > solutionCache_;
     };
 
     class MakeFdHestonVanillaEngine {
@@ -142,6 +181,8 @@ namespace QuantLib {
             const std::vector<Date>& dividendDates,
             const std::vector<Real>& dividendAmounts);
 
+        MakeFdHestonVanillaEngine& withSolutionCaching(Size maxSize = 100);
+
         operator std::shared_ptr<PricingEngine>() const;
 
       private:
@@ -152,6 +193,7 @@ namespace QuantLib {
         std::shared_ptr<FdmSchemeDesc> schemeDesc_;
         std::shared_ptr<LocalVolTermStructure> leverageFct_;
         std::shared_ptr<FdmQuantoHelper> quantoHelper_;
+        Size solutionCacheSize_ = 0;
     };
 
 }
@@ -0,0 +1,313 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/fastfouriertransform.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/pricingengines/vanilla/fouriersurfacepricer.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        typedef std::complex<Real> complex;
+
+        /* fractional FFT y_k = sum_j x_j exp(-2 pi i j k zeta) via
+           Bluestein's algorithm, i.e., as a circular convolution of
+           twice the length of x */
+        std::vector<complex> fractionalFFT(const std::vector<complex>& x,
+                                           Real zeta) {
+            const Size n = x.size();
+            const FastFourierTransform fft(
+                FastFourierTransform::min_order(2*n));
+            const Size m = fft.output_size();
+
+            std::vector<complex> chirp(n), a(m, 0.0), b(m, 0.0);
+            for (Size j=0; j < n; ++j) {
+                chirp[j] = std::polar(1.0, M_PI*zeta*Real(j)*Real(j));
+                a[j] = x[j]*std::conj(chirp[j]);
+                b[j] = chirp[j];
+                if (j > 0)
+                    b[m-j] = chirp[j];
+            }
+
+            std::vector<complex> fa(m), fb(m), conv(m);
+            fft.transform(a.begin(), a.end(), fa.begin());
+            fft.transform(b.begin(), b.end(), fb.begin());
+            for (Size j=0; j < m; ++j)
+                fa[j] *= fb[j];
+            fft.inverse_transform(fa.begin(), fa.end(), conv.begin());
+
+            std::vector<complex> y(n);
+            for (Size k=0; k < n; ++k)
+                y[k] = std::conj(chirp[k])*conv[k]/Real(m);
+
+            return y;
+        }
+
+    }
+
+    FourierSurfacePricer::FourierSurfacePricer(
+        std::shared_ptr<CharacteristicFunction> chF,
+        Handle<Quote> spot,
+        Handle<YieldTermStructure> riskFreeRate,
+        Handle<YieldTermStructure> dividendYield,
+        Method method,
+        Size points,
+        Real eta,
+        Real alpha,
+        Real truncation)
+    : chF_(std::move(chF)), spot_(std::move(spot)),
+      riskFreeRate_(std::move(riskFreeRate)),
+      dividendYield_(std::move(dividendYield)),
+      method_(method), points_(points), eta_(eta), alpha_(alpha),
+      truncation_(truncation) {
+        QL_REQUIRE(points_ >= 8, "at least 8 points are required");
+        QL_REQUIRE(method_ == COS || (points_ & (points_-1)) == 0,
+                   "number of points (" << points_
+                   << ") must be a power of two");
+        QL_REQUIRE(eta_ > 0.0, "Fourier grid spacing must be positive");
+        QL_REQUIRE(alpha_ == Null<Real>() || alpha_ > 0.0,
+                   "damping factor must be positive");
+        QL_REQUIRE(truncation_ > 0.0, "truncation range must be positive");
+    }
+
+    Real FourierSurfacePricer::dampingFactor(Time t) const {
+        if (alpha_ != Null<Real>())
+            return alpha_;
+
+        // log of the damped Fourier transform at the forward and u=0
+        const auto f = [&](Real alpha) -> Real {
+            const Real m =
+                (*chF_)(complex(0.0, -(alpha+1.0)), t).real();
+            return (m > 0.0 && std::isfinite(m))
+                ? Real(std::log(m) - std::log(alpha*(alpha+1.0)))
+                : QL_MAX_REAL;
+        };
+
+        // f is convex within the strip of finite moments,
+        // hence the minimum is bracketed by the first increase
+        const Real maxAlpha = 20.0;
+        Real a = 0.0, b = 0.05, c = 1.25*b;
+        Real fb = f(b), fc = f(c);
+        QL_REQUIRE(fb < QL_MAX_REAL,
+                   "no finite exponential moment beyond the forward");
+        while (fc < fb && c < maxAlpha) {
+            a = b; b = c; fb = fc;
+            c *= 1.25;
+            fc = f(c);
+        }
+
+        // golden section search
+        const Real g = 0.5*(std::sqrt(5.0) - 1.0);
+        Real x1 = c - g*(c-a), x2 = a + g*(c-a);
+        Real f1 = f(x1), f2 = f(x2);
+        for (Size i=0; i < 40; ++i) {
+            if (f1 < f2) {
+                c = x2; x2 = x1; f2 = f1;
+                x1 = c - g*(c-a);
+                f1 = f(x1);
+            } else {
+                a = x1; x1 = x2; f1 = f2;
+                x2 = a + g*(c-a);
+                f2 = f(x2);
+            }
+        }
+
+        return 0.5*(a+c);
+    }
+
+    std::vector<Real> FourierSurfacePricer::fftCallValues(
+        const std::vector<Real>& k, Time t) const {
+
+        const Size n = points_;
+        const Real alpha = dampingFactor(t);
+
+        const Real kLow = *std::min_element(k.begin(), k.end());
+        const Real kHigh = *std::max_element(k.begin(), k.end());
+
+        // log-strike grid k_m = kMin + m*lambda
+        Real kMin, lambda;
+        if (method_ == CarrMadan) {
+            lambda = 2.0*M_PI/(n*eta_);
+            kMin = -0.5*n*lambda;
+            QL_REQUIRE(kLow >= kMin + lambda
+                       && kHigh <= kMin + (n-2)*lambda,
+                       "strikes are out of the range of the log-strike "
+                       "grid [" << kMin + lambda << ", "
+                       << kMin + (n-2)*lambda << "]");
+        } else {
+            // two nodes of margin at both ends for the interpolation
+            lambda = std::max(kHigh - kLow, 1e-4)/(n-5);
+            kMin = kLow - 2.0*lambda;
+        }
+
+        // damped Fourier transform of the call value, with Simpson's
+        // weights and the phase of the first log-strike node
+        std::vector<complex> x(n);
+        for (Size j=0; j < n; ++j) {
+            const Real u = j*eta_;
+            const Real w =
+                eta_*(3.0 + ((j % 2) == 0 ? -1.0 : 1.0)
+                      - ((j == 0) ? 1.0 : 0.0))/3.0;
+
+            x[j] = w*(*chF_)(complex(u, -(alpha+1.0)), t)
+                / complex(alpha*alpha + alpha - u*u, (2.0*alpha+1.0)*u)
+                * std::polar(1.0, -u*kMin);
+        }
+
+        std::vector<complex> y;
+        if (method_ == CarrMadan) {
+            const FastFourierTransform fft(FastFourierTransform::min_order(n));
+            y.resize(n);
+            fft.transform(x.begin(), x.end(), y.begin());
+        } else {
+            y = fractionalFFT(x, eta_*lambda/(2.0*M_PI));
+        }
+
+        // interpolate on the part of the grid covering the strikes
+        const Size first = Size(std::max(
+            std::floor((kLow - kMin)/lambda) - 2.0, 0.0));
+        const Size last = std::min(
+            Size(std::ceil((kHigh - kMin)/lambda)) + 2, n-1);
+
+        std::vector<Real> kGrid(last-first+1), cGrid(last-first+1);
+        for (Size m=first; m <= last; ++m) {
+            kGrid[m-first] = kMin + m*lambda;
+            cGrid[m-first] =
+                std::exp(-alpha*kGrid[m-first])/M_PI*y[m].real();
+        }
+        const CubicNaturalSpline interpolation(
+            kGrid.begin(), kGrid.end(), cGrid.begin());
+
+        std::vector<Real> c(k.size());
+        for (Size i=0; i < k.size(); ++i)
+            c[i] = interpolation(k[i], true);
+
+        return c;
+    }
+
+    std::vector<Real> FourierSurfacePricer::cosCallValues(
+        const std::vector<Real>& k, Time t) const {
+
+        const Size n = points_;
+
+        // first two cumulants from the cumulant generating function
+        const Real h = 1e-3;
+        const Real kUp = std::log((*chF_)(complex(0.0, -h), t).real());
+        const Real kDown = std::log((*chF_)(complex(0.0, h), t).real());
+        const Real c1 = 0.5*(kUp - kDown)/h;
+        const Real c2 = (kUp + kDown)/(h*h);
+        QL_REQUIRE(c2 > 0.0, "non-positive variance (" << c2 << ")");
+
+        const Real a = c1 - truncation_*std::sqrt(c2);
+        const Real b = c1 + truncation_*std::sqrt(c2);
+        const Real bma = b - a;
+
+        // strike independent part of the expansion
+        std::vector<Real> phi(n);
+        for (Size j=0; j < n; ++j) {
+            const Real u = j*M_PI/bma;
+            phi[j] = ((*chF_)(complex(u, 0.0), t)
+                      * std::polar(1.0, -u*a)).real();
+        }
+        phi[0] *= 0.5;
+
+        std::vector<Real> c(k.size());
+        for (Size i=0; i < k.size(); ++i) {
+            const Real ek = std::exp(k[i]);
+            const Real d = std::min(std::max(k[i], a), b);
+            const Real ed = std::exp(d), ea = std::exp(a);
+
+            // cosine coefficients of the put payoff (e^k - e^x)^+
+            Real put = phi[0]*2.0/bma*(ek*(d - a) - (ed - ea));
+            for (Size j=1; j < n; ++j) {
+                const Real u = j*M_PI/bma;
+                const Real s = std::sin(u*(d-a)), co = std::cos(u*(d-a));
+
+                const Real chi = (co*ed - ea + u*s*ed)/(1.0 + u*u);
+                const Real psi = s/u;
+
+                put += phi[j]*2.0/bma*(ek*psi - chi);
+            }
+            c[i] = put + 1.0 - ek;
+        }
+
+        return c;
+    }
+
+    std::vector<Real> FourierSurfacePricer::prices(
+        Option::Type type, const std::vector<Real>& strikes, Time t) const {
+
+        QL_REQUIRE(t > 0.0, "positive maturity required");
+        QL_REQUIRE(!strikes.empty(), "no strikes given");
+
+        const DiscountFactor df = riskFreeRate_->discount(t);
+        const Real fwd = spot_->value()*dividendYield_->discount(t)/df;
+
+        std::vector<Real> k(strikes.size());
+        for (Size i=0; i < strikes.size(); ++i) {
+            QL_REQUIRE(strikes[i] > 0.0,
+                       "positive strike required: " << strikes[i]);
+            k[i] = std::log(strikes[i]/fwd);
+        }
+
+        const std::vector<Real> c =
+            (method_ == COS) ? cosCallValues(k, t) : fftCallValues(k, t);
+
+        std::vector<Real> values(strikes.size());
+        for (Size i=0; i < strikes.size(); ++i) {
+            const Real call = df*fwd*c[i];
+            switch (type) {
+              case Option::Call:
+                values[i] = call;
+                break;
+              case Option::Put:
+                values[i] = call - df*(fwd - strikes[i]);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+        }
+
+        return values;
+    }
+
+    std::vector<Real> FourierSurfacePricer::prices(
+        Option::Type type,
+        const std::vector<Real>& strikes,
+        const Date& maturity) const {
+        return prices(type, strikes,
+                      riskFreeRate_->timeFromReference(maturity));
+    }
+
+    Matrix FourierSurfacePricer::prices(
+        Option::Type type,
+        const std::vector<Real>& strikes,
+        const std::vector<Date>& maturities) const {
+
+        Matrix values(maturities.size(), strikes.size());
+        for (Size i=0; i < maturities.size(); ++i) {
+            const std::vector<Real> v = prices(type, strikes, maturities[i]);
+            std::copy(v.begin(), v.end(), values.row_begin(i));
+        }
+
+        return values;
+    }
+
+}
@@ -0,0 +1,139 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fouriersurfacepricer.hpp
+    \brief Fourier pricer of European options on whole volatility surfaces
+*/
+
+#ifndef quantlib_fourier_surface_pricer_hpp
+#define quantlib_fourier_surface_pricer_hpp
+
+#include <ql/handle.hpp>
+#include <ql/option.hpp>
+#include <ql/quote.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/pricingengines/vanilla/characteristicfunction.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Fourier pricer of European options on whole volatility surfaces
+    /*! The pricer values European options on many strikes and
+        maturities. The only input is the characteristic function of
+        the normalized log spot. The characteristic function is
+        evaluated once per maturity, and the result is shared by all
+        strikes.
+
+        - CarrMadan: the damped call price is mapped onto an
+          equidistant log-strike grid of \f$ N \f$ nodes centred
+          around the forward, using a single FFT of length \f$ N \f$.
+          The grid spacing is \f$ 2\pi/(N\eta) \f$, where \f$ \eta \f$
+          is the spacing of the Fourier grid. Prices at the given
+          strikes are interpolated with cubic splines.
+        - FractionalFFT: like CarrMadan, but the fractional FFT maps
+          the log-strike grid onto the range of the given strikes.
+          Its spacing is then independent of \f$ \eta \f$, so a much
+          smaller \f$ N \f$ gives the same accuracy for non-uniform
+          or narrow strike sets. The cost is three FFTs of length
+          \f$ 2N \f$.
+        - COS: the Fourier-cosine expansion with \f$ N \f$ terms. The
+          truncation range is derived from the first two cumulants.
+          The cost is \f$ O(N) \f$ per strike.
+
+        Unless it is given, the damping factor \f$ \alpha \f$ of the
+        FFT methods is chosen per maturity as proposed by Lord and
+        Kahl. It minimizes the damped integrand at the forward.
+
+        References:
+
+        P. Carr, D. Madan, 1999. Option valuation using the fast
+        Fourier transform. Journal of Computational Finance 2(4).
+
+        K. Chourdakis, 2005. Option pricing using the fractional FFT.
+        Journal of Computational Finance 8(2).
+
+        R. Lord, C. Kahl, 2007. Optimal Fourier inversion in
+        semi-analytical option pricing. Journal of Computational
+        Finance 10(4).
+
+        F. Fang, C.W. Oosterlee, 2008. A novel pricing method for
+        European options based on Fourier-cosine series expansions.
+        SIAM Journal on Scientific Computing 31(2).
+
+        \ingroup vanillaengines
+    */
+    class FourierSurfacePricer {
+      public:
+        enum Method { CarrMadan, FractionalFFT, COS };
+
+        /*! \param points     number of Fourier nodes, which must be a
+                              power of two for the FFT methods
+            \param eta        spacing of the Fourier grid of the FFT
+                              methods
+            \param alpha      damping factor of the FFT methods, chosen
+                              per maturity if null
+            \param truncation width of the COS truncation range in
+                              standard deviations
+        */
+        FourierSurfacePricer(std::shared_ptr<CharacteristicFunction> chF,
+                             Handle<Quote> spot,
+                             Handle<YieldTermStructure> riskFreeRate,
+                             Handle<YieldTermStructure> dividendYield,
+                             Method method = CarrMadan,
+                             Size points = 4096,
+                             Real eta = 0.25,
+                             Real alpha = Null<Real>(),
+                             Real truncation = 12.0);
+
+        //! option values for the given strikes and maturity time
+        std::vector<Real> prices(Option::Type type,
+                                 const std::vector<Real>& strikes,
+                                 Time maturity) const;
+        //! option values for the given strikes and maturity date
+        std::vector<Real> prices(Option::Type type,
+                                 const std::vector<Real>& strikes,
+                                 const Date& maturity) const;
+        /*! option values for the given strikes and maturities; rows
+            correspond to maturities and columns to strikes
+        */
+        Matrix prices(Option::Type type,
+                      const std::vector<Real>& strikes,
+                      const std::vector<Date>& maturities) const;
+
+        //! damping factor of the FFT methods for the given maturity
+        Real dampingFactor(Time maturity) const;
+
+      private:
+        // undiscounted call values normalized by the forward,
+        // given the log-moneyness ln(K/F)
+        std::vector<Real> fftCallValues(const std::vector<Real>& k,
+                                        Time t) const;
+        std::vector<Real> cosCallValues(const std::vector<Real>& k,
+                                        Time t) const;
+
+        const std::shared_ptr<CharacteristicFunction> chF_;
+        const Handle<Quote> spot_;
+        const Handle<YieldTermStructure> riskFreeRate_, dividendYield_;
+        const Method method_;
+        const Size points_;
+        const Real eta_, alpha_, truncation_;
+    };
+
+}
+
+#endif
@@ -32,6 +32,7 @@ namespace QuantLib {
                                            Size polynomialOrder,
                                            LsmBasisSystem::PolynomialType polynomialType)
     : payoff_(std::move(payoff)),
+      basis_(1, polynomialOrder, polynomialType),
       v_(LsmBasisSystem::pathBasisSystem(polynomialOrder, polynomialType)) {
 
         QL_REQUIRE(   polynomialType == LsmBasisSystem::Monomial
@@ -71,4 +72,18 @@ namespace QuantLib {
         return v_;
     }
 
+    Matrix AmericanPathPricer::basisSystemValues(
+                                    const std::vector<Real>& states) const {
+        const Size m = basis_.size();
+        Matrix A(states.size(), m+1);
+
+        #pragma omp parallel for
+        for (long k=0; k < long(states.size()); ++k) {
+            basis_.polynomialValues(states[k], A.row_begin(k));
+            A[k][m] = payoff(states[k]);
+        }
+
+        return A;
+    }
+
 }
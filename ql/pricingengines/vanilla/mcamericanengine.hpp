@@ -66,7 +66,8 @@ namespace QuantLib {
                          LsmBasisSystem::PolynomialType polynomialType,
                          Size nCalibrationSamples = Null<Size>(),
                          const std::optional<bool>& antitheticVariateCalibration = std::nullopt,
-                         BigNatural seedCalibration = Null<Size>());
+                         BigNatural seedCalibration = Null<Size>(),
+                         LsmRegression::Method regressionMethod = LsmRegression::SVD);
 
         void calculate() const override;
 
@@ -80,6 +81,7 @@ namespace QuantLib {
       private:
         const Size polynomialOrder_;
         const LsmBasisSystem::PolynomialType polynomialType_;
+        const LsmRegression::Method regressionMethod_;
     };
 
     class AmericanPathPricer : public EarlyExercisePathPricer<Path>  {
@@ -92,12 +94,14 @@ namespace QuantLib {
         Real operator()(const Path& path, Size t) const override;
 
         std::vector<std::function<Real(Real)> > basisSystem() const override;
+        Matrix basisSystemValues(const std::vector<Real>& states) const override;
 
       protected:
         Real payoff(Real state) const;
 
         Real scalingValue_ = 1.0;
         const std::shared_ptr<Payoff> payoff_;
+        const LsmPolynomialBasis basis_;
         std::vector<std::function<Real(Real)> > v_;
     };
 
@@ -122,6 +126,7 @@ namespace QuantLib {
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
         MakeMCAmericanEngine& withAntitheticVariateCalibration(bool b = true);
         MakeMCAmericanEngine& withSeedCalibration(BigNatural seed);
+        MakeMCAmericanEngine& withRegressionMethod(LsmRegression::Method);
 
         /*! \deprecated Renamed to withPolynomialOrder.
                         Deprecated in version 1.26.
@@ -142,6 +147,7 @@ namespace QuantLib {
         LsmBasisSystem::PolynomialType polynomialType_ = LsmBasisSystem::Monomial;
         std::optional<bool> antitheticCalibration_;
         BigNatural seedCalibration_;
+        LsmRegression::Method regressionMethod_ = LsmRegression::SVD;
     };
 
     template <class RNG, class S, class RNG_Calibration>
@@ -159,7 +165,8 @@ namespace QuantLib {
         LsmBasisSystem::PolynomialType polynomialType,
         Size nCalibrationSamples,
         const std::optional<bool>& antitheticVariateCalibration,
-        BigNatural seedCalibration)
+        BigNatural seedCalibration,
+        LsmRegression::Method regressionMethod)
     : MCLongstaffSchwartzEngine<VanillaOption::engine, SingleVariate, RNG, S, RNG_Calibration>(
           process,
           timeSteps,
@@ -175,7 +182,8 @@ namespace QuantLib {
           false,
           antitheticVariateCalibration,
           seedCalibration),
-      polynomialOrder_(polynomialOrder), polynomialType_(polynomialType) {}
+      polynomialOrder_(polynomialOrder), polynomialType_(polynomialType),
+      regressionMethod_(regressionMethod) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline void MCAmericanEngine<RNG, S, RNG_Calibration>::calculate() const {
@@ -211,7 +219,8 @@ namespace QuantLib {
              
                                       this->timeGrid(),
                                       earlyExercisePathPricer,
-                                      *(process->riskFreeRate()));
+                                      *(process->riskFreeRate()),
+                                      regressionMethod_);
     }
 
     template <class RNG, class S, class RNG_Calibration>
@@ -387,6 +396,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withRegressionMethod(
+        LsmRegression::Method regressionMethod) {
+        regressionMethod_ = regressionMethod;
+        return *this;
+    }
+
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration>::
     operator std::shared_ptr<PricingEngine>() const {
@@ -407,7 +424,8 @@ namespace QuantLib {
                                      polynomialType_,
                                      calibrationSamples_,
                                      antitheticCalibration_,
-                                     seedCalibration_));
+                                     seedCalibration_,
+                                     regressionMethod_));
     }
 
 }
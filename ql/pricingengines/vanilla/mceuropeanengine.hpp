@@ -26,6 +26,9 @@
 #ifndef quantlib_montecarlo_european_engine_hpp
 #define quantlib_montecarlo_european_engine_hpp
 
+#include <ql/methods/montecarlo/blockpathpricer.hpp>
+#include <ql/methods/montecarlo/pathblockgenerator.hpp>
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -34,10 +37,26 @@
 namespace QuantLib {
 
     //! European option pricing engine using Monte Carlo simulation
-    /*! \ingroup vanillaengines
+    /*! If requested, delta, vega and rho are estimated in the same
+        simulation by pathwise derivatives or likelihood-ratio
+        weights of the paths, see BlackScholesPathDerivatives. Their
+        standard errors are returned as additional results, see
+        MonteCarloGreeksResults.
+
+        If a block size is given, the paths are generated in blocks
+        by PathBlockGenerator and priced by EuropeanBlockPathPricer;
+        the path generated from a given sequence is the same, so
+        the result equals the one without blocks when the number of
+        samples is a multiple of the block size. Path blocks require
+        a given number of samples, which is rounded up to a multiple
+        of the block size, and don't provide greeks.
+
+        \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
               checking it against analytic results.
+
+        \test the returned greeks are tested against analytic results.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanEngine : public MCVanillaEngine<SingleVariate,RNG,S> {
@@ -60,9 +79,15 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             MonteCarloGreeks::Estimator greeks = MonteCarloGreeks::None,
+             Size blockSize = Null<Size>());
+        void calculate() const override;
       protected:
         std::shared_ptr<path_pricer_type> pathPricer() const override;
+        void calculateWithBlocks() const;
+        MonteCarloGreeksResults greeks_;
+        Size blockSize_;
     };
 
     //! Monte Carlo European engine factory
@@ -79,6 +104,9 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withGreeks(
+            MonteCarloGreeks::Estimator estimator = MonteCarloGreeks::Pathwise);
+        MakeMCEuropeanEngine& withBlockSize(Size blockSize);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
       private:
@@ -88,6 +116,8 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_ = false;
         BigNatural seed_ = 0;
+        MonteCarloGreeks::Estimator greeks_ = MonteCarloGreeks::None;
+        Size blockSize_;
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -102,6 +132,20 @@ namespace QuantLib {
         DiscountFactor discount_;
     };
 
+    //! European path pricer for blocks of paths
+    class EuropeanBlockPathPricer : public BlockPathPricer<PathBlock> {
+      public:
+        EuropeanBlockPathPricer(Option::Type type,
+                                Real strike,
+                                DiscountFactor discount);
+        Array operator()(const PathBlock& paths) const override;
+
+      private:
+        Real phi_;
+        Real strike_;
+        DiscountFactor discount_;
+    };
+
 
     // inline definitions
 
@@ -116,7 +160,9 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             MonteCarloGreeks::Estimator greeks,
+             Size blockSize)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +172,69 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed),
+      greeks_(greeks), blockSize_(blockSize) {
+        QL_REQUIRE(blockSize_ == Null<Size>() || blockSize_ > 0,
+                   "null block size given");
+        QL_REQUIRE(blockSize_ == Null<Size>()
+                   || greeks_.estimator() == MonteCarloGreeks::None,
+                   "greeks are not available with path blocks");
+    }
+
+
+    template <class RNG, class S>
+    inline void MCEuropeanEngine<RNG,S>::calculate() const {
+        if (blockSize_ != Null<Size>()) {
+            calculateWithBlocks();
+            return;
+        }
+        greeks_.reset();
+        MCVanillaEngine<SingleVariate,RNG,S>::calculate();
+        greeks_.fillResults(this->results_);
+    }
+
+
+    template <class RNG, class S>
+    inline void MCEuropeanEngine<RNG,S>::calculateWithBlocks() const {
+        QL_REQUIRE(this->requiredSamples_ != Null<Size>(),
+                   "number of samples required with path blocks");
+
+        std::shared_ptr<PlainVanillaPayoff> payoff =
+            std::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        std::shared_ptr<GeneralizedBlackScholesProcess> process =
+            std::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        const TimeGrid grid = this->timeGrid();
+        PathBlockGenerator<typename RNG::rsg_type> generator(
+            process, grid,
+            RNG::make_sequence_generator(grid.size()-1, this->seed_),
+            this->brownianBridge_, blockSize_);
+        const EuropeanBlockPathPricer pricer(
+            payoff->optionType(), payoff->strike(),
+            process->riskFreeRate()->discount(grid.back()));
+
+        S stats;
+        while (stats.samples() < this->requiredSamples_) {
+            Array values = pricer(generator.next());
+            if (this->antitheticVariate_) {
+                const Array antitheticValues =
+                    pricer(generator.antithetic());
+                for (Size j=0; j<values.size(); ++j)
+                    values[j] = 0.5*(values[j] + antitheticValues[j]);
+            }
+            for (Real value : values)
+                stats.add(value);
+        }
+
+        this->results_.value = stats.mean();
+        if (RNG::allowsErrorEstimate)
+            this->results_.errorEstimate = stats.errorEstimate();
+    }
 
 
     template <class RNG, class S>
@@ -144,12 +252,34 @@ namespace QuantLib {
                 this->process_);
         QL_REQUIRE(process, "Black-Scholes process required");
 
-        return std::shared_ptr<
+        const TimeGrid grid = this->timeGrid();
+        const Time maturity = grid.back();
+        const DiscountFactor discount =
+            process->riskFreeRate()->discount(maturity);
+
+        switch (greeks_.estimator()) {
+          case MonteCarloGreeks::None:
+            return std::shared_ptr<
                        typename MCEuropeanEngine<RNG,S>::path_pricer_type>(
-          new EuropeanPathPricer(
-              payoff->optionType(),
-              payoff->strike(),
-              process->riskFreeRate()->discount(this->timeGrid().back())));
+                new EuropeanPathPricer(payoff->optionType(),
+                                       payoff->strike(),
+                                       discount));
+          case MonteCarloGreeks::Pathwise:
+            return greeks_.setPricer(std::make_shared<PathwiseAveragePathPricer>(
+                payoff->optionType(), payoff->strike(), discount, maturity,
+                BlackScholesPathDerivatives(process, grid), grid.size()-1,
+                this->antitheticVariate_));
+          case MonteCarloGreeks::LikelihoodRatio:
+            return greeks_.setPricer(std::make_shared<LikelihoodRatioPathPricer>(
+                std::make_shared<EuropeanPathPricer>(
+                    payoff->optionType(), payoff->strike(), discount),
+                std::make_shared<EuropeanPathPricer>(
+                    payoff->optionType(), payoff->strike(), maturity*discount),
+                BlackScholesPathDerivatives(process, grid),
+                this->antitheticVariate_));
+          default:
+            QL_FAIL("unknown greeks estimator");
+        }
     }
 
 
@@ -157,7 +287,8 @@ namespace QuantLib {
     inline MakeMCEuropeanEngine<RNG, S>::MakeMCEuropeanEngine(
         std::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
-      samples_(Null<Size>()), maxSamples_(Null<Size>()), tolerance_(Null<Real>()) {}
+      samples_(Null<Size>()), maxSamples_(Null<Size>()), tolerance_(Null<Real>()),
+      blockSize_(Null<Size>()) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -222,6 +353,21 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withGreeks(
+                                    MonteCarloGreeks::Estimator estimator) {
+        greeks_ = estimator;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withBlockSize(Size blockSize) {
+        blockSize_ = blockSize;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator std::shared_ptr<PricingEngine>()
@@ -238,7 +384,9 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    greeks_,
+                                    blockSize_));
     }
 
 
@@ -256,6 +404,28 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline EuropeanBlockPathPricer::EuropeanBlockPathPricer(
+                                                    Option::Type type,
+                                                    Real strike,
+                                                    DiscountFactor discount)
+    : phi_(type == Option::Call ? 1.0 : -1.0), strike_(strike),
+      discount_(discount) {
+        QL_REQUIRE(type == Option::Call || type == Option::Put,
+                   "unknown option type");
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+    }
+
+    inline Array
+    EuropeanBlockPathPricer::operator()(const PathBlock& paths) const {
+        QL_REQUIRE(paths.length() > 0, "the path cannot be empty");
+        const Real* s = paths[paths.length()-1];
+        Array values(paths.size());
+        for (Size j=0; j<values.size(); ++j)
+            values[j] = std::max(phi_*(s[j]-strike_), 0.0) * discount_;
+        return values;
+    }
+
 }
 
 
@@ -25,6 +25,7 @@
 #ifndef quantlib_mc_european_heston_engine_hpp
 #define quantlib_mc_european_heston_engine_hpp
 
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <utility>
@@ -32,10 +33,21 @@
 namespace QuantLib {
 
     //! Monte Carlo Heston-model engine for European options
-    /*! \ingroup vanillaengines
+    /*! If requested, delta and rho are estimated in the same
+        simulation by pathwise derivatives, see
+        EuropeanHestonPathwisePathPricer; their standard errors are
+        returned as additional results, see MonteCarloGreeksResults.
+        Vega is not returned, and likelihood-ratio greeks are not
+        available since the transition density of the discretized
+        process is not known in closed form.
+
+        \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
+
+        \test the returned greeks are tested against
+               finite-difference results.
     */
     template <class RNG = PseudoRandom,
               class S = Statistics, class P = HestonProcess>
@@ -51,9 +63,13 @@ namespace QuantLib {
                                Size requiredSamples,
                                Real requiredTolerance,
                                Size maxSamples,
-                               BigNatural seed);
+                               BigNatural seed,
+                               MonteCarloGreeks::Estimator greeks
+                                                  = MonteCarloGreeks::None);
+        void calculate() const override;
       protected:
         std::shared_ptr<path_pricer_type> pathPricer() const override;
+        MonteCarloGreeksResults greeks_;
     };
 
     //! Monte Carlo Heston European engine factory
@@ -70,6 +86,8 @@ namespace QuantLib {
         MakeMCEuropeanHestonEngine& withMaxSamples(Size samples);
         MakeMCEuropeanHestonEngine& withSeed(BigNatural seed);
         MakeMCEuropeanHestonEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanHestonEngine& withGreeks(
+            MonteCarloGreeks::Estimator estimator = MonteCarloGreeks::Pathwise);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
       private:
@@ -78,6 +96,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_ = 0;
+        MonteCarloGreeks::Estimator greeks_ = MonteCarloGreeks::None;
     };
 
 
@@ -93,6 +112,34 @@ namespace QuantLib {
         DiscountFactor discount_;
     };
 
+    //! pathwise delta and rho of a European option on Heston paths
+    /*! The discretizations of HestonProcess evolve the spot as
+        \f[
+            S_{k+1} = S_k \exp\left( (r_k - q_k)\Delta t_k
+                                    + f(v_k, v_{k+1}, Z_k) \right),
+        \f]
+        so that the final spot is proportional to the initial one and
+        a parallel shift of the risk-free rate multiplies it by
+        \f$ \exp(T \, \delta r) \f$; the variance paths don't depend
+        on either. Rho also includes the effect of the rate on the
+        discount factor.
+    */
+    class EuropeanHestonPathwisePathPricer : public PathPricer<MultiPath>,
+                                             public GreeksAccumulator {
+      public:
+        EuropeanHestonPathwisePathPricer(Option::Type type,
+                                         Real strike,
+                                         DiscountFactor discount,
+                                         Time maturity,
+                                         bool antitheticVariate);
+        Real operator()(const MultiPath& multiPath) const override;
+
+      private:
+        Real phi_, strike_;
+        DiscountFactor discount_;
+        Time maturity_;
+    };
+
 
     // template definitions
 
@@ -101,11 +148,24 @@ namespace QuantLib {
                 const std::shared_ptr<P>& process,
                 Size timeSteps, Size timeStepsPerYear, bool antitheticVariate,
                 Size requiredSamples, Real requiredTolerance,
-                Size maxSamples, BigNatural seed)
+                Size maxSamples, BigNatural seed,
+                MonteCarloGreeks::Estimator greeks)
     : MCVanillaEngine<MultiVariate,RNG,S>(process, timeSteps, timeStepsPerYear,
                                           false, antitheticVariate, false,
                                           requiredSamples, requiredTolerance,
-                                          maxSamples, seed) {}
+                                          maxSamples, seed),
+      greeks_(greeks) {
+        QL_REQUIRE(greeks != MonteCarloGreeks::LikelihoodRatio,
+                   "likelihood-ratio greeks not available for Heston paths");
+    }
+
+
+    template <class RNG, class S, class P>
+    inline void MCEuropeanHestonEngine<RNG,S,P>::calculate() const {
+        greeks_.reset();
+        MCVanillaEngine<MultiVariate,RNG,S>::calculate();
+        greeks_.fillResults(this->results_, false);
+    }
 
 
     template <class RNG, class S, class P>
@@ -122,13 +182,22 @@ namespace QuantLib {
             std::dynamic_pointer_cast<P>(this->process_);
         QL_REQUIRE(process, "Heston like process required");
 
+        const Time maturity = this->timeGrid().back();
+        const DiscountFactor discount =
+            process->riskFreeRate()->discount(maturity);
+
+        if (greeks_.estimator() == MonteCarloGreeks::Pathwise)
+            return greeks_.setPricer(
+                std::make_shared<EuropeanHestonPathwisePathPricer>(
+                    payoff->optionType(), payoff->strike(), discount,
+                    maturity, this->antitheticVariate_));
+
         return std::shared_ptr<
             typename MCEuropeanHestonEngine<RNG,S,P>::path_pricer_type>(
                    new EuropeanHestonPathPricer(
                                         payoff->optionType(),
                                         payoff->strike(),
-                                        process->riskFreeRate()->discount(
-                                                   this->timeGrid().back())));
+                                        discount));
     }
 
 
@@ -198,6 +267,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class P>
+    inline MakeMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMCEuropeanHestonEngine<RNG,S,P>::withGreeks(
+                                    MonteCarloGreeks::Estimator estimator) {
+        greeks_ = estimator;
+        return *this;
+    }
+
     template <class RNG, class S, class P>
     inline
     MakeMCEuropeanHestonEngine<RNG,S,P>::
@@ -211,7 +288,8 @@ namespace QuantLib {
                                                    antithetic_,
                                                    samples_, tolerance_,
                                                    maxSamples_,
-                                                   seed_));
+                                                   seed_,
+                                                   greeks_));
     }
 
 
@@ -234,6 +312,40 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+
+    inline EuropeanHestonPathwisePathPricer::EuropeanHestonPathwisePathPricer(
+                                                 Option::Type type,
+                                                 Real strike,
+                                                 DiscountFactor discount,
+                                                 Time maturity,
+                                                 bool antitheticVariate)
+    : GreeksAccumulator(antitheticVariate),
+      phi_(type == Option::Call ? 1.0 : -1.0), strike_(strike),
+      discount_(discount), maturity_(maturity) {
+        QL_REQUIRE(type == Option::Call || type == Option::Put,
+                   "unknown option type");
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+    }
+
+    inline Real EuropeanHestonPathwisePathPricer::operator()(
+                                           const MultiPath& multiPath) const {
+        const Path& path = multiPath[0];
+        QL_REQUIRE(multiPath.pathSize()>0, "the path cannot be empty");
+
+        const Real spot = path.back();
+        if (phi_*(spot - strike_) <= 0.0) {
+            addGreeks(0.0, 0.0, 0.0);
+            return 0.0;
+        }
+
+        const Real value = discount_*phi_*(spot - strike_);
+        const Real dValue = discount_*phi_*spot;
+        addGreeks(dValue/path.front(), 0.0,
+                  maturity_*dValue - maturity_*value);
+        return value;
+    }
+
 }
 
 
@@ -0,0 +1,271 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmceuropeanhestonengine.hpp
+    \brief Multilevel Monte Carlo Heston-model engine for European options
+*/
+
+#ifndef quantlib_mlmc_european_heston_engine_hpp
+#define quantlib_mlmc_european_heston_engine_hpp
+
+#include <ql/exercise.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/multilevelmcsimulation.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo Heston-model engine for European options
+    /*! The number of time steps of the coarsest level is given;
+        finer levels are added until the estimated discretization
+        bias and statistical error are both below the required
+        tolerance divided by \f$ \sqrt{2} \f$, see
+        MultilevelMonteCarloModel.
+
+        The coarse path of a level is driven by the sums of the
+        Gaussian increments of the fine one; this couples the levels
+        only for the Euler discretizations of the variance process
+        (partial truncation, full truncation and reflection), which
+        are therefore the only ones accepted. The other schemes map
+        the increments non-linearly into the variance of each step,
+        so that the variances of the level differences decay too
+        slowly for the multilevel estimate to pay off.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned value is tested by
+              checking it against analytic results.
+    */
+    template <class RNG = PseudoRandom,
+              class S = Statistics, class P = HestonProcess>
+    class MLMCEuropeanHestonEngine : public VanillaOption::engine,
+                                     public MultilevelMcSimulation<RNG,S> {
+      public:
+        typedef typename MultilevelMcSimulation<RNG,S>::path_pricer_type
+            path_pricer_type;
+        MLMCEuropeanHestonEngine(std::shared_ptr<P> process,
+                                 Size timeSteps,
+                                 Size timeStepsPerYear,
+                                 bool antitheticVariate,
+                                 Real requiredTolerance,
+                                 Size maxLevels,
+                                 Size initialSamples,
+                                 BigNatural seed,
+                                 Real weakOrder = 1.0);
+        void calculate() const override;
+      protected:
+        std::shared_ptr<StochasticProcess> process() const override {
+            return process_;
+        }
+        TimeGrid coarsestTimeGrid() const override;
+        std::shared_ptr<path_pricer_type> pathPricer(
+                                       const TimeGrid& grid) const override;
+        std::shared_ptr<P> process_;
+        Size timeSteps_, timeStepsPerYear_;
+        Real requiredTolerance_;
+        Size maxLevels_, initialSamples_;
+        BigNatural seed_;
+    };
+
+    //! Multilevel Monte Carlo Heston European engine factory
+    template <class RNG = PseudoRandom,
+              class S = Statistics, class P = HestonProcess>
+    class MakeMLMCEuropeanHestonEngine {
+      public:
+        explicit MakeMLMCEuropeanHestonEngine(std::shared_ptr<P>);
+        // named parameters
+        MakeMLMCEuropeanHestonEngine& withSteps(Size steps);
+        MakeMLMCEuropeanHestonEngine& withStepsPerYear(Size steps);
+        MakeMLMCEuropeanHestonEngine& withAbsoluteTolerance(Real tolerance);
+        MakeMLMCEuropeanHestonEngine& withMaxLevels(Size levels);
+        MakeMLMCEuropeanHestonEngine& withInitialSamples(Size samples);
+        MakeMLMCEuropeanHestonEngine& withSeed(BigNatural seed);
+        MakeMLMCEuropeanHestonEngine& withAntitheticVariate(bool b = true);
+        MakeMLMCEuropeanHestonEngine& withWeakOrder(Real order);
+        // conversion to pricing engine
+        operator std::shared_ptr<PricingEngine>() const;
+      private:
+        std::shared_ptr<P> process_;
+        bool antithetic_ = false;
+        Size steps_, stepsPerYear_;
+        Real tolerance_;
+        Size maxLevels_ = 10, initialSamples_ = 1000;
+        BigNatural seed_ = 0;
+        Real weakOrder_ = 1.0;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S, class P>
+    inline MLMCEuropeanHestonEngine<RNG,S,P>::MLMCEuropeanHestonEngine(
+                std::shared_ptr<P> process,
+                Size timeSteps, Size timeStepsPerYear, bool antitheticVariate,
+                Real requiredTolerance, Size maxLevels, Size initialSamples,
+                BigNatural seed, Real weakOrder)
+    : MultilevelMcSimulation<RNG,S>(antitheticVariate, weakOrder),
+      process_(std::move(process)), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear),
+      requiredTolerance_(requiredTolerance), maxLevels_(maxLevels),
+      initialSamples_(initialSamples), seed_(seed) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        QL_REQUIRE(process_->discretization() == HestonProcess::PartialTruncation
+                   || process_->discretization() == HestonProcess::FullTruncation
+                   || process_->discretization() == HestonProcess::Reflection,
+                   "only the Euler discretizations of the Heston process "
+                   "are supported by the multilevel engine");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S, class P>
+    inline TimeGrid
+    MLMCEuropeanHestonEngine<RNG,S,P>::coarsestTimeGrid() const {
+        const Time t = process_->time(arguments_.exercise->lastDate());
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(t, timeSteps_);
+        } else {
+            const Size steps = static_cast<Size>(timeStepsPerYear_*t);
+            return TimeGrid(t, std::max<Size>(steps, 1));
+        }
+    }
+
+    template <class RNG, class S, class P>
+    inline
+    std::shared_ptr<
+        typename MLMCEuropeanHestonEngine<RNG,S,P>::path_pricer_type>
+    MLMCEuropeanHestonEngine<RNG,S,P>::pathPricer(const TimeGrid& grid) const {
+        std::shared_ptr<PlainVanillaPayoff> payoff =
+            std::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return std::make_shared<EuropeanHestonPathPricer>(
+            payoff->optionType(), payoff->strike(),
+            process_->riskFreeRate()->discount(grid.back()));
+    }
+
+    template <class RNG, class S, class P>
+    inline void MLMCEuropeanHestonEngine<RNG,S,P>::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        MultilevelMcSimulation<RNG,S>::calculate(requiredTolerance_,
+                                                 maxLevels_,
+                                                 initialSamples_,
+                                                 seed_);
+        results_.value = this->model_->value();
+        results_.errorEstimate = this->model_->errorEstimate();
+        results_.additionalResults["Levels"] = this->model_->levels();
+        results_.additionalResults["Cost"] = this->model_->cost();
+    }
+
+
+    template <class RNG, class S, class P>
+    inline
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::MakeMLMCEuropeanHestonEngine(
+                                                    std::shared_ptr<P> process)
+    : process_(std::move(process)), steps_(Null<Size>()),
+      stepsPerYear_(Null<Size>()), tolerance_(Null<Real>()) {}
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withSteps(Size steps) {
+        QL_REQUIRE(stepsPerYear_ == Null<Size>(),
+                   "number of steps per year already set");
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withStepsPerYear(Size steps) {
+        QL_REQUIRE(steps_ == Null<Size>(),
+                   "number of steps already set");
+        stepsPerYear_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withAbsoluteTolerance(
+                                                            Real tolerance) {
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withMaxLevels(Size levels) {
+        maxLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withInitialSamples(Size samples) {
+        initialSamples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withAntitheticVariate(bool b) {
+        antithetic_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withWeakOrder(Real order) {
+        weakOrder_ = order;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::
+    operator std::shared_ptr<PricingEngine>() const {
+        QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
+                   "number of steps not given");
+        return std::make_shared<MLMCEuropeanHestonEngine<RNG,S,P> >(
+            process_, steps_, stepsPerYear_, antithetic_, tolerance_,
+            maxLevels_, initialSamples_, seed_, weakOrder_);
+    }
+
+}
+
+
+#endif
@@ -60,6 +60,11 @@ namespace QuantLib {
         Size factors() const override;
         Array drift(Time t, const Array& x) const override;
         Array evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
+        //! the jumps are not part of the Heston step evolver
+        std::shared_ptr<StepEvolver>
+        stepEvolver(const TimeGrid& grid) const override {
+            return StochasticProcess::stepEvolver(grid);
+        }
 
         Real lambda() const;
         Real nu()     const;
@@ -146,6 +146,32 @@ namespace QuantLib {
                                  stdDeviation(t0, x0, dt) * dw);
     }
 
+    bool GeneralizedBlackScholesProcess::stepCoefficients(
+                                                    const TimeGrid& grid,
+                                                    Array& drift,
+                                                    Array& diffusion) const {
+        localVolatility(); // trigger update
+        if (!isStrikeIndependent_ || forceDiscretization_)
+            return false;
+
+        const Size steps = grid.size()-1;
+        drift = Array(steps);
+        diffusion = Array(steps);
+        for (Size i=0; i<steps; ++i) {
+            // same as in evolve
+            const Time t0 = grid[i], dt = grid.dt(i);
+            const Real var = variance(t0, x0(), dt);
+            drift[i] = (riskFreeRate_->forwardRate(t0, t0 + dt, Continuous,
+                                                   NoFrequency, true).rate() -
+                        dividendYield_->forwardRate(t0, t0 + dt, Continuous,
+                                                    NoFrequency, true).rate()) *
+                           dt -
+                       0.5 * var;
+            diffusion[i] = std::sqrt(var);
+        }
+        return true;
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
@@ -83,6 +83,13 @@ namespace QuantLib {
         Real stdDeviation(Time t0, Real x0, Time dt) const override;
         Real variance(Time t0, Real x0, Time dt) const override;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const override;
+        /*! the coefficients are available for the exact evolution,
+            i.e., if the volatility is strike-independent and the
+            discretization is not forced.
+        */
+        bool stepCoefficients(const TimeGrid& grid,
+                              Array& drift,
+                              Array& diffusion) const override;
         //@}
         Time time(const Date&) const override;
         //! \name Observer interface
@@ -43,7 +43,7 @@ namespace QuantLib {
                                  Real sigma,
                                  Real rho,
                                  Discretization d)
-    : StochasticProcess(std::shared_ptr<discretization>(new EulerDiscretization)),
+    : StochasticProcess(std::shared_ptr<StochasticProcess::discretization>(new EulerDiscretization)),
       riskFreeRate_(std::move(riskFreeRate)), dividendYield_(std::move(dividendYield)),
       s0_(std::move(s0)), v0_(v0), kappa_(kappa), theta_(theta), sigma_(sigma), rho_(rho),
       discretization_(d) {
@@ -393,8 +393,44 @@ namespace QuantLib {
                      v/k) / k;
      }
 
+    class HestonProcess::HestonStepEvolver
+        : public StochasticProcess::StepEvolver {
+      public:
+        HestonStepEvolver(const HestonProcess& process, TimeGrid grid)
+        : process_(process), grid_(std::move(grid)),
+          rateDrift_(grid_.size()-1) {
+            for (Size i=0; i<rateDrift_.size(); ++i)
+                rateDrift_[i] = process_.rateDrift(grid_[i], grid_.dt(i));
+        }
+
+        Array evolve(Size i, const Array& x0,
+                     const Array& dw) const override {
+            return process_.evolveStep(x0, grid_.dt(i), dw, rateDrift_[i]);
+        }
+
+      private:
+        const HestonProcess& process_;
+        TimeGrid grid_;
+        Array rateDrift_;
+    };
+
     Array HestonProcess::evolve(Time t0, const Array& x0,
                                 Time dt, const Array& dw) const {
+        return evolveStep(x0, dt, dw, rateDrift(t0, dt));
+    }
+
+    std::shared_ptr<StochasticProcess::StepEvolver>
+    HestonProcess::stepEvolver(const TimeGrid& grid) const {
+        return std::make_shared<HestonStepEvolver>(*this, grid);
+    }
+
+    Real HestonProcess::rateDrift(Time t0, Time dt) const {
+        return riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
+             - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate();
+    }
+
+    Array HestonProcess::evolveStep(const Array& x0, Time dt,
+                                    const Array& dw, Real r) const {
         Array retVal(2);
         Real vol, vol2, mu, nu, dy;
 
@@ -410,9 +446,7 @@ namespace QuantLib {
           case PartialTruncation:
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : Real(0.0);
             vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate()
-                    - 0.5 * vol * vol;
+            mu = r - 0.5 * vol * vol;
             nu = kappa_*(theta_ - x0[1]);
 
             retVal[0] = x0[0] * std::exp(mu*dt+vol*dw[0]*sdt);
@@ -421,9 +455,7 @@ namespace QuantLib {
           case FullTruncation:
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : Real(0.0);
             vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate()
-                    - 0.5 * vol * vol;
+            mu = r - 0.5 * vol * vol;
             nu = kappa_*(theta_ - vol*vol);
 
             retVal[0] = x0[0] * std::exp(mu*dt+vol*dw[0]*sdt);
@@ -432,9 +464,7 @@ namespace QuantLib {
           case Reflection:
             vol = std::sqrt(std::fabs(x0[1]));
             vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate()
-                    - 0.5 * vol*vol;
+            mu = r - 0.5 * vol*vol;
             nu = kappa_*(theta_ - vol*vol);
 
             retVal[0] = x0[0]*std::exp(mu*dt+vol*dw[0]*sdt);
@@ -448,9 +478,7 @@ namespace QuantLib {
             // process. For further details please read the Wilmott thread
             // "QuantLib code is very high quality"
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : Real(0.0);
-            mu =   riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                 - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate()
-                   - 0.5 * vol*vol;
+            mu = r - 0.5 * vol*vol;
 
             retVal[1] = varianceDistribution(x0[1], dw[1], dt);
             dy = (mu - rho_/sigma_*kappa_
@@ -507,8 +535,7 @@ namespace QuantLib {
                 retVal[1] = ((u <= p) ? Real(0.0) : std::log((1-p)/(1-u))/beta);
             }
 
-            mu =   riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                 - dividendYield_->forwardRate(t0, t0+dt, Continuous).rate();
+            mu = r;
 
             retVal[0] = x0[0]*std::exp(mu*dt + k0 + k1*x0[1] + k2*retVal[1]
                                        +std::sqrt(k3*x0[1]+k4*retVal[1])*dw[0]);
@@ -531,9 +558,7 @@ namespace QuantLib {
             const Real vdw
                 = (nu_t - nu_0 - kappa_*theta_*dt + kappa_*vds)/sigma_;
 
-            mu = ( riskFreeRate_->forwardRate(t0, t0+dt, Continuous).rate()
-                  -dividendYield_->forwardRate(t0, t0+dt, Continuous).rate())*dt
-                - 0.5*vds + rho_*vdw;
+            mu = r*dt - 0.5*vds + rho_*vdw;
 
             const Volatility sig = std::sqrt((1-rho_*rho_)*vds);
             const Real s = x0[0]*std::exp(mu + sig*dw[0]);
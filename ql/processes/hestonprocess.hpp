@@ -73,12 +73,18 @@ namespace QuantLib {
         Matrix diffusion(Time t, const Array& x) const override;
         Array apply(const Array& x0, const Array& dx) const override;
         Array evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
+        /*! precomputes the difference of the risk-free and dividend
+            forward rates over each step of the grid.
+        */
+        std::shared_ptr<StepEvolver>
+        stepEvolver(const TimeGrid& grid) const override;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
         Real kappa() const { return kappa_; }
         Real theta() const { return theta_; }
         Real sigma() const { return sigma_; }
+        Discretization discretization() const { return discretization_; }
 
         const Handle<Quote>& s0() const;
         const Handle<YieldTermStructure>& dividendYield() const;
@@ -91,7 +97,11 @@ namespace QuantLib {
         Real pdf(Real x, Real v, Time t, Real eps=1e-3) const;
 
       private:
+        class HestonStepEvolver;
         Real varianceDistribution(Real v, Real dw, Time dt) const;
+        Real rateDrift(Time t0, Time dt) const;
+        Array evolveStep(const Array& x0, Time dt,
+                         const Array& dw, Real r) const;
 
         Handle<YieldTermStructure> riskFreeRate_, dividendYield_;
         Handle<Quote> s0_;
@@ -20,6 +20,7 @@
 
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
+#include <utility>
 
 namespace QuantLib {
 
@@ -109,6 +110,70 @@ namespace QuantLib {
         return tmp;
     }
 
+    class StochasticProcessArray::ArrayStepEvolver
+        : public StochasticProcess::StepEvolver {
+      public:
+        ArrayStepEvolver(const StochasticProcessArray& process,
+                         TimeGrid grid)
+        : process_(process), grid_(std::move(grid)),
+          drift_(process.size()), diffusion_(process.size()),
+          hasCoefficients_(process.size()) {
+            for (Size k=0; k<process_.size(); ++k)
+                hasCoefficients_[k] =
+                    process_.processes_[k]->stepCoefficients(
+                        grid_, drift_[k], diffusion_[k]);
+        }
+
+        Array evolve(Size i, const Array& x0,
+                     const Array& dw) const override {
+            const Array dz = process_.sqrtCorrelation_ * dw;
+
+            Array tmp(process_.size());
+            for (Size k=0; k<tmp.size(); ++k) {
+                const auto& p = process_.processes_[k];
+                tmp[k] = hasCoefficients_[k]
+                    ? p->apply(x0[k], diffusion_[k][i]*dz[k] + drift_[k][i])
+                    : p->evolve(grid_[i], x0[k], grid_.dt(i), dz[k]);
+            }
+            return tmp;
+        }
+
+        void evolveBlock(Size i, Matrix& x,
+                         const Matrix& dw) const override {
+            QL_REQUIRE(x.columns() == dw.columns(),
+                       "number of paths (" << x.columns() << ", "
+                       << dw.columns() << ") differ");
+            const Matrix dz = process_.sqrtCorrelation_ * dw;
+
+            const Size paths = x.columns();
+            for (Size k=0; k<process_.size(); ++k) {
+                const auto& p = process_.processes_[k];
+                const Real* z = dz.row_begin(k);
+                Real* y = x.row_begin(k);
+                if (hasCoefficients_[k]) {
+                    const Real a = drift_[k][i], b = diffusion_[k][i];
+                    for (Size j=0; j<paths; ++j)
+                        y[j] = p->apply(y[j], b*z[j] + a);
+                } else {
+                    const Time t = grid_[i], dt = grid_.dt(i);
+                    for (Size j=0; j<paths; ++j)
+                        y[j] = p->evolve(t, y[j], dt, z[j]);
+                }
+            }
+        }
+
+      private:
+        const StochasticProcessArray& process_;
+        TimeGrid grid_;
+        std::vector<Array> drift_, diffusion_;
+        std::vector<bool> hasCoefficients_;
+    };
+
+    std::shared_ptr<StochasticProcess::StepEvolver>
+    StochasticProcessArray::stepEvolver(const TimeGrid& grid) const {
+        return std::make_shared<ArrayStepEvolver>(*this, grid);
+    }
+
     Array StochasticProcessArray::apply(const Array& x0,
                                         const Array& dx) const {
         Array tmp(size());
@@ -49,6 +49,11 @@ namespace QuantLib {
 
         Array apply(const Array& x0, const Array& dx) const override;
         Array evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
+        /*! uses the step coefficients of the processes providing
+            them, see StochasticProcess1D::stepCoefficients.
+        */
+        std::shared_ptr<StepEvolver>
+        stepEvolver(const TimeGrid& grid) const override;
 
         Time time(const Date&) const override;
         // inspectors
@@ -57,6 +62,8 @@ namespace QuantLib {
       protected:
         std::vector<std::shared_ptr<StochasticProcess1D> > processes_;
         Matrix sqrtCorrelation_;
+      private:
+        class ArrayStepEvolver;
     };
 
 }
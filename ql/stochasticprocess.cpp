@@ -61,6 +61,29 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess::StepEvolver::evolveBlock(Size i,
+                                                     Matrix& x,
+                                                     const Matrix& dw) const {
+        QL_REQUIRE(x.columns() == dw.columns(),
+                   "number of paths (" << x.columns() << ", "
+                   << dw.columns() << ") differ");
+        Array x0(x.rows()), w(dw.rows());
+        for (Size j=0; j<x.columns(); ++j) {
+            for (Size k=0; k<x0.size(); ++k)
+                x0[k] = x[k][j];
+            for (Size l=0; l<w.size(); ++l)
+                w[l] = dw[l][j];
+            const Array x1 = evolve(i, x0, w);
+            for (Size k=0; k<x0.size(); ++k)
+                x[k][j] = x1[k];
+        }
+    }
+
+    std::shared_ptr<StochasticProcess::StepEvolver>
+    StochasticProcess::stepEvolver(const TimeGrid&) const {
+        return nullptr;
+    }
+
     Time StochasticProcess::time(const Date& ) const {
         QL_FAIL("date/time conversion not supported");
     }
@@ -96,4 +119,9 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    bool StochasticProcess1D::stepCoefficients(const TimeGrid&,
+                                               Array&, Array&) const {
+        return false;
+    }
+
 }
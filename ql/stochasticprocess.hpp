@@ -29,6 +29,7 @@
 #include <ql/time/date.hpp>
 #include <ql/patterns/observable.hpp>
 #include <ql/math/matrix.hpp>
+#include <ql/timegrid.hpp>
 
 namespace QuantLib {
 
@@ -58,6 +59,35 @@ namespace QuantLib {
                                       const Array& x0,
                                       Time dt) const = 0;
         };
+        //! evolution of a stochastic process over the steps of a time grid
+        /*! Instances precompute the path-independent parts of the
+            evolution, e.g., forward rates taken from term structures,
+            for all the steps of the grid.
+
+            \warning instances reflect the state of the process when
+                     they are built and are not notified of its
+                     changes; they must not outlive the process.
+        */
+        class StepEvolver {
+          public:
+            virtual ~StepEvolver() = default;
+            //! evolves x0 over the i-th step of the grid
+            virtual Array evolve(Size i,
+                                 const Array& x0,
+                                 const Array& dw) const = 0;
+            /*! evolves a block of paths over the i-th step of the
+                grid. The rows of x hold the state variables and the
+                rows of dw the factors, with one column per path;
+                x is overwritten with the evolved values.
+
+                The default implementation calls evolve() for each
+                path; evolvers should override it when they can work
+                on all the paths of a step at once.
+            */
+            virtual void evolveBlock(Size i,
+                                     Matrix& x,
+                                     const Matrix& dw) const;
+        };
         ~StochasticProcess() override = default;
         //! \name Stochastic process interface
         //@{
@@ -129,6 +159,13 @@ namespace QuantLib {
         */
         virtual Array apply(const Array& x0,
                             const Array& dx) const;
+        /*! returns an evolver over the steps of the given grid giving
+            the same results as evolve(), or null if the process does
+            not precompute any part of its evolution, which is the
+            default.
+        */
+        virtual std::shared_ptr<StepEvolver>
+        stepEvolver(const TimeGrid& grid) const;
         //@}
 
         //! \name utilities
@@ -221,6 +258,20 @@ namespace QuantLib {
             returns \f$ x + \Delta x \f$.
         */
         virtual Real apply(Real x0, Real dx) const;
+        /*! returns true and fills the given arrays if the evolution
+            over the \f$ i \f$-th step of the given grid is
+            \f[
+            x_{i+1} = \mathrm{apply}(x_i, \mu_i + \sigma_i \Delta w),
+            \f]
+            with \f$ \mu_i \f$ and \f$ \sigma_i \f$ independent of
+            \f$ x_i \f$ and with the same results as evolve(). Path
+            generators use these coefficients instead of calling
+            evolve() for each step of each path. The default
+            implementation returns false.
+        */
+        virtual bool stepCoefficients(const TimeGrid& grid,
+                                      Array& drift,
+                                      Array& diffusion) const;
         //@}
       protected:
         StochasticProcess1D() = default;
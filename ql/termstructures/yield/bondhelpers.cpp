@@ -69,6 +69,22 @@ namespace QuantLib {
         }
     }
 
+    void BondHelper::impliedQuoteAdjoint(Real quoteAdjoint,
+                                         DiscountAdjoints& adjoints) const {
+        QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
+        QL_REQUIRE(priceType_ == Bond::Price::Clean ||
+                   priceType_ == Bond::Price::Dirty,
+                   "This price type isn't implemented.");
+        // both prices are settlementValue*100/notional, up to the
+        // accrued amount which doesn't depend on the curve
+        Real notional = bond_->notional(bond_->settlementDate());
+        if (notional == 0.0)
+            return;
+        DiscountingBondEngine(termStructureHandle_)
+            .settlementValueAdjoint(*bond_, quoteAdjoint * 100.0 / notional,
+                                    adjoints);
+    }
+
     void BondHelper::accept(AcyclicVisitor& v) {
         auto* v1 = dynamic_cast<Visitor<BondHelper>*>(&v);
         if (v1 != nullptr)
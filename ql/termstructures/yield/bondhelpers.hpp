@@ -30,6 +30,7 @@
 #include <ql/instruments/bonds/fixedratebond.hpp>
 #include <ql/instruments/bonds/cpibond.hpp>
 #include <ql/cashflows/cpicoupon.hpp>
+#include <ql/termstructures/yield/discountadjoints.hpp>
 
 namespace QuantLib {
 
@@ -37,7 +38,7 @@ namespace QuantLib {
     /*! \warning This class assumes that the reference date
                  does not change between calls of setTermStructure().
     */
-    class BondHelper : public RateHelper {
+    class BondHelper : public RateHelper, public AdjointRateHelper {
       public:
         /*! \warning Setting a pricing engine to the passed bond from
                      external code will cause the bootstrap to fail or
@@ -54,6 +55,11 @@ namespace QuantLib {
         Real impliedQuote() const override;
         void setTermStructure(YieldTermStructure*) override;
         //@}
+        //! \name AdjointRateHelper interface
+        //@{
+        void impliedQuoteAdjoint(Real quoteAdjoint,
+                                 DiscountAdjoints& adjoints) const override;
+        //@}
         //! \name Additional inspectors
         //@{
         std::shared_ptr<Bond> bond() const;
@@ -107,6 +107,26 @@ namespace QuantLib {
                                 Size i) {
             data[i] = discount;
         }
+        // adjoint of the discount at t with respect to the data
+        template <class C, class A>
+        static void discountAdjoint(const C* c,
+                                    const A& interpolation,
+                                    Time t,
+                                    Real adjoint,
+                                    std::vector<Real>& dataAdjoints) {
+            Time tMax = c->times().back();
+            if (t <= tMax) {
+                interpolation.addValueAdjoint(t, adjoint, dataAdjoints);
+                return;
+            }
+            // flat fwd extrapolation
+            DiscountFactor dMax = c->data().back();
+            Rate instFwdMax = - interpolation.derivative(tMax) / dMax;
+            DiscountFactor d = dMax * std::exp(- instFwdMax * (t-tMax));
+            dataAdjoints.back() += adjoint * d * (1.0 + instFwdMax*(t-tMax)) / dMax;
+            interpolation.addDerivativeAdjoint(tMax, adjoint * d * (t-tMax) / dMax,
+                                               dataAdjoints);
+        }
         // upper bound for convergence loop
         static Size maxIterations() { return 100; }
     };
@@ -188,6 +208,29 @@ namespace QuantLib {
             if (i==1)
                 data[0] = rate; // first point is updated as well
         }
+        // adjoint of the discount at t with respect to the data
+        template <class C, class A>
+        static void discountAdjoint(const C* c,
+                                    const A& interpolation,
+                                    Time t,
+                                    Real adjoint,
+                                    std::vector<Real>& dataAdjoints) {
+            if (t == 0.0)
+                return;
+            Time tMax = c->times().back();
+            if (t <= tMax) {
+                DiscountFactor d = std::exp(- interpolation.value(t) * t);
+                interpolation.addValueAdjoint(t, - adjoint * d * t, dataAdjoints);
+                return;
+            }
+            // flat fwd extrapolation
+            Rate zMax = c->data().back();
+            Rate instFwdMax = zMax + tMax * interpolation.derivative(tMax);
+            DiscountFactor d = std::exp(- zMax * tMax - instFwdMax * (t-tMax));
+            dataAdjoints.back() -= adjoint * d * t;
+            interpolation.addDerivativeAdjoint(tMax, - adjoint * d * tMax * (t-tMax),
+                                               dataAdjoints);
+        }
         // upper bound for convergence loop
         static Size maxIterations() { return 100; }
     };
@@ -269,6 +312,28 @@ namespace QuantLib {
             if (i==1)
                 data[0] = forward; // first point is updated as well
         }
+        // adjoint of the discount at t with respect to the data
+        template <class C, class A>
+        static void discountAdjoint(const C* c,
+                                    const A& interpolation,
+                                    Time t,
+                                    Real adjoint,
+                                    std::vector<Real>& dataAdjoints) {
+            if (t == 0.0)
+                return;
+            Time tMax = c->times().back();
+            if (t <= tMax) {
+                DiscountFactor d = std::exp(- interpolation.primitive(t));
+                interpolation.addPrimitiveAdjoint(t, - adjoint * d, dataAdjoints);
+                return;
+            }
+            // flat fwd extrapolation
+            Rate fMax = c->data().back();
+            DiscountFactor d =
+                std::exp(- interpolation.primitive(tMax) - fMax * (t-tMax));
+            dataAdjoints.back() -= adjoint * d * (t-tMax);
+            interpolation.addPrimitiveAdjoint(tMax, - adjoint * d, dataAdjoints);
+        }
         // upper bound for convergence loop
         static Size maxIterations() { return 100; }
     };
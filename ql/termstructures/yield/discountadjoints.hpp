@@ -0,0 +1,222 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file discountadjoints.hpp
+    \brief reverse-mode derivatives with respect to discount factors
+*/
+
+#ifndef quantlib_discount_adjoints_hpp
+#define quantlib_discount_adjoints_hpp
+
+#include <ql/math/interpolations/backwardflatinterpolation.hpp>
+#include <ql/math/interpolations/forwardflatinterpolation.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! adjoints of the discount factors read from yield term structures
+    /*! Pricing code running in reverse mode adds here the derivative
+        of its result with respect to each discount factor it reads,
+        keyed by term structure and time.  A term structure can then
+        chain them to its own inputs; see
+        PiecewiseYieldCurve::quoteSensitivities.
+
+        The term structures are identified by address; the adjoints
+        are only valid as long as the curves are alive.
+    */
+    class DiscountAdjoints {
+      public:
+        typedef std::vector<std::pair<Time, Real> > entries;
+        //! adds the adjoint of the discount factor at the given time
+        void add(const YieldTermStructure& curve, Time t, Real adjoint) {
+            if (adjoint != 0.0)
+                adjoints_[&curve].emplace_back(t, adjoint);
+        }
+        //! adds the adjoint of the discount factor at the given date
+        void add(const YieldTermStructure& curve, const Date& d, Real adjoint) {
+            add(curve, curve.timeFromReference(d), adjoint);
+        }
+        //! adds the adjoint of the simple forward rate \f$ (D(d_1)/D(d_2)-1)/t \f$
+        void addForward(const YieldTermStructure& curve,
+                        const Date& d1, const Date& d2, Time t, Real adjoint) {
+            DiscountFactor disc1 = curve.discount(d1);
+            DiscountFactor disc2 = curve.discount(d2);
+            add(curve, d1, adjoint / (t * disc2));
+            add(curve, d2, -adjoint * disc1 / (t * disc2 * disc2));
+        }
+        //! the adjoints added for the given curve
+        const entries& operator[](const YieldTermStructure& curve) const {
+            static const entries none;
+            auto i = adjoints_.find(&curve);
+            return i == adjoints_.end() ? none : i->second;
+        }
+        void clear() { adjoints_.clear(); }
+      private:
+        std::map<const YieldTermStructure*, entries> adjoints_;
+    };
+
+
+    //! rate helper providing the adjoint of its implied quote
+    /*! To be inherited by rate helpers along with RateHelper. */
+    class AdjointRateHelper {
+      public:
+        virtual ~AdjointRateHelper() = default;
+        /*! adds to the given adjoints the derivatives of the implied
+            quote, times quoteAdjoint, with respect to the discount
+            factors it reads.
+        */
+        virtual void impliedQuoteAdjoint(Real quoteAdjoint,
+                                         DiscountAdjoints& adjoints) const = 0;
+    };
+
+
+    namespace detail {
+
+        /* Derivatives of an interpolation with respect to its data.
+           Each specialization provides the interpolated value,
+           derivative and primitive at t, and adds the derivatives of
+           the same quantities, times a given adjoint, to a vector
+           holding one entry per data point.
+        */
+        template <class Interpolator>
+        class InterpolationAdjoint;
+
+        // interpolations linear in the data: the derivatives are the
+        // interpolations of the unit vectors
+        class LinearDataInterpolationAdjoint {
+          public:
+            template <class Interpolator>
+            LinearDataInterpolationAdjoint(const std::vector<Time>& x,
+                                           const std::vector<Real>& y,
+                                           const Interpolator& interpolator)
+            : x_(x), y_(y), units_(y.size(), std::vector<Real>(y.size(), 0.0)) {
+                interpolation_ = interpolator.interpolate(x_.begin(), x_.end(),
+                                                          y_.begin());
+                basis_.reserve(y.size());
+                for (Size j=0; j<y.size(); ++j) {
+                    units_[j][j] = 1.0;
+                    basis_.push_back(interpolator.interpolate(
+                        x_.begin(), x_.end(), units_[j].begin()));
+                }
+            }
+            // the interpolations point to the data members
+            LinearDataInterpolationAdjoint(const LinearDataInterpolationAdjoint&) = delete;
+            LinearDataInterpolationAdjoint& operator=(const LinearDataInterpolationAdjoint&) = delete;
+
+            Real value(Time t) const { return interpolation_(t, true); }
+            Real derivative(Time t) const { return interpolation_.derivative(t, true); }
+            Real primitive(Time t) const { return interpolation_.primitive(t, true); }
+
+            void addValueAdjoint(Time t, Real adjoint, std::vector<Real>& result) const {
+                for (Size j=0; j<basis_.size(); ++j)
+                    result[j] += adjoint * basis_[j](t, true);
+            }
+            void addDerivativeAdjoint(Time t, Real adjoint, std::vector<Real>& result) const {
+                for (Size j=0; j<basis_.size(); ++j)
+                    result[j] += adjoint * basis_[j].derivative(t, true);
+            }
+            void addPrimitiveAdjoint(Time t, Real adjoint, std::vector<Real>& result) const {
+                for (Size j=0; j<basis_.size(); ++j)
+                    result[j] += adjoint * basis_[j].primitive(t, true);
+            }
+          private:
+            std::vector<Time> x_;
+            std::vector<Real> y_;
+            std::vector<std::vector<Real> > units_;
+            Interpolation interpolation_;
+            std::vector<Interpolation> basis_;
+        };
+
+        template <>
+        class InterpolationAdjoint<Linear> : public LinearDataInterpolationAdjoint {
+          public:
+            using LinearDataInterpolationAdjoint::LinearDataInterpolationAdjoint;
+        };
+
+        template <>
+        class InterpolationAdjoint<BackwardFlat> : public LinearDataInterpolationAdjoint {
+          public:
+            using LinearDataInterpolationAdjoint::LinearDataInterpolationAdjoint;
+        };
+
+        template <>
+        class InterpolationAdjoint<ForwardFlat> : public LinearDataInterpolationAdjoint {
+          public:
+            using LinearDataInterpolationAdjoint::LinearDataInterpolationAdjoint;
+        };
+
+        // log-linear interpolation: y = exp(L(t)) with L linear in log y
+        template <>
+        class InterpolationAdjoint<LogLinear> {
+          public:
+            InterpolationAdjoint(const std::vector<Time>& x,
+                                 const std::vector<Real>& y,
+                                 const LogLinear&)
+            : y_(y), logs_(x, logs(y), Linear()) {}
+
+            Real value(Time t) const { return std::exp(logs_.value(t)); }
+            Real derivative(Time t) const {
+                return value(t) * logs_.derivative(t);
+            }
+            Real primitive(Time) const {
+                QL_FAIL("primitive not implemented for log-linear interpolation");
+            }
+
+            void addValueAdjoint(Time t, Real adjoint, std::vector<Real>& result) const {
+                std::vector<Real> logAdjoints(y_.size(), 0.0);
+                logs_.addValueAdjoint(t, adjoint * value(t), logAdjoints);
+                addLogAdjoints(logAdjoints, result);
+            }
+            void addDerivativeAdjoint(Time t, Real adjoint, std::vector<Real>& result) const {
+                Real v = value(t);
+                std::vector<Real> logAdjoints(y_.size(), 0.0);
+                logs_.addValueAdjoint(t, adjoint * v * logs_.derivative(t), logAdjoints);
+                logs_.addDerivativeAdjoint(t, adjoint * v, logAdjoints);
+                addLogAdjoints(logAdjoints, result);
+            }
+            void addPrimitiveAdjoint(Time, Real, std::vector<Real>&) const {
+                QL_FAIL("primitive not implemented for log-linear interpolation");
+            }
+          private:
+            static std::vector<Real> logs(const std::vector<Real>& y) {
+                std::vector<Real> result(y.size());
+                for (Size j=0; j<y.size(); ++j) {
+                    QL_REQUIRE(y[j] > 0.0, "invalid value (" << y[j] << ") at index " << j);
+                    result[j] = std::log(y[j]);
+                }
+                return result;
+            }
+            void addLogAdjoints(const std::vector<Real>& logAdjoints,
+                                std::vector<Real>& result) const {
+                for (Size j=0; j<y_.size(); ++j)
+                    result[j] += logAdjoints[j] / y_[j];
+            }
+            std::vector<Real> y_;
+            LinearDataInterpolationAdjoint logs_;
+        };
+
+    }
+
+}
+
+#endif
@@ -26,10 +26,13 @@
 #ifndef quantlib_piecewise_yield_curve_hpp
 #define quantlib_piecewise_yield_curve_hpp
 
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
+#include <ql/termstructures/yield/discountadjoints.hpp>
+#include <ql/utilities/dataformatters.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -169,6 +172,43 @@ namespace QuantLib {
         //@{
         void update() override;
         //@}
+        //! \name Sensitivities
+        //@{
+        /*! returns the derivatives of a function of this curve,
+            e.g., the NPV of a portfolio, with respect to the quotes
+            of the alive helpers in the order of their pillar dates.
+
+            The function is passed by its adjoints, i.e., by its
+            derivatives with respect to the discount factors it reads,
+            as recorded by the pricing engines (see for instance
+            DiscountingSwapEngine::npvAdjoint); the adjoints recorded
+            for other curves are ignored.  They are chained to the
+            derivatives \f$ \bar{z} = \partial f/\partial z \f$ with
+            respect to the bootstrapped nodes.  The helpers, which
+            must inherit from AdjointRateHelper, give in the same way
+            the Jacobian \f$ J = \partial h/\partial z \f$ of their
+            implied quotes.  Since the bootstrap solves
+            \f$ h(z) = q \f$, the implicit function theorem gives the
+            quote sensitivities as the solution of
+            \f$ J^T \lambda = \bar{z} \f$.  When each helper only
+            depends on the nodes up to its own pillar, as in a
+            sequential bootstrap, \f$ J \f$ is lower triangular and
+            the system is solved by back substitution; otherwise, a
+            QR decomposition is used.
+
+            No bootstrap and no repricing is performed; the cost is
+            the one of the adjoint sweeps, which is independent of
+            the number of quotes for the portfolio and grows with
+            the number of helpers for the Jacobian.
+
+            \warning this requires a bootstrap with one node per
+                     alive helper, such as IterativeBootstrap or
+                     LocalBootstrap, and is only available for the
+                     interpolations specialized in
+                     detail::InterpolationAdjoint.
+        */
+        std::vector<Real> quoteSensitivities(const DiscountAdjoints& adjoints) const;
+        //@}
       private:
         //! \name LazyObject interface
         //@{
@@ -176,6 +216,9 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const override;
+        std::vector<Real> nodeAdjoints(
+                   const detail::InterpolationAdjoint<Interpolator>& interpolation,
+                   const DiscountAdjoints::entries& adjoints) const;
         // data members
         std::vector<std::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -252,6 +295,91 @@ namespace QuantLib {
         bootstrap_.calculate();
     }
 
+    template <class C, class I, template <class> class B>
+    inline std::vector<Real> PiecewiseYieldCurve<C,I,B>::nodeAdjoints(
+                      const detail::InterpolationAdjoint<I>& interpolation,
+                      const DiscountAdjoints::entries& adjoints) const {
+        const Size n = this->data_.size()-1;
+        std::vector<Real> dataAdjoints(n+1, 0.0);
+        for (const auto& a : adjoints) {
+            if (a.first <= 0.0)
+                continue;
+            // jumps are multiplicative and don't depend on the nodes
+            Real jumps = this->discount(a.first, true) / discountImpl(a.first);
+            C::discountAdjoint(this, interpolation, a.first,
+                               a.second * jumps, dataAdjoints);
+        }
+        // the nodes are set from the unknowns as in the bootstrap
+        std::vector<Real> result(n, 0.0), unit(n+1);
+        for (Size j=1; j<=n; ++j) {
+            std::fill(unit.begin(), unit.end(), 0.0);
+            C::updateGuess(unit, 1.0, j);
+            for (Size k=0; k<=n; ++k)
+                result[j-1] += unit[k] * dataAdjoints[k];
+        }
+        return result;
+    }
+
+    template <class C, class I, template <class> class B>
+    inline std::vector<Real>
+    PiecewiseYieldCurve<C,I,B>::quoteSensitivities(
+                                    const DiscountAdjoints& adjoints) const {
+        calculate();
+
+        const Size n = this->data_.size()-1;
+        QL_REQUIRE(n <= instruments_.size(),
+                   "more nodes (" << n << ") than helpers ("
+                   << instruments_.size() << ")");
+        // the alive helpers are the last ones after sorting
+        const Size firstAlive = instruments_.size() - n;
+
+        const YieldTermStructure& curve = *this;
+        const detail::InterpolationAdjoint<I> interpolation(
+                               this->times_, this->data_, this->interpolator_);
+
+        const std::vector<Real> gradient =
+            nodeAdjoints(interpolation, adjoints[curve]);
+
+        Matrix jacobian(n, n);
+        bool triangular = true;
+        DiscountAdjoints quoteAdjoints;
+        for (Size i=0; i<n; ++i) {
+            const auto* helper = dynamic_cast<const AdjointRateHelper*>(
+                                         instruments_[firstAlive+i].get());
+            QL_REQUIRE(helper != nullptr,
+                       io::ordinal(firstAlive+i+1) << " helper doesn't "
+                       "provide the adjoint of its implied quote");
+            quoteAdjoints.clear();
+            helper->impliedQuoteAdjoint(1.0, quoteAdjoints);
+            const std::vector<Real> row =
+                nodeAdjoints(interpolation, quoteAdjoints[curve]);
+            for (Size k=0; k<n; ++k) {
+                jacobian[i][k] = row[k];
+                if (k > i && row[k] != 0.0)
+                    triangular = false;
+            }
+        }
+
+        std::vector<Real> result(n);
+        if (triangular) {
+            // reverse sweep: back substitution on the transpose
+            for (Size k=n; k>0; --k) {
+                Real sum = gradient[k-1];
+                for (Size i=k; i<n; ++i)
+                    sum -= jacobian[i][k-1] * result[i];
+                QL_REQUIRE(jacobian[k-1][k-1] != 0.0,
+                           io::ordinal(firstAlive+k) << " helper doesn't "
+                           "depend on its pillar");
+                result[k-1] = sum / jacobian[k-1][k-1];
+            }
+        } else {
+            const Array lambda =
+                qrSolve(transpose(jacobian), Array(gradient.begin(), gradient.end()));
+            std::copy(lambda.begin(), lambda.end(), result.begin());
+        }
+        return result;
+    }
+
 }
 
 #endif
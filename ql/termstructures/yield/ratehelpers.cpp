@@ -339,6 +339,15 @@ namespace QuantLib {
         return iborIndex_->fixing(fixingDate_, true);
     }
 
+    void DepositRateHelper::impliedQuoteAdjoint(Real quoteAdjoint,
+                                                DiscountAdjoints& adjoints) const {
+        QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
+        Date valueDate = iborIndex_->valueDate(fixingDate_);
+        Date maturityDate = iborIndex_->maturityDate(valueDate);
+        Time t = iborIndex_->dayCounter().yearFraction(valueDate, maturityDate);
+        adjoints.addForward(*termStructure_, valueDate, maturityDate, t, quoteAdjoint);
+    }
+
     void DepositRateHelper::setTermStructure(YieldTermStructure* t) {
         // do not set the relinkable handle as an observer -
         // force recalculation when needed---the index is not lazy
@@ -591,6 +600,21 @@ namespace QuantLib {
                    spanningTime_;
     }
 
+    void FraRateHelper::impliedQuoteAdjoint(Real quoteAdjoint,
+                                            DiscountAdjoints& adjoints) const {
+        QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
+        if (useIndexedCoupon_) {
+            Date valueDate = iborIndex_->valueDate(fixingDate_);
+            Date maturityDate = iborIndex_->maturityDate(valueDate);
+            Time t = iborIndex_->dayCounter().yearFraction(valueDate, maturityDate);
+            adjoints.addForward(*termStructure_, valueDate, maturityDate, t,
+                                quoteAdjoint);
+        } else {
+            adjoints.addForward(*termStructure_, earliestDate_, maturityDate_,
+                                spanningTime_, quoteAdjoint);
+        }
+    }
+
     void FraRateHelper::setTermStructure(YieldTermStructure* t) {
         // do not set the relinkable handle as an observer -
         // force recalculation when needed---the index is not lazy
@@ -895,6 +919,21 @@ namespace QuantLib {
         return result;
     }
 
+    void SwapRateHelper::impliedQuoteAdjoint(Real quoteAdjoint,
+                                             DiscountAdjoints& adjoints) const {
+        Real result = impliedQuote();
+        static const Spread basisPoint = 1.0e-4;
+        Spread spread = spread_.empty() ? 0.0 : spread_->value();
+        Real fixedLegBPS = swap_->fixedLegBPS();
+        // the same engine set by MakeVanillaSwap in initializeDates
+        DiscountingSwapEngine engine(discountRelinkableHandle_, false);
+        engine.legAdjoints(*swap_,
+                           {0.0, -quoteAdjoint * basisPoint / fixedLegBPS},
+                           {-quoteAdjoint * result / fixedLegBPS,
+                            -quoteAdjoint * spread / fixedLegBPS},
+                           adjoints);
+    }
+
     void SwapRateHelper::accept(AcyclicVisitor& v) {
         auto* v1 = dynamic_cast<Visitor<SwapRateHelper>*>(&v);
         if (v1 != nullptr)
@@ -34,6 +34,7 @@
 #include <ql/instruments/vanillaswap.hpp>
 #include <ql/instruments/bmaswap.hpp>
 #include <ql/instruments/futures.hpp>
+#include <ql/termstructures/yield/discountadjoints.hpp>
 #include <ql/time/calendar.hpp>
 #include <ql/time/daycounter.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
@@ -110,7 +111,8 @@ namespace QuantLib {
 
 
     //! Rate helper for bootstrapping over deposit rates
-    class DepositRateHelper : public RelativeDateRateHelper {
+    class DepositRateHelper : public RelativeDateRateHelper,
+                              public AdjointRateHelper {
       public:
         DepositRateHelper(const Handle<Quote>& rate,
                           const Period& tenor,
@@ -135,6 +137,11 @@ namespace QuantLib {
         Real impliedQuote() const override;
         void setTermStructure(YieldTermStructure*) override;
         //@}
+        //! \name AdjointRateHelper interface
+        //@{
+        void impliedQuoteAdjoint(Real quoteAdjoint,
+                                 DiscountAdjoints& adjoints) const override;
+        //@}
         //! \name Visitability
         //@{
         void accept(AcyclicVisitor&) override;
@@ -148,7 +155,8 @@ namespace QuantLib {
 
 
     //! Rate helper for bootstrapping over %FRA rates
-    class FraRateHelper : public RelativeDateRateHelper {
+    class FraRateHelper : public RelativeDateRateHelper,
+                          public AdjointRateHelper {
       public:
         FraRateHelper(const Handle<Quote>& rate,
                       Natural monthsToStart,
@@ -237,6 +245,11 @@ namespace QuantLib {
         Real impliedQuote() const override;
         void setTermStructure(YieldTermStructure*) override;
         //@}
+        //! \name AdjointRateHelper interface
+        //@{
+        void impliedQuoteAdjoint(Real quoteAdjoint,
+                                 DiscountAdjoints& adjoints) const override;
+        //@}
         //! \name Visitability
         //@{
         void accept(AcyclicVisitor&) override;
@@ -256,7 +269,8 @@ namespace QuantLib {
 
     //! Rate helper for bootstrapping over swap rates
     /*! \todo use input SwapIndex to create the swap */
-    class SwapRateHelper : public RelativeDateRateHelper {
+    class SwapRateHelper : public RelativeDateRateHelper,
+                           public AdjointRateHelper {
       public:
         SwapRateHelper(const Handle<Quote>& rate,
                        const std::shared_ptr<SwapIndex>& swapIndex,
@@ -319,6 +333,11 @@ namespace QuantLib {
         Real impliedQuote() const override;
         void setTermStructure(YieldTermStructure*) override;
         //@}
+        //! \name AdjointRateHelper interface
+        //@{
+        void impliedQuoteAdjoint(Real quoteAdjoint,
+                                 DiscountAdjoints& adjoints) const override;
+        //@}
         //! \name SwapRateHelper inspectors
         //@{
         Spread spread() const;
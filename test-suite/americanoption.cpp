@@ -2280,6 +2280,97 @@ void AmericanOptionTest::testSingleBjerksundStenslandGreeks() {
         BOOST_FAIL("American exercise type expected");
 }
 
+void AmericanOptionTest::testFdSolutionCaching() {
+    BOOST_TEST_MESSAGE("Testing caching of finite-difference solutions "
+                       "for American options...");
+
+    SavedSettings backup;
+
+    const Date today = Date(20, January, 2023);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual365Fixed();
+
+    const auto spot = std::make_shared<SimpleQuote>(100.0);
+    const auto rRate = std::make_shared<SimpleQuote>(0.05);
+
+    const auto bsProcess = std::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(spot),
+        Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+        Handle<YieldTermStructure>(flatRate(today, rRate, dc)),
+        Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+
+    VanillaOption option(
+        std::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        std::make_shared<AmericanExercise>(today, today + Period(1, Years)));
+
+    const auto cachingEngine =
+        std::make_shared<FdBlackScholesVanillaEngine>(bsProcess, 100, 200);
+    cachingEngine->enableSolutionCaching();
+
+    const auto engine =
+        std::make_shared<FdBlackScholesVanillaEngine>(bsProcess, 100, 200);
+
+    const Real tol = 5e-3;
+    const std::vector<Real> spots = { 100.0, 95.0, 101.0, 110.0, 100.0 };
+    for (Real s: spots) {
+        spot->setValue(s);
+
+        option.setPricingEngine(engine);
+        const Real expected = option.NPV();
+        const Real expectedDelta = option.delta();
+
+        option.setPricingEngine(cachingEngine);
+        const Real calculated = option.NPV();
+        const Real calculatedDelta = option.delta();
+
+        if (std::fabs(calculated - expected) > tol
+            || std::fabs(calculatedDelta - expectedDelta) > tol)
+            BOOST_FAIL("failed to reproduce the American option price"
+                       << "\n    spot:       " << s
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected
+                       << "\n    calculated delta: " << calculatedDelta
+                       << "\n    expected delta:   " << expectedDelta);
+    }
+
+    if (cachingEngine->solutionCacheMisses() != 1
+        || cachingEngine->solutionCacheHits() != spots.size()-1)
+        BOOST_FAIL("unexpected number of cache hits and misses"
+                   << "\n    hits:   " << cachingEngine->solutionCacheHits()
+                   << "\n    misses: " << cachingEngine->solutionCacheMisses());
+
+    // a spot far away from the cached grid needs a new solution
+    spot->setValue(40.0);
+    option.NPV();
+    if (cachingEngine->solutionCacheMisses() != 2)
+        BOOST_FAIL("spot outside of the cached grid must not be a cache hit");
+
+    // new market data must invalidate the cache
+    rRate->setValue(0.06);
+    const Real calculated = option.NPV();
+    if (cachingEngine->solutionCacheMisses() != 3)
+        BOOST_FAIL("changed interest rate must clear the cache");
+
+    // a different exercise must not share the cached solution
+    VanillaOption payoffAtExpiryOption(
+        std::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        std::make_shared<AmericanExercise>(
+            today, today + Period(1, Years), true));
+    payoffAtExpiryOption.setPricingEngine(cachingEngine);
+    payoffAtExpiryOption.NPV();
+    if (cachingEngine->solutionCacheMisses() != 4)
+        BOOST_FAIL("American exercise with payoff at expiry must not "
+                   "share the cached solution");
+
+    option.setPricingEngine(engine);
+    const Real expected = option.NPV();
+    if (std::fabs(calculated - expected) > 1e-10)
+        BOOST_FAIL("failed to reproduce the American option price "
+                   "after a change of the interest rate"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+}
+
 
 test_suite* AmericanOptionTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("American option tests");
@@ -2307,6 +2398,7 @@ test_suite* AmericanOptionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testBjerksundStenslandEuropeanGreeks));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testBjerksundStenslandAmericanGreeks));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testSingleBjerksundStenslandGreeks));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdSolutionCaching));
 
 
     if (speed <= Fast) {
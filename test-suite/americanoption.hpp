@@ -54,6 +54,7 @@ class AmericanOptionTest {
     static void testBjerksundStenslandEuropeanGreeks();
     static void testBjerksundStenslandAmericanGreeks();
     static void testSingleBjerksundStenslandGreeks();
+    static void testFdSolutionCaching();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
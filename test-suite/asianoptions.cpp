@@ -35,6 +35,7 @@
 #include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_price_heston.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_strike.hpp>
+#include <ql/pricingengines/asian/mlmc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/fdblackscholesasianengine.hpp>
 #include <ql/experimental/exoticoptions/continuousarithmeticasianlevyengine.hpp>
 #include <ql/experimental/exoticoptions/continuousarithmeticasianvecerengine.hpp>
@@ -993,6 +994,97 @@ void AsianOptionTest::testMCDiscreteArithmeticAveragePrice() {
 }
 
 
+void AsianOptionTest::testMCDiscreteArithmeticAveragePriceGreeks() {
+
+    BOOST_TEST_MESSAGE(
+           "Testing Monte Carlo greeks of discrete arithmetic "
+           "average-price Asians...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today(15, May, 2023);
+    Settings::instance().evaluationDate() = today;
+
+    std::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    std::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.05));
+    std::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    std::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, rRate, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc))));
+
+    std::vector<Date> fixingDates;
+    for (Size i=1; i<=12; ++i)
+        fixingDates.push_back(today + Period(i, Months));
+
+    DiscreteAveragingAsianOption option(
+        Average::Arithmetic, 0.0, 0, fixingDates,
+        std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        std::make_shared<EuropeanExercise>(fixingDates.back() + 7));
+
+    const Size samples = 20000;
+
+    // with common random numbers, the pathwise estimators are the
+    // derivatives of the Monte Carlo price
+    option.setPricingEngine(
+        MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+        .withSamples(samples)
+        .withSeed(42));
+    auto bumped = [&](SimpleQuote& quote, Real h) {
+        const Real value = quote.value();
+        quote.setValue(value + h);
+        const Real up = option.NPV();
+        quote.setValue(value - h);
+        const Real down = option.NPV();
+        quote.setValue(value);
+        return (up - down)/(2.0*h);
+    };
+    const Real delta = bumped(*spot, 1.0e-3);
+    const Real vega = bumped(*vol, 1.0e-5);
+    const Real rho = bumped(*rRate, 1.0e-5);
+
+    option.setPricingEngine(
+        MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+        .withSamples(samples)
+        .withSeed(42)
+        .withGreeks(MonteCarloGreeks::Pathwise));
+
+    Real tolerance = 1.0e-4;
+    if (std::fabs(option.delta() - delta) > tolerance*std::fabs(delta)
+        || std::fabs(option.vega() - vega) > tolerance*std::fabs(vega)
+        || std::fabs(option.rho() - rho) > tolerance*std::fabs(rho))
+        BOOST_ERROR("pathwise greeks don't match the bumped prices:"
+                    << "\n    delta:          " << option.delta()
+                    << "\n    bumped delta:   " << delta
+                    << "\n    vega:           " << option.vega()
+                    << "\n    bumped vega:    " << vega
+                    << "\n    rho:            " << option.rho()
+                    << "\n    bumped rho:     " << rho);
+
+    // the likelihood-ratio estimators have a larger variance
+    option.setPricingEngine(
+        MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+        .withSamples(samples)
+        .withAntitheticVariate()
+        .withSeed(42)
+        .withGreeks(MonteCarloGreeks::LikelihoodRatio));
+
+    tolerance = 0.03;
+    if (std::fabs(option.delta() - delta) > tolerance*std::fabs(delta)
+        || std::fabs(option.vega() - vega) > tolerance*std::fabs(vega)
+        || std::fabs(option.rho() - rho) > tolerance*std::fabs(rho))
+        BOOST_ERROR("likelihood-ratio greeks don't match the bumped prices:"
+                    << "\n    delta:          " << option.delta()
+                    << "\n    bumped delta:   " << delta
+                    << "\n    vega:           " << option.vega()
+                    << "\n    bumped vega:    " << vega
+                    << "\n    rho:            " << option.rho()
+                    << "\n    bumped rho:     " << rho);
+}
+
 void AsianOptionTest::testMCDiscreteArithmeticAveragePriceHeston() {
 
     BOOST_TEST_MESSAGE(
@@ -1186,6 +1278,123 @@ void AsianOptionTest::testMCDiscreteArithmeticAveragePriceHeston() {
 
 
 
+void AsianOptionTest::testMLMCDiscreteArithmeticAveragePrice() {
+
+    BOOST_TEST_MESSAGE(
+           "Testing multilevel Monte Carlo discrete arithmetic "
+           "average-price Asians...");
+
+    // data from "Asian Option", Levy, 1997
+    // in "Exotic Options: The State of the Art",
+    // edited by Clewlow, Strickland
+    DiscreteAverageData cases[] = {
+        { Option::Put, 90.0, 87.0, 0.06, 0.025, 0.0, 11.0/12.0, 12,
+          0.13, false, 1.6980019214 },
+        { Option::Put, 90.0, 87.0, 0.06, 0.025, 1.0/12.0, 11.0/12.0, 12,
+          0.13, false, 2.1105094397 }
+    };
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    std::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    std::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.03));
+    std::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    std::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.06));
+    std::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    std::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    std::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    Average::Type averageType = Average::Arithmetic;
+    Real runningSum = 0.0;
+    Size pastFixings = 0;
+    for (auto& l : cases) {
+
+        std::shared_ptr<StrikedTypePayoff> payoff(new PlainVanillaPayoff(l.type, l.strike));
+
+        Time dt = l.length / (l.fixings - 1);
+        std::vector<Date> fixingDates(l.fixings);
+        for (Size i = 0; i < l.fixings; i++)
+            fixingDates[i] = today + timeToDays(i * dt + l.first);
+        std::shared_ptr<Exercise> exercise(new EuropeanExercise(fixingDates[l.fixings - 1]));
+
+        spot->setValue(l.underlying);
+        qRate->setValue(l.dividendYield);
+        rRate->setValue(l.riskFreeRate);
+        vol->setValue(l.volatility);
+
+        std::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+            BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+        const Real requiredTolerance = 5.0e-3;
+        std::shared_ptr<PricingEngine> engine =
+            MakeMLMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+                .withAbsoluteTolerance(requiredTolerance)
+                .withSeed(42);
+
+        DiscreteAveragingAsianOption option(averageType, runningSum,
+                                            pastFixings, fixingDates,
+                                            payoff, exercise);
+        option.setPricingEngine(engine);
+
+        Real calculated = option.NPV();
+        Real expected = l.result;
+        Real tolerance = 3.0*requiredTolerance;
+        if (std::fabs(calculated-expected) > tolerance) {
+            REPORT_FAILURE("value", averageType, runningSum, pastFixings,
+                        fixingDates, payoff, exercise, spot->value(),
+                        qRate->value(), rRate->value(), today,
+                        vol->value(), expected, calculated, tolerance);
+        }
+
+        Real errorEstimate = option.errorEstimate();
+        if (errorEstimate > requiredTolerance) {
+            BOOST_ERROR("error estimate exceeds the required tolerance:"
+                        << "\n    error estimate: " << errorEstimate
+                        << "\n    tolerance:      " << requiredTolerance);
+        }
+
+        const Size levels = std::any_cast<Size>(
+            option.additionalResults().at("Levels"));
+        const Real cost = std::any_cast<Real>(
+            option.additionalResults().at("Cost"));
+        if (levels < 2)
+            BOOST_ERROR("a single level used");
+
+        // to limit the running time, the cost is only compared for
+        // the first case
+        if (&l != &cases[0])
+            continue;
+
+        // plain Monte Carlo on the finest grid, with the statistical
+        // error required from the multilevel run, has the same root
+        // mean square error; the coarsest grid has a step between
+        // consecutive fixings, and one before the first if needed
+        const Size coarsestSteps = (l.first == 0.0) ? l.fixings-1 : l.fixings;
+        option.setPricingEngine(
+            MakeMLMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+                .withSteps(coarsestSteps*(Size(1) << (levels-1)))
+                .withAbsoluteTolerance(requiredTolerance)
+                .withMaxLevels(1)
+                .withSeed(42));
+        option.NPV();
+        const Real singleLevelCost = std::any_cast<Real>(
+            option.additionalResults().at("Cost"));
+
+        if (cost >= singleLevelCost) {
+            BOOST_ERROR("multilevel Monte Carlo not cheaper than "
+                        "plain Monte Carlo"
+                        << "\n    levels:            " << levels
+                        << "\n    cost:              " << cost
+                        << "\n    single-level cost: " << singleLevelCost);
+        }
+    }
+}
+
+
 void AsianOptionTest::testMCDiscreteArithmeticAverageStrike() {
 
     BOOST_TEST_MESSAGE(
@@ -2442,6 +2651,8 @@ test_suite* AsianOptionTest::suite(SpeedLevel speed) {
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&AsianOptionTest::testMCDiscreteArithmeticAveragePrice));
+        suite->add(QUANTLIB_TEST_CASE(&AsianOptionTest::testMLMCDiscreteArithmeticAveragePrice));
+        suite->add(QUANTLIB_TEST_CASE(&AsianOptionTest::testMCDiscreteArithmeticAveragePriceGreeks));
         suite->add(QUANTLIB_TEST_CASE(&AsianOptionTest::testMCDiscreteGeometricAveragePriceHeston));
     }
 
@@ -41,6 +41,8 @@ class AsianOptionTest {
     static void testMCDiscreteGeometricAveragePrice();
     static void testMCDiscreteGeometricAveragePriceHeston();
     static void testMCDiscreteArithmeticAveragePrice();
+    static void testMLMCDiscreteArithmeticAveragePrice();
+    static void testMCDiscreteArithmeticAveragePriceGreeks();
     static void testMCDiscreteArithmeticAveragePriceHeston();
     static void testMCDiscreteArithmeticAverageStrike();
     static void testAnalyticDiscreteGeometricAveragePriceGreeks();
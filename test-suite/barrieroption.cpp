@@ -37,6 +37,7 @@
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/barrier/mlmcbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/experimental/barrieroption/perturbativebarrieroptionengine.hpp>
@@ -1697,6 +1698,253 @@ void BarrierOptionTest::testLowVolatility() {
     check(  95.0,  Option::Call,      99.0,   Barrier::DownIn,     4.0,   0.01,   0.04,        2.0);  // fwd = 97, call, ITM
 }
 
+void BarrierOptionTest::testMultilevelMonteCarlo() {
+    BOOST_TEST_MESSAGE("Testing multilevel Monte Carlo barrier engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+
+    Date today(11, February, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    Date maturity = today + Period(1, Years);
+
+    Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    auto process = std::make_shared<BlackScholesMertonProcess>(s0, qTS, rTS, volTS);
+    auto analyticEngine = std::make_shared<AnalyticBarrierEngine>(process);
+
+    const Real requiredTolerance = 0.05;
+    const Size stepsPerYear = 4;
+    std::shared_ptr<PricingEngine> mlmcEngine =
+        MakeMLMCBarrierEngine<PseudoRandom>(process)
+        .withStepsPerYear(stepsPerYear)
+        .withAbsoluteTolerance(requiredTolerance)
+        .withSeed(42);
+
+    auto check = [&](Real strike, Option::Type optionType,
+                     Real barrier, Barrier::Type barrierType, Real rebate) {
+        auto payoff = std::make_shared<PlainVanillaPayoff>(optionType, strike);
+        auto exercise = std::make_shared<EuropeanExercise>(maturity);
+        BarrierOption option(barrierType, barrier, rebate, payoff, exercise);
+
+        option.setPricingEngine(analyticEngine);
+        const Real expected = option.NPV();
+
+        option.setPricingEngine(mlmcEngine);
+        const Real calculated = option.NPV();
+
+        const Real tolerance = 3.0*requiredTolerance;
+        if (std::fabs(calculated - expected) > tolerance) {
+            BOOST_ERROR("Failed to match analytic price:"
+                        << "\n    strike:         " << strike
+                        << "\n    option type:    " << optionType
+                        << "\n    barrier:        " << barrier
+                        << "\n    barrier type:   " << barrierType
+                        << "\n    rebate:         " << rebate
+                        << "\n    expected:       " << expected
+                        << "\n    calculated:     " << calculated
+                        << "\n    error estimate: " << option.errorEstimate()
+                        << "\n    tolerance:      " << tolerance);
+        }
+
+        const Size levels = std::any_cast<Size>(
+            option.additionalResults().at("Levels"));
+        // the first three levels are always simulated; further ones
+        // are only added if the estimated bias requires them
+        if (levels <= 3)
+            BOOST_ERROR("no level added to reduce the bias"
+                        << "\n    barrier type: " << barrierType);
+    };
+
+    //    strike          type     barrier     barrier type     rebate
+
+    check( 100.0,  Option::Call,      90.0,  Barrier::DownOut,     0.0);
+    check( 100.0,   Option::Put,     110.0,    Barrier::UpOut,     0.0);
+    check( 100.0,  Option::Call,      90.0,   Barrier::DownIn,     3.0);
+    check( 100.0,   Option::Put,     110.0,     Barrier::UpIn,     3.0);
+}
+
+void BarrierOptionTest::benchmarkMultilevelMonteCarlo() {
+    BOOST_TEST_MESSAGE("Benchmarking multilevel Monte Carlo barrier engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+
+    Date today(11, February, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    auto process = std::make_shared<BlackScholesMertonProcess>(s0, qTS, rTS, volTS);
+
+    BarrierOption option(
+        Barrier::DownOut, 90.0, 0.0,
+        std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        std::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    option.setPricingEngine(std::make_shared<AnalyticBarrierEngine>(process));
+    const Real expected = option.NPV();
+
+    const Size stepsPerYear = 4;
+    for (Real tolerance : { 0.05, 0.02 }) {
+        option.setPricingEngine(
+            MakeMLMCBarrierEngine<PseudoRandom>(process)
+            .withStepsPerYear(stepsPerYear)
+            .withAbsoluteTolerance(tolerance)
+            .withSeed(42));
+        Real mlmcValue;
+        const Real mlmcTime = elapsedSeconds([&]() {
+            mlmcValue = option.NPV();
+        });
+        const Size levels = std::any_cast<Size>(
+            option.additionalResults().at("Levels"));
+
+        // continuity-corrected discrete monitoring on the finest grid
+        option.setPricingEngine(
+            MakeMLMCBarrierEngine<PseudoRandom>(process)
+            .withStepsPerYear(stepsPerYear*(Size(1) << (levels-1)))
+            .withAbsoluteTolerance(tolerance)
+            .withMaxLevels(1)
+            .withSeed(42));
+        Real singleLevelValue;
+        const Real singleLevelTime = elapsedSeconds([&]() {
+            singleLevelValue = option.NPV();
+        });
+
+        // Brownian-bridge crossing probabilities on the coarsest grid
+        option.setPricingEngine(
+            MakeMCBarrierEngine<PseudoRandom>(process)
+            .withStepsPerYear(stepsPerYear)
+            .withAbsoluteTolerance(tolerance)
+            .withSeed(42));
+        Real mcValue;
+        const Real mcTime = elapsedSeconds([&]() {
+            mcValue = option.NPV();
+        });
+
+        BOOST_TEST_MESSAGE("    tolerance " << tolerance
+                           << ", analytic value " << expected
+                           << "\n        multilevel, " << levels
+                           << " levels:      error "
+                           << mlmcValue - expected << ", "
+                           << mlmcTime << " s"
+                           << "\n        single level, finest grid: error "
+                           << singleLevelValue - expected << ", "
+                           << singleLevelTime << " s"
+                           << "\n        MCBarrierEngine, coarsest grid: error "
+                           << mcValue - expected << ", "
+                           << mcTime << " s");
+    }
+}
+
+void BarrierOptionTest::testMcGreeks() {
+    BOOST_TEST_MESSAGE("Testing likelihood-ratio greeks of the Monte Carlo "
+                       "barrier engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+
+    Date today(11, February, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    Date maturity = today + Period(1, Years);
+
+    auto spot = std::make_shared<SimpleQuote>(100.0);
+    auto rRate = std::make_shared<SimpleQuote>(0.05);
+    auto vol = std::make_shared<SimpleQuote>(0.20);
+    auto process = std::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(spot),
+        Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+        Handle<YieldTermStructure>(flatRate(today, rRate, dc)),
+        Handle<BlackVolTermStructure>(flatVol(today, vol, dc)));
+
+    auto bumped = [](BarrierOption& option, SimpleQuote& quote, Real h) {
+        const Real value = quote.value();
+        quote.setValue(value + h);
+        const Real up = option.NPV();
+        quote.setValue(value - h);
+        const Real down = option.NPV();
+        quote.setValue(value);
+        return (up - down)/(2.0*h);
+    };
+
+    BarrierOption option(Barrier::DownOut, 90.0, 0.0,
+                         std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+                         std::make_shared<EuropeanExercise>(maturity));
+
+    // continuous monitoring: delta and rho against the analytic engine
+    option.setPricingEngine(std::make_shared<AnalyticBarrierEngine>(process));
+    Real delta = bumped(option, *spot, 1.0e-3);
+    Real rho = bumped(option, *rRate, 1.0e-5);
+
+    option.setPricingEngine(
+        MakeMCBarrierEngine<PseudoRandom>(process)
+        .withSteps(20)
+        .withSamples(50000)
+        .withAntitheticVariate()
+        .withSeed(42)
+        .withGreeks());
+
+    Real tolerance = 0.02;
+    if (std::fabs(option.delta() - delta) > tolerance*std::fabs(delta)
+        || std::fabs(option.rho() - rho) > tolerance*std::fabs(rho))
+        BOOST_ERROR("failed to reproduce analytic greeks:"
+                    << "\n    delta:          " << option.delta()
+                    << "\n    expected delta: " << delta
+                    << "\n    rho:            " << option.rho()
+                    << "\n    expected rho:   " << rho);
+
+    // no vega without the bias, hence no error either
+    const auto& results = option.additionalResults();
+    if (results.count("vegaError") != 0
+        || std::any_cast<Real>(results.at("deltaError")) <= 0.0
+        || std::any_cast<Real>(results.at("rhoError")) <= 0.0)
+        BOOST_ERROR("unexpected standard errors of greeks");
+
+    // discrete monitoring: all greeks against bumped Monte Carlo prices
+    option.setPricingEngine(
+        MakeMCBarrierEngine<PseudoRandom>(process)
+        .withSteps(4)
+        .withBias()
+        .withSamples(200000)
+        .withAntitheticVariate()
+        .withSeed(42));
+    delta = bumped(option, *spot, 0.5);
+    Real vega = bumped(option, *vol, 5.0e-3);
+    rho = bumped(option, *rRate, 2.0e-3);
+
+    option.setPricingEngine(
+        MakeMCBarrierEngine<PseudoRandom>(process)
+        .withSteps(4)
+        .withBias()
+        .withSamples(200000)
+        .withAntitheticVariate()
+        .withSeed(42)
+        .withGreeks());
+
+    tolerance = 0.03;
+    if (std::fabs(option.delta() - delta) > tolerance*std::fabs(delta)
+        || std::fabs(option.vega() - vega) > tolerance*std::fabs(vega)
+        || std::fabs(option.rho() - rho) > tolerance*std::fabs(rho))
+        BOOST_ERROR("failed to reproduce bumped greeks:"
+                    << "\n    delta:          " << option.delta()
+                    << "\n    expected delta: " << delta
+                    << "\n    vega:           " << option.vega()
+                    << "\n    expected vega:  " << vega
+                    << "\n    rho:            " << option.rho()
+                    << "\n    expected rho:   " << rho);
+}
+
 test_suite* BarrierOptionTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Barrier option tests");
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testParity));
@@ -1710,6 +1958,8 @@ test_suite* BarrierOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testBarrierAndDividendEngine));
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testImpliedVolatility));
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testLowVolatility));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMultilevelMonteCarlo));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMcGreeks));
     return suite;
 }
 
@@ -41,6 +41,10 @@ class BarrierOptionTest {
     static void testBarrierAndDividendEngine();
     static void testImpliedVolatility();
     static void testLowVolatility();
+    static void testMultilevelMonteCarlo();
+    static void testMcGreeks();
+
+    static void benchmarkMultilevelMonteCarlo();
 
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
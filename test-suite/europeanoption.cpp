@@ -1372,6 +1372,240 @@ void EuropeanOptionTest::testQmcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testRqmcEngines() {
+
+    BOOST_TEST_MESSAGE("Testing randomized Quasi Monte Carlo European "
+                       "engines against analytic results...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(5, October, 2018);
+
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(std::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    const std::shared_ptr<BlackScholesMertonProcess> process =
+        std::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, rTS, volTS);
+
+    VanillaOption option(
+        std::make_shared<PlainVanillaPayoff>(Option::Call, 105.0),
+        std::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    option.setPricingEngine(
+        std::make_shared<AnalyticEuropeanEngine>(process));
+    const Real npv = option.NPV();
+
+    const Size samples = 8192;
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(process)
+        .withSteps(1)
+        .withSamples(samples)
+        .withSeed(42));
+    const Real mcError = option.errorEstimate();
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<RandomizedLowDiscrepancy>(process)
+        .withSteps(1)
+        .withSamples(samples)
+        .withSeed(42));
+    const Real rqmcNpv = option.NPV();
+    const Real rqmcError = option.errorEstimate();
+
+    if (std::fabs(rqmcNpv - npv) > 4.0*rqmcError)
+        BOOST_FAIL("randomized QMC price outside of its error bounds"
+                   << "\n    analytic NPV:   " << npv
+                   << "\n    RQMC NPV:       " << rqmcNpv
+                   << "\n    error estimate: " << rqmcError);
+
+    if (rqmcError > 0.2*mcError)
+        BOOST_FAIL("randomized QMC error estimate not smaller than the "
+                   "pseudo-random one"
+                   << "\n    RQMC error:      " << rqmcError
+                   << "\n    MC error:        " << mcError);
+
+    // early stopping on the estimated error
+    const Real tolerance = 0.005;
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<RandomizedLowDiscrepancy>(process)
+        .withSteps(1)
+        .withAbsoluteTolerance(tolerance)
+        .withSeed(42));
+    const Real tolNpv = option.NPV();
+    const Real tolError = option.errorEstimate();
+
+    if (tolError > tolerance || std::fabs(tolNpv - npv) > 4.0*tolerance)
+        BOOST_FAIL("failed to reach the required tolerance"
+                   << "\n    analytic NPV:   " << npv
+                   << "\n    RQMC NPV:       " << tolNpv
+                   << "\n    error estimate: " << tolError
+                   << "\n    tolerance:      " << tolerance);
+}
+
+void EuropeanOptionTest::testMcGreeks() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo greeks of European options "
+                       "against analytic results...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(5, October, 2018);
+
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(std::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<BlackVolTermStructure> volTS(flatVol(today, 0.20, dc));
+
+    const std::shared_ptr<BlackScholesMertonProcess> process =
+        std::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, rTS, volTS);
+
+    const std::shared_ptr<PricingEngine> analyticEngine =
+        std::make_shared<AnalyticEuropeanEngine>(process);
+
+    struct Estimator {
+        MonteCarloGreeks::Estimator estimator;
+        const char* name;
+    };
+    const Estimator estimators[] = {
+        { MonteCarloGreeks::Pathwise, "pathwise" },
+        { MonteCarloGreeks::LikelihoodRatio, "likelihood ratio" }
+    };
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real strikes[] = { 90.0, 100.0, 115.0 };
+
+    for (auto type : types) {
+        for (Real strike : strikes) {
+            VanillaOption option(
+                std::make_shared<PlainVanillaPayoff>(type, strike),
+                std::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+            option.setPricingEngine(analyticEngine);
+            const Real delta = option.delta();
+            const Real vega = option.vega();
+            const Real rho = option.rho();
+
+            for (const auto& e : estimators) {
+                option.setPricingEngine(
+                    MakeMCEuropeanEngine<PseudoRandom>(process)
+                    .withSteps(1)
+                    .withSamples(50000)
+                    .withAntitheticVariate()
+                    .withSeed(42)
+                    .withGreeks(e.estimator));
+
+                if (std::fabs(option.delta() - delta) > 0.01
+                    || std::fabs(option.vega() - vega) > 1.0
+                    || std::fabs(option.rho() - rho) > 1.0)
+                    BOOST_ERROR("failed to reproduce analytic greeks with "
+                                << e.name << " estimator"
+                                << "\n    type:           " << type
+                                << "\n    strike:         " << strike
+                                << "\n    delta:          " << option.delta()
+                                << "\n    expected delta: " << delta
+                                << "\n    vega:           " << option.vega()
+                                << "\n    expected vega:  " << vega
+                                << "\n    rho:            " << option.rho()
+                                << "\n    expected rho:   " << rho);
+
+                // the estimates are within a few standard errors
+                const auto& results = option.additionalResults();
+                const Real deltaError =
+                    std::any_cast<Real>(results.at("deltaError"));
+                const Real vegaError =
+                    std::any_cast<Real>(results.at("vegaError"));
+                const Real rhoError =
+                    std::any_cast<Real>(results.at("rhoError"));
+                if (!(deltaError > 0.0 && vegaError > 0.0 && rhoError > 0.0)
+                    || std::fabs(option.delta() - delta) > 4.0*deltaError
+                    || std::fabs(option.vega() - vega) > 4.0*vegaError
+                    || std::fabs(option.rho() - rho) > 4.0*rhoError)
+                    BOOST_ERROR("inconsistent standard errors of greeks with "
+                                << e.name << " estimator"
+                                << "\n    type:        " << type
+                                << "\n    strike:      " << strike
+                                << "\n    delta error: " << option.delta() - delta
+                                << "\n    estimated:   " << deltaError
+                                << "\n    vega error:  " << option.vega() - vega
+                                << "\n    estimated:   " << vegaError
+                                << "\n    rho error:   " << option.rho() - rho
+                                << "\n    estimated:   " << rhoError);
+            }
+        }
+    }
+}
+
+void EuropeanOptionTest::testMcBlockEngine() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo European engine "
+                       "with path blocks...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(5, October, 2018);
+
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(std::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<BlackVolTermStructure> volTS(flatVol(today, 0.20, dc));
+
+    const std::shared_ptr<BlackScholesMertonProcess> process =
+        std::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, rTS, volTS);
+
+    VanillaOption option(
+        std::make_shared<PlainVanillaPayoff>(Option::Put, 105.0),
+        std::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    for (bool antithetic : { false, true }) {
+        for (bool brownianBridge : { false, true }) {
+            option.setPricingEngine(
+                MakeMCEuropeanEngine<PseudoRandom>(process)
+                .withSteps(4)
+                .withSamples(4096)
+                .withAntitheticVariate(antithetic)
+                .withBrownianBridge(brownianBridge)
+                .withSeed(42));
+            const Real expected = option.NPV();
+            const Real expectedError = option.errorEstimate();
+
+            option.setPricingEngine(
+                MakeMCEuropeanEngine<PseudoRandom>(process)
+                .withSteps(4)
+                .withSamples(4096)
+                .withAntitheticVariate(antithetic)
+                .withBrownianBridge(brownianBridge)
+                .withSeed(42)
+                .withBlockSize(256));
+            const Real calculated = option.NPV();
+            const Real error = option.errorEstimate();
+
+            const Real tol = 1e-10;
+            if (std::fabs(calculated - expected) > tol
+                || std::fabs(error - expectedError) > tol)
+                BOOST_ERROR("failed to reproduce Monte Carlo price "
+                            "with path blocks"
+                            << "\n    antithetic:      " << antithetic
+                            << "\n    Brownian bridge: " << brownianBridge
+                            << "\n    calculated:      " << calculated
+                            << "\n    expected:        " << expected
+                            << "\n    error estimate:  " << error
+                            << "\n    expected error:  " << expectedError);
+        }
+    }
+}
+
 void EuropeanOptionTest::testFFTEngines() {
 
     BOOST_TEST_MESSAGE("Testing FFT European engines "
@@ -1869,6 +2103,9 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testRqmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcGreeks));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcBlockEngine));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testAnalyticEngineDiscountCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPDESchemes));
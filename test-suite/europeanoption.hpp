@@ -44,7 +44,10 @@ class EuropeanOptionTest {
     static void testFdEngines();
     static void testIntegralEngines();
     static void testQmcEngines();
+    static void testRqmcEngines();
     static void testMcEngines();
+    static void testMcGreeks();
+    static void testMcBlockEngine();
     static void testFFTEngines();
     static void testLocalVolatility();
     static void testAnalyticEngineDiscountCurve();
@@ -34,6 +34,7 @@
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 #include <ql/pricingengines/barrier/analyticbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
@@ -1115,6 +1116,219 @@ void FdHestonTest::testAmericanCallPutParity() {
     }
 }
 
+void FdHestonTest::testSpotLadder() {
+    BOOST_TEST_MESSAGE("Testing bulk evaluation of spot ladders "
+                       "for finite difference engines...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(15, April, 2022);
+    Settings::instance().evaluationDate() = today;
+
+    const auto spot = std::make_shared<SimpleQuote>(100.0);
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+
+    VanillaOption option(
+        std::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        std::make_shared<AmericanExercise>(today, today + Period(1, Years)));
+
+    const std::vector<Real> spots = { 80.0, 90.0, 95.0, 100.0, 105.0, 120.0 };
+    const Real tol = 1e-8;
+
+    // Black-Scholes: the ladder must match repricing on the same grid
+    const auto bsProcess = std::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(spot), qTS, rTS,
+        Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+
+    const std::shared_ptr<FdBlackScholesVanillaEngine> bsEngine =
+        std::make_shared<FdBlackScholesVanillaEngine>(bsProcess, 50, 200);
+    bsEngine->enableSpotLadder(spots);
+    bsEngine->enableSolutionCaching();
+    option.setPricingEngine(bsEngine);
+
+    const auto ladder = [&](const std::string& name) {
+        return option.result<std::vector<Real> >(name);
+    };
+    const std::vector<Real> values = ladder("valueLadder");
+    const std::vector<Real> deltas = ladder("deltaLadder");
+    const std::vector<Real> gammas = ladder("gammaLadder");
+
+    for (Size i=0; i < spots.size(); ++i) {
+        spot->setValue(spots[i]);
+        if (std::fabs(values[i] - option.NPV()) > tol
+            || std::fabs(deltas[i] - option.delta()) > tol
+            || std::fabs(gammas[i] - option.gamma()) > tol)
+            BOOST_FAIL("failed to reproduce Black-Scholes spot ladder"
+                       << "\n    spot:      " << spots[i]
+                       << "\n    value:     " << values[i]
+                       << "\n    expected:  " << option.NPV()
+                       << "\n    delta:     " << deltas[i]
+                       << "\n    expected:  " << option.delta()
+                       << "\n    gamma:     " << gammas[i]
+                       << "\n    expected:  " << option.gamma());
+    }
+    if (bsEngine->solutionCacheMisses() != 1)
+        BOOST_FAIL("spot ladder should be evaluated from one solve");
+
+    // Heston: the grid must match pointwise evaluation of the solution
+    spot->setValue(100.0);
+    const auto hestonProcess = std::make_shared<HestonProcess>(
+        rTS, qTS, Handle<Quote>(spot), 0.04, 1.0, 0.06, 0.4, -0.75);
+
+    const std::vector<Real> variances = { 0.02, 0.04, 0.08 };
+    const std::shared_ptr<FdHestonVanillaEngine> hestonEngine =
+        std::make_shared<FdHestonVanillaEngine>(
+            std::make_shared<HestonModel>(hestonProcess), 50, 100, 25);
+    hestonEngine->enableSpotLadder(spots, variances);
+    option.setPricingEngine(hestonEngine);
+
+    const Matrix valueGrid = option.result<Matrix>("valueGrid");
+    const Matrix deltaGrid = option.result<Matrix>("deltaGrid");
+    const Matrix gammaGrid = option.result<Matrix>("gammaGrid");
+
+    const FdmHestonSolver solver(
+        Handle<HestonProcess>(hestonProcess),
+        hestonEngine->getSolverDesc(1.5));
+
+    for (Size i=0; i < spots.size(); ++i) {
+        for (Size j=0; j < variances.size(); ++j) {
+            const Real s = spots[i], v = variances[j];
+            if (std::fabs(valueGrid[i][j] - solver.valueAt(s, v)) > tol
+                || std::fabs(deltaGrid[i][j] - solver.deltaAt(s, v)) > tol
+                || std::fabs(gammaGrid[i][j] - solver.gammaAt(s, v)) > tol)
+                BOOST_FAIL("failed to reproduce Heston spot ladder"
+                           << "\n    spot:      " << s
+                           << "\n    variance:  " << v
+                           << "\n    value:     " << valueGrid[i][j]
+                           << "\n    expected:  " << solver.valueAt(s, v)
+                           << "\n    delta:     " << deltaGrid[i][j]
+                           << "\n    expected:  " << solver.deltaAt(s, v)
+                           << "\n    gamma:     " << gammaGrid[i][j]
+                           << "\n    expected:  " << solver.gammaAt(s, v));
+        }
+    }
+}
+
+
+void FdHestonTest::testSolutionCaching() {
+    BOOST_TEST_MESSAGE("Testing caching of finite-difference solutions "
+                       "for the Heston engine...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(15, April, 2022);
+    Settings::instance().evaluationDate() = today;
+
+    const auto spot = std::make_shared<SimpleQuote>(100.0);
+    const auto rRate = std::make_shared<SimpleQuote>(0.05);
+    const Handle<YieldTermStructure> rTS(flatRate(today, rRate, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+
+    const auto model = std::make_shared<HestonModel>(
+        std::make_shared<HestonProcess>(
+            rTS, qTS, Handle<Quote>(spot), 0.04, 1.0, 0.06, 0.4, -0.75));
+
+    VanillaOption option(
+        std::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        std::make_shared<AmericanExercise>(today, today + Period(1, Years)));
+
+    const std::vector<Real> ladder = { 90.0, 100.0, 110.0 };
+    const auto cachingEngine =
+        std::make_shared<FdHestonVanillaEngine>(model, 50, 100, 25);
+    cachingEngine->enableSolutionCaching();
+    cachingEngine->enableSpotLadder(ladder);
+
+    const auto engine =
+        std::make_shared<FdHestonVanillaEngine>(model, 50, 100, 25);
+
+    const Real tol = 1e-2;
+    const std::vector<Real> spots = { 100.0, 95.0, 103.0, 100.0 };
+    for (Real s: spots) {
+        spot->setValue(s);
+
+        option.setPricingEngine(engine);
+        const Real expected = option.NPV();
+        const Real expectedDelta = option.delta();
+
+        option.setPricingEngine(cachingEngine);
+        const Real calculated = option.NPV();
+        const Real calculatedDelta = option.delta();
+
+        if (std::fabs(calculated - expected) > tol
+            || std::fabs(calculatedDelta - expectedDelta) > tol)
+            BOOST_FAIL("failed to reproduce the Heston option price"
+                       << "\n    spot:       " << s
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected
+                       << "\n    calculated delta: " << calculatedDelta
+                       << "\n    expected delta:   " << expectedDelta);
+
+        if (option.result<Matrix>("valueGrid").rows() != ladder.size())
+            BOOST_FAIL("spot ladder missing for spot " << s);
+    }
+
+    if (cachingEngine->solutionCacheMisses() != 1
+        || cachingEngine->solutionCacheHits() != spots.size()-1)
+        BOOST_FAIL("unexpected number of cache hits and misses"
+                   << "\n    hits:   " << cachingEngine->solutionCacheHits()
+                   << "\n    misses: " << cachingEngine->solutionCacheMisses());
+
+    // new model parameters must not share the cached solution
+    Array params = model->params();
+    params[4] = 0.05;
+    model->setParams(params);
+    option.NPV();
+    if (cachingEngine->solutionCacheMisses() != 2)
+        BOOST_FAIL("changed model parameters must not be a cache hit");
+
+    // new market data must invalidate the cache
+    rRate->setValue(0.06);
+    const Real calculated = option.NPV();
+    if (cachingEngine->solutionCacheMisses() != 3)
+        BOOST_FAIL("changed interest rate must clear the cache");
+
+    option.setPricingEngine(engine);
+    const Real expected = option.NPV();
+    if (std::fabs(calculated - expected) > 1e-10)
+        BOOST_FAIL("failed to reproduce the Heston option price "
+                   "after a change of the interest rate"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+
+    // results from the multiple strikes cache come with spot ladders
+    const auto strikesEngine =
+        std::make_shared<FdHestonVanillaEngine>(model, 50, 100, 25);
+    strikesEngine->enableMultipleStrikesCaching({ 90.0, 100.0, 110.0 });
+    strikesEngine->enableSpotLadder(ladder);
+
+    VanillaOption europeanOption(
+        std::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        std::make_shared<EuropeanExercise>(today + Period(1, Years)));
+    europeanOption.setPricingEngine(strikesEngine);
+    europeanOption.NPV();
+
+    VanillaOption otherStrikeOption(
+        std::make_shared<PlainVanillaPayoff>(Option::Put, 110.0),
+        std::make_shared<EuropeanExercise>(today + Period(1, Years)));
+    otherStrikeOption.setPricingEngine(strikesEngine);
+
+    // the second ladder spot is the current spot
+    const Matrix valueGrid = otherStrikeOption.result<Matrix>("valueGrid");
+    const Matrix deltaGrid = otherStrikeOption.result<Matrix>("deltaGrid");
+    if (std::fabs(valueGrid[1][0] - otherStrikeOption.NPV()) > 1e-10
+        || std::fabs(deltaGrid[1][0] - otherStrikeOption.delta()) > 1e-10)
+        BOOST_FAIL("spot ladder of a cached strike does not match "
+                   "its results"
+                   << "\n    value:    " << valueGrid[1][0]
+                   << "\n    expected: " << otherStrikeOption.NPV()
+                   << "\n    delta:    " << deltaGrid[1][0]
+                   << "\n    expected: " << otherStrikeOption.delta());
+}
+
+
 test_suite* FdHestonTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Finite Difference Heston tests");
 
@@ -1127,6 +1341,8 @@ test_suite* FdHestonTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testMethodOfLinesAndCN));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testSpuriousOscillations));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testAmericanCallPutParity));
+    suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testSpotLadder));
+    suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testSolutionCaching));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonBlackScholes));
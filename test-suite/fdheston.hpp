@@ -41,6 +41,8 @@ public:
     static void testMethodOfLinesAndCN();
     static void testSpuriousOscillations();
     static void testAmericanCallPutParity();
+    static void testSpotLadder();
+    static void testSolutionCaching();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
@@ -37,6 +37,8 @@
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/exercise.hpp>
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
@@ -49,6 +51,7 @@
 #include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmcoarsetofinesolver.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
@@ -1418,6 +1421,297 @@ void FdmLinearOpTest::testCrankNicolsonWithDamping() {
     }
 }
 
+void FdmLinearOpTest::testAdaptiveTimeStepping() {
+
+    BOOST_TEST_MESSAGE("Testing adaptive time stepping "
+                       "for a Bermudan option...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(28, March, 2023);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(std::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    const auto process = std::make_shared<BlackScholesMertonProcess>(
+        spot, qTS, rTS, volTS);
+
+    const Real strike = 105.0;
+    const auto payoff =
+        std::make_shared<PlainVanillaPayoff>(Option::Put, strike);
+
+    std::vector<Date> exerciseDates;
+    for (Size i=1; i <= 4; ++i)
+        exerciseDates.push_back(today + Period(3*i, Months));
+    const auto exercise =
+        std::make_shared<BermudanExercise>(exerciseDates);
+    const Time maturity = dc.yearFraction(today, exerciseDates.back());
+
+    const auto mesher = std::make_shared<FdmMesherComposite>(
+        std::make_shared<FdmBlackScholesMesher>(
+            200, process, maturity, strike,
+            Null<Real>(), Null<Real>(), 0.0001, 1.5,
+            std::pair<Real, Real>(strike, 0.1)));
+
+    const auto calculator =
+        std::make_shared<FdmLogInnerValue>(payoff, mesher, 0);
+
+    const auto conditions = FdmStepConditionComposite::vanillaComposite(
+        DividendSchedule(), exercise, mesher, calculator, today, dc);
+
+    const auto map = std::make_shared<FdmBlackScholesOp>(
+        mesher, process, strike);
+
+    const std::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+    Array rhs(layout->size()), x(layout->size());
+    for (const auto& iter : *layout) {
+        rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+        x[iter.index()] = mesher->location(iter, 0);
+    }
+
+    const auto price = [&](const Array& values) {
+        return MonotonicCubicNaturalSpline(
+            x.begin(), x.end(), values.begin())(std::log(spot->value()));
+    };
+
+    const Size referenceSteps = 20000, dampingSteps = 2;
+
+    const FdmSchemeDesc schemes[] = {
+        FdmSchemeDesc::Douglas(), FdmSchemeDesc::CraigSneyd(),
+        FdmSchemeDesc::Hundsdorfer(), FdmSchemeDesc::TrBDF2()
+    };
+
+    for (const auto& scheme : schemes) {
+        FdmBackwardSolver solver(
+            map, FdmBoundaryConditionSet(), conditions, scheme);
+
+        Array reference(rhs);
+        solver.rollback(reference, maturity, 0.0,
+                        referenceSteps, dampingSteps);
+        const Real expected = price(reference);
+
+        Array adaptive(rhs);
+        const FdmAdaptiveRollbackStatistics statistics =
+            solver.adaptiveRollback(
+                adaptive, maturity, 0.0, 1e-5, dampingSteps);
+        const Real adaptiveError = std::fabs(price(adaptive) - expected);
+
+        // uniform time grid with the same number of evolver steps
+        Array uniform(rhs);
+        solver.rollback(uniform, maturity, 0.0,
+                        statistics.evolverSteps - dampingSteps,
+                        dampingSteps);
+        const Real uniformError = std::fabs(price(uniform) - expected);
+
+        // with the same work, the adapted and extrapolated steps
+        // must be more accurate than the uniform grid
+        const Real tol = 1e-5;
+        if (adaptiveError > tol || adaptiveError > uniformError) {
+            BOOST_ERROR("Failed to reproduce Bermudan option price "
+                        "with adaptive time steps"
+                        << "\n    scheme type:      " << scheme.type
+                        << "\n    expected:         " << expected
+                        << "\n    adaptive error:   " << adaptiveError
+                        << "\n    uniform error:    " << uniformError
+                        << "\n    tolerance:        " << tol
+                        << "\n    accepted steps:   "
+                        << statistics.acceptedSteps
+                        << "\n    rejected steps:   "
+                        << statistics.rejectedSteps
+                        << "\n    evolver steps:    "
+                        << statistics.evolverSteps);
+        }
+    }
+}
+
+void FdmLinearOpTest::testCoarseToFineSolver() {
+
+    BOOST_TEST_MESSAGE("Testing coarse-to-fine solver "
+                       "with curvature adapted meshes...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(28, March, 2023);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(std::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<BlackVolTermStructure> volTS(flatVol(today, 0.2, dc));
+
+    const auto process = std::make_shared<BlackScholesMertonProcess>(
+        spot, qTS, rTS, volTS);
+
+    const Real strike = 110.0;
+    const auto payoff =
+        std::make_shared<PlainVanillaPayoff>(Option::Put, strike);
+    const Date maturityDate = today + Period(1, Years);
+    const Time maturity = dc.yearFraction(today, maturityDate);
+
+    VanillaOption option(
+        payoff, std::make_shared<EuropeanExercise>(maturityDate));
+    option.setPricingEngine(
+        std::make_shared<AnalyticEuropeanEngine>(process));
+    const Real expected = option.NPV();
+
+    const auto pdeSolver =
+        [&](const std::shared_ptr<FdmMesherComposite>& mesher) {
+            const auto calculator =
+                std::make_shared<FdmLogInnerValue>(payoff, mesher, 0);
+
+            Array rhs(mesher->layout()->size());
+            for (const auto& iter : *mesher->layout())
+                rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+
+            FdmBackwardSolver(
+                std::make_shared<FdmBlackScholesOp>(mesher, process, strike),
+                FdmBoundaryConditionSet(),
+                std::shared_ptr<FdmStepConditionComposite>(),
+                FdmSchemeDesc::Douglas()).rollback(rhs, maturity, 0.0, 200, 2);
+
+            return rhs;
+        };
+
+    const Size xGrid = 41;
+    const Real x0 = std::log(spot->value());
+    const auto uniformMesher = [&](Size size) {
+        return std::make_shared<FdmMesherComposite>(
+            std::make_shared<Uniform1dMesher>(x0 - 1.5, x0 + 1.5, size));
+    };
+
+    FdmCoarseToFineSolver<1> solver(pdeSolver, uniformMesher(xGrid), 2);
+    const Real calculated = solver.interpolateAt(std::vector<Real>(1, x0));
+
+    // uniform mesh with as many nodes as all adapted meshes together;
+    // all solves use the same time grid, i.e., both take the same work
+    const Size uniformNodes = solver.totalNodes();
+    const auto referenceMesher = uniformMesher(uniformNodes);
+    const Array uniform = pdeSolver(referenceMesher);
+    const Real uniformNPV = MonotonicCubicNaturalSpline(
+        referenceMesher->getFdm1dMeshers()[0]->locations().begin(),
+        referenceMesher->getFdm1dMeshers()[0]->locations().end(),
+        uniform.begin())(x0);
+
+    const Real uniformError = std::fabs(uniformNPV - expected);
+    const Real error = std::fabs(calculated - expected);
+    const Real tol = 2e-4;
+
+    if (error > tol || error > 0.5*uniformError
+        || solver.mesher()->layout()->size() != xGrid) {
+        BOOST_ERROR("Failed to improve accuracy with adapted meshes"
+                    << "\n    expected:        " << expected
+                    << "\n    uniform mesh:    " << uniformNPV
+                    << "\n    adapted meshes:  " << calculated
+                    << "\n    tolerance:       " << tol
+                    << "\n    total nodes:     " << uniformNodes);
+    }
+}
+
+void FdmLinearOpTest::testCoarseToFineHestonSolver() {
+
+    BOOST_TEST_MESSAGE("Testing coarse-to-fine solver "
+                       "for the two-dimensional Heston PDE...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(28, March, 2023);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(std::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+
+    const Real v0 = 0.04;
+    const auto process = std::make_shared<HestonProcess>(
+        rTS, qTS, spot, v0, 1.5, 0.04, 0.3, -0.7);
+
+    const Real strike = 110.0;
+    const auto payoff =
+        std::make_shared<PlainVanillaPayoff>(Option::Put, strike);
+    const Date maturityDate = today + Period(1, Years);
+    const Time maturity = dc.yearFraction(today, maturityDate);
+
+    VanillaOption option(
+        payoff, std::make_shared<EuropeanExercise>(maturityDate));
+    option.setPricingEngine(std::make_shared<AnalyticHestonEngine>(
+        std::make_shared<HestonModel>(process)));
+    const Real expected = option.NPV();
+
+    const auto pdeSolver =
+        [&](const std::shared_ptr<FdmMesherComposite>& mesher) {
+            const auto calculator =
+                std::make_shared<FdmLogInnerValue>(payoff, mesher, 0);
+
+            Array rhs(mesher->layout()->size());
+            for (const auto& iter : *mesher->layout())
+                rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+
+            FdmBackwardSolver(
+                std::make_shared<FdmHestonOp>(mesher, process),
+                FdmBoundaryConditionSet(),
+                std::shared_ptr<FdmStepConditionComposite>(),
+                FdmSchemeDesc::Hundsdorfer()).rollback(
+                    rhs, maturity, 0.0, 50, 0);
+
+            return rhs;
+        };
+
+    const Real x0 = std::log(spot->value());
+    const auto uniformMesher = [&](Size xGrid, Size vGrid) {
+        return std::make_shared<FdmMesherComposite>(
+            std::make_shared<Uniform1dMesher>(x0 - 1.5, x0 + 1.5, xGrid),
+            std::make_shared<Uniform1dMesher>(0.0, 0.5, vGrid));
+    };
+
+    const Size xGrid = 41, vGrid = 21;
+    FdmCoarseToFineSolver<2> solver(pdeSolver, uniformMesher(xGrid, vGrid), 2);
+
+    const std::vector<Real> x = { x0, v0 };
+    const Real calculated = solver.interpolateAt(x);
+
+    // single uniform grid with at least as many nodes as all the
+    // solves of the coarse-to-fine solver together
+    const Real scaling = std::sqrt(Real(solver.totalNodes())/(xGrid*vGrid));
+    const Size xUniform = Size(std::ceil(scaling*xGrid));
+    const Size vUniform = Size(std::ceil(scaling*vGrid));
+    const auto referenceMesher = uniformMesher(xUniform, vUniform);
+    const Array uniform = pdeSolver(referenceMesher);
+
+    std::vector<std::vector<Real> > grid = {
+        referenceMesher->getFdm1dMeshers()[0]->locations(),
+        referenceMesher->getFdm1dMeshers()[1]->locations()
+    };
+    MultiCubicSpline<2>::data_table f(grid);
+    for (const auto& iter : *referenceMesher->layout())
+        FdmNdimSolver<2>::setValue(f, iter.coordinates(), uniform[iter.index()]);
+    const std::vector<bool> extrapolation(2, false);
+    const Real uniformNPV = MultiCubicSpline<2>(grid, f, extrapolation)(x);
+
+    const Real uniformError = std::fabs(uniformNPV - expected);
+    const Real error = std::fabs(calculated - expected);
+    const Real tol = 2.5e-3;
+
+    // the intermediate mesh is not solved on: coarse, final and
+    // refined final mesh only
+    if (error > tol || error > 0.5*uniformError
+        || solver.solves() != 3
+        || solver.mesher()->layout()->size() != xGrid*vGrid) {
+        BOOST_ERROR("Failed to improve accuracy with adapted meshes"
+                    << "\n    expected:        " << expected
+                    << "\n    uniform mesh:    " << uniformNPV
+                    << "\n    adapted meshes:  " << calculated
+                    << "\n    tolerance:       " << tol
+                    << "\n    total nodes:     " << solver.totalNodes()
+                    << "\n    uniform nodes:   " << xUniform*vUniform);
+    }
+}
+
 void FdmLinearOpTest::testSpareMatrixReference() {
     BOOST_TEST_MESSAGE("Testing SparseMatrixReference type...");
 
@@ -1707,6 +2001,9 @@ test_suite* FdmLinearOpTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdaptiveTimeStepping));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCoarseToFineSolver));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCoarseToFineHestonSolver));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseMatrixZeroAssignment));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmMesherIntegral));
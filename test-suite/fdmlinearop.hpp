@@ -44,6 +44,9 @@ public:
     static void testBiCGstab();
     static void testGMRES();
     static void testCrankNicolsonWithDamping();
+    static void testAdaptiveTimeStepping();
+    static void testCoarseToFineSolver();
+    static void testCoarseToFineHestonSolver();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
     static void testFdmMesherIntegral();
@@ -26,6 +26,7 @@
 #include <ql/math/integrals/gausslobattointegral.hpp>
 #include <ql/math/optimization/differentialevolution.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/optimization/jacobianlevenbergmarquardt.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/methods/finitedifferences/operators/numericaldifferentiation.hpp>
@@ -39,12 +40,15 @@
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
 #include <ql/pricingengines/vanilla/exponentialfittinghestonengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fouriersurfacepricer.hpp>
 #include <ql/pricingengines/vanilla/hestonexpansionengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/pricingengines/vanilla/mlmceuropeanhestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/equityfx/hestonblackvolsurface.hpp>
@@ -57,6 +61,7 @@
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/time/period.hpp>
 #include <cmath>
+#include <numeric>
 #include <utility>
 
 using namespace QuantLib;
@@ -289,6 +294,482 @@ void HestonModelTest::testDAXCalibration() {
     }
 }
 
+void HestonModelTest::testParallelCalibration() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing parallel Heston model calibration using DAX volatility data...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<std::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    const std::shared_ptr<HestonModel> model(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    // the helpers are priced concurrently, each needs its own engine
+    for (const auto& option : options)
+        std::dynamic_pointer_cast<BlackCalibrationHelper>(option)
+            ->setPricingEngine(std::make_shared<AnalyticHestonEngine>(model, 64));
+
+    const Array initialParams = model->params();
+    const EndCriteria endCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+    model->calibrate(options, om, endCriteria);
+    const Array expected = model->params();
+
+    model->setParams(initialParams);
+    model->setCalibrationThreads(4);
+    model->calibrate(options, om, endCriteria);
+    const Array calculated = model->params();
+
+    for (Size i=0; i < expected.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > 1e-12) {
+            BOOST_FAIL("parallel calibration differs from sequential one"
+                       << "\n    parameter:  " << i
+                       << "\n    calculated: " << calculated[i]
+                       << "\n    expected:   " << expected[i]);
+        }
+    }
+
+    const CalibratedModel::CalibrationDiagnostics& diagnostics =
+        model->calibrationDiagnostics();
+    if (diagnostics.evaluations < Size(model->functionEvaluation())
+        || diagnostics.evaluationTimes.size() != diagnostics.evaluations
+        || diagnostics.threads < 1 || diagnostics.threads > 4) {
+        BOOST_FAIL("inconsistent calibration diagnostics"
+                   << "\n    evaluations:      " << diagnostics.evaluations
+                   << "\n    timings:          "
+                   << diagnostics.evaluationTimes.size()
+                   << "\n    threads:          " << diagnostics.threads
+                   << "\n    function evaluations: "
+                   << model->functionEvaluation());
+    }
+
+    const Real totalTime = std::accumulate(diagnostics.evaluationTimes.begin(),
+                                           diagnostics.evaluationTimes.end(),
+                                           Real(0.0));
+    if (std::fabs(totalTime - diagnostics.totalTime) > 1e-10) {
+        BOOST_FAIL("inconsistent calibration timings"
+                   << "\n    sum of evaluation times: " << totalTime
+                   << "\n    total time:              "
+                   << diagnostics.totalTime);
+    }
+}
+
+void HestonModelTest::testAnalyticGradient() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing analytic Heston price derivatives w.r.t. model parameters...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual365Fixed();
+
+    const Handle<YieldTermStructure> rTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.01, dc));
+    const Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+
+    const std::shared_ptr<HestonModel> model(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                rTS, qTS, s0, 0.05, 1.5, 0.06, 0.6, -0.7)));
+
+    // the price is the one of the engine and the gradient is its
+    // derivative, whatever the complex-log formula or control variate
+    const std::shared_ptr<AnalyticHestonEngine> engines[] = {
+        std::make_shared<AnalyticHestonEngine>(model),
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::BranchCorrection,
+            AnalyticHestonEngine::Integration::gaussLaguerre(160)),
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::AndersenPiterbarg,
+            AnalyticHestonEngine::Integration::gaussLegendre(256)),
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::AndersenPiterbargOptCV,
+            AnalyticHestonEngine::Integration::gaussLaguerre(192)),
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::AsymptoticChF,
+            AnalyticHestonEngine::Integration::gaussLaguerre(192)),
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::OptimalCV,
+            AnalyticHestonEngine::Integration::gaussLaguerre(192))
+    };
+
+    const Array params = model->params();
+    const Real h = 1e-5;
+
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real strikes[] = { 70.0, 100.0, 140.0 };
+    const Period maturities[] = { 1*Months, 3*Months, 1*Years, 5*Years };
+
+    for (Size e=0; e < LENGTH(engines); ++e) {
+        for (auto type : types) {
+            for (auto strike : strikes) {
+                for (const auto& maturity : maturities) {
+                    const Date maturityDate = today + maturity;
+                    const PlainVanillaPayoff payoff(type, strike);
+
+                    VanillaOption option(
+                        std::make_shared<PlainVanillaPayoff>(type, strike),
+                        std::make_shared<EuropeanExercise>(maturityDate));
+                    option.setPricingEngine(engines[e]);
+
+                    model->setParams(params);
+                    Array gradient;
+                    const Real calculated =
+                        engines[e]->priceAndGradient(payoff, maturityDate, gradient);
+                    const Real expected = option.NPV();
+
+                    if (std::fabs(calculated - expected) > 1e-10) {
+                        BOOST_FAIL("failed to reproduce Heston price"
+                                   << "\n    engine:     " << e
+                                   << "\n    strike:     " << strike
+                                   << "\n    maturity:   " << maturity
+                                   << "\n    calculated: " << calculated
+                                   << "\n    expected:   " << expected);
+                    }
+
+                    for (Size j=0; j < params.size(); ++j) {
+                        Array bumped = params;
+                        bumped[j] += h;
+                        model->setParams(bumped);
+                        const Real up = option.NPV();
+                        bumped[j] = params[j] - h;
+                        model->setParams(bumped);
+                        const Real down = option.NPV();
+                        const Real fd = (up - down)/(2*h);
+
+                        if (std::fabs(gradient[j] - fd) > 1e-6*(1.0 + std::fabs(fd))) {
+                            BOOST_FAIL("failed to reproduce Heston price derivative"
+                                       << "\n    engine:     " << e
+                                       << "\n    parameter:  " << j
+                                       << "\n    strike:     " << strike
+                                       << "\n    maturity:   " << maturity
+                                       << "\n    analytic:   " << gradient[j]
+                                       << "\n    bumped:     " << fd);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    model->setParams(params);
+
+    // adaptive integrations are not supported
+    Array gradient;
+    BOOST_CHECK_THROW(
+        AnalyticHestonEngine(model, 1e-8, 10000).priceAndGradient(
+            PlainVanillaPayoff(Option::Call, 100.0), today + 1*Years, gradient),
+        Error);
+}
+
+void HestonModelTest::testDAXCalibrationWithAnalyticJacobian() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston model calibration with analytic Jacobian...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<std::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    const std::shared_ptr<HestonModel> model(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const std::shared_ptr<PricingEngine> engine(
+        std::make_shared<AnalyticHestonEngine>(model, 64));
+    for (const auto& option : options)
+        std::dynamic_pointer_cast<BlackCalibrationHelper>(option)
+            ->setPricingEngine(engine);
+
+    const Array gradient = options[0]->calibrationErrorGradient();
+    if (gradient.size() != model->params().size())
+        BOOST_FAIL("analytic calibration error gradient not available");
+
+    const Array initialParams = model->params();
+    const Real expected = 177.2; //see article by A. Sepp.
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    model->calibrate(options, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (const auto& option : options) {
+        const Real diff = option->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_FAIL("Failed to reproduce calibration error"
+                   << "\n    calculated: " << sse
+                   << "\n    expected:   " << expected);
+    }
+
+    // native Levenberg-Marquardt with and without Broyden updates
+    for (Size maxBroydenUpdates : { 0, 3 }) {
+        model->setParams(initialParams);
+
+        JacobianLevenbergMarquardt jom(1e-8, 1e-8, 1e-8, true,
+                                       maxBroydenUpdates);
+        model->calibrate(options, jom,
+                         EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+        sse = 0;
+        for (const auto& option : options) {
+            const Real diff = option->calibrationError()*100.0;
+            sse += diff*diff;
+        }
+        if (std::fabs(sse - expected) > 1.0) {
+            BOOST_FAIL("Failed to reproduce calibration error with "
+                       "Jacobian Levenberg-Marquardt"
+                       << "\n    Broyden updates: " << maxBroydenUpdates
+                       << "\n    calculated:      " << sse
+                       << "\n    expected:        " << expected);
+        }
+
+        const JacobianLevenbergMarquardt::Diagnostics& diagnostics =
+            jom.diagnostics();
+        if (diagnostics.jacobianEvaluations == 0
+            || diagnostics.jacobianEvaluations > diagnostics.iterations + 1
+            || (maxBroydenUpdates > 0 && diagnostics.broydenUpdates == 0)) {
+            BOOST_FAIL("unexpected Jacobian evaluations"
+                       << "\n    iterations:           "
+                       << diagnostics.iterations
+                       << "\n    Jacobian evaluations: "
+                       << diagnostics.jacobianEvaluations
+                       << "\n    Broyden updates:      "
+                       << diagnostics.broydenUpdates);
+        }
+    }
+}
+
+namespace {
+
+    template <class Engine>
+    void checkBatchPrices(const std::shared_ptr<Engine>& engine,
+                          const std::string& name) {
+
+        const Date today = Settings::instance().evaluationDate();
+        const Period maturities[] = { 1*Months, 1*Years, 5*Years };
+
+        std::vector<std::shared_ptr<PlainVanillaPayoff> > payoffs;
+        for (Real strike = 50.0; strike <= 200.0; strike += 10.0) {
+            payoffs.push_back(std::make_shared<PlainVanillaPayoff>(
+                (strike < 100.0) ? Option::Put : Option::Call, strike));
+        }
+
+        for (const auto& maturity : maturities) {
+            const Date maturityDate = today + maturity;
+            const std::vector<Real> calculated =
+                engine->prices(payoffs, maturityDate);
+
+            for (Size i=0; i < payoffs.size(); ++i) {
+                VanillaOption option(
+                    payoffs[i], std::make_shared<EuropeanExercise>(maturityDate));
+                option.setPricingEngine(engine);
+                const Real expected = option.NPV();
+
+                if (std::fabs(calculated[i] - expected) > 1e-9) {
+                    BOOST_FAIL("failed to reproduce single option price "
+                               "with batch pricing"
+                               << "\n    engine:     " << name
+                               << "\n    strike:     " << payoffs[i]->strike()
+                               << "\n    maturity:   " << maturity
+                               << "\n    calculated: " << calculated[i]
+                               << "\n    expected:   " << expected);
+                }
+            }
+        }
+    }
+
+}
+
+void HestonModelTest::testBatchPricing() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing batch pricing of Heston options with a common maturity...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual365Fixed();
+
+    const Handle<YieldTermStructure> rTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.01, dc));
+    const Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+
+    const std::shared_ptr<HestonModel> model(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                rTS, qTS, s0, 0.05, 1.5, 0.06, 0.6, -0.7)));
+
+    typedef AnalyticHestonEngine::Integration Integration;
+
+    checkBatchPrices(
+        std::make_shared<AnalyticHestonEngine>(model, 144),
+        "Gatheral, Gauss-Laguerre");
+    checkBatchPrices(
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::BranchCorrection,
+            Integration::gaussLaguerre(144)),
+        "branch correction, Gauss-Laguerre");
+    checkBatchPrices(
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::OptimalCV,
+            Integration::gaussLegendre(128)),
+        "optimal control variate, Gauss-Legendre");
+    checkBatchPrices(
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::AndersenPiterbarg,
+            Integration::gaussChebyshev(128)),
+        "Andersen-Piterbarg, Gauss-Chebyshev");
+    checkBatchPrices(
+        std::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::Gatheral,
+            Integration::discreteSimpson(1000)),
+        "Gatheral, discrete Simpson");
+    checkBatchPrices(
+        std::make_shared<COSHestonEngine>(model), "COS");
+
+    const std::shared_ptr<BatesModel> batesModel(
+        std::make_shared<BatesModel>(
+            std::make_shared<BatesProcess>(
+                rTS, qTS, s0, 0.05, 1.5, 0.06, 0.6, -0.7, 0.5, -0.1, 0.15)));
+    checkBatchPrices(
+        std::make_shared<BatesEngine>(batesModel, 144), "Bates");
+}
+
+void HestonModelTest::testFourierSurfacePricer() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Fourier surface pricer for Heston-type models...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual365Fixed();
+
+    const Handle<YieldTermStructure> rTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.01, dc));
+    const Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+
+    const Real v0 = 0.04, kappa = 1.5, theta = 0.05, sigma = 0.5, rho = -0.6;
+
+    const std::shared_ptr<HestonModel> hestonModel(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                rTS, qTS, s0, v0, kappa, theta, sigma, rho)));
+    const std::shared_ptr<BatesModel> batesModel(
+        std::make_shared<BatesModel>(
+            std::make_shared<BatesProcess>(
+                rTS, qTS, s0, v0, kappa, theta, sigma, rho,
+                0.3, -0.1, 0.15)));
+
+    const std::vector<Time> modelTimes = { 1.0, 5.0 };
+    PiecewiseConstantParameter kappaP(
+        std::vector<Time>(1, 1.0), PositiveConstraint());
+    kappaP.setParam(0, 3.0);
+    kappaP.setParam(1, 1.0);
+    const std::shared_ptr<PiecewiseTimeDependentHestonModel> ptdModel(
+        std::make_shared<PiecewiseTimeDependentHestonModel>(
+            rTS, qTS, s0, v0,
+            ConstantParameter(theta, PositiveConstraint()), kappaP,
+            ConstantParameter(sigma, PositiveConstraint()),
+            ConstantParameter(rho, BoundaryConstraint(-1.0, 1.0)),
+            TimeGrid(modelTimes.begin(), modelTimes.end())));
+
+    const std::vector<std::pair<std::shared_ptr<CharacteristicFunction>,
+                                std::shared_ptr<PricingEngine> > > models = {
+        { std::make_shared<HestonCharacteristicFunction>(hestonModel),
+          std::make_shared<AnalyticHestonEngine>(hestonModel, 192) },
+        { std::make_shared<BatesCharacteristicFunction>(batesModel),
+          std::make_shared<BatesEngine>(batesModel, 192) },
+        { std::make_shared<PiecewiseTimeDependentHestonCharacteristicFunction>(
+              ptdModel),
+          std::make_shared<AnalyticPTDHestonEngine>(ptdModel, 192) }
+    };
+    const std::string modelNames[] = { "Heston", "Bates", "PTD Heston" };
+
+    const FourierSurfacePricer::Method methods[] = {
+        FourierSurfacePricer::CarrMadan,
+        FourierSurfacePricer::FractionalFFT,
+        FourierSurfacePricer::COS
+    };
+    const Size points[] = { 4096, 512, 256 };
+    const Real eta[] = { 0.25, 0.5, 0.25 };
+    const std::string methodNames[] = { "Carr-Madan", "fractional FFT", "COS" };
+
+    const std::vector<Real> strikes = { 60, 75, 90, 97.5, 100, 105, 120, 150 };
+    const std::vector<Date> maturities = {
+        today + 3*Months, today + 1*Years, today + 3*Years };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    const Real tol = 1e-4;
+    for (Size i=0; i < models.size(); ++i) {
+        for (Size j=0; j < LENGTH(methods); ++j) {
+            const FourierSurfacePricer pricer(
+                models[i].first, s0, rTS, qTS,
+                methods[j], points[j], eta[j]);
+
+            for (auto type : types) {
+                const Matrix calculated =
+                    pricer.prices(type, strikes, maturities);
+
+                for (Size m=0; m < maturities.size(); ++m) {
+                    for (Size k=0; k < strikes.size(); ++k) {
+                        VanillaOption option(
+                            std::make_shared<PlainVanillaPayoff>(
+                                type, strikes[k]),
+                            std::make_shared<EuropeanExercise>(
+                                maturities[m]));
+                        option.setPricingEngine(models[i].second);
+                        const Real expected = option.NPV();
+
+                        const Real diff =
+                            std::fabs(calculated[m][k] - expected);
+                        if (diff > tol) {
+                            BOOST_FAIL("failed to reproduce option price "
+                                       "with Fourier surface pricer"
+                                       << "\n    model:      "
+                                       << modelNames[i]
+                                       << "\n    method:     "
+                                       << methodNames[j]
+                                       << "\n    type:       " << type
+                                       << "\n    strike:     " << strikes[k]
+                                       << "\n    maturity:   "
+                                       << maturities[m]
+                                       << "\n    calculated: "
+                                       << calculated[m][k]
+                                       << "\n    expected:   " << expected
+                                       << "\n    difference: " << diff
+                                       << "\n    tolerance:  " << tol);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 void HestonModelTest::testAnalyticVsBlack() {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -516,6 +997,464 @@ void HestonModelTest::testMcVsCached() {
     }
 }
 
+void HestonModelTest::testMultilevelMcVsAnalytic() {
+    BOOST_TEST_MESSAGE(
+        "Testing multilevel Monte Carlo Heston engine against analytic values...");
+
+    SavedSettings backup;
+
+    const Date today(27, December, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date maturity = today + Period(1, Years);
+
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+
+    const auto process = std::make_shared<HestonProcess>(
+        rTS, qTS, s0, 0.04, 1.5, 0.04, 0.5, -0.7,
+        HestonProcess::FullTruncation);
+
+    const auto analyticEngine = std::make_shared<AnalyticHestonEngine>(
+        std::make_shared<HestonModel>(process));
+
+    const Real requiredTolerance = 0.05;
+    const Size coarsestSteps = 2;
+    const std::shared_ptr<PricingEngine> mlmcEngine =
+        MakeMLMCEuropeanHestonEngine<PseudoRandom>(process)
+        .withSteps(coarsestSteps)
+        .withAbsoluteTolerance(requiredTolerance)
+        .withSeed(42);
+
+    const Real strikes[] = { 80.0, 100.0, 120.0 };
+    const Option::Type types[] = { Option::Put, Option::Call };
+
+    for (auto strike : strikes) {
+        for (auto type : types) {
+            VanillaOption option(
+                std::make_shared<PlainVanillaPayoff>(type, strike),
+                std::make_shared<EuropeanExercise>(maturity));
+
+            option.setPricingEngine(analyticEngine);
+            const Real expected = option.NPV();
+
+            option.setPricingEngine(mlmcEngine);
+            const Real calculated = option.NPV();
+            const Size levels = std::any_cast<Size>(
+                option.additionalResults().at("Levels"));
+
+            const Real tolerance = 3.0*requiredTolerance;
+            if (std::fabs(calculated - expected) > tolerance) {
+                BOOST_ERROR("failed to reproduce analytic Heston price"
+                            << "\n    strike:         " << strike
+                            << "\n    option type:    " << type
+                            << "\n    calculated:     " << calculated
+                            << "\n    expected:       " << expected
+                            << "\n    error estimate: " << option.errorEstimate()
+                            << "\n    levels:         " << levels
+                            << "\n    tolerance:      " << tolerance);
+            }
+            // the first three levels are always simulated; further
+            // ones are only added if the estimated bias requires them
+            if (levels <= 3)
+                BOOST_ERROR("no level added to reduce the bias"
+                            << "\n    strike:      " << strike
+                            << "\n    option type: " << type);
+        }
+    }
+
+    // the quadratic-exponential scheme doesn't couple the levels
+    BOOST_CHECK_THROW(
+        std::shared_ptr<PricingEngine>(
+            MakeMLMCEuropeanHestonEngine<PseudoRandom>(
+                std::make_shared<HestonProcess>(
+                    rTS, qTS, s0, 0.04, 1.5, 0.04, 0.5, -0.7))
+            .withSteps(coarsestSteps)
+            .withAbsoluteTolerance(requiredTolerance)),
+        Error);
+}
+
+void HestonModelTest::testMcGreeks() {
+    BOOST_TEST_MESSAGE(
+        "Testing pathwise greeks of the Monte Carlo Heston engine...");
+
+    SavedSettings backup;
+
+    const Date today(27, December, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date maturity = today + Period(1, Years);
+
+    const auto r = std::make_shared<SimpleQuote>(0.05);
+    const auto s0 = std::make_shared<SimpleQuote>(100.0);
+    const Handle<YieldTermStructure> rTS(flatRate(today, r, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+
+    const auto process = std::make_shared<HestonProcess>(
+        rTS, qTS, Handle<Quote>(s0), 0.04, 1.5, 0.04, 0.5, -0.7);
+
+    const std::shared_ptr<PricingEngine> analyticEngine =
+        std::make_shared<AnalyticHestonEngine>(
+            std::make_shared<HestonModel>(process));
+    const std::shared_ptr<PricingEngine> mcEngine =
+        MakeMCEuropeanHestonEngine<PseudoRandom>(process)
+        .withSteps(20)
+        .withAntitheticVariate()
+        .withSamples(20000)
+        .withSeed(42)
+        .withGreeks();
+
+    const Real strikes[] = { 80.0, 100.0, 120.0 };
+    const Option::Type types[] = { Option::Put, Option::Call };
+
+    for (auto strike : strikes) {
+        for (auto type : types) {
+            VanillaOption option(
+                std::make_shared<PlainVanillaPayoff>(type, strike),
+                std::make_shared<EuropeanExercise>(maturity));
+
+            // centered differences of the analytic price; the bias of
+            // the discretization is well below the tolerance
+            option.setPricingEngine(analyticEngine);
+            const Real ds = 1.0e-4*s0->value(), dr = 1.0e-6;
+            s0->setValue(100.0 + ds);
+            Real up = option.NPV();
+            s0->setValue(100.0 - ds);
+            Real down = option.NPV();
+            s0->setValue(100.0);
+            const Real expectedDelta = (up - down)/(2*ds);
+            r->setValue(0.05 + dr);
+            up = option.NPV();
+            r->setValue(0.05 - dr);
+            down = option.NPV();
+            r->setValue(0.05);
+            const Real expectedRho = (up - down)/(2*dr);
+
+            option.setPricingEngine(mcEngine);
+            const Real delta = option.delta();
+            const Real rho = option.rho();
+            const Real deltaError = std::any_cast<Real>(
+                option.additionalResults().at("deltaError"));
+            const Real rhoError = std::any_cast<Real>(
+                option.additionalResults().at("rhoError"));
+
+            if (std::fabs(delta - expectedDelta) > 4.0*deltaError)
+                BOOST_ERROR("failed to reproduce Heston delta"
+                            << "\n    strike:         " << strike
+                            << "\n    option type:    " << type
+                            << "\n    calculated:     " << delta
+                            << "\n    expected:       " << expectedDelta
+                            << "\n    error estimate: " << deltaError);
+            if (std::fabs(rho - expectedRho) > 4.0*rhoError)
+                BOOST_ERROR("failed to reproduce Heston rho"
+                            << "\n    strike:         " << strike
+                            << "\n    option type:    " << type
+                            << "\n    calculated:     " << rho
+                            << "\n    expected:       " << expectedRho
+                            << "\n    error estimate: " << rhoError);
+            BOOST_CHECK_THROW(option.vega(), Error);
+        }
+    }
+
+    BOOST_CHECK_THROW(
+        std::shared_ptr<PricingEngine>(
+            MakeMCEuropeanHestonEngine<PseudoRandom>(process)
+            .withSteps(20)
+            .withSamples(1000)
+            .withGreeks(MonteCarloGreeks::LikelihoodRatio)),
+        Error);
+}
+
+void HestonModelTest::benchmarkAnalyticJacobian() {
+    BOOST_TEST_MESSAGE(
+        "Benchmarking Heston calibration with analytic against "
+        "finite-difference Jacobian...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+    const std::vector<std::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    const std::shared_ptr<HestonModel> model(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+    const Array initialParams = model->params();
+
+    const std::shared_ptr<PricingEngine> engine(
+        std::make_shared<AnalyticHestonEngine>(model, 64));
+    for (const auto& option : options)
+        std::dynamic_pointer_cast<BlackCalibrationHelper>(option)
+            ->setPricingEngine(engine);
+
+    // the same optimizer with either the Jacobian of the cost
+    // function or its own finite differences; the budget limits the
+    // evaluations of the cost function
+    for (Size budget : { 10, 20, 50, 400 }) {
+        BOOST_TEST_MESSAGE("    budget of " << budget << " evaluations");
+        for (bool analytic : { false, true }) {
+            model->setParams(initialParams);
+            LevenbergMarquardt om(1e-8, 1e-8, 1e-8, analytic);
+            const Real time = elapsedSeconds([&]() {
+                model->calibrate(options, om,
+                                 EndCriteria(budget, budget/2, 1.0e-8, 1.0e-8, 1.0e-8));
+            });
+
+            Real sse = 0;
+            for (const auto& option : options) {
+                const Real diff = option->calibrationError()*100.0;
+                sse += diff*diff;
+            }
+            BOOST_TEST_MESSAGE("        " << (analytic ? "analytic:          "
+                                                       : "finite differences:")
+                               << " SSE " << sse
+                               << ", " << model->calibrationDiagnostics().evaluations
+                               << " smile evaluations, " << time*1000.0 << " ms");
+        }
+    }
+}
+
+void HestonModelTest::benchmarkBatchPricing() {
+    BOOST_TEST_MESSAGE(
+        "Benchmarking batch pricing of a Heston volatility surface "
+        "against single option pricing...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual365Fixed();
+
+    const Handle<YieldTermStructure> rTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.01, dc));
+    const Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+
+    const std::shared_ptr<HestonModel> model(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                rTS, qTS, s0, 0.05, 1.5, 0.06, 0.6, -0.7)));
+
+    // 200 strikes times 20 expiries
+    std::vector<std::shared_ptr<PlainVanillaPayoff> > payoffs;
+    for (Size i=0; i < 200; ++i) {
+        const Real strike = 50.0 + 0.75*i;
+        payoffs.push_back(std::make_shared<PlainVanillaPayoff>(
+            (strike < 100.0) ? Option::Put : Option::Call, strike));
+    }
+    std::vector<Date> maturities;
+    for (Size j=1; j <= 20; ++j)
+        maturities.push_back(today + Period(3*j, Months));
+
+    typedef AnalyticHestonEngine::Integration Integration;
+    const std::pair<std::string, std::shared_ptr<AnalyticHestonEngine> > engines[] = {
+        { "Gatheral, Gauss-Laguerre",
+          std::make_shared<AnalyticHestonEngine>(model, 144) },
+        { "optimal control variate, Gauss-Legendre",
+          std::make_shared<AnalyticHestonEngine>(
+              model, AnalyticHestonEngine::OptimalCV,
+              Integration::gaussLegendre(128)) }
+    };
+
+    for (const auto& engine : engines) {
+        std::vector<std::vector<Real> > batch;
+        const Real batchTime = elapsedSeconds([&]() {
+            for (const auto& maturity : maturities)
+                batch.push_back(engine.second->prices(payoffs, maturity));
+        });
+
+        std::vector<std::vector<Real> > single;
+        const Real singleTime = elapsedSeconds([&]() {
+            for (const auto& maturity : maturities) {
+                const auto exercise = std::make_shared<EuropeanExercise>(maturity);
+                std::vector<Real> npvs;
+                for (const auto& payoff : payoffs) {
+                    VanillaOption option(payoff, exercise);
+                    option.setPricingEngine(engine.second);
+                    npvs.push_back(option.NPV());
+                }
+                single.push_back(npvs);
+            }
+        });
+
+        Real maxDiff = 0.0;
+        for (Size j=0; j < maturities.size(); ++j)
+            for (Size i=0; i < payoffs.size(); ++i)
+                maxDiff = std::max(maxDiff, std::fabs(batch[j][i] - single[j][i]));
+
+        BOOST_TEST_MESSAGE("    " << engine.first << ":"
+                           << "\n        batch:  " << batchTime*1000.0 << " ms"
+                           << "\n        single: " << singleTime*1000.0 << " ms"
+                           << "\n        ratio:  " << singleTime/batchTime
+                           << "\n        max difference: " << maxDiff);
+    }
+}
+
+void HestonModelTest::benchmarkFourierSurfacePricer() {
+    BOOST_TEST_MESSAGE(
+        "Benchmarking Fourier surface pricer against single option "
+        "pricing...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual365Fixed();
+
+    const Handle<YieldTermStructure> rTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.01, dc));
+    const Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+
+    const std::shared_ptr<HestonModel> model(
+        std::make_shared<HestonModel>(
+            std::make_shared<HestonProcess>(
+                rTS, qTS, s0, 0.04, 1.5, 0.05, 0.5, -0.6)));
+
+    // 200 strikes times 20 expiries
+    std::vector<Real> strikes;
+    for (Size i=0; i < 200; ++i)
+        strikes.push_back(50.0 + 0.75*i);
+    std::vector<Date> maturities;
+    for (Size j=1; j <= 20; ++j)
+        maturities.push_back(today + Period(3*j, Months));
+
+    const std::shared_ptr<PricingEngine> engine(
+        std::make_shared<AnalyticHestonEngine>(model, 192));
+    Matrix expected(maturities.size(), strikes.size());
+    const Real singleTime = elapsedSeconds([&]() {
+        for (Size m=0; m < maturities.size(); ++m) {
+            const auto exercise = std::make_shared<EuropeanExercise>(maturities[m]);
+            for (Size k=0; k < strikes.size(); ++k) {
+                VanillaOption option(
+                    std::make_shared<PlainVanillaPayoff>(Option::Call, strikes[k]),
+                    exercise);
+                option.setPricingEngine(engine);
+                expected[m][k] = option.NPV();
+            }
+        }
+    });
+    BOOST_TEST_MESSAGE("    single options: " << singleTime*1000.0 << " ms");
+
+    const FourierSurfacePricer::Method methods[] = {
+        FourierSurfacePricer::CarrMadan,
+        FourierSurfacePricer::FractionalFFT,
+        FourierSurfacePricer::COS
+    };
+    const Size points[] = { 4096, 512, 256 };
+    const Real eta[] = { 0.25, 0.5, 0.25 };
+    const std::string methodNames[] = { "Carr-Madan", "fractional FFT", "COS" };
+
+    for (Size j=0; j < LENGTH(methods); ++j) {
+        const FourierSurfacePricer pricer(
+            std::make_shared<HestonCharacteristicFunction>(model), s0, rTS, qTS,
+            methods[j], points[j], eta[j]);
+
+        Matrix calculated;
+        const Real time = elapsedSeconds([&]() {
+            calculated = pricer.prices(Option::Call, strikes, maturities);
+        });
+
+        Real maxDiff = 0.0;
+        for (Size m=0; m < maturities.size(); ++m)
+            for (Size k=0; k < strikes.size(); ++k)
+                maxDiff = std::max(maxDiff,
+                                   std::fabs(calculated[m][k] - expected[m][k]));
+
+        BOOST_TEST_MESSAGE("    " << methodNames[j] << " (" << points[j]
+                           << " points): " << time*1000.0 << " ms, ratio "
+                           << singleTime/time << ", max difference " << maxDiff);
+    }
+}
+
+void HestonModelTest::benchmarkMultilevelMonteCarlo() {
+    BOOST_TEST_MESSAGE(
+        "Benchmarking multilevel Monte Carlo Heston engine...");
+
+    SavedSettings backup;
+
+    const Date today(27, December, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dc = Actual365Fixed();
+
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<Quote> s0(std::make_shared<SimpleQuote>(100.0));
+
+    const auto process = std::make_shared<HestonProcess>(
+        rTS, qTS, s0, 0.04, 1.5, 0.04, 0.5, -0.7,
+        HestonProcess::FullTruncation);
+    const auto qeProcess = std::make_shared<HestonProcess>(
+        rTS, qTS, s0, 0.04, 1.5, 0.04, 0.5, -0.7,
+        HestonProcess::QuadraticExponentialMartingale);
+
+    VanillaOption option(
+        std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        std::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    option.setPricingEngine(std::make_shared<AnalyticHestonEngine>(
+        std::make_shared<HestonModel>(process)));
+    const Real expected = option.NPV();
+
+    const Size coarsestSteps = 2;
+    for (Real tolerance : { 0.1, 0.05, 0.02 }) {
+        option.setPricingEngine(
+            MakeMLMCEuropeanHestonEngine<PseudoRandom>(process)
+            .withSteps(coarsestSteps)
+            .withAbsoluteTolerance(tolerance)
+            .withSeed(42));
+        Real mlmcValue;
+        const Real mlmcTime = elapsedSeconds([&]() {
+            mlmcValue = option.NPV();
+        });
+        const Size levels = std::any_cast<Size>(
+            option.additionalResults().at("Levels"));
+        const Size finestSteps = coarsestSteps*(Size(1) << (levels-1));
+
+        // same root mean square error as the multilevel estimate
+        option.setPricingEngine(
+            MakeMCEuropeanHestonEngine<PseudoRandom>(process)
+            .withSteps(finestSteps)
+            .withAbsoluteTolerance(tolerance*M_SQRT1_2)
+            .withSeed(42));
+        Real mcValue;
+        const Real mcTime = elapsedSeconds([&]() {
+            mcValue = option.NPV();
+        });
+
+        option.setPricingEngine(
+            MakeMCEuropeanHestonEngine<PseudoRandom>(qeProcess)
+            .withSteps(coarsestSteps)
+            .withAbsoluteTolerance(tolerance*M_SQRT1_2)
+            .withSeed(42));
+        Real qeValue;
+        const Real qeTime = elapsedSeconds([&]() {
+            qeValue = option.NPV();
+        });
+
+        BOOST_TEST_MESSAGE("    tolerance " << tolerance
+                           << ", analytic value " << expected
+                           << "\n        multilevel, " << levels
+                           << " levels:        error "
+                           << mlmcValue - expected << ", "
+                           << mlmcTime << " s"
+                           << "\n        MCEuropeanHestonEngine, "
+                           << finestSteps << " steps: error "
+                           << mcValue - expected << ", "
+                           << mcTime << " s"
+                           << "\n        MCEuropeanHestonEngine, QE, "
+                           << coarsestSteps << " steps: error "
+                           << qeValue - expected << ", "
+                           << qeTime << " s");
+    }
+}
+
 void HestonModelTest::testFdBarrierVsCached() {
     BOOST_TEST_MESSAGE("Testing FD barrier Heston engine against cached values...");
 
@@ -3410,6 +4349,11 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
 
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBlackCalibration));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDAXCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testParallelCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticGradient));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDAXCalibrationWithAnalyticJacobian));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBatchPricing));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFourierSurfacePricer));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsBlack));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
@@ -3440,6 +4384,8 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testOptimalControlVariateChoice));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAsymptoticControlVariate));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testLocalVolFromHestonModel));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultilevelMcVsAnalytic));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMcGreeks));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDifferentIntegrals));
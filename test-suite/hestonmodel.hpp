@@ -31,6 +31,11 @@ class HestonModelTest {
   public:
     static void testBlackCalibration();
     static void testDAXCalibration();
+    static void testParallelCalibration();
+    static void testAnalyticGradient();
+    static void testDAXCalibrationWithAnalyticJacobian();
+    static void testBatchPricing();
+    static void testFourierSurfacePricer();
     static void testAnalyticVsBlack();
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
@@ -65,7 +70,13 @@ class HestonModelTest {
     static void testOptimalControlVariateChoice();
     static void testAsymptoticControlVariate();
     static void testLocalVolFromHestonModel();
-    
+    static void testMultilevelMcVsAnalytic();
+    static void testMcGreeks();
+
+    static void benchmarkAnalyticJacobian();
+    static void benchmarkBatchPricing();
+    static void benchmarkFourierSurfacePricer();
+    static void benchmarkMultilevelMonteCarlo();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
     static boost::unit_test_framework::test_suite* experimental();
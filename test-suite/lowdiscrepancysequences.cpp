@@ -30,6 +30,9 @@
 #include <ql/math/randomnumbers/randomizedlds.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/math/randomnumbers/latticerules.hpp>
 #include <ql/math/randomnumbers/latticersg.hpp>
@@ -1070,6 +1073,176 @@ void LowDiscrepancyTest::testSobolSkipping() {
     }
 }
 
+void LowDiscrepancyTest::testSobolBulkGeneration() {
+
+    BOOST_TEST_MESSAGE("Testing bulk generation of Sobol sequences...");
+
+    unsigned long seed = 42;
+    Size dimensionality[] = { 1, 10, 100, 1000, 1500 };
+    // chunks of different sizes, also not multiples of the tile
+    // size; the larger ones cross the first powers of two of the
+    // sequence counter
+    Size chunks[] = { 1, 7, 16, 33, 100, 1000, 1025 };
+
+    for (Size d : dimensionality) {
+        SobolRsg rsg1(d, seed, SobolRsg::JoeKuoD7);
+        SobolRsg rsg2(d, seed, SobolRsg::JoeKuoD7);
+        SobolRsg rsg3(d, seed, SobolRsg::JoeKuoD7);
+        rsg1.skipTo(5);
+        rsg2.skipTo(5);
+        rsg3.skipTo(5);
+
+        for (Size n : chunks) {
+            std::vector<Real> pointMajor(n*d), dimensionMajor(n*d);
+            rsg2.nextSequences(n, &pointMajor[0]);
+            rsg3.nextSequences(n, &dimensionMajor[0],
+                               SobolRsg::DimensionMajor);
+            for (Size i = 0; i < n; i++) {
+                const std::vector<Real>& x = rsg1.nextSequence().value;
+                for (Size k = 0; k < d; k++) {
+                    if (x[k] != pointMajor[i*d+k]
+                        || x[k] != dimensionMajor[k*n+i])
+                        BOOST_FAIL("Mismatch in bulk generation:"
+                                   << "\n  size:      " << d
+                                   << "\n  chunk:     " << n
+                                   << "\n  point:     " << i
+                                   << "\n  dimension: " << k
+                                   << "\n  expected:  " << x[k]
+                                   << "\n  found:     " << pointMajor[i*d+k]
+                                   << ", " << dimensionMajor[k*n+i]);
+                }
+            }
+            if (rsg2.lastSequence().value != rsg1.lastSequence().value)
+                BOOST_FAIL("last sequence not updated by bulk generation");
+        }
+    }
+
+    // bulk inverse-cumulative transformation
+    const Size d = 40, n = 1000;
+    InverseCumulativeRsg<SobolRsg, InverseCumulativeNormal>
+        gaussian1(SobolRsg(d, seed)), gaussian2(SobolRsg(d, seed));
+    std::vector<Real> z(n*d);
+    gaussian2.nextSequences(n, &z[0]);
+    for (Size i = 0; i < n; i++) {
+        const std::vector<Real>& x = gaussian1.nextSequence().value;
+        for (Size k = 0; k < d; k++) {
+            if (x[k] != z[i*d+k])
+                BOOST_FAIL("Mismatch in bulk Gaussian generation:"
+                           << "\n  point:     " << i
+                           << "\n  dimension: " << k
+                           << "\n  expected:  " << x[k]
+                           << "\n  found:     " << z[i*d+k]);
+        }
+    }
+}
+
+void LowDiscrepancyTest::benchmarkSobolBulkGeneration() {
+
+    BOOST_TEST_MESSAGE("Benchmarking bulk generation of Sobol sequences...");
+
+    const unsigned long seed = 42;
+    // about 10^7 numbers for each dimensionality
+    const Size numbers = 10000000;
+
+    for (Size d : { Size(100), Size(1000), Size(10000) }) {
+        const Size n = numbers/d;
+        std::vector<Real> buffer(n*d);
+
+        SobolRsg scalar(d, seed);
+        const Real scalarTime = elapsedSeconds([&]() {
+            for (Size i = 0; i < n; i++) {
+                const std::vector<Real>& x = scalar.nextSequence().value;
+                std::copy(x.begin(), x.end(), buffer.begin() + i*d);
+            }
+        });
+        const Real last = buffer.back();
+
+        SobolRsg pointMajor(d, seed);
+        const Real pointMajorTime = elapsedSeconds([&]() {
+            pointMajor.nextSequences(n, &buffer[0]);
+        });
+        if (buffer.back() != last)
+            BOOST_ERROR("bulk generation does not reproduce the sequence"
+                        << "\n    dimension: " << d);
+
+        SobolRsg dimensionMajor(d, seed);
+        const Real dimensionMajorTime = elapsedSeconds([&]() {
+            dimensionMajor.nextSequences(n, &buffer[0],
+                                         SobolRsg::DimensionMajor);
+        });
+
+        const Real mega = 1.0e-6*Real(n*d);
+        BOOST_TEST_MESSAGE("    dimension " << d << ", " << n << " points:"
+                           << "\n        single points:   "
+                           << mega/scalarTime << " M numbers/s"
+                           << "\n        point major:     "
+                           << mega/pointMajorTime << " M numbers/s"
+                           << "\n        dimension major: "
+                           << mega/dimensionMajorTime << " M numbers/s");
+    }
+}
+
+void LowDiscrepancyTest::testScrambledSobol() {
+
+    BOOST_TEST_MESSAGE("Testing scrambled Sobol sequences...");
+
+    const Size dimensionality = 20, m = 10, points = 1 << m;
+
+    // the block of points 2^m, ..., 2^{m+1}-1 is a net; in each
+    // dimension there must be exactly one point in each interval
+    // [i 2^{-m}, (i+1) 2^{-m}) for any scrambling
+    for (unsigned long seed : {1UL, 42UL, 12345UL}) {
+        ScrambledSobolRsg rsg(dimensionality, seed);
+        rsg.skipTo(points-1);
+        std::vector<std::vector<Size> > counts(
+            dimensionality, std::vector<Size>(points, 0));
+        for (Size i = 0; i < points; i++) {
+            const std::vector<Real>& x = rsg.nextSequence().value;
+            for (Size k = 0; k < dimensionality; k++) {
+                if (x[k] <= 0.0 || x[k] >= 1.0)
+                    BOOST_FAIL("scrambled point " << x[k]
+                               << " outside of (0, 1)");
+                counts[k][Size(x[k]*points)]++;
+            }
+        }
+        for (Size k = 0; k < dimensionality; k++) {
+            for (Size i = 0; i < points; i++) {
+                if (counts[k][i] != 1)
+                    BOOST_FAIL(counts[k][i] << " points in interval " << i
+                               << " of dimension " << k
+                               << " for seed " << seed);
+            }
+        }
+    }
+
+    // reproducibility and independence of the scramblings
+    ScrambledSobolRsg rsg1(dimensionality, 42), rsg2(dimensionality, 42),
+        rsg3(dimensionality, 43);
+    for (Size i = 0; i < 100; i++) {
+        const std::vector<Real> x1 = rsg1.nextSequence().value;
+        if (x1 != rsg2.nextSequence().value)
+            BOOST_FAIL("failed to reproduce scrambled sequence");
+        if (x1 == rsg3.nextSequence().value)
+            BOOST_FAIL("different seeds gave the same scrambling");
+    }
+
+    // interleaved randomizations
+    const Size randomizations = 4;
+    MultiRandomizedLDS<ScrambledSobolRsg> rqmc(dimensionality,
+                                               randomizations, 42);
+    std::vector<ScrambledSobolRsg> single;
+    MersenneTwisterUniformRng seeds(42);
+    for (Size k = 0; k < randomizations; k++)
+        single.emplace_back(dimensionality, seeds.nextInt32());
+    for (Size i = 0; i < 100; i++) {
+        for (Size k = 0; k < randomizations; k++) {
+            if (rqmc.nextSequence().value != single[k].nextSequence().value)
+                BOOST_FAIL("failed to reproduce point " << i
+                           << " of randomization " << k);
+        }
+    }
+}
+
 
 test_suite* LowDiscrepancyTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Low-discrepancy sequence tests");
@@ -1108,6 +1281,9 @@ test_suite* LowDiscrepancyTest::suite() {
            &LowDiscrepancyTest::testSobolLevitanLemieuxSobolDiscrepancy));
 
     suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolSkipping));
+    suite->add(QUANTLIB_TEST_CASE(
+           &LowDiscrepancyTest::testSobolBulkGeneration));
+    suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testScrambledSobol));
 
     suite->add(QUANTLIB_TEST_CASE(
            &LowDiscrepancyTest::testRandomizedLowDiscrepancySequence));
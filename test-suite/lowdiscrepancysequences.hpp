@@ -48,9 +48,13 @@ class LowDiscrepancyTest {
     static void testRandomizedLowDiscrepancySequence();
 
     static void testSobolSkipping();
+    static void testSobolBulkGeneration();
+    static void testScrambledSobol();
 
     static void testRandomizedLattices();
 
+    static void benchmarkSobolBulkGeneration();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
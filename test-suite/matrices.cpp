@@ -32,8 +32,10 @@
 #include <ql/math/matrixutilities/qrdecomposition.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <boost/numeric/ublas/vector.hpp>
 #include <cmath>
 #include <utility>
 #include <numeric>
@@ -767,7 +769,7 @@ void MatricesTest::testSparseMatrixMemory() {
 
     Array x{1, 2, 3, 4};
     Array y = prod(m, x);
-    BOOST_CHECK_EQUAL(y, Array({0, 18, 0, 84}));
+    BOOST_CHECK_EQUAL(y, Array({0, 18, 0, 84, 0, 0, 0, 0}));
 
     m(3, 2) = 43;
     coords = sparseMatrixToCoordinateTuple(m);
@@ -791,6 +793,159 @@ void MatricesTest::testSparseMatrixMemory() {
 
 }
 
+void MatricesTest::testSparseMatrixAssembly() {
+
+    BOOST_TEST_MESSAGE("Testing row-wise sparse matrix assembly...");
+
+    const Size rows = 23, columns = 17, entriesPerRow = 6;
+
+    MersenneTwisterUniformRng rng(1234);
+
+    SparseMatrix expected(rows, columns), calculated(rows, columns);
+    Matrix dense(rows, columns, 0.0);
+
+    std::vector<std::pair<Size, Real> > row(entriesPerRow);
+    for (Size i=0; i < rows; ++i) {
+        // leave a few empty rows, including the last one
+        if (i % 5 == 3 || i == rows-1)
+            continue;
+
+        for (Size k=0; k < entriesPerRow; ++k) {
+            const Size j = std::min(Size(rng.nextReal()*columns), columns-1);
+            const Real v = rng.nextReal() - 0.5;
+            row[k] = std::make_pair(j, v);
+            expected(i, j) += v;
+            dense[i][j] += v;
+        }
+        appendRow(calculated, i, row.begin(), row.end());
+    }
+
+    const auto expectedCoords = sparseMatrixToCoordinateTuple(expected);
+    const auto calculatedCoords = sparseMatrixToCoordinateTuple(calculated);
+    BOOST_CHECK(expectedCoords.first == calculatedCoords.first);
+    for (Size i=0; i < expectedCoords.second.size(); ++i)
+        BOOST_CHECK_SMALL(calculatedCoords.second[i]
+                          - expectedCoords.second[i], 1e-12);
+
+    BOOST_CHECK_THROW(appendRow(calculated, 2, row.begin(), row.end()),
+                      Error);
+
+    Array x(columns), y(rows);
+    for (Size i=0; i < columns; ++i)
+        x[i] = rng.nextReal();
+    for (Size i=0; i < rows; ++i)
+        y[i] = rng.nextReal();
+
+    const Array ax = prod(calculated, x), axExpected = dense*x;
+    const Array ay = prod(y, calculated), ayExpected = y*dense;
+
+    BOOST_REQUIRE(ax.size() == rows && ay.size() == columns);
+    for (Size i=0; i < rows; ++i)
+        BOOST_CHECK_SMALL(ax[i] - axExpected[i], 1e-12);
+    for (Size i=0; i < columns; ++i)
+        BOOST_CHECK_SMALL(ay[i] - ayExpected[i], 1e-12);
+}
+
+void MatricesTest::benchmarkSparseMatrixProducts() {
+
+    using namespace matrices_test;
+
+    BOOST_TEST_MESSAGE("Benchmarking sparse matrix assembly, products "
+                       "and ILU preconditioning...");
+
+    // five-point stencil of a diagonally dominant 2D diffusion operator
+    const Size n = 300, size = n*n, products = 200;
+
+    const auto stencil = [n](Size k) {
+        const Size i = k % n, j = k / n;
+        std::vector<std::pair<Size, Real> > row;
+        row.reserve(5);
+        row.emplace_back(k, 4.5);
+        if (i > 0)   row.emplace_back(k-1, -1.0);
+        if (i < n-1) row.emplace_back(k+1, -1.0);
+        if (j > 0)   row.emplace_back(k-n, -1.0);
+        if (j < n-1) row.emplace_back(k+n, -1.0);
+        return row;
+    };
+
+    SparseMatrix elementWise(size, size), rowWise(size, size);
+    const Real elementWiseTime = elapsedSeconds([&]() {
+        for (Size k=0; k < size; ++k)
+            for (const auto& e: stencil(k))
+                elementWise(k, e.first) += e.second;
+    });
+    const Real rowWiseTime = elapsedSeconds([&]() {
+        for (Size k=0; k < size; ++k) {
+            auto row = stencil(k);
+            appendRow(rowWise, k, row.begin(), row.end());
+        }
+    });
+    BOOST_REQUIRE(elementWise.nnz() == rowWise.nnz());
+
+    Array x(size);
+    boost::numeric::ublas::vector<Real> xu(size), yu(size);
+    MersenneTwisterUniformRng rng(42);
+    for (Size k=0; k < size; ++k)
+        xu[k] = x[k] = rng.nextReal();
+
+    Array y;
+    const Real prodTime = elapsedSeconds([&]() {
+        for (Size k=0; k < products; ++k)
+            y = prod(rowWise, x);
+    });
+    // the same product through the sparse iterators of ublas
+    const Real ublasTime = elapsedSeconds([&]() {
+        for (Size k=0; k < products; ++k)
+            for (auto i1 = rowWise.cbegin1(); i1 != rowWise.cend1(); ++i1) {
+                Real t = 0.0;
+                for (auto i2 = i1.begin(); i2 != i1.end(); ++i2)
+                    t += *i2 * xu[i2.index2()];
+                yu[i1.index1()] = t;
+            }
+    });
+    for (Size k=0; k < size; ++k)
+        BOOST_CHECK_SMALL(y[k] - yu[k], 1e-12);
+
+    Array yt;
+    const Real transposedTime = elapsedSeconds([&]() {
+        for (Size k=0; k < products; ++k)
+            yt = prod(x, rowWise);
+    });
+    // the operator is symmetric
+    for (Size k=0; k < size; ++k)
+        BOOST_CHECK_SMALL(yt[k] - y[k], 1e-12);
+
+    std::unique_ptr<SparseILUPreconditioner> ilu;
+    const Real iluTime = elapsedSeconds([&]() {
+        ilu = std::make_unique<SparseILUPreconditioner>(rowWise, 1);
+    });
+    Array z;
+    const Real applyTime = elapsedSeconds([&]() {
+        for (Size k=0; k < products; ++k)
+            z = ilu->apply(y);
+    });
+
+    const auto matmult = [&](const Array& v) { return prod(rowWise, v); };
+    const auto precond = [&](const Array& v) { return ilu->apply(v); };
+    BiCGStabResult result;
+    const Real solveTime = elapsedSeconds([&]() {
+        result = BiCGstab(matmult, 100, 1e-10, precond).solve(y);
+    });
+    BOOST_CHECK_SMALL(norm(Array(result.x - x)), 1e-6);
+
+    BOOST_TEST_MESSAGE(std::fixed << std::setprecision(4)
+        << "    " << size << " rows, " << rowWise.nnz() << " non-zeros"
+        << "\n    element-wise assembly  : " << elementWiseTime << " s"
+        << "\n    row-wise assembly      : " << rowWiseTime << " s"
+        << "\n    " << products << " products          : " << prodTime << " s"
+        << " (ublas iterators: " << ublasTime << " s)"
+        << "\n    " << products << " transposed        : " << transposedTime << " s"
+        << "\n    ILU(1) factorization   : " << iluTime << " s"
+        << "\n    " << products << " ILU applications  : " << applyTime << " s"
+        << "\n    preconditioned BiCGstab: " << solveTime << " s, "
+        << result.iterations << " iterations");
+}
+
 #define QL_CHECK_CLOSE_MATRIX(actual, expected)                             \
     BOOST_REQUIRE(actual.rows() == expected.rows() &&                       \
                   actual.columns() == expected.columns());                  \
@@ -871,6 +1026,7 @@ test_suite* MatricesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testInverse));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testDeterminant));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSparseMatrixMemory));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSparseMatrixAssembly));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testCholeskyDecomposition));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testMoorePenroseInverse));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testIterativeSolvers));
@@ -43,8 +43,11 @@ class MatricesTest {
     static void testIterativeSolvers();
     static void testInitializers();
     static void testSparseMatrixMemory();
+    static void testSparseMatrixAssembly();
     static void testOperators();
 
+    static void benchmarkSparseMatrixProducts();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
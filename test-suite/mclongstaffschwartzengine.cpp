@@ -22,6 +22,8 @@
 #include "mclongstaffschwartzengine.hpp"
 #include "utilities.hpp"
 #include <ql/instruments/vanillaoption.hpp>
+#include <ql/math/integrals/gaussianorthogonalpolynomial.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -30,6 +32,9 @@
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
+#include <functional>
+#include <map>
+#include <set>
 #include <utility>
 
 using namespace QuantLib;
@@ -118,6 +123,44 @@ namespace {
         }
     };
 
+
+    class StateRecordingPathPricer
+        : public LongstaffSchwartzPathPricer<MultiPath> {
+      public:
+        using LongstaffSchwartzPathPricer<MultiPath>::LongstaffSchwartzPathPricer;
+
+        std::map<Size, std::vector<Array> > states;
+        std::map<Size, std::vector<Real> > exerciseValues;
+
+      protected:
+        void post_processing(const Size i,
+                             const std::vector<Array>& state,
+                             const std::vector<Real>&,
+                             const std::vector<Real>& exercise) override {
+            states[i] = state;
+            exerciseValues[i] = exercise;
+        }
+    };
+
+    std::shared_ptr<StochasticProcessArray> maxOptionProcess(
+        const Date& today, Size numberAssets, Real correlation) {
+        const DayCounter dayCounter = Actual365Fixed();
+
+        const auto process = std::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(std::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.10, dayCounter)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dayCounter)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.20, dayCounter)));
+
+        Matrix corr(numberAssets, numberAssets, correlation);
+        for (Size i=0; i<numberAssets; ++i)
+            corr[i][i] = 1.0;
+
+        return std::make_shared<StochasticProcessArray>(
+            std::vector<std::shared_ptr<StochasticProcess1D> >(
+                numberAssets, process), corr);
+    }
+
 }
 
 
@@ -311,10 +354,389 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testRegressionMethods() {
+    BOOST_TEST_MESSAGE("Testing regression methods of the Longstaff-Schwartz "
+                       "calibration...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    const auto process = std::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(std::make_shared<SimpleQuote>(36.0)),
+        Handle<YieldTermStructure>(flatRate(today, 0.0, dayCounter)),
+        Handle<YieldTermStructure>(flatRate(today, 0.06, dayCounter)),
+        Handle<BlackVolTermStructure>(flatVol(today, 0.2, dayCounter)));
+
+    VanillaOption option(
+        std::make_shared<PlainVanillaPayoff>(Option::Put, 40.0),
+        std::make_shared<AmericanExercise>(today, today + Period(1, Years)));
+
+    const auto price = [&](LsmRegression::Method method) {
+        option.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(process)
+                .withSteps(50)
+                .withAntitheticVariate()
+                .withSamples(4096)
+                .withCalibrationSamples(4096)
+                .withSeed(42)
+                .withPolynomialOrder(3)
+                .withRegressionMethod(method));
+        return option.NPV();
+    };
+
+    const Real expected = price(LsmRegression::SVD);
+    const Real tol = 1e-3;
+
+    const LsmRegression::Method methods[] =
+        { LsmRegression::QR, LsmRegression::Cholesky };
+    for (auto method : methods) {
+        const Real calculated = price(method);
+        if (std::fabs(calculated - expected) > tol)
+            BOOST_ERROR("failed to reproduce SVD regression result"
+                        << "\n    method:     " << Integer(method)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected
+                        << "\n    tolerance:  " << tol);
+    }
+}
+
+namespace {
+
+    // independent reference: weighted orthogonal polynomials
+    Real referencePolynomial(LsmBasisSystem::PolynomialType type,
+                             Size n, Real x) {
+        switch (type) {
+          case LsmBasisSystem::Monomial:
+            return std::pow(x, Integer(n));
+          case LsmBasisSystem::Laguerre:
+            return GaussLaguerrePolynomial().weightedValue(n, x);
+          case LsmBasisSystem::Hermite:
+            return GaussHermitePolynomial().weightedValue(n, x);
+          case LsmBasisSystem::Hyperbolic:
+            return GaussHyperbolicPolynomial().weightedValue(n, x);
+          case LsmBasisSystem::Legendre:
+            return GaussLegendrePolynomial().weightedValue(n, x);
+          case LsmBasisSystem::Chebyshev:
+            return GaussChebyshevPolynomial().weightedValue(n, x);
+          case LsmBasisSystem::Chebyshev2nd:
+            return GaussChebyshev2ndPolynomial().weightedValue(n, x);
+          default:
+            QL_FAIL("unknown polynomial type");
+        }
+    }
+
+    // orders of the one-dimensional factors of the multi-dimensional
+    // basis: total order 0, 1, ..., in lexicographic order each
+    std::vector<std::vector<Size> > referenceTuples(Size dim, Size order) {
+        std::vector<std::vector<Size> > result;
+        for (Size total=0; total<=order; ++total) {
+            std::set<std::vector<Size> > tuples;
+            std::vector<Size> tuple(dim, 0);
+            std::function<void(Size, Size)> fill = [&](Size k, Size rest) {
+                if (k == dim-1) {
+                    tuple[k] = rest;
+                    tuples.insert(tuple);
+                    return;
+                }
+                for (Size m=0; m<=rest; ++m) {
+                    tuple[k] = m;
+                    fill(k+1, rest-m);
+                }
+            };
+            fill(0, total);
+            result.insert(result.end(), tuples.begin(), tuples.end());
+        }
+        return result;
+    }
+
+}
+
+void MCLongstaffSchwartzEngineTest::testPolynomialBasis() {
+    BOOST_TEST_MESSAGE("Testing batch evaluation of LSM basis systems...");
+
+    const LsmBasisSystem::PolynomialType types[] = {
+        LsmBasisSystem::Monomial, LsmBasisSystem::Laguerre,
+        LsmBasisSystem::Hermite, LsmBasisSystem::Hyperbolic,
+        LsmBasisSystem::Legendre, LsmBasisSystem::Chebyshev,
+        LsmBasisSystem::Chebyshev2nd };
+
+    const Real tol = 1e-12;
+
+    std::vector<Array> states(20);
+    std::vector<Real> x(states.size());
+    for (Size j=0; j<states.size(); ++j) {
+        states[j] = Array(3);
+        for (Size k=0; k<3; ++k)
+            states[j][k] = -0.9 + 0.09*j + 0.03*k;
+        x[j] = states[j][0];
+    }
+
+    const auto check = [&](Real calculated, Real expected,
+                           const std::string& what,
+                           LsmBasisSystem::PolynomialType type,
+                           Size order, Size dim, Size function) {
+        if (std::fabs(calculated - expected)
+                > tol*std::max(1.0, std::fabs(expected)))
+            BOOST_ERROR("failed to reproduce " << what
+                        << "\n    type:       " << Integer(type)
+                        << "\n    order:      " << order
+                        << "\n    dim:        " << dim
+                        << "\n    function:   " << function
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    };
+
+    for (auto type : types) {
+        for (Size order=1; order<=6; ++order) {
+            const auto v = LsmBasisSystem::pathBasisSystem(order, type);
+            const Matrix A = LsmPolynomialBasis(1, order, type).designMatrix(x);
+
+            BOOST_REQUIRE(A.columns() == order+1);
+            BOOST_REQUIRE(v.size() == order+1);
+            for (Size j=0; j<x.size(); ++j) {
+                for (Size l=0; l<=order; ++l) {
+                    const Real expected = referencePolynomial(type, l, x[j]);
+                    check(A[j][l], expected, "design matrix",
+                          type, order, 1, l);
+                    check(v[l](x[j]), expected, "path basis function",
+                          type, order, 1, l);
+                }
+            }
+
+            for (Size dim=1; dim<=3; ++dim) {
+                const std::vector<std::vector<Size> > tuples =
+                    referenceTuples(dim, order);
+                const auto w =
+                    LsmBasisSystem::multiPathBasisSystem(dim, order, type);
+                std::vector<Array> s(states.size());
+                for (Size j=0; j<states.size(); ++j)
+                    s[j] = Array(states[j].begin(), states[j].begin()+dim);
+                const Matrix B =
+                    LsmPolynomialBasis(dim, order, type).designMatrix(s);
+
+                BOOST_REQUIRE(B.columns() == tuples.size());
+                BOOST_REQUIRE(w.size() == tuples.size());
+                for (Size j=0; j<s.size(); ++j) {
+                    for (Size l=0; l<tuples.size(); ++l) {
+                        Real expected = 1.0;
+                        for (Size k=0; k<dim; ++k)
+                            expected *= referencePolynomial(
+                                type, tuples[l][k], s[j][k]);
+                        check(B[j][l], expected, "multi-path design matrix",
+                              type, order, dim, l);
+                        check(w[l](s[j]), expected,
+                              "multi-path basis function",
+                              type, order, dim, l);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void MCLongstaffSchwartzEngineTest::testCalibrationStates() {
+    BOOST_TEST_MESSAGE("Testing the calibration states "
+                       "of the Longstaff-Schwartz path pricer...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+
+    const Size numberAssets = 2;
+    const std::shared_ptr<StochasticProcessArray> process =
+        maxOptionProcess(today, numberAssets, 0.3);
+
+    const TimeGrid grid(3.0, 12);
+    MultiPathGenerator<PseudoRandom::rsg_type> generator(
+        process, grid,
+        PseudoRandom::make_sequence_generator(
+            numberAssets*(grid.size()-1), 42));
+
+    const auto earlyExercisePathPricer =
+        std::make_shared<AmericanMaxPathPricer>(
+            std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0));
+
+    StateRecordingPathPricer pricer(
+        grid, earlyExercisePathPricer,
+        flatRate(today, 0.05, Actual365Fixed()));
+
+    std::vector<MultiPath> paths;
+    for (Size j=0; j<200; ++j) {
+        paths.push_back(generator.next().value);
+        pricer(paths.back());
+    }
+    pricer.calibrate();
+
+    // the stored states and exercise values must reproduce the paths
+    for (Size i=1; i<grid.size(); ++i) {
+        BOOST_REQUIRE(pricer.states[i].size() == paths.size());
+        for (Size j=0; j<paths.size(); ++j) {
+            const Array expected = earlyExercisePathPricer->state(paths[j], i);
+            const Array& calculated = pricer.states[i][j];
+            BOOST_REQUIRE(calculated.size() == numberAssets);
+            for (Size k=0; k<numberAssets; ++k) {
+                if (calculated[k] != expected[k])
+                    BOOST_FAIL("failed to reproduce the calibration state"
+                               << "\n    time index: " << i
+                               << "\n    path:       " << j
+                               << "\n    asset:      " << k
+                               << "\n    calculated: " << calculated[k]
+                               << "\n    expected:   " << expected[k]);
+            }
+            if (pricer.exerciseValues[i][j]
+                    != (*earlyExercisePathPricer)(paths[j], i))
+                BOOST_FAIL("failed to reproduce the exercise value"
+                           << "\n    time index: " << i
+                           << "\n    path:       " << j
+                           << "\n    calculated: "
+                           << pricer.exerciseValues[i][j]
+                           << "\n    expected:   "
+                           << (*earlyExercisePathPricer)(paths[j], i));
+        }
+    }
+}
+
+void MCLongstaffSchwartzEngineTest::benchmarkBermudanCalibration() {
+    BOOST_TEST_MESSAGE("Benchmarking the calibration of a Bermudan max "
+                       "option with 50 exercise dates...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+
+    const Size numberAssets = 2, nExercises = 50, nCalibration = 20000;
+    const std::shared_ptr<StochasticProcessArray> process =
+        maxOptionProcess(today, numberAssets, 0.3);
+
+    const TimeGrid grid(3.0, nExercises);
+    MultiPathGenerator<PseudoRandom::rsg_type> generator(
+        process, grid,
+        PseudoRandom::make_sequence_generator(
+            numberAssets*nExercises, 42));
+
+    const auto earlyExercisePathPricer =
+        std::make_shared<AmericanMaxPathPricer>(
+            std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0));
+    const std::shared_ptr<YieldTermStructure> rTS =
+        flatRate(today, 0.05, Actual365Fixed());
+
+    std::vector<MultiPath> paths;
+    paths.reserve(nCalibration);
+    for (Size j=0; j<nCalibration; ++j)
+        paths.push_back(generator.next().value);
+
+    LongstaffSchwartzPathPricer<MultiPath> pricer(
+        grid, earlyExercisePathPricer, rTS);
+    const Real calibrationTime = elapsedSeconds([&]() {
+        for (const auto& path: paths)
+            pricer(path);
+        pricer.calibrate();
+    });
+
+    // previously, the pricer kept a copy of every calibration path
+    std::vector<MultiPath> copies;
+    const Real copyTime = elapsedSeconds([&]() {
+        for (const auto& path: paths)
+            copies.push_back(path);
+    });
+
+    Size pathBytes = 0;
+    for (const auto& path: copies) {
+        pathBytes += sizeof(MultiPath);
+        for (Size k=0; k<path.assetNumber(); ++k) {
+            const TimeGrid& times = path[k].timeGrid();
+            pathBytes += sizeof(Path) + sizeof(Real)*(path[k].length()
+                + 2*times.size() + times.mandatoryTimes().size());
+        }
+    }
+    // one value per state component plus the exercise value
+    const Size stateBytes =
+        nCalibration*nExercises*(numberAssets+1)*sizeof(Real);
+
+    Real price = 0.0;
+    const Real pricingTime = elapsedSeconds([&]() {
+        for (Size j=0; j<nCalibration; ++j)
+            price += pricer(generator.next().value);
+    });
+    price /= nCalibration;
+
+    BOOST_TEST_MESSAGE("    calibration paths:   " << nCalibration
+                       << "\n    calibration time:    "
+                       << calibrationTime << " s"
+                       << "\n    path copying time:   " << copyTime << " s"
+                       << "\n    stored states:       "
+                       << stateBytes/1024 << " kB"
+                       << "\n    stored paths:        "
+                       << pathBytes/1024 << " kB"
+                       << "\n    pricing time:        "
+                       << pricingTime << " s"
+                       << "\n    price:               " << price);
+
+    if (stateBytes >= pathBytes)
+        BOOST_ERROR("stored states should use less memory than the paths");
+}
+
+
+void MCLongstaffSchwartzEngineTest::benchmarkPolynomialBasis() {
+    BOOST_TEST_MESSAGE("Benchmarking the evaluation of LSM basis systems...");
+
+    const Size nStates = 2000;
+    MersenneTwisterUniformRng rng(42);
+
+    for (Size dim=1; dim<=5; ++dim) {
+        std::vector<Array> states(nStates, Array(dim));
+        for (auto& state: states)
+            for (auto& x: state)
+                x = 2.0*rng.nextReal() - 1.0;
+
+        for (Size order=3; order<=8; ++order) {
+            const LsmPolynomialBasis basis(dim, order, LsmBasisSystem::Hermite);
+            const auto v = LsmBasisSystem::multiPathBasisSystem(
+                dim, order, LsmBasisSystem::Hermite);
+
+            Matrix A;
+            const Real batchTime = elapsedSeconds([&]() {
+                A = basis.designMatrix(states);
+            });
+
+            Matrix B(nStates, v.size());
+            const Real functorTime = elapsedSeconds([&]() {
+                for (Size j=0; j<nStates; ++j)
+                    for (Size l=0; l<v.size(); ++l)
+                        B[j][l] = v[l](states[j]);
+            });
+
+            for (Size j=0; j<nStates; ++j)
+                for (Size l=0; l<v.size(); ++l)
+                    if (std::fabs(A[j][l] - B[j][l])
+                            > 1e-12*std::max(1.0, std::fabs(B[j][l])))
+                        BOOST_FAIL("basis functors and design matrix differ"
+                                   << "\n    dim:   " << dim
+                                   << "\n    order: " << order);
+
+            BOOST_TEST_MESSAGE("    assets: " << dim
+                               << ", order: " << order
+                               << ", functions: " << v.size()
+                               << ", design matrix: " << batchTime << " s"
+                               << ", functors: " << functorTime << " s");
+        }
+    }
+}
+
+
 test_suite* MCLongstaffSchwartzEngineTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
 
     suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testRegressionMethods));
+    suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testPolynomialBasis));
+    suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testCalibrationStates));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testAmericanOption));
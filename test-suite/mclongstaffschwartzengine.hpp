@@ -30,6 +30,12 @@ class MCLongstaffSchwartzEngineTest {
   public:
     static void testAmericanOption();
     static void testAmericanMaxOption();
+    static void testRegressionMethods();
+    static void testPolynomialBasis();
+    static void testCalibrationStates();
+
+    static void benchmarkBermudanCalibration();
+    static void benchmarkPolynomialBasis();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -20,7 +20,9 @@
 #include "observable.hpp"
 #include "utilities.hpp"
 #include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/stock.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/patterns/dependencygraph.hpp>
 #include <ql/patterns/observable.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/capfloor/capfloortermvolsurface.hpp>
@@ -303,6 +305,53 @@ void ObservableTest::testDeepUpdate() {
     QL_CHECK_CLOSE(v4, 0.21, 1E-10);
 }
 
+void ObservableTest::testDependencyGraph() {
+    BOOST_TEST_MESSAGE("Testing dependency-graph queries...");
+
+    SavedSettings backup;
+
+    auto q1 = std::make_shared<SimpleQuote>(0.02);
+    auto q2 = std::make_shared<SimpleQuote>(100.0);
+
+    Handle<YieldTermStructure> yts(
+        std::make_shared<FlatForward>(0, NullCalendar(), Handle<Quote>(q1),
+                                      Actual365Fixed()));
+    auto ibor = std::make_shared<Euribor>(3 * Months, yts);
+    auto stock1 = std::make_shared<Stock>(Handle<Quote>(q1));
+    auto stock2 = std::make_shared<Stock>(Handle<Quote>(q2));
+
+    const std::vector<Instrument*> instruments1 =
+        reachableObservers<Instrument>(*q1);
+    if (instruments1.size() != 1 || instruments1[0] != stock1.get())
+        BOOST_FAIL("failed to find the only instrument depending on q1"
+                   << "\n    instruments found: " << instruments1.size());
+
+    const std::vector<Instrument*> instruments2 =
+        reachableObservers<Instrument>(*q2);
+    if (instruments2.size() != 1 || instruments2[0] != stock2.get())
+        BOOST_FAIL("failed to find the only instrument depending on q2"
+                   << "\n    instruments found: " << instruments2.size());
+
+    const std::vector<Index*> indexes = reachableObservers<Index>(*q1);
+    if (indexes.size() != 1 || indexes[0] != ibor.get())
+        BOOST_FAIL("failed to find the index depending on q1 through its curve"
+                   << "\n    indexes found: " << indexes.size());
+
+    if (!reachableObservers<Index>(*q2).empty())
+        BOOST_FAIL("index unexpectedly depending on q2");
+
+    const auto byType = reachableObserversByType(*q1);
+    const auto stocks = byType.find(typeid(Stock));
+    if (stocks == byType.end() || stocks->second.size() != 1)
+        BOOST_FAIL("failed to group the observers of q1 by type");
+    if (byType.find(typeid(FlatForward)) == byType.end())
+        BOOST_FAIL("failed to find the curve among the observers of q1");
+
+    stock1.reset();
+    if (!reachableObservers<Instrument>(*q1).empty())
+        BOOST_FAIL("deleted instrument still found among the observers of q1");
+}
+
 namespace {
 	class DummyObserver : public Observer {
 	  public:
@@ -413,6 +462,7 @@ test_suite* ObservableTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testEmptyObserverList));
     suite->add(QUANTLIB_TEST_CASE(
         &ObservableTest::testAddAndDeleteObserverDuringNotifyObservers));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testDependencyGraph));
     return suite;
 }
 
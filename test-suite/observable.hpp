@@ -33,6 +33,7 @@ class ObservableTest {
     static void testDeepUpdate();
     static void testEmptyObserverList();
     static void testAddAndDeleteObserverDuringNotifyObservers();
+    static void testDependencyGraph();
 
     static boost::unit_test_framework::test_suite* suite();
 };
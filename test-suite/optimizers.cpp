@@ -25,6 +25,7 @@
 #include "utilities.hpp"
 #include <ql/math/optimization/simplex.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/optimization/jacobianlevenbergmarquardt.hpp>
 #include <ql/math/optimization/conjugategradient.hpp>
 #include <ql/math/optimization/steepestdescent.hpp>
 #include <ql/math/optimization/bfgs.hpp>
@@ -33,6 +34,7 @@
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/optimization/differentialevolution.hpp>
 #include <ql/math/optimization/goldstein.hpp>
+#include <atomic>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -432,6 +434,49 @@ namespace {
             return fx - p + 1.0;
         }
     };
+
+    class BatchSecondDeJong : public SecondDeJong {
+      public:
+        Array batchValue(const std::vector<Array>& x) const override {
+            ++calls;
+            points += x.size();
+            Array v(x.size());
+            for (Size i=0; i<x.size(); ++i)
+                v[i] = value(x[i]);
+            return v;
+        }
+        // updated concurrently by parallel evaluations
+        mutable std::atomic<Size> calls{0}, points{0};
+    };
+
+    // residuals of the fit of a exp(-b t) + c to exact data
+    class ExponentialFit : public CostFunction {
+      public:
+        explicit ExponentialFit(Size n = 20) : t_(n), y_(n) {
+            for (Size i=0; i<t_.size(); ++i) {
+                t_[i] = 5.0*i/n;
+                y_[i] = 2.0*std::exp(-1.5*t_[i]) + 0.5;
+            }
+        }
+        Array values(const Array& x) const override {
+            Array v(t_.size());
+            for (Size i=0; i<t_.size(); ++i)
+                v[i] = x[0]*std::exp(-x[1]*t_[i]) + x[2] - y_[i];
+            return v;
+        }
+        void jacobian(Matrix& jac, const Array& x) const override {
+            ++jacobianCalls;
+            for (Size i=0; i<t_.size(); ++i) {
+                const Real e = std::exp(-x[1]*t_[i]);
+                jac[i][0] = e;
+                jac[i][1] = -x[0]*t_[i]*e;
+                jac[i][2] = 1.0;
+            }
+        }
+        mutable Size jacobianCalls = 0;
+      private:
+        std::vector<Real> t_, y_;
+    };
 }
 
 void OptimizersTest::testDifferentialEvolution() {
@@ -543,11 +588,262 @@ void OptimizersTest::testDifferentialEvolution() {
     }
 }
 
+void OptimizersTest::testDifferentialEvolutionBatchEvaluation() {
+    BOOST_TEST_MESSAGE(
+        "Testing batch and parallel evaluation in differential evolution...");
+
+    const DifferentialEvolution::Configuration conf =
+        DifferentialEvolution::Configuration()
+        .withStepsizeWeight(0.4)
+        .withBounds()
+        .withCrossoverProbability(0.35)
+        .withPopulationMembers(100)
+        .withStrategy(DifferentialEvolution::Rand1SelfadaptiveWithRotation)
+        .withAdaptiveCrossover()
+        .withSeed(3242);
+    const EndCriteria endCriteria(100, 10, 1e-10, 1e-8, Null<Real>());
+    BoundaryConstraint constraint(-10.0, 10.0);
+
+    // a whole generation is passed to the cost function at once
+    BatchSecondDeJong batchCostFunction;
+    Problem batchProblem(batchCostFunction, constraint, Array(2, 5.0));
+    DifferentialEvolution(conf).minimize(batchProblem, endCriteria);
+
+    if (Integer(batchCostFunction.points)
+        != batchProblem.functionEvaluation()) {
+        BOOST_ERROR("batch evaluations do not match function evaluations"
+                    << "\n    batch points:         "
+                    << batchCostFunction.points
+                    << "\n    function evaluations: "
+                    << batchProblem.functionEvaluation());
+    }
+    if (batchCostFunction.points != 100*batchCostFunction.calls) {
+        BOOST_ERROR("generations are not evaluated as a whole"
+                    << "\n    batch calls:  " << batchCostFunction.calls
+                    << "\n    batch points: " << batchCostFunction.points);
+    }
+
+    // the result must not depend on the number of threads, and
+    // each thread evaluates its chunk of a generation at once
+    for (Size threads : { 1, 2, 4 }) {
+        BatchSecondDeJong costFunction;
+        Problem problem(costFunction, constraint, Array(2, 5.0));
+        DifferentialEvolution(
+            DifferentialEvolution::Configuration(conf).withThreads(threads))
+            .minimize(problem, endCriteria);
+
+        if (problem.functionValue() != batchProblem.functionValue()
+            || problem.currentValue() != batchProblem.currentValue()
+            || problem.functionEvaluation()
+                   != batchProblem.functionEvaluation()) {
+            BOOST_ERROR("parallel evaluation does not reproduce "
+                        "batch evaluation"
+                        << "\n    threads:    " << threads
+                        << "\n    calculated: " << problem.functionValue()
+                        << " at " << problem.currentValue()
+                        << "\n    expected:   "
+                        << batchProblem.functionValue()
+                        << " at " << batchProblem.currentValue());
+        }
+        if (costFunction.calls != threads*batchCostFunction.calls) {
+            BOOST_ERROR("generations are not split into one chunk "
+                        "per thread"
+                        << "\n    threads:     " << threads
+                        << "\n    batch calls: " << costFunction.calls
+                        << "\n    generations: " << batchCostFunction.calls);
+        }
+    }
+}
+
+void OptimizersTest::benchmarkDifferentialEvolution() {
+    BOOST_TEST_MESSAGE(
+        "Benchmarking parallel evaluation in differential evolution...");
+
+    const DifferentialEvolution::Configuration conf =
+        DifferentialEvolution::Configuration()
+        .withStepsizeWeight(0.4)
+        .withBounds()
+        .withCrossoverProbability(0.35)
+        .withPopulationMembers(100)
+        .withStrategy(DifferentialEvolution::Rand1SelfadaptiveWithRotation)
+        .withAdaptiveCrossover()
+        .withSeed(3242);
+    const EndCriteria endCriteria(50, 49, 1e-10, 1e-8, Null<Real>());
+    BoundaryConstraint constraint(0.0, 5.0);
+
+    // fit to 10000 points, so that the evaluations dominate
+    ExponentialFit costFunction(10000);
+    for (Size threads : { 1, 2, 4 }) {
+        Problem problem(costFunction, constraint, Array(3, 1.0));
+        const Real time = elapsedSeconds([&]() {
+            DifferentialEvolution(
+                DifferentialEvolution::Configuration(conf).withThreads(threads))
+                .minimize(problem, endCriteria);
+        });
+        BOOST_TEST_MESSAGE("    " << threads << " thread(s): "
+                           << time*1000.0 << " ms, "
+                           << problem.functionEvaluation() << " evaluations, "
+                           << "cost " << problem.functionValue());
+    }
+}
+
+void OptimizersTest::testJacobianLevenbergMarquardt() {
+    BOOST_TEST_MESSAGE(
+        "Testing Levenberg-Marquardt method with Jacobian reuse...");
+
+    NoConstraint constraint;
+    const EndCriteria endCriteria(1000, 100, 1e-12, 1e-16, 1e-12);
+    const Real expected[] = { 2.0, 1.5, 0.5 };
+
+    struct Setup {
+        bool analyticJacobian;
+        Size maxBroydenUpdates;
+    };
+    const Setup setups[] = { { false, 0 }, { true, 0 }, { true, 5 } };
+
+    Size jacobianEvaluations = Null<Size>();
+    for (const auto& setup : setups) {
+        ExponentialFit costFunction;
+        Array initialValue(3);
+        initialValue[0] = 1.0;
+        initialValue[1] = 1.0;
+        initialValue[2] = 0.0;
+        Problem problem(costFunction, constraint, initialValue);
+
+        JacobianLevenbergMarquardt method(1e-8, 1e-12, 1e-12,
+                                          setup.analyticJacobian,
+                                          setup.maxBroydenUpdates);
+        method.minimize(problem, endCriteria);
+        const JacobianLevenbergMarquardt::Diagnostics& diagnostics =
+            method.diagnostics();
+
+        for (Size i=0; i<3; ++i) {
+            if (std::fabs(problem.currentValue()[i] - expected[i]) > 1e-6) {
+                BOOST_ERROR("failed to fit exponential"
+                            << "\n    analytic Jacobian: "
+                            << setup.analyticJacobian
+                            << "\n    Broyden updates:   "
+                            << setup.maxBroydenUpdates
+                            << "\n    calculated: " << problem.currentValue()
+                            << "\n    expected:   2.0, 1.5, 0.5");
+            }
+        }
+
+        const Size finiteDifferenceEvaluations = setup.analyticJacobian
+            ? 0 : 3*diagnostics.jacobianEvaluations;
+        if (Size(problem.functionEvaluation())
+            != diagnostics.functionEvaluations + finiteDifferenceEvaluations) {
+            BOOST_ERROR("unexpected number of function evaluations"
+                        << "\n    problem:     "
+                        << problem.functionEvaluation()
+                        << "\n    diagnostics: "
+                        << diagnostics.functionEvaluations
+                        << "\n    finite differences: "
+                        << finiteDifferenceEvaluations);
+        }
+
+        if (setup.analyticJacobian) {
+            if (costFunction.jacobianCalls
+                != diagnostics.jacobianEvaluations) {
+                BOOST_ERROR("analytic Jacobian not used"
+                            << "\n    Jacobian calls:       "
+                            << costFunction.jacobianCalls
+                            << "\n    Jacobian evaluations: "
+                            << diagnostics.jacobianEvaluations);
+            }
+
+            if (setup.maxBroydenUpdates == 0) {
+                jacobianEvaluations = diagnostics.jacobianEvaluations;
+            } else if (diagnostics.broydenUpdates == 0
+                       || diagnostics.jacobianEvaluations
+                              >= jacobianEvaluations) {
+                BOOST_ERROR("Broyden updates do not save Jacobian "
+                            "evaluations"
+                            << "\n    Broyden updates:      "
+                            << diagnostics.broydenUpdates
+                            << "\n    Jacobian evaluations: "
+                            << diagnostics.jacobianEvaluations
+                            << "\n    without updates:      "
+                            << jacobianEvaluations);
+            }
+        }
+    }
+}
+
+void OptimizersTest::benchmarkJacobianLevenbergMarquardt() {
+    BOOST_TEST_MESSAGE(
+        "Benchmarking Levenberg-Marquardt method with Jacobian reuse...");
+
+    NoConstraint constraint;
+    const EndCriteria endCriteria(1000, 100, 1e-12, 1e-16, 1e-12);
+    const Size runs = 20;
+
+    // fit to 10000 points, so that the evaluations dominate
+    ExponentialFit costFunction(10000);
+    Array initialValue(3);
+    initialValue[0] = 1.0;
+    initialValue[1] = 1.0;
+    initialValue[2] = 0.0;
+
+    {
+        Integer evaluations = 0;
+        const Real time = elapsedSeconds([&]() {
+            for (Size i=0; i<runs; ++i) {
+                Problem problem(costFunction, constraint, initialValue);
+                LevenbergMarquardt(1e-8, 1e-12, 1e-12).minimize(problem,
+                                                                endCriteria);
+                evaluations = problem.functionEvaluation();
+            }
+        });
+        BOOST_TEST_MESSAGE("    LevenbergMarquardt, finite differences: "
+                           << time*1000.0/runs << " ms, "
+                           << evaluations << " evaluations");
+    }
+
+    struct Setup {
+        bool analyticJacobian;
+        Size maxBroydenUpdates;
+        std::string name;
+    };
+    const Setup setups[] = {
+        { false, 0, "finite differences:" },
+        { true, 0,  "analytic Jacobian: " },
+        { true, 5,  "Broyden updates:   " }
+    };
+
+    for (const auto& setup : setups) {
+        JacobianLevenbergMarquardt method(1e-8, 1e-12, 1e-12,
+                                          setup.analyticJacobian,
+                                          setup.maxBroydenUpdates);
+        Integer evaluations = 0;
+        const Real time = elapsedSeconds([&]() {
+            for (Size i=0; i<runs; ++i) {
+                Problem problem(costFunction, constraint, initialValue);
+                method.minimize(problem, endCriteria);
+                evaluations = problem.functionEvaluation();
+            }
+        });
+        const JacobianLevenbergMarquardt::Diagnostics& diagnostics =
+            method.diagnostics();
+        BOOST_TEST_MESSAGE("    JacobianLevenbergMarquardt, " << setup.name
+                           << " " << time*1000.0/runs << " ms, "
+                           << evaluations << " evaluations, "
+                           << diagnostics.jacobianEvaluations
+                           << " Jacobians, "
+                           << diagnostics.broydenUpdates
+                           << " Broyden updates");
+    }
+}
+
 test_suite* OptimizersTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Optimizers tests");
 
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::test));
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::nestedOptimizationTest));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OptimizersTest::testDifferentialEvolutionBatchEvaluation));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OptimizersTest::testJacobianLevenbergMarquardt));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
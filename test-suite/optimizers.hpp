@@ -30,6 +30,11 @@ class OptimizersTest {
     static void test();
     static void nestedOptimizationTest();
     static void testDifferentialEvolution();
+    static void testDifferentialEvolutionBatchEvaluation();
+    static void testJacobianLevenbergMarquardt();
+
+    static void benchmarkDifferentialEvolution();
+    static void benchmarkJacobianLevenbergMarquardt();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
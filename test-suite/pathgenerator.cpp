@@ -20,20 +20,68 @@
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/pathblockgenerator.hpp>
+#include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
+#include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/basket/mceuropeanbasketengine.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <numeric>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
 namespace {
 
+    /* optionally applies the Brownian bridge to the sequences of a
+       generator, factor by factor, taking the elements i*factors+l
+       as the bridge variates of the l-th factor */
+    template <class GSG>
+    class BridgedSequenceGenerator {
+      public:
+        typedef Sample<std::vector<Real> > sample_type;
+        BridgedSequenceGenerator(GSG generator, const TimeGrid& grid,
+                                 Size factors, bool brownianBridge)
+        : generator_(std::move(generator)), bridge_(grid),
+          factors_(factors), brownianBridge_(brownianBridge),
+          next_(std::vector<Real>(generator_.dimension()), 1.0) {}
+        const sample_type& nextSequence() const {
+            const std::vector<Real>& sequence =
+                generator_.nextSequence().value;
+            if (!brownianBridge_) {
+                next_.value = sequence;
+                return next_;
+            }
+            const Size steps = bridge_.size();
+            std::vector<Real> input(steps), output(steps);
+            for (Size l=0; l<factors_; ++l) {
+                for (Size i=0; i<steps; ++i)
+                    input[i] = sequence[i*factors_+l];
+                bridge_.transform(input.begin(), input.end(),
+                                  output.begin());
+                for (Size i=0; i<steps; ++i)
+                    next_.value[i*factors_+l] = output[i];
+            }
+            return next_;
+        }
+        const sample_type& lastSequence() const { return next_; }
+        Size dimension() const { return generator_.dimension(); }
+      private:
+        GSG generator_;
+        BrownianBridge bridge_;
+        Size factors_;
+        bool brownianBridge_;
+        mutable sample_type next_;
+    };
+
     void testSingle(const std::shared_ptr<StochasticProcess1D>& process,
                     const std::string& tag, bool brownianBridge,
                     Real expected, Real antithetic) {
@@ -290,10 +338,405 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testPathBlockGenerator() {
+
+    BOOST_TEST_MESSAGE("Testing path block generation against "
+                       "single paths...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(std::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    typedef PseudoRandom::rsg_type rsg_type;
+
+    const TimeGrid grid(2.0, 12);
+    const Size blockSize = 16, blocks = 3;
+    const BigNatural seed = 42;
+
+    const auto process =
+        std::make_shared<BlackScholesMertonProcess>(x0,q,r,sigma);
+
+    for (bool brownianBridge : { false, true }) {
+        PathGenerator<rsg_type> generator(
+            process, grid,
+            PseudoRandom::make_sequence_generator(grid.size()-1, seed),
+            brownianBridge);
+        PathBlockGenerator<rsg_type> blockGenerator(
+            process, grid,
+            PseudoRandom::make_sequence_generator(grid.size()-1, seed),
+            brownianBridge, blockSize);
+
+        for (Size b=0; b<blocks; ++b) {
+            const Matrix values = blockGenerator.next().values();
+            const Matrix antithetic = blockGenerator.antithetic().values();
+            for (Size j=0; j<blockSize; ++j) {
+                const Path path = generator.next().value;
+                const Path antitheticPath = generator.antithetic().value;
+                for (Size i=0; i<grid.size(); ++i) {
+                    if (std::fabs(values[i][j] - path[i]) > 1e-12
+                        || std::fabs(antithetic[i][j]
+                                     - antitheticPath[i]) > 1e-12)
+                        BOOST_FAIL("failed to reproduce single path "
+                                   << (brownianBridge ? "with " : "without ")
+                                   << "Brownian bridge:"
+                                   << "\n    block:      " << b
+                                   << "\n    path:       " << j
+                                   << "\n    time point: " << i
+                                   << "\n    block:      " << values[i][j]
+                                   << "\n    single:     " << path[i]
+                                   << "\n    antithetic block:  "
+                                   << antithetic[i][j]
+                                   << "\n    antithetic single: "
+                                   << antitheticPath[i]);
+                }
+            }
+        }
+    }
+
+    const auto hestonProcess = std::make_shared<HestonProcess>(
+        r, q, x0, 0.04, 1.5, 0.04, 0.5, -0.7);
+    const Size dimension = hestonProcess->factors()*(grid.size()-1);
+
+    // MultiPathGenerator doesn't support the Brownian bridge; the
+    // bridged paths are checked against bridged input sequences
+    typedef BridgedSequenceGenerator<rsg_type> bridged_type;
+    for (bool brownianBridge : { false, true }) {
+        MultiPathGenerator<bridged_type> generator(
+            hestonProcess, grid,
+            bridged_type(PseudoRandom::make_sequence_generator(dimension, seed),
+                         grid, hestonProcess->factors(), brownianBridge));
+        MultiPathBlockGenerator<rsg_type> blockGenerator(
+            hestonProcess, grid,
+            PseudoRandom::make_sequence_generator(dimension, seed), blockSize,
+            brownianBridge);
+
+        for (Size b=0; b<blocks; ++b) {
+            const MultiPathBlock values = blockGenerator.next();
+            const MultiPathBlock antithetic = blockGenerator.antithetic();
+            for (Size j=0; j<blockSize; ++j) {
+                const MultiPath path = generator.next().value;
+                const MultiPath antitheticPath = generator.antithetic().value;
+                for (Size k=0; k<path.assetNumber(); ++k) {
+                    for (Size i=0; i<grid.size(); ++i) {
+                        if (std::fabs(values[k][i][j] - path[k][i]) > 1e-12
+                            || std::fabs(antithetic[k][i][j]
+                                         - antitheticPath[k][i]) > 1e-12)
+                            BOOST_FAIL("failed to reproduce single Heston path "
+                                       << (brownianBridge ? "with " : "without ")
+                                       << "Brownian bridge:"
+                                       << "\n    block:      " << b
+                                       << "\n    path:       " << j
+                                       << "\n    asset:      " << k
+                                       << "\n    time point: " << i
+                                       << "\n    block:      " << values[k][i][j]
+                                       << "\n    single:     " << path[k][i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void PathGeneratorTest::testBlockPathPricers() {
+
+    BOOST_TEST_MESSAGE("Testing block path pricers against "
+                       "single path pricers...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(std::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    typedef PseudoRandom::rsg_type rsg_type;
+
+    const TimeGrid grid(1.0, 10);
+    const Size blockSize = 64;
+    const auto process =
+        std::make_shared<BlackScholesMertonProcess>(x0,q,r,sigma);
+    PathBlockGenerator<rsg_type> generator(
+        process, grid,
+        PseudoRandom::make_sequence_generator(grid.size()-1, 42),
+        false, blockSize);
+    const PathBlock& block = generator.next();
+
+    std::vector<DiscountFactor> discounts(grid.size());
+    for (Size i=0; i<grid.size(); ++i)
+        discounts[i] = r->discount(grid[i]);
+
+    const auto check = [&](const std::string& tag,
+                           const Array& calculated,
+                           const PathPricer<Path>& pricer) {
+        for (Size j=0; j<blockSize; ++j) {
+            const Real expected = pricer(block.path(j));
+            if (std::fabs(calculated[j] - expected) > 1e-12)
+                BOOST_ERROR("failed to reproduce single " << tag
+                            << " path price:"
+                            << "\n    path:       " << j
+                            << "\n    calculated: " << calculated[j]
+                            << "\n    expected:   " << expected);
+        }
+    };
+
+    for (auto type : { Option::Call, Option::Put }) {
+        check("European",
+              EuropeanBlockPathPricer(type, 100.0, discounts.back())(block),
+              EuropeanPathPricer(type, 100.0, discounts.back()));
+        check("Asian",
+              ArithmeticAPOBlockPathPricer(type, 100.0,
+                                           discounts.back())(block),
+              ArithmeticAPOPathPricer(type, 100.0, discounts.back()));
+
+        for (auto barrierType : { Barrier::DownIn, Barrier::UpIn,
+                                  Barrier::DownOut, Barrier::UpOut }) {
+            const Real barrier =
+                (barrierType == Barrier::DownIn ||
+                 barrierType == Barrier::DownOut) ? 95.0 : 105.0;
+            check("barrier",
+                  BiasedBarrierBlockPathPricer(barrierType, barrier, 3.0,
+                                               type, 100.0,
+                                               discounts)(block),
+                  BiasedBarrierPathPricer(barrierType, barrier, 3.0,
+                                          type, 100.0, discounts));
+        }
+    }
+
+    Matrix correlation(2, 2, 0.5);
+    correlation[0][0] = correlation[1][1] = 1.0;
+    const auto processes = std::make_shared<StochasticProcessArray>(
+        std::vector<std::shared_ptr<StochasticProcess1D> >(2, process),
+        correlation);
+    MultiPathBlockGenerator<rsg_type> multiGenerator(
+        processes, grid,
+        PseudoRandom::make_sequence_generator(2*(grid.size()-1), 42),
+        blockSize);
+    const MultiPathBlock& multiBlock = multiGenerator.next();
+
+    const auto payoff = std::make_shared<AverageBasketPayoff>(
+        std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0), 2);
+    const Array calculated = EuropeanMultiPathBlockPricer(
+        payoff, discounts.back())(multiBlock);
+    const EuropeanMultiPathPricer pricer(payoff, discounts.back());
+    for (Size j=0; j<blockSize; ++j) {
+        const Real expected = pricer(multiBlock.multiPath(j));
+        if (std::fabs(calculated[j] - expected) > 1e-12)
+            BOOST_ERROR("failed to reproduce single basket path price:"
+                        << "\n    path:       " << j
+                        << "\n    calculated: " << calculated[j]
+                        << "\n    expected:   " << expected);
+    }
+}
+
+
+void PathGeneratorTest::testStepEvolution() {
+
+    BOOST_TEST_MESSAGE("Testing precomputed step evolution "
+                       "of stochastic processes...");
+
+    SavedSettings backup;
+
+    const Date today(26,April,2005);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<Quote> x0(std::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    std::vector<Time> times = { 0.1, 0.25, 0.5, 1.0, 1.75, 3.0 };
+    const TimeGrid grid(times.begin(), times.end(), 10);
+    const Size steps = grid.size()-1;
+
+    const auto tolerance = [](Real x) {
+        return 1e-12*std::max(1.0, std::fabs(x));
+    };
+
+    const auto bsProcess =
+        std::make_shared<BlackScholesMertonProcess>(x0,q,r,sigma);
+    Array drift, diffusion;
+    if (!bsProcess->stepCoefficients(grid, drift, diffusion))
+        BOOST_FAIL("step coefficients expected for Black-Scholes process");
+
+    PseudoRandom::rng_type rng(PseudoRandom::urng_type(42));
+    Real x = x0->value();
+    for (Size i=0; i<steps; ++i) {
+        const Real dw = rng.next().value;
+        const Real expected = bsProcess->evolve(grid[i], x, grid.dt(i), dw);
+        const Real calculated =
+            bsProcess->apply(x, diffusion[i]*dw + drift[i]);
+        if (std::fabs(calculated - expected) > tolerance(expected))
+            BOOST_ERROR("failed to reproduce Black-Scholes evolution:"
+                        << "\n    step:       " << i
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+        x = expected;
+    }
+
+    const HestonProcess::Discretization discretizations[] = {
+        HestonProcess::PartialTruncation, HestonProcess::FullTruncation,
+        HestonProcess::Reflection, HestonProcess::QuadraticExponential,
+        HestonProcess::QuadraticExponentialMartingale };
+
+    for (auto discretization : discretizations) {
+        const auto process = std::make_shared<HestonProcess>(
+            r, q, x0, 0.04, 1.5, 0.04, 0.5, -0.7, discretization);
+        const auto evolver = process->stepEvolver(grid);
+        BOOST_REQUIRE(evolver);
+
+        Array x = process->initialValues(), dw(2);
+        for (Size i=0; i<steps; ++i) {
+            dw[0] = rng.next().value;
+            dw[1] = rng.next().value;
+            const Array expected = process->evolve(grid[i], x, grid.dt(i), dw);
+            const Array calculated = evolver->evolve(i, x, dw);
+            for (Size k=0; k<2; ++k)
+                if (std::fabs(calculated[k] - expected[k])
+                        > tolerance(expected[k]))
+                    BOOST_ERROR("failed to reproduce Heston evolution:"
+                                << "\n    discretization: "
+                                << Integer(discretization)
+                                << "\n    step:           " << i
+                                << "\n    component:      " << k
+                                << "\n    calculated:     " << calculated[k]
+                                << "\n    expected:       " << expected[k]);
+            x = expected;
+        }
+    }
+
+    Matrix correlation(2, 2, 0.3);
+    correlation[0][0] = correlation[1][1] = 1.0;
+    const auto processes = std::make_shared<StochasticProcessArray>(
+        std::vector<std::shared_ptr<StochasticProcess1D> >{
+            bsProcess,
+            std::make_shared<OrnsteinUhlenbeckProcess>(0.1, 0.20) },
+        correlation);
+    const auto evolver = processes->stepEvolver(grid);
+    BOOST_REQUIRE(evolver);
+
+    Array y = processes->initialValues(), dw(2);
+    for (Size i=0; i<steps; ++i) {
+        dw[0] = rng.next().value;
+        dw[1] = rng.next().value;
+        const Array expected = processes->evolve(grid[i], y, grid.dt(i), dw);
+        const Array calculated = evolver->evolve(i, y, dw);
+        for (Size k=0; k<2; ++k)
+            if (std::fabs(calculated[k] - expected[k])
+                    > tolerance(expected[k]))
+                BOOST_ERROR("failed to reproduce process array evolution:"
+                            << "\n    step:       " << i
+                            << "\n    component:  " << k
+                            << "\n    calculated: " << calculated[k]
+                            << "\n    expected:   " << expected[k]);
+        y = expected;
+    }
+}
+
+
+void PathGeneratorTest::benchmarkBlockGeneration() {
+
+    BOOST_TEST_MESSAGE("Benchmarking block against single multi-path "
+                       "generation...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(std::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    const Size assets = 5, steps = 50, samples = 32768, blockSize = 256;
+    const TimeGrid grid(1.0, steps);
+    const Size dimension = assets*steps;
+
+    Matrix correlation(assets, assets, 0.5);
+    for (Size k=0; k<assets; ++k)
+        correlation[k][k] = 1.0;
+    const auto processes = std::make_shared<StochasticProcessArray>(
+        std::vector<std::shared_ptr<StochasticProcess1D> >(
+            assets, std::make_shared<BlackScholesMertonProcess>(x0,q,r,sigma)),
+        correlation);
+
+    const auto payoff = std::make_shared<AverageBasketPayoff>(
+        std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0), assets);
+    const DiscountFactor discount = r->discount(1.0);
+    const EuropeanMultiPathPricer pricer(payoff, discount);
+    const EuropeanMultiPathBlockPricer blockPricer(payoff, discount);
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    MultiPathGenerator<rsg_type> generator(
+        processes, grid,
+        PseudoRandom::make_sequence_generator(dimension, 42));
+    Real singlePrice = 0.0;
+    const Real singleTime = elapsedSeconds([&]() {
+        for (Size j=0; j<samples; ++j)
+            singlePrice += pricer(generator.next().value);
+    });
+    singlePrice /= samples;
+
+    MultiPathBlockGenerator<rsg_type> blockGenerator(
+        processes, grid,
+        PseudoRandom::make_sequence_generator(dimension, 42), blockSize);
+    Real blockPrice = 0.0;
+    const Real blockTime = elapsedSeconds([&]() {
+        for (Size b=0; b<samples/blockSize; ++b) {
+            const Array prices = blockPricer(blockGenerator.next());
+            blockPrice += std::accumulate(prices.begin(), prices.end(), 0.0);
+        }
+    });
+    blockPrice /= samples;
+
+    typedef LowDiscrepancy::rsg_type ld_rsg_type;
+    MultiPathBlockGenerator<ld_rsg_type> sobolGenerator(
+        processes, grid,
+        LowDiscrepancy::make_sequence_generator(dimension, 42), blockSize,
+        true);
+    Real sobolPrice = 0.0;
+    const Real sobolTime = elapsedSeconds([&]() {
+        for (Size b=0; b<samples/blockSize; ++b) {
+            const Array prices = blockPricer(sobolGenerator.next());
+            sobolPrice += std::accumulate(prices.begin(), prices.end(), 0.0);
+        }
+    });
+    sobolPrice /= samples;
+
+    BOOST_TEST_MESSAGE("    " << samples << " paths, " << assets
+                       << " assets, " << steps << " steps"
+                       << "\n    single paths:            " << singleTime
+                       << " s, price " << singlePrice
+                       << "\n    blocks:                  " << blockTime
+                       << " s, price " << blockPrice
+                       << "\n    Sobol and bridge blocks: " << sobolTime
+                       << " s, price " << sobolPrice);
+
+    if (std::fabs(singlePrice - blockPrice) > 1e-10*singlePrice)
+        BOOST_ERROR("block and single paths give different prices"
+                    << "\n    single: " << singlePrice
+                    << "\n    block:  " << blockPrice);
+    if (std::fabs(sobolPrice - singlePrice) > 0.02*singlePrice)
+        BOOST_ERROR("Sobol and pseudo-random paths give different prices"
+                    << "\n    pseudo-random: " << singlePrice
+                    << "\n    Sobol:         " << sobolPrice);
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathBlockGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testBlockPathPricers));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testStepEvolution));
     return suite;
 }
 
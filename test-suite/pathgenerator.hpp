@@ -29,6 +29,12 @@ class PathGeneratorTest {
   public:
     static void testPathGenerator();
     static void testMultiPathGenerator();
+    static void testPathBlockGenerator();
+    static void testBlockPathPricers();
+    static void testStepEvolution();
+
+    static void benchmarkBlockGeneration();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -27,6 +27,8 @@
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/instruments/forwardrateagreement.hpp>
 #include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/swaption.hpp>
+#include <ql/instruments/vanillaoption.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
 #include <ql/math/interpolations/convexmonotoneinterpolation.hpp>
@@ -34,8 +36,12 @@
 #include <ql/math/interpolations/forwardflatinterpolation.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/math/optimization/jacobianlevenbergmarquardt.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/pricingengines/swaption/blackswaptionengine.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
@@ -52,6 +58,7 @@
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/imm.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <functional>
 #include <iomanip>
 #include <map>
 #include <string>
@@ -1341,6 +1348,20 @@ void PiecewiseYieldCurveTest::testGlobalBootstrap() {
         QL_CHECK_SMALL(std::fabs(refZeroRate[i] - curve->zeroRate(refDate[i], Actual360(), Continuous).rate()),
                           1E-6);
     }
+
+    // same curve using a user-supplied optimizer
+    std::shared_ptr<Curve> curve2 = std::make_shared<Curve>(
+        2, TARGET(), helpers, Actual365Fixed(), std::vector<Handle<Quote> >(), std::vector<Date>(),
+        Linear(),
+        Curve::bootstrap_type(additionalHelpers, additionalDates(),
+                              additionalErrors(additionalHelpers), 1.0e-12,
+                              std::make_shared<JacobianLevenbergMarquardt>(1.0e-12, 1.0e-12, 1.0e-12)));
+    curve2->enableExtrapolation();
+
+    for (Size i = 0; i < LENGTH(refZeroRate); ++i) {
+        QL_CHECK_SMALL(std::fabs(refZeroRate[i] - curve2->zeroRate(refDate[i], Actual360(), Continuous).rate()),
+                          1E-6);
+    }
 }
 
 /* This test attempts to build an ARS collateralised in USD curve as of 25 Sep 2019. Using the default 
@@ -1452,6 +1473,276 @@ void PiecewiseYieldCurveTest::testIterativeBootstrapRetries() {
     QL_CHECK_SMALL(calcFwd - expFwd, 1e-10);
 }
 
+namespace piecewise_yield_curve_test {
+
+    // instruments priced on a curve along with the adjoints of their
+    // engines; each one reads the curve in a different way
+    struct AdjointPortfolio {
+        std::vector<std::shared_ptr<Instrument> > instruments;
+        std::vector<std::function<void(Real, DiscountAdjoints&)> > adjoints;
+        std::vector<std::string> names;
+
+        AdjointPortfolio(const CommonVars& vars,
+                         const Handle<YieldTermStructure>& curveHandle) {
+            std::shared_ptr<IborIndex> euribor6m =
+                std::make_shared<Euribor6M>(curveHandle);
+
+            auto swapEngine = std::make_shared<DiscountingSwapEngine>(curveHandle);
+            std::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(7*Years, euribor6m, 0.052, 6*Months)
+                .withType(Swap::Receiver)
+                .withNominal(2000000.0)
+                .withPricingEngine(swapEngine);
+            add(swap, "forward-starting swap", [swapEngine, swap](Real a, DiscountAdjoints& r) {
+                swapEngine->npvAdjoint(*swap, a, r);
+            });
+
+            auto bondEngine = std::make_shared<DiscountingBondEngine>(curveHandle);
+            Schedule schedule(vars.settlement, vars.settlement + 8*Years,
+                              Period(Annual), vars.calendar,
+                              vars.bondConvention, vars.bondConvention,
+                              DateGeneration::Backward, false);
+            auto bond = std::make_shared<FixedRateBond>(
+                vars.bondSettlementDays, 1000000.0, schedule,
+                std::vector<Rate>(1, 0.045), vars.bondDayCounter,
+                vars.bondConvention);
+            bond->setPricingEngine(bondEngine);
+            add(bond, "fixed-rate bond", [bondEngine, bond](Real a, DiscountAdjoints& r) {
+                bondEngine->npvAdjoint(*bond, a, r);
+            });
+
+            auto process = std::make_shared<BlackScholesMertonProcess>(
+                Handle<Quote>(std::make_shared<SimpleQuote>(100.0)),
+                Handle<YieldTermStructure>(flatRate(vars.today, 0.02, Actual365Fixed())),
+                curveHandle,
+                Handle<BlackVolTermStructure>(flatVol(vars.today, 0.20, Actual365Fixed())));
+            auto optionEngine = std::make_shared<AnalyticEuropeanEngine>(process);
+            auto option = std::make_shared<VanillaOption>(
+                std::make_shared<PlainVanillaPayoff>(Option::Call, 105.0),
+                std::make_shared<EuropeanExercise>(vars.today + 5*Years));
+            option->setPricingEngine(optionEngine);
+            add(option, "European option", [optionEngine, option](Real a, DiscountAdjoints& r) {
+                optionEngine->npvAdjoint(*option, a, r);
+            });
+
+            auto swaptionEngine =
+                std::make_shared<BlackSwaptionEngine>(curveHandle, 0.20);
+            std::shared_ptr<VanillaSwap> underlying =
+                MakeVanillaSwap(5*Years, euribor6m, 0.05, 2*Years)
+                .withNominal(1000000.0);
+            auto swaption = std::make_shared<Swaption>(
+                underlying, std::make_shared<EuropeanExercise>(
+                    euribor6m->fixingDate(underlying->startDate())));
+            swaption->setPricingEngine(swaptionEngine);
+            add(swaption, "swaption", [swaptionEngine, swaption](Real a, DiscountAdjoints& r) {
+                swaptionEngine->npvAdjoint(*swaption, a, r);
+            });
+        }
+
+        void add(const std::shared_ptr<Instrument>& instrument,
+                 const std::string& name,
+                 const std::function<void(Real, DiscountAdjoints&)>& adjoint) {
+            instruments.push_back(instrument);
+            names.push_back(name);
+            adjoints.push_back(adjoint);
+        }
+
+        Real NPV() const {
+            Real sum = 0.0;
+            for (const auto& i : instruments)
+                sum += i->NPV();
+            return sum;
+        }
+    };
+
+    // the helper quotes in the order of the pillars
+    std::vector<std::shared_ptr<SimpleQuote> >
+    sortedQuotes(std::vector<std::shared_ptr<RateHelper> > helpers) {
+        std::sort(helpers.begin(), helpers.end(),
+                  detail::BootstrapHelperSorter());
+        std::vector<std::shared_ptr<SimpleQuote> > quotes;
+        for (const auto& h : helpers)
+            quotes.push_back(
+                std::dynamic_pointer_cast<SimpleQuote>(h->quote().currentLink()));
+        return quotes;
+    }
+
+    template <class T, class I>
+    void checkQuoteSensitivities(const std::string& curveName,
+                                 const std::vector<std::shared_ptr<RateHelper> >& helpers,
+                                 const CommonVars& vars,
+                                 Real shift) {
+
+        std::shared_ptr<PiecewiseYieldCurve<T,I> > curve =
+            std::make_shared<PiecewiseYieldCurve<T,I> >(vars.settlement,
+                                                       helpers,
+                                                       Actual360());
+        curve->enableExtrapolation();
+        Handle<YieldTermStructure> curveHandle(curve);
+        AdjointPortfolio portfolio(vars, curveHandle);
+        const std::vector<std::shared_ptr<SimpleQuote> > quotes =
+            sortedQuotes(helpers);
+        const Size n = quotes.size();
+        const Size m = portfolio.instruments.size();
+
+        // one reverse sweep per instrument, and one for the portfolio
+        std::vector<std::vector<Real> > sensitivities(m+1);
+        DiscountAdjoints total;
+        for (Size k=0; k<m; ++k) {
+            DiscountAdjoints adjoints;
+            portfolio.adjoints[k](1.0, adjoints);
+            portfolio.adjoints[k](1.0, total);
+            sensitivities[k] = curve->quoteSensitivities(adjoints);
+        }
+        sensitivities[m] = curve->quoteSensitivities(total);
+
+        if (sensitivities[m].size() != n)
+            BOOST_FAIL(curveName << ": " << sensitivities[m].size()
+                       << " sensitivities returned for "
+                       << n << " quotes");
+
+        // central differences on the quotes, re-bootstrapping the curve
+        std::vector<std::vector<Real> > expected(m+1, std::vector<Real>(n));
+        for (Size i=0; i<n; ++i) {
+            const Real q = quotes[i]->value();
+            std::vector<Real> up(m), down(m);
+            quotes[i]->setValue(q+shift);
+            for (Size k=0; k<m; ++k)
+                up[k] = portfolio.instruments[k]->NPV();
+            quotes[i]->setValue(q-shift);
+            for (Size k=0; k<m; ++k)
+                down[k] = portfolio.instruments[k]->NPV();
+            quotes[i]->setValue(q);
+            expected[m][i] = 0.0;
+            for (Size k=0; k<m; ++k) {
+                expected[k][i] = (up[k]-down[k])/(2.0*shift);
+                expected[m][i] += expected[k][i];
+            }
+        }
+
+        // relative to the largest sensitivity of each instrument, as
+        // some quotes don't affect it at all
+        const Real tolerance = 1.0e-6;
+        for (Size k=0; k<=m; ++k) {
+            Real scale = 0.0;
+            for (Size i=0; i<n; ++i)
+                scale = std::max(scale, std::fabs(expected[k][i]));
+            for (Size i=0; i<n; ++i) {
+                Real error = std::fabs(sensitivities[k][i]-expected[k][i]);
+                if (error > tolerance*scale)
+                    BOOST_ERROR(curveName << ", "
+                                << (k < m ? portfolio.names[k] : std::string("portfolio"))
+                                << ": sensitivity mismatch for quote " << i
+                                << std::setprecision(10)
+                                << "\n    adjoint:          " << sensitivities[k][i]
+                                << "\n    re-bootstrap:     " << expected[k][i]
+                                << "\n    relative error:   " << error/scale
+                                << "\n    tolerance:        " << tolerance);
+            }
+        }
+    }
+
+    template <class T, class I>
+    void checkQuoteSensitivities(const std::string& curveName) {
+        CommonVars vars;
+        checkQuoteSensitivities<T,I>(curveName + " on deposits and swaps",
+                                     vars.instruments, vars, 1.0e-5);
+        checkQuoteSensitivities<T,I>(curveName + " on FRAs",
+                                     vars.fraHelpers, vars, 1.0e-5);
+        checkQuoteSensitivities<T,I>(curveName + " on bonds",
+                                     vars.bondHelpers, vars, 1.0e-3);
+    }
+
+}
+
+void PiecewiseYieldCurveTest::testQuoteSensitivities() {
+
+    BOOST_TEST_MESSAGE("Testing adjoint quote sensitivities of piecewise yield curves...");
+
+    using namespace piecewise_yield_curve_test;
+
+    checkQuoteSensitivities<Discount,LogLinear>("log-linear discount");
+    checkQuoteSensitivities<ZeroYield,Linear>("linear zero");
+    checkQuoteSensitivities<ForwardRate,BackwardFlat>("flat forward");
+}
+
+void PiecewiseYieldCurveTest::benchmarkQuoteSensitivities() {
+
+    BOOST_TEST_MESSAGE("Benchmarking adjoint quote sensitivities against "
+                       "bump-and-reprice...");
+
+    using namespace piecewise_yield_curve_test;
+
+    CommonVars vars;
+
+    auto curve = std::make_shared<PiecewiseYieldCurve<Discount,LogLinear> >(
+                                    vars.settlement, vars.instruments, Actual360());
+    Handle<YieldTermStructure> curveHandle(curve);
+    auto euribor6m = std::make_shared<Euribor6M>(curveHandle);
+    auto engine = std::make_shared<DiscountingSwapEngine>(curveHandle);
+
+    std::vector<std::shared_ptr<VanillaSwap> > portfolio;
+    for (Integer length=1; length<=20; ++length) {
+        for (Integer start=0; start<5; ++start) {
+            portfolio.push_back(
+                MakeVanillaSwap(length*Years, euribor6m, 0.04 + 0.002*start,
+                                start*Years)
+                .withNominal(1000000.0)
+                .withPricingEngine(engine));
+        }
+    }
+    auto npv = [&portfolio]() {
+        Real sum = 0.0;
+        for (const auto& swap : portfolio)
+            sum += swap->NPV();
+        return sum;
+    };
+    npv();
+
+    const std::vector<std::shared_ptr<SimpleQuote> > quotes =
+        sortedQuotes(vars.instruments);
+    const Size n = quotes.size();
+
+    const Size runs = 20;
+    std::vector<Real> adjoint;
+    const Real adjointTime = elapsedSeconds([&]() {
+        for (Size k=0; k<runs; ++k) {
+            DiscountAdjoints adjoints;
+            for (const auto& swap : portfolio)
+                engine->npvAdjoint(*swap, 1.0, adjoints);
+            adjoint = curve->quoteSensitivities(adjoints);
+        }
+    }) / runs;
+
+    const Real shift = 1.0e-5;
+    std::vector<Real> bumped(n);
+    const Real bumpTime = elapsedSeconds([&]() {
+        for (Size i=0; i<n; ++i) {
+            const Real q = quotes[i]->value();
+            quotes[i]->setValue(q+shift);
+            const Real up = npv();
+            quotes[i]->setValue(q-shift);
+            const Real down = npv();
+            quotes[i]->setValue(q);
+            bumped[i] = (up-down)/(2.0*shift);
+        }
+    });
+    npv();
+
+    Real scale = 0.0, error = 0.0;
+    for (Size i=0; i<n; ++i) {
+        scale = std::max(scale, std::fabs(bumped[i]));
+        error = std::max(error, std::fabs(adjoint[i]-bumped[i]));
+    }
+
+    BOOST_TEST_MESSAGE("    " << portfolio.size() << " swaps, " << n << " quotes"
+                       << "\n        adjoint:          " << adjointTime*1000.0 << " ms"
+                       << "\n        bump and reprice: " << bumpTime*1000.0 << " ms"
+                       << "\n        cost ratio:       " << bumpTime/adjointTime
+                       << "\n        max difference:   " << error/scale
+                       << " of the largest sensitivity");
+}
+
 test_suite* PiecewiseYieldCurveTest::suite() {
 
     auto* suite = BOOST_TEST_SUITE("Piecewise yield curve tests");
@@ -1496,5 +1787,7 @@ test_suite* PiecewiseYieldCurveTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testIterativeBootstrapRetries));
 
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testQuoteSensitivities));
+
     return suite;
 }
@@ -60,6 +60,10 @@ class PiecewiseYieldCurveTest {
 
     static void testIterativeBootstrapRetries();
 
+    static void testQuoteSensitivities();
+
+    static void benchmarkQuoteSensitivities();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
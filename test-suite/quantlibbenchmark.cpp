@@ -130,6 +130,11 @@
 #include "jumpdiffusion.hpp"
 #include "marketmodel_smm.hpp"
 #include "marketmodel_cms.hpp"
+#include "matrices.hpp"
+#include "mclongstaffschwartzengine.hpp"
+#include "optimizers.hpp"
+#include "pathgenerator.hpp"
+#include "piecewiseyieldcurve.hpp"
 #include "lowdiscrepancysequences.hpp"
 #include "quantooption.hpp"
 #include "riskstats.hpp"
@@ -205,7 +210,10 @@ namespace {
         TimedCase f_;
         const std::string name_;
         const double mflop_; // total number of mega floating
-                             // point operations (not per sec!)
+                             // point operations (not per sec!);
+                             // zero for cases only timed, which
+                             // report their own comparisons and
+                             // are not part of the index
     };
 
     std::list<Benchmark> bm;
@@ -221,25 +229,29 @@ namespace {
                   << std::endl << std::endl;
 
         double sum=0;
+        std::size_t n=0;
         std::list<double>::const_iterator iterT = runTimes.begin();
         std::list<Benchmark>::const_iterator iterBM = bm.begin();
 
         while (iterT != runTimes.end()) {
-            const double mflopsPerSec = iterBM->getMflop()/(*iterT);
             std::cout << iterBM->getName()
                       << std::string(42-iterBM->getName().length(),' ') << ":"
-                      << std::fixed << std::setw(6) << std::setprecision(1)
-                      << mflopsPerSec
-                      << " mflops" << std::endl;
-
-            sum+=mflopsPerSec;
+                      << std::fixed << std::setw(6) << std::setprecision(1);
+            if (iterBM->getMflop() > 0.0) {
+                const double mflopsPerSec = iterBM->getMflop()/(*iterT);
+                std::cout << mflopsPerSec << " mflops" << std::endl;
+                sum+=mflopsPerSec;
+                ++n;
+            } else {
+                std::cout << *iterT << " s" << std::endl;
+            }
             ++iterT;
             ++iterBM;
         }
         std::cout << std::string(56,'-') << std::endl
                   << "QuantLib Benchmark Index                  :"
                   << std::fixed << std::setw(6) << std::setprecision(1)
-                  << sum/runTimes.size()
+                  << sum/n
                   << " mflops" << std::endl;
     }
 }
@@ -250,6 +262,8 @@ test_suite* init_unit_test_suite(int, char*[]) {
     bm.emplace_back("AsianOption::MCArithmeticAveragePrice",
                     &AsianOptionTest::testMCDiscreteArithmeticAveragePrice, 5186.13);
     bm.emplace_back("BarrierOption::BabsiriValues", &BarrierOptionTest::testBabsiriValues, 880.8);
+    bm.emplace_back("BarrierOption::MultilevelMonteCarlo",
+                    &BarrierOptionTest::benchmarkMultilevelMonteCarlo, 0.0);
     bm.emplace_back("BasketOption::EuroTwoValues", &BasketOptionTest::testEuroTwoValues, 340.04);
     bm.emplace_back("BasketOption::TavellaValues", &BasketOptionTest::testTavellaValues, 933.80);
     bm.emplace_back("BasketOption::OddSamples", &BasketOptionTest::testOddSamples, 642.46);
@@ -265,7 +279,15 @@ test_suite* init_unit_test_suite(int, char*[]) {
     bm.emplace_back("EuropeanOption::FdEngines", &EuropeanOptionTest::testFdEngines, 148.43);
     bm.emplace_back("FdHestonTest::testFdmHestonAmerican", &FdHestonTest::testFdmHestonAmerican,
                     234.21);
+    bm.emplace_back("HestonModel::AnalyticJacobian",
+                    &HestonModelTest::benchmarkAnalyticJacobian, 0.0);
+    bm.emplace_back("HestonModel::BatchPricing",
+                    &HestonModelTest::benchmarkBatchPricing, 0.0);
     bm.emplace_back("HestonModel::DAXCalibration", &HestonModelTest::testDAXCalibration, 555.19);
+    bm.emplace_back("HestonModel::FourierSurfacePricer",
+                    &HestonModelTest::benchmarkFourierSurfacePricer, 0.0);
+    bm.emplace_back("HestonModel::MultilevelMonteCarlo",
+                    &HestonModelTest::benchmarkMultilevelMonteCarlo, 0.0);
     bm.emplace_back("InterpolationTest::testSabrInterpolation",
                     &InterpolationTest::testSabrInterpolation, 2266.06);
     bm.emplace_back("JumpDiffusion::Greeks", &JumpDiffusionTest::testGreeks, 433.77);
@@ -273,9 +295,25 @@ test_suite* init_unit_test_suite(int, char*[]) {
                     &MarketModelCmsTest::testMultiStepCmSwapsAndSwaptions, 11497.73);
     bm.emplace_back("MarketModelSmmTest::testMultiSmmSwaptions",
                     &MarketModelSmmTest::testMultiStepCoterminalSwapsAndSwaptions, 11244.95);
+    bm.emplace_back("Matrices::SparseMatrixProducts",
+                    &MatricesTest::benchmarkSparseMatrixProducts, 0.0);
+    bm.emplace_back("MCLongstaffSchwartzEngine::BermudanCalibration",
+                    &MCLongstaffSchwartzEngineTest::benchmarkBermudanCalibration, 0.0);
+    bm.emplace_back("MCLongstaffSchwartzEngine::PolynomialBasis",
+                    &MCLongstaffSchwartzEngineTest::benchmarkPolynomialBasis, 0.0);
+    bm.emplace_back("Optimizers::DifferentialEvolution",
+                    &OptimizersTest::benchmarkDifferentialEvolution, 0.0);
+    bm.emplace_back("Optimizers::JacobianLevenbergMarquardt",
+                    &OptimizersTest::benchmarkJacobianLevenbergMarquardt, 0.0);
+    bm.emplace_back("PathGenerator::BlockGeneration",
+                    &PathGeneratorTest::benchmarkBlockGeneration, 0.0);
+    bm.emplace_back("PiecewiseYieldCurve::QuoteSensitivities",
+                    &PiecewiseYieldCurveTest::benchmarkQuoteSensitivities, 0.0);
     bm.emplace_back("QuantoOption::ForwardGreeks", &QuantoOptionTest::testForwardGreeks, 90.98);
     bm.emplace_back("RandomNumber::MersenneTwisterDescrepancy",
                     &LowDiscrepancyTest::testMersenneTwisterDiscrepancy, 951.98);
+    bm.emplace_back("RandomNumber::SobolBulkGeneration",
+                    &LowDiscrepancyTest::benchmarkSobolBulkGeneration, 0.0);
     bm.emplace_back("RiskStatistics::Results", &RiskStatisticsTest::testResults, 300.28);
     bm.emplace_back("ShortRateModel::Swaps", &ShortRateModelTest::testSwaps, 454.73);
 
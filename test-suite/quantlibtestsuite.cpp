@@ -174,6 +174,7 @@
 #include "rounding.hpp"
 #include "sampledcurve.hpp"
 #include "schedule.hpp"
+#include "sensitivityanalysis.hpp"
 #include "settings.hpp"
 #include "shortratemodels.hpp"
 #include "sofrfutures.hpp"
@@ -516,6 +517,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(PartialTimeBarrierOptionTest::suite());
     test->add(QuantoOptionTest::experimental());
     test->add(RiskNeutralDensityCalculatorTest::experimental(speed));
+    test->add(SensitivityAnalysisTest::suite());
     test->add(SpreadOptionTest::suite());
     test->add(SquareRootCLVModelTest::experimental());
     test->add(SviVolatilityTest::experimental());
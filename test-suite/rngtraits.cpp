@@ -22,6 +22,8 @@
 #include "utilities.hpp"
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/randomnumbers/ranluxuniformrng.hpp>
+#include <ql/math/randomnumbers/haltonrsg.hpp>
+#include <ql/math/randomnumbers/sobolbrownianbridgersg.hpp>
 #include <ql/math/comparison.hpp>
 
 using namespace QuantLib;
@@ -126,12 +128,193 @@ void RngTraitsTest::testRanLux() {
     }
 }
 
+void RngTraitsTest::testCounterBasedRngs() {
+    BOOST_TEST_MESSAGE("Testing counter-based random number generators...");
+
+    // known-answer tests of the reference implementation
+    typedef Philox4x32::counter_type counter_type;
+
+    const counter_type philoxZeros =
+        Philox4x32::apply({0U, 0U, 0U, 0U}, {0U, 0U});
+    const counter_type philoxPi =
+        Philox4x32::apply({0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U},
+                          {0xa4093822U, 0x299f31d0U});
+    const counter_type threefryZeros =
+        Threefry4x32::apply({0U, 0U, 0U, 0U}, {0U, 0U, 0U, 0U});
+    const counter_type threefryPi =
+        Threefry4x32::apply({0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U},
+                            {0xa4093822U, 0x299f31d0U, 0x082efa98U, 0xec4e6c89U});
+
+    if (philoxZeros != counter_type{0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U}
+        || philoxPi != counter_type{0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U})
+        BOOST_FAIL("failed to reproduce Philox-4x32-10 known answers");
+
+    if (threefryZeros != counter_type{0x9c6ca96aU, 0xe17eae66U, 0xfc10ecd4U, 0x5256a7d8U}
+        || threefryPi != counter_type{0x59cd1dbbU, 0xb8879579U, 0x86b5d00cU, 0xac8b6d84U})
+        BOOST_FAIL("failed to reproduce Threefry-4x32-20 known answers");
+
+    const unsigned long seed = 42UL;
+    const Size n = 1003;
+
+    Philox4x32UniformRng rng(seed);
+    std::vector<Real> sequential(n);
+    for (Size i=0; i < n; ++i)
+        sequential[i] = rng.nextReal();
+
+    // skip-ahead and discard
+    for (Size k : {0, 1, 5, 8, 517, 1002}) {
+        Philox4x32UniformRng skipped(seed);
+        skipped.skipTo(k);
+        if (skipped.nextReal() != sequential[k])
+            BOOST_FAIL("skipTo(" << k << ") does not reproduce the sequence");
+
+        Philox4x32UniformRng discarded(seed);
+        discarded.nextReal();
+        discarded.discard(k);
+        if (k+1 < n && discarded.nextReal() != sequential[k+1])
+            BOOST_FAIL("discard(" << k << ") does not reproduce the sequence");
+    }
+
+    // bulk generation, also starting within a block
+    Philox4x32UniformRng bulk(seed);
+    std::vector<Real> bulkValues(n);
+    bulk.nextReals(bulkValues.begin(), bulkValues.begin() + 3);
+    bulk.nextReals(bulkValues.begin() + 3, bulkValues.end());
+    if (bulkValues != sequential || bulk.position() != n)
+        BOOST_FAIL("bulk generation does not reproduce the sequence");
+
+    // different streams
+    Philox4x32UniformRng other(seed, 1);
+    Size equal = 0;
+    for (Size i=0; i < n; ++i) {
+        const Real x = other.nextReal();
+        if (x <= 0.0 || x >= 1.0)
+            BOOST_FAIL("random number " << x << " out of (0, 1)");
+        if (x == sequential[i])
+            ++equal;
+    }
+    if (equal > 0)
+        BOOST_FAIL("streams 0 and 1 share " << equal << " numbers");
+
+    // sequence generator
+    PhiloxPseudoRandom::rsg_type rsg =
+        PhiloxPseudoRandom::make_sequence_generator(10, seed);
+    Philox4x32UniformRng reference(seed);
+    const std::vector<Real>& values = rsg.nextSequence().value;
+    InverseCumulativeNormal icn;
+    for (Size i=0; i < values.size(); ++i) {
+        const Real expected = icn(reference.nextReal());
+        if (!close_enough(values[i], expected))
+            BOOST_FAIL("failed to reproduce Gaussian sequence"
+                       << "\n    calculated: " << values[i]
+                       << "\n    expected:   " << expected);
+    }
+
+    // sequence generators for given streams
+    for (std::uint64_t stream : {std::uint64_t(1), std::uint64_t(1) << 40}) {
+        PhiloxPseudoRandom::rsg_type philoxRsg =
+            PhiloxPseudoRandom::make_sequence_generator(10, seed, stream);
+        ThreefryPseudoRandom::rsg_type threefryRsg =
+            ThreefryPseudoRandom::make_sequence_generator(10, seed, stream);
+        Philox4x32UniformRng philoxReference(seed, stream);
+        Threefry4x32UniformRng threefryReference(seed, stream);
+        const std::vector<Real> philoxValues = philoxRsg.nextSequence().value;
+        const std::vector<Real>& threefryValues =
+            threefryRsg.nextSequence().value;
+        for (Size i=0; i < 10; ++i) {
+            if (!close_enough(philoxValues[i],
+                              icn(philoxReference.nextReal()))
+                || !close_enough(threefryValues[i],
+                                 icn(threefryReference.nextReal())))
+                BOOST_FAIL("failed to reproduce Gaussian sequence "
+                           "of stream " << stream);
+        }
+        if (philoxValues == values)
+            BOOST_FAIL("stream " << stream << " reproduces stream 0");
+    }
+
+    Threefry4x32UniformRng threefry(seed), threefrySkipped(seed);
+    for (Size i=0; i < 9; ++i)
+        threefry.nextReal();
+    threefrySkipped.skipTo(9);
+    if (threefry.nextReal() != threefrySkipped.nextReal())
+        BOOST_FAIL("Threefry skipTo does not reproduce the sequence");
+}
+
+namespace {
+
+    template <class RSG>
+    void checkBlocks(const RSG& prototype, Size blocks, Size blockSize,
+                     const std::string& name) {
+        RSG sequential(prototype);
+        std::vector<std::vector<Real> > expected;
+        for (Size j=0; j < blocks*blockSize; ++j)
+            expected.push_back(sequential.nextSequence().value);
+
+        // draw the blocks in reverse order
+        for (Size i=blocks; i-- > 0;) {
+            RSG rsg = prototype.block(i, blockSize);
+            for (Size j=i*blockSize; j < (i+1)*blockSize; ++j) {
+                if (rsg.nextSequence().value != expected[j])
+                    BOOST_FAIL("failed to reproduce sequence " << j
+                               << " of " << name << " in block " << i);
+            }
+        }
+    }
+
+    template <class RSG>
+    void checkSkip(const RSG& prototype, Size n, const std::string& name) {
+        RSG sequential(prototype), skipped(prototype);
+        for (Size j=0; j < n; ++j)
+            sequential.nextSequence();
+        skipped.skipTo(n);
+        if (skipped.nextSequence().value != sequential.nextSequence().value)
+            BOOST_FAIL("skipTo(" << n << ") does not reproduce the "
+                       << name << " sequence");
+    }
+
+}
+
+void RngTraitsTest::testSequencePartitioning() {
+    BOOST_TEST_MESSAGE("Testing partitioning of random sequences...");
+
+    // long jumps of the Mersenne Twister
+    for (std::uint64_t n : {std::uint64_t(17), std::uint64_t(2000003)}) {
+        MersenneTwisterUniformRng sequential(42), jumped(42);
+        for (Size i=0; i < 700; ++i) {
+            sequential.nextInt32();
+            jumped.nextInt32();
+        }
+        for (std::uint64_t i=0; i < n; ++i)
+            sequential.nextInt32();
+        jumped.discard(n);
+        for (Size i=0; i < 1000; ++i) {
+            if (jumped.nextInt32() != sequential.nextInt32())
+                BOOST_FAIL("failed to jump ahead by " << n << " numbers");
+        }
+    }
+
+    const Size dimension = 10, blocks = 5, blockSize = 30000;
+
+    checkBlocks(PseudoRandom::make_sequence_generator(dimension, 1234),
+                blocks, blockSize, "Mersenne Twister");
+    checkBlocks(PhiloxPseudoRandom::make_sequence_generator(dimension, 1234),
+                blocks, blockSize, "Philox");
+    checkBlocks(LowDiscrepancy::make_sequence_generator(dimension, 1234),
+                blocks, blockSize, "Sobol");
+
+    checkSkip(HaltonRsg(dimension, 1234), 1001, "Halton");
+    checkSkip(SobolBrownianBridgeRsg(2, 5), 1001, "Sobol Brownian bridge");
+}
+
 test_suite* RngTraitsTest::suite() {
     auto* suite = BOOST_TEST_SUITE("RNG traits tests");
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testGaussian));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testDefaultPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCustomPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testRanLux));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCounterBasedRngs));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testSequencePartitioning));
     return suite;
 }
 
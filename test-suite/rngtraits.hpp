@@ -32,6 +32,8 @@ class RngTraitsTest {
     static void testDefaultPoisson();
     static void testCustomPoisson();
     static void testRanLux();
+    static void testCounterBasedRngs();
+    static void testSequencePartitioning();
     static boost::unit_test_framework::test_suite* suite();
 };
 
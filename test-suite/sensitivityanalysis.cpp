@@ -0,0 +1,458 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "sensitivityanalysis.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/risk/scenariorunner.hpp>
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <atomic>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+namespace sensitivity_analysis_test {
+
+    // counts its own valuations
+    class CountingOption : public VanillaOption {
+      public:
+        using VanillaOption::VanillaOption;
+        Size calculations() const { return calculations_; }
+        void resetCalculations() { calculations_ = 0; }
+      protected:
+        void performCalculations() const override {
+            ++calculations_;
+            VanillaOption::performCalculations();
+        }
+      private:
+        mutable std::atomic<Size> calculations_{0};
+    };
+
+    Size calculations(const std::shared_ptr<Instrument>& instrument) {
+        return std::dynamic_pointer_cast<CountingOption>(instrument)
+            ->calculations();
+    }
+
+    void resetCalculations(
+                const std::vector<std::shared_ptr<Instrument> >& instruments) {
+        for (const auto& i : instruments)
+            std::dynamic_pointer_cast<CountingOption>(i)->resetCalculations();
+    }
+
+    // whether the i-th instrument of the book depends on the k-th quote
+    bool depends(Size i, Size k) {
+        return k == 4 || i/2 == k/2;
+    }
+
+    /* options on two underlyings; the quotes are the spots and
+       volatilities of the underlyings and the common interest rate,
+       so that most quotes reach only part of the instruments */
+    SensitivityAnalysisSetup book(const Date& today) {
+        const DayCounter dc = Actual365Fixed();
+        const auto rate = std::make_shared<SimpleQuote>(0.03);
+        const Handle<YieldTermStructure> rTS(flatRate(today, rate, dc));
+
+        std::vector<Handle<SimpleQuote> > quotes;
+        std::vector<std::shared_ptr<PricingEngine> > engines;
+        const Real spots[] = { 100.0, 50.0 };
+        const Volatility vols[] = { 0.20, 0.35 };
+        for (Size i=0; i<2; ++i) {
+            const auto spot = std::make_shared<SimpleQuote>(spots[i]);
+            const auto vol = std::make_shared<SimpleQuote>(vols[i]);
+            quotes.emplace_back(spot);
+            quotes.emplace_back(vol);
+            engines.push_back(std::make_shared<AnalyticEuropeanEngine>(
+                std::make_shared<BlackScholesMertonProcess>(
+                    Handle<Quote>(spot),
+                    Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+                    rTS,
+                    Handle<BlackVolTermStructure>(
+                        flatVol(today, vol, dc)))));
+        }
+        quotes.emplace_back(rate);
+
+        struct OptionData {
+            Size underlying;
+            Option::Type type;
+            Real strike;
+            Period maturity;
+        };
+        const OptionData options[] = {
+            { 0, Option::Call,  95.0, 1*Years },
+            { 0, Option::Put,  105.0, 2*Years },
+            { 1, Option::Call,  55.0, 6*Months },
+            { 1, Option::Put,   45.0, 3*Years }
+        };
+
+        std::vector<std::shared_ptr<Instrument> > instruments;
+        for (const auto& o : options) {
+            const auto option = std::make_shared<CountingOption>(
+                std::make_shared<PlainVanillaPayoff>(o.type, o.strike),
+                std::make_shared<EuropeanExercise>(today + o.maturity));
+            option->setPricingEngine(engines[o.underlying]);
+            instruments.push_back(option);
+        }
+
+        return { quotes, instruments };
+    }
+
+    // first and second derivatives by full revaluation of the book
+    std::pair<Real, Real> bumpAndReprice(
+                const Handle<SimpleQuote>& quote,
+                const std::vector<std::shared_ptr<Instrument> >& instruments,
+                const std::vector<Real>& quantities,
+                Real shift,
+                SensitivityAnalysis type) {
+        const Real value = quote->value();
+        const Real npv = aggregateNPV(instruments, quantities);
+
+        quote->setValue(value + shift);
+        const Real up = aggregateNPV(instruments, quantities);
+        quote->setValue(value - shift);
+        const Real down = aggregateNPV(instruments, quantities);
+        quote->setValue(value);
+
+        if (type == OneSide)
+            return { (up - npv)/shift, Null<Real>() };
+        else
+            return { (up - down)/(2.0*shift),
+                     (up - 2.0*npv + down)/(shift*shift) };
+    }
+
+    void checkSensitivity(const std::string& method,
+                          SensitivityAnalysis type,
+                          Size quote,
+                          std::pair<Real, Real> calculated,
+                          std::pair<Real, Real> expected) {
+        // the full revaluation loses precision to cancellation
+        const Real firstTol = 1e-8, secondTol = 1e-4;
+        const bool firstOk = std::fabs(calculated.first - expected.first)
+            <= firstTol*(1.0 + std::fabs(expected.first));
+        const bool secondOk = (type == OneSide)
+            ? calculated.second == Null<Real>()
+            : std::fabs(calculated.second - expected.second)
+                  <= secondTol*(1.0 + std::fabs(expected.second));
+        if (!firstOk || !secondOk)
+            BOOST_ERROR("failed to reproduce full revaluation with "
+                        << method << " bucket analysis"
+                        << "\n    type:                  " << type
+                        << "\n    quote:                 " << quote
+                        << "\n    first derivative:      " << calculated.first
+                        << "\n    expected:              " << expected.first
+                        << "\n    second derivative:     " << calculated.second
+                        << "\n    expected:              " << expected.second);
+    }
+
+}
+
+void SensitivityAnalysisTest::testBucketAnalysis() {
+
+    BOOST_TEST_MESSAGE("Testing bucket analysis against "
+                       "full revaluation...");
+
+    using namespace sensitivity_analysis_test;
+
+    SavedSettings backup;
+
+    const Date today = Date(14, March, 2023);
+    Settings::instance().evaluationDate() = today;
+
+    const SensitivityAnalysisSetup setup = book(today);
+    const std::vector<Handle<SimpleQuote> >& quotes = setup.first;
+    const std::vector<std::shared_ptr<Instrument> >& instruments =
+        setup.second;
+    const std::vector<Real> quantities = { 1.0, -2.0, 3.0, 0.5 };
+    const Real shift = 1e-4;
+
+    // quotes tweaked separately but grouped in two buckets
+    const std::vector<std::vector<Handle<SimpleQuote> > > groupedQuotes = {
+        { quotes[0], quotes[1] },
+        { quotes[2], quotes[3], quotes[4] }
+    };
+
+    for (SensitivityAnalysis type : { OneSide, Centered }) {
+        const std::pair<std::vector<Real>, std::vector<Real> > results =
+            bucketAnalysis(quotes, instruments, quantities, shift, type);
+        const std::pair<std::vector<std::vector<Real> >,
+                        std::vector<std::vector<Real> > > groupedResults =
+            bucketAnalysis(groupedQuotes, instruments, quantities,
+                           shift, type);
+
+        Size k = 0;
+        for (Size i=0; i<groupedQuotes.size(); ++i) {
+            for (Size j=0; j<groupedQuotes[i].size(); ++j, ++k) {
+                const std::pair<Real, Real> expected = bumpAndReprice(
+                    quotes[k], instruments, quantities, shift, type);
+
+                checkSensitivity("vector", type, k,
+                                 { results.first[k], results.second[k] },
+                                 expected);
+                checkSensitivity("matrix", type, k,
+                                 { groupedResults.first[i][j],
+                                   groupedResults.second[i][j] },
+                                 expected);
+                checkSensitivity("single-quote", type, k,
+                                 bucketAnalysis(quotes[k], instruments,
+                                                quantities, shift, type),
+                                 expected);
+            }
+        }
+
+        // after a single tweak, only the instruments depending on
+        // the tweaked quote are valued again
+        const Size tweaks = (type == OneSide) ? 1 : 2;
+        for (Size k=0; k<quotes.size(); ++k) {
+            aggregateNPV(instruments, quantities);
+            resetCalculations(instruments);
+            bucketAnalysis(std::vector<Handle<SimpleQuote> >(1, quotes[k]),
+                           instruments, quantities, shift, type);
+            for (Size i=0; i<instruments.size(); ++i) {
+                const Size expected = depends(i, k) ? tweaks : 0;
+                if (calculations(instruments[i]) != expected)
+                    BOOST_ERROR("unexpected number of valuations"
+                                << "\n    type:       " << type
+                                << "\n    quote:      " << k
+                                << "\n    instrument: " << i
+                                << "\n    valuations: "
+                                << calculations(instruments[i])
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+}
+
+void SensitivityAnalysisTest::testParallelBucketAnalysis() {
+
+    BOOST_TEST_MESSAGE("Testing parallel bucket analysis against "
+                       "sequential bucket analysis...");
+
+    using namespace sensitivity_analysis_test;
+
+    SavedSettings backup;
+
+    const Date today = Date(14, March, 2023);
+    Settings::instance().evaluationDate() = today;
+
+    const std::vector<Real> quantities = { 1.0, -2.0, 3.0, 0.5 };
+    const Real shift = 1e-4;
+
+    for (SensitivityAnalysis type : { OneSide, Centered }) {
+        const SensitivityAnalysisSetup setup = book(today);
+        const std::pair<std::vector<Real>, std::vector<Real> > expected =
+            bucketAnalysis(setup.first, setup.second, quantities,
+                           shift, type);
+
+        for (Size workers : { 1, 2, 4 }) {
+            const std::pair<std::vector<Real>, std::vector<Real> >
+                calculated = parallelBucketAnalysis(
+                    [&]() { return book(today); }, quantities,
+                    shift, type, workers);
+
+            for (Size i=0; i<expected.first.size(); ++i) {
+                if (calculated.first[i] != expected.first[i]
+                    || calculated.second[i] != expected.second[i])
+                    BOOST_ERROR("parallel bucket analysis differs from "
+                                "sequential one"
+                                << std::setprecision(16)
+                                << "\n    type:              " << type
+                                << "\n    workers:           " << workers
+                                << "\n    quote:             " << i
+                                << "\n    first derivative:  "
+                                << calculated.first[i]
+                                << "\n    expected:          "
+                                << expected.first[i]
+                                << "\n    second derivative: "
+                                << calculated.second[i]
+                                << "\n    expected:          "
+                                << expected.second[i]);
+            }
+        }
+
+        // with one quote per worker, each copy of the book values all
+        // its instruments once and then only those depending on the
+        // quote tweaked by its worker
+        std::vector<SensitivityAnalysisSetup> copies;
+        parallelBucketAnalysis(
+            [&]() { copies.push_back(book(today)); return copies.back(); },
+            quantities, shift, type, setup.first.size());
+        const Size tweaks = (type == OneSide) ? 1 : 2;
+        for (Size k=0; k<copies.size(); ++k) {
+            for (Size i=0; i<copies[k].second.size(); ++i) {
+                const Size expected = 1 + (depends(i, k) ? tweaks : 0);
+                if (calculations(copies[k].second[i]) != expected)
+                    BOOST_ERROR("unexpected number of valuations"
+                                << "\n    type:       " << type
+                                << "\n    worker:     " << k
+                                << "\n    instrument: " << i
+                                << "\n    valuations: "
+                                << calculations(copies[k].second[i])
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+}
+
+void SensitivityAnalysisTest::testScenarioRunner() {
+
+    BOOST_TEST_MESSAGE("Testing scenario runner against "
+                       "full revaluation...");
+
+    using namespace sensitivity_analysis_test;
+
+    SavedSettings backup;
+
+    const Date today = Date(14, March, 2023);
+    Settings::instance().evaluationDate() = today;
+
+    const SensitivityAnalysisSetup setup = book(today);
+    const std::vector<Handle<SimpleQuote> >& quotes = setup.first;
+    const std::vector<std::shared_ptr<Instrument> >& instruments =
+        setup.second;
+    const std::vector<Real> quantities = { 1.0, -2.0, 3.0, 0.5 };
+
+    ScenarioRunner runner(quotes, instruments, quantities);
+
+    struct ScenarioData {
+        ScenarioRunner::Scenario scenario;
+        Size repriced;
+    };
+    // the first two quotes reach the options on the first underlying,
+    // the next two those on the second one, the rate all of them
+    const ScenarioData scenarios[] = {
+        { {}, 0 },
+        { { {0, 103.0} }, 2 },
+        { { {3, 0.30} }, 2 },
+        { { {0, 97.0}, {1, 0.25} }, 2 },
+        { { {2, 48.0}, {0, 101.0} }, 4 },
+        { { {4, 0.04} }, 4 },
+        { { {1, 0.22}, {1, 0.18} }, 2 }
+    };
+
+    const Real tol = 1e-10;
+    Size repriced = 0;
+    for (Size i=0; i<LENGTH(scenarios); ++i) {
+        const ScenarioRunner::Scenario& scenario = scenarios[i].scenario;
+
+        resetCalculations(instruments);
+        const Real calculated = runner.npv(scenario);
+        Size valuations = 0;
+        for (const auto& instrument : instruments)
+            valuations += calculations(instrument);
+        if (valuations != scenarios[i].repriced)
+            BOOST_ERROR("unexpected number of valuations "
+                        "under scenario " << i
+                        << "\n    valuations: " << valuations
+                        << "\n    expected:   " << scenarios[i].repriced);
+
+        std::vector<Real> values;
+        for (const auto& q : quotes)
+            values.push_back(q->value());
+        for (const auto& shift : scenario)
+            quotes[shift.first]->setValue(shift.second);
+        const Real expected = aggregateNPV(instruments, quantities);
+        for (Size k=0; k<quotes.size(); ++k)
+            quotes[k]->setValue(values[k]);
+
+        repriced += scenarios[i].repriced;
+        if (std::fabs(calculated - expected) > tol)
+            BOOST_ERROR("failed to reproduce full revaluation "
+                        "under scenario " << i
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+        if (runner.scenarios() != i+1
+            || runner.repricedInstruments() != repriced
+            || runner.skippedInstruments()
+                   != (i+1)*instruments.size() - repriced)
+            BOOST_ERROR("unexpected statistics after scenario " << i
+                        << "\n    scenarios:            "
+                        << runner.scenarios()
+                        << "\n    repriced instruments: "
+                        << runner.repricedInstruments()
+                        << "\n    expected:             " << repriced
+                        << "\n    skipped instruments:  "
+                        << runner.skippedInstruments()
+                        << "\n    expected:             "
+                        << (i+1)*instruments.size() - repriced);
+    }
+
+    const std::vector<Real> expected = { 100.0, 0.20, 50.0, 0.35, 0.03 };
+    for (Size k=0; k<quotes.size(); ++k) {
+        if (quotes[k]->value() != expected[k])
+            BOOST_ERROR("quote " << k << " not restored"
+                        << "\n    value:    " << quotes[k]->value()
+                        << "\n    expected: " << expected[k]);
+    }
+}
+
+void SensitivityAnalysisTest::testScenarioRunnerRestoresQuotes() {
+
+    BOOST_TEST_MESSAGE("Testing that the scenario runner restores "
+                       "quotes when pricing fails...");
+
+    using namespace sensitivity_analysis_test;
+
+    SavedSettings backup;
+
+    const Date today = Date(14, March, 2023);
+    Settings::instance().evaluationDate() = today;
+
+    const SensitivityAnalysisSetup setup = book(today);
+    const std::vector<Handle<SimpleQuote> >& quotes = setup.first;
+
+    ScenarioRunner runner(quotes, setup.second);
+    const Real baseNpv = runner.npv();
+
+    std::vector<Real> values;
+    for (const auto& q : quotes)
+        values.push_back(q->value());
+
+    // the engine rejects the negative spot, after all the quotes
+    // of the scenario have been set
+    const ScenarioRunner::Scenario scenario = {
+        {4, 0.05}, {1, 0.30}, {0, 110.0}, {0, -1.0}
+    };
+    BOOST_CHECK_THROW(runner.npv(scenario), Error);
+
+    for (Size k=0; k<quotes.size(); ++k) {
+        if (quotes[k]->value() != values[k])
+            BOOST_ERROR("quote " << k << " not restored after failure"
+                        << "\n    value:    " << quotes[k]->value()
+                        << "\n    expected: " << values[k]);
+    }
+
+    const Real npv = aggregateNPV(setup.second, std::vector<Real>());
+    if (std::fabs(npv - baseNpv) > 1e-10 || runner.npv(ScenarioRunner::Scenario()) != baseNpv)
+        BOOST_ERROR("failed to reproduce base NPV after failure"
+                    << std::setprecision(12)
+                    << "\n    full revaluation: " << npv
+                    << "\n    runner:           " << runner.npv(ScenarioRunner::Scenario())
+                    << "\n    expected:         " << baseNpv);
+}
+
+test_suite* SensitivityAnalysisTest::suite() {
+    auto* suite = BOOST_TEST_SUITE("Sensitivity analysis tests");
+    suite->add(QUANTLIB_TEST_CASE(&SensitivityAnalysisTest::testBucketAnalysis));
+    suite->add(QUANTLIB_TEST_CASE(&SensitivityAnalysisTest::testParallelBucketAnalysis));
+    suite->add(QUANTLIB_TEST_CASE(&SensitivityAnalysisTest::testScenarioRunner));
+    suite->add(QUANTLIB_TEST_CASE(&SensitivityAnalysisTest::testScenarioRunnerRestoresQuotes));
+    return suite;
+}
@@ -34,6 +34,7 @@
 #else
 #include <boost/test/tools/floating_point_comparison.hpp>
 #endif
+#include <chrono>
 #include <cmath>
 #include <iomanip>
 #include <numeric>
@@ -176,6 +177,16 @@ namespace QuantLib {
     }
 
 
+    // wall-clock time in seconds spent in a call, used by the benchmarks
+    template <class F>
+    Real elapsedSeconds(const F& f) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(stop - start).count();
+    }
+
+
     // this cleans up index-fixing histories when destroyed
     class IndexHistoryCleaner {
       public:
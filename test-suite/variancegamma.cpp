@@ -25,6 +25,8 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/instruments/europeanoption.hpp>
 #include <ql/experimental/variancegamma/analyticvariancegammaengine.hpp>
 #include <ql/experimental/variancegamma/fftvariancegammaengine.hpp>
+#include <ql/experimental/variancegamma/variancegammacharacteristicfunction.hpp>
+#include <ql/pricingengines/vanilla/fouriersurfacepricer.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -250,10 +252,83 @@ void VarianceGammaTest::testSingularityAtZero() {
 }
 
 
+void VarianceGammaTest::testFourierSurfacePricer() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Fourier surface pricer for the variance-gamma model...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual360();
+    const Date today = Date::todaysDate();
+
+    // see testVarianceGamma
+    const Handle<Quote> spot(std::make_shared<SimpleQuote>(6000.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+
+    const std::shared_ptr<VarianceGammaModel> model(
+        std::make_shared<VarianceGammaModel>(
+            std::make_shared<VarianceGammaProcess>(
+                spot, qTS, rTS, 0.15, 0.01, -0.50)));
+
+    const std::vector<Real> strikes = {
+        5550, 5650, 5750, 5850, 5950, 6050, 6150, 6250, 6350, 6450, 6550 };
+    const Real expectedCalls[] = {
+        732.8705, 665.1404, 601.1002, 540.8824, 484.5766, 432.2273,
+        383.8346, 339.3559, 298.7087, 261.7751, 228.4057 };
+    const Real expectedPut = 130.9974;
+
+    const FourierSurfacePricer::Method methods[] = {
+        FourierSurfacePricer::CarrMadan,
+        FourierSurfacePricer::FractionalFFT,
+        FourierSurfacePricer::COS
+    };
+    const Size points[] = { 4096, 256, 256 };
+
+    const Real tol = 0.01;
+    for (Size i=0; i < LENGTH(methods); ++i) {
+        const FourierSurfacePricer pricer(
+            std::make_shared<VarianceGammaCharacteristicFunction>(model),
+            spot, rTS, qTS, methods[i], points[i]);
+
+        const std::vector<Real> calls =
+            pricer.prices(Option::Call, strikes, 1.0);
+        const std::vector<Real> puts =
+            pricer.prices(Option::Put, strikes, 1.0);
+
+        for (Size j=0; j < strikes.size(); ++j) {
+            const Real error = std::fabs(calls[j] - expectedCalls[j]);
+            if (error > tol) {
+                BOOST_FAIL("failed to reproduce variance-gamma call price"
+                           << "\n    method:     " << i
+                           << "\n    strike:     " << strikes[j]
+                           << "\n    calculated: " << calls[j]
+                           << "\n    expected:   " << expectedCalls[j]
+                           << "\n    error:      " << error
+                           << "\n    tolerance:  " << tol);
+            }
+        }
+
+        const Real error = std::fabs(puts.front() - expectedPut);
+        if (error > tol) {
+            BOOST_FAIL("failed to reproduce variance-gamma put price"
+                       << "\n    method:     " << i
+                       << "\n    strike:     " << strikes.front()
+                       << "\n    calculated: " << puts.front()
+                       << "\n    expected:   " << expectedPut
+                       << "\n    error:      " << error
+                       << "\n    tolerance:  " << tol);
+        }
+    }
+}
+
+
 test_suite* VarianceGammaTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Variance Gamma tests");
 
     suite->add(QUANTLIB_TEST_CASE(&VarianceGammaTest::testVarianceGamma));
     suite->add(QUANTLIB_TEST_CASE(&VarianceGammaTest::testSingularityAtZero));
+    suite->add(QUANTLIB_TEST_CASE(&VarianceGammaTest::testFourierSurfacePricer));
     return suite;
 }
@@ -30,6 +30,7 @@ class VarianceGammaTest {
 public:
     static void testVarianceGamma();
     static void testSingularityAtZero();
+    static void testFourierSurfacePricer();
     static boost::unit_test_framework::test_suite* suite();
 };
 